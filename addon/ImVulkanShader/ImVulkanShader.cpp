@@ -1,5 +1,11 @@
 #include "ImVulkanShader.h"
 #include "imvk_mat_shader.h"
+#include "filters/ColorGrade_vulkan.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <cmath>
 
 namespace ImGui
 {
@@ -54,6 +60,96 @@ void ImVulkanVkMatToVkImageMat(const VkMat &src, VkImageMat &dst)
     vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
 }
 
+// store pipeline of ImVulkanVkMatToTexture, compiled once per device on first use
+static std::mutex g_texture_pipeline_mutex;
+static std::map<const VulkanDevice*, Pipeline*> g_texture_pipelines;
+
+static const Pipeline* texture_pipeline(const VulkanDevice* vkdev)
+{
+    std::lock_guard<std::mutex> lock(g_texture_pipeline_mutex);
+    auto it = g_texture_pipelines.find(vkdev);
+    if (it != g_texture_pipelines.end())
+        return it->second;
+    Option opt;
+    Pipeline* pipe = nullptr;
+    std::vector<vk_specialization_type> specializations(0);
+    std::vector<uint32_t> spirv_data;
+    if (compile_spirv_module(store_texture_data, opt, spirv_data) == 0)
+    {
+        pipe = new Pipeline(vkdev);
+        pipe->set_optimal_local_size_xyz(16, 16, 1);
+        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+    }
+    g_texture_pipelines[vkdev] = pipe;
+    return pipe;
+}
+
+// stores submitted without waiting, kept with their source until the queue is done with both
+struct texture_store
+{
+    VkCompute* cmd;
+    VkMat src;
+};
+static std::mutex g_texture_store_mutex;
+static std::vector<texture_store> g_texture_stores;
+
+static void retire_texture_stores(bool wait)
+{
+    std::lock_guard<std::mutex> lock(g_texture_store_mutex);
+    for (auto it = g_texture_stores.begin(); it != g_texture_stores.end();)
+    {
+        if (!wait && !it->cmd->finished())
+        {
+            ++it;
+            continue;
+        }
+        it->cmd->wait();
+        delete it->cmd;
+        it = g_texture_stores.erase(it);
+    }
+}
+
+bool ImVulkanVkMatToTexture(const VkMat &src, VkImageMat &dst, VkSemaphore wait_semaphore, VkSemaphore signal_semaphore, uint32_t dst_queue_family_index)
+{
+    const VkAllocator* allocator = (VkAllocator*)src.allocator;
+    const VulkanDevice* vkdev = allocator->vkdev;
+    const Pipeline* pipe = texture_pipeline(vkdev);
+    if (!pipe)
+        return false;
+    std::vector<VkMat> buffer_bindings(4);
+    if      (src.type == IM_DT_INT8)     buffer_bindings[0] = src;
+    else if (src.type == IM_DT_INT16)    buffer_bindings[1] = src;
+    else if (src.type == IM_DT_FLOAT16)  buffer_bindings[2] = src;
+    else if (src.type == IM_DT_FLOAT32)  buffer_bindings[3] = src;
+    std::vector<VkImageMat> image_bindings(1);
+    image_bindings[0] = dst;
+    std::vector<vk_constant_type> constants(4);
+    constants[0].i = src.w;
+    constants[1].i = src.h;
+    constants[2].i = src.c;
+    constants[3].i = src.type;
+    if (!signal_semaphore)
+    {
+        VkCompute cmd(vkdev);
+        cmd.record_pipeline(pipe, buffer_bindings, image_bindings, constants, dst);
+        return cmd.submit_and_wait() == 0;
+    }
+
+    retire_texture_stores(false);
+    VkCompute* cmd = new VkCompute(vkdev);
+    cmd->record_pipeline(pipe, buffer_bindings, image_bindings, constants, dst);
+    if (dst_queue_family_index != VK_QUEUE_FAMILY_IGNORED && dst_queue_family_index != vkdev->info.compute_queue_family_index())
+        cmd->record_queue_release(dst, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, dst_queue_family_index);
+    if (cmd->submit(wait_semaphore, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, signal_semaphore) != 0)
+    {
+        delete cmd;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_texture_store_mutex);
+    g_texture_stores.push_back({ cmd, src });
+    return true;
+}
+
 void ImVulkanShaderInit()
 {
     create_gpu_instance();
@@ -61,6 +157,13 @@ void ImVulkanShaderInit()
 
 void ImVulkanShaderClear()
 {
+    retire_texture_stores(true);
+    {
+        std::lock_guard<std::mutex> lock(g_texture_pipeline_mutex);
+        for (auto& it : g_texture_pipelines)
+            delete it.second;
+        g_texture_pipelines.clear();
+    }
     destroy_gpu_instance();
 }
 
@@ -169,4 +272,326 @@ float ImVulkanPeak(VulkanDevice* vkdev, int loop, int count_mb, int cmd_loop, in
     vkdev->reclaim_blob_allocator(allocator);
     return max_gflops / cmd_loop;
 }
+
+// host <-> device through the staging allocator, GB/s of a count_mb MB block, best of loop
+static void measure_transfer(const VulkanDevice* vkdev, int count_mb, int loop, double& upload_gbs, double& download_gbs)
+{
+    Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImMat host;
+    host.create(count_mb * 1024 * 1024 / 4, (size_t)4u);
+    memset(host.data, 0, host.total() * host.elemsize);
+    double bytes = (double)host.total() * host.elemsize;
+    upload_gbs = download_gbs = 0;
+    for (int i = 0; i < loop; i++)
+    {
+        VkMat dev;
+        ImMat back;
+        VkCompute cmd(vkdev);
+        double t0 = get_current_time();
+        cmd.record_clone(host, dev, opt);
+        cmd.submit_and_wait();
+        double t1 = get_current_time();
+        cmd.reset();
+        cmd.record_clone(dev, back, opt);
+        cmd.submit_and_wait();
+        double t2 = get_current_time();
+        upload_gbs = std::max(upload_gbs, bytes / (t1 - t0) / 1e9);
+        download_gbs = std::max(download_gbs, bytes / (t2 - t1) / 1e9);
+    }
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+}
+
+// us per dispatch recorded in one command buffer, and us of one submit_and_wait round trip
+static void measure_dispatch(const VulkanDevice* vkdev, int count, double& dispatch_us, double& submit_us)
+{
+    Option opt;
+    std::vector<uint32_t> spirv;
+    dispatch_us = submit_us = -1;
+    if (compile_spirv_module(glsl_dispatch_data, opt, spirv) != 0)
+        return;
+    Pipeline pipeline(vkdev);
+    pipeline.set_local_size_xyz(1, 1, 1);
+    pipeline.create(spirv.data(), spirv.size() * 4, std::vector<vk_specialization_type>());
+    VkAllocator* allocator = vkdev->acquire_blob_allocator();
+    {
+        VkMat c(1, (size_t)4u, allocator);
+        std::vector<VkMat> bindings(1, c);
+        std::vector<vk_constant_type> constants;
+        VkCompute cmd(vkdev);
+        for (int i = 0; i < count; i++)
+            cmd.record_pipeline(&pipeline, bindings, constants, c);
+        double t0 = get_current_time();
+        cmd.submit_and_wait();
+        dispatch_us = (get_current_time() - t0) * 1e6 / count;
+        cmd.reset();
+
+        double total = 0;
+        for (int i = 0; i < count / 10 + 1; i++)
+        {
+            cmd.record_pipeline(&pipeline, bindings, constants, c);
+            t0 = get_current_time();
+            cmd.submit_and_wait();
+            total += get_current_time() - t0;
+            cmd.reset();
+        }
+        submit_us = total * 1e6 / (count / 10 + 1);
+    }
+    vkdev->reclaim_blob_allocator(allocator);
+}
+
+// shared memory read GB/s, 4 vec4 per loop per invocation
+static double measure_shared(const VulkanDevice* vkdev, int loop)
+{
+    const int count = 1024 * 1024;
+    Option opt;
+    std::vector<uint32_t> spirv;
+    if (compile_spirv_module(glsl_shared_data, opt, spirv) != 0)
+        return -1;
+    std::vector<vk_specialization_type> specializations(2);
+    specializations[0].i = count;
+    specializations[1].i = loop;
+    Pipeline pipeline(vkdev);
+    pipeline.set_local_size_xyz(128, 1, 1);
+    pipeline.create(spirv.data(), spirv.size() * 4, specializations);
+    VkAllocator* allocator = vkdev->acquire_blob_allocator();
+    double gbs = 0;
+    {
+        VkMat c(count, (size_t)16u, allocator);
+        std::vector<VkMat> bindings(1, c);
+        VkCompute cmd(vkdev);
+        for (int i = 0; i < 3; i++)
+        {
+            cmd.record_pipeline(&pipeline, bindings, std::vector<vk_constant_type>(), c);
+            double t0 = get_current_time();
+            cmd.submit_and_wait();
+            double time = get_current_time() - t0;
+            gbs = std::max(gbs, (double)count * loop * 4 * 16 / time / 1e9);
+            cmd.reset();
+        }
+    }
+    vkdev->reclaim_blob_allocator(allocator);
+    return gbs;
+}
+
+// 3x3 box over a vec4 plane, ms per pass for buffer or image storage
+static double measure_storage(const VulkanDevice* vkdev, bool image, bool fp16, int w, int h, int loop)
+{
+    Option opt;
+    opt.use_image_storage = image;
+    opt.use_fp16_storage = fp16;
+    size_t elemsize = fp16 ? 8u : 16u;
+    std::vector<uint32_t> spirv;
+    if (compile_spirv_module(glsl_box_data, opt, spirv) != 0)
+        return -1;
+    std::vector<vk_specialization_type> specializations(2);
+    specializations[0].i = w;
+    specializations[1].i = h;
+    Pipeline pipeline(vkdev);
+    pipeline.set_optimal_local_size_xyz(16, 16, 1);
+    pipeline.create(spirv.data(), spirv.size() * 4, specializations);
+    VkAllocator* allocator = vkdev->acquire_blob_allocator();
+    double ms = -1;
+    {
+        VkCompute cmd(vkdev);
+        if (image)
+        {
+            VkImageMat a(w, h, elemsize, 4, allocator);
+            VkImageMat c(w, h, elemsize, 4, allocator);
+            if (a.empty() || c.empty())
+            {
+                vkdev->reclaim_blob_allocator(allocator);
+                return -1;
+            }
+            std::vector<VkImageMat> bindings(2);
+            bindings[0] = a;
+            bindings[1] = c;
+            cmd.record_pipeline(&pipeline, bindings, std::vector<vk_constant_type>(), c); // warm up, layout transitions
+            cmd.submit_and_wait();
+            cmd.reset();
+            for (int i = 0; i < loop; i++)
+                cmd.record_pipeline(&pipeline, bindings, std::vector<vk_constant_type>(), c);
+        }
+        else
+        {
+            VkMat a(w, h, elemsize, 4, allocator);
+            VkMat c(w, h, elemsize, 4, allocator);
+            std::vector<VkMat> bindings(2);
+            bindings[0] = a;
+            bindings[1] = c;
+            for (int i = 0; i < loop; i++)
+                cmd.record_pipeline(&pipeline, bindings, std::vector<vk_constant_type>(), c);
+        }
+        double t0 = get_current_time();
+        cmd.submit_and_wait();
+        ms = (get_current_time() - t0) * 1000.0 / loop;
+    }
+    vkdev->reclaim_blob_allocator(allocator);
+    return ms;
+}
+
+// JSON has no inf or nan, a failed or skipped measure is null
+static std::string json_number(double v)
+{
+    if (!std::isfinite(v))
+        return "null";
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.3f", v);
+    return buf;
+}
+
+// quoted and escaped, driver provided names may hold quotes, backslashes or control characters
+static std::string json_string(const char* s)
+{
+    std::string out = "\"";
+    for (const unsigned char* c = (const unsigned char*)s; c && *c; c++)
+    {
+        switch (*c)
+        {
+            case '"':   out += "\\\""; break;
+            case '\\':  out += "\\\\"; break;
+            case '\b':  out += "\\b"; break;
+            case '\f':  out += "\\f"; break;
+            case '\n':  out += "\\n"; break;
+            case '\r':  out += "\\r"; break;
+            case '\t':  out += "\\t"; break;
+            default:
+                if (*c < 0x20)
+                {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", *c);
+                    out += buf;
+                }
+                else
+                    out += (char)*c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string ImVulkanCharacterize(VulkanDevice* vkdev, int loop)
+{
+    if (!vkdev)
+        return "{}";
+    const GpuInfo& info = vkdev->info;
+    const int gpu = vkdev->get_device_index();
+    loop = std::max(loop, 1);
+    bool discrete = info.type() == 0;
+    std::string json = "{\n";
+    uint32_t api = info.api_version();
+    uint32_t drv = info.driver_version();
+    json += "  \"device\": {\n";
+    json += "    \"index\": " + std::to_string(gpu) + ",\n";
+    json += "    \"name\": " + json_string(info.device_name()) + ",\n";
+    json += "    \"type\": \"" + std::string(info.type() == 0 ? "discrete" : info.type() == 1 ? "integrated" : info.type() == 2 ? "virtual" : "cpu") + "\",\n";
+    json += "    \"api\": \"" + std::to_string(VK_VERSION_MAJOR(api)) + "." + std::to_string(VK_VERSION_MINOR(api)) + "." + std::to_string(VK_VERSION_PATCH(api)) + "\",\n";
+    json += "    \"driver\": \"" + std::to_string(VK_VERSION_MAJOR(drv)) + "." + std::to_string(VK_VERSION_MINOR(drv)) + "." + std::to_string(VK_VERSION_PATCH(drv)) + "\",\n";
+    json += "    \"subgroup_size\": " + std::to_string(info.subgroup_size()) + ",\n";
+    json += "    \"fp16_packed\": " + std::string(info.support_fp16_packed() ? "true" : "false") + ",\n";
+    json += "    \"fp16_storage\": " + std::string(info.support_fp16_storage() ? "true" : "false") + ",\n";
+    json += "    \"fp16_arithmetic\": " + std::string(info.support_fp16_arithmetic() ? "true" : "false") + ",\n";
+    json += "    \"heap_budget_mb\": " + std::to_string(vkdev->get_heap_budget()) + "\n";
+    json += "  },\n";
+
+    // arithmetic, same variants as the perf test window
+    const int peak_loop = discrete ? 200 : 40;
+    const struct { const char* name; int storage; int arithmetic; int packing; } peaks[] = {
+        { "fp32", 0, 0, 0 }, { "fp32v4", 0, 0, 1 }, { "fp32v8", 0, 0, 2 },
+        { "fp16pv4", 1, 1, 1 }, { "fp16pv8", 1, 1, 2 },
+        { "fp16s", 2, 1, 0 }, { "fp16sv4", 2, 1, 1 }, { "fp16sv8", 2, 1, 2 },
+    };
+    float gflops[8];
+    json += "  \"gflops\": {";
+    for (int i = 0; i < 8; i++)
+    {
+        gflops[i] = ImVulkanPeak(vkdev, peak_loop, 4, 2, peaks[i].storage, peaks[i].arithmetic, peaks[i].packing);
+        json += std::string(i ? ", " : " ") + json_string(peaks[i].name) + ": " + json_number(gflops[i]);
+    }
+    json += " },\n";
+
+    double upload_gbs, download_gbs;
+    measure_transfer(vkdev, 64, loop, upload_gbs, download_gbs);
+    json += "  \"transfer_gbs\": { \"host_to_device\": " + json_number(upload_gbs) + ", \"device_to_host\": " + json_number(download_gbs) + " },\n";
+
+    double dispatch_us, submit_us;
+    measure_dispatch(vkdev, 100 * loop, dispatch_us, submit_us);
+    json += "  \"dispatch_us\": { \"recorded\": " + json_number(dispatch_us) + ", \"submit_and_wait\": " + json_number(submit_us) + " },\n";
+
+    json += "  \"shared_memory_gbs\": " + json_number(measure_shared(vkdev, discrete ? 1024 : 256)) + ",\n";
+
+    // 3x3 box on a 1080p vec4 plane, -1 when the storage is not supported
+    bool fp16 = info.support_fp16_storage();
+    double buffer_ms = measure_storage(vkdev, false, false, 1920, 1080, loop);
+    double image_ms = measure_storage(vkdev, true, false, 1920, 1080, loop);
+    double buffer16_ms = fp16 ? measure_storage(vkdev, false, true, 1920, 1080, loop) : -1;
+    double image16_ms = fp16 ? measure_storage(vkdev, true, true, 1920, 1080, loop) : -1;
+    json += "  \"storage_ms\": { \"buffer_fp32\": " + json_number(buffer_ms) + ", \"image_fp32\": " + json_number(image_ms) +
+            ", \"buffer_fp16\": " + json_number(buffer16_ms) + ", \"image_fp16\": " + json_number(image16_ms) + " },\n";
+
+    // filters on device mats, rgba8 at standard resolutions
+    const struct { const char* name; int w; int h; } sizes[] = { { "720p", 1280, 720 }, { "1080p", 1920, 1080 }, { "2160p", 3840, 2160 } };
+    json += "  \"filter_ms\": {\n";
+    {
+        Option opt;
+        opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+        opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+        ColorConvert_vulkan convert(gpu);
+        Resize_vulkan resize(gpu);
+        ColorGrade_vulkan grade(gpu);
+        ColorGradeParam param;
+        param.exposure = 0.2f;
+        param.contrast = 1.1f;
+        param.saturation = 1.2f;
+        for (int s = 0; s < 3; s++)
+        {
+            ImMat host;
+            host.create_type(sizes[s].w, sizes[s].h, 4, IM_DT_INT8);
+            memset(host.data, 128, host.total() * host.elemsize);
+            VkMat src;
+            {
+                VkCompute cmd(vkdev);
+                cmd.record_clone(host, src, opt);
+                cmd.submit_and_wait();
+            }
+            VkMat nv12, half, graded;
+            nv12.type = half.type = graded.type = IM_DT_INT8;
+            nv12.color_format = IM_CF_NV12;
+            nv12.color_range = IM_CR_NARROW_RANGE;
+            src.color_space = IM_CS_BT709;
+            convert.ConvertColorFormat(src, nv12); // warm up
+            resize.Resize(src, half, 0.5f, 0.5f, IM_INTERPOLATE_BILINEAR);
+            grade.filter(src, graded, param);
+            double t0 = get_current_time();
+            for (int i = 0; i < loop; i++) convert.ConvertColorFormat(src, nv12);
+            double t1 = get_current_time();
+            for (int i = 0; i < loop; i++) resize.Resize(src, half, 0.5f, 0.5f, IM_INTERPOLATE_BILINEAR);
+            double t2 = get_current_time();
+            for (int i = 0; i < loop; i++) grade.filter(src, graded, param);
+            double t3 = get_current_time();
+            json += "    " + json_string(sizes[s].name) + ": { \"rgba_to_nv12\": " + json_number((t1 - t0) * 1000.0 / loop) +
+                    ", \"resize_half_bilinear\": " + json_number((t2 - t1) * 1000.0 / loop) +
+                    ", \"color_grade\": " + json_number((t3 - t2) * 1000.0 / loop) + " }" + (s < 2 ? ",\n" : "\n");
+        }
+        vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+        vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    }
+    json += "  },\n";
+
+    // Option defaults picked from the numbers above
+    bool use_fp16_storage = info.support_fp16_storage() && (buffer16_ms < 0 || buffer16_ms <= buffer_ms);
+    bool use_fp16_arithmetic = info.support_fp16_arithmetic() && gflops[6] > gflops[1] * 1.1f;
+    bool use_image_storage = image_ms > 0 && image_ms < buffer_ms * 0.9;
+    bool use_shader_pack8 = gflops[2] > gflops[1] * 1.05f;
+    json += "  \"recommended_option\": {\n";
+    json += "    \"use_fp16_packed\": " + std::string(info.support_fp16_packed() ? "true" : "false") + ",\n";
+    json += "    \"use_fp16_storage\": " + std::string(use_fp16_storage ? "true" : "false") + ",\n";
+    json += "    \"use_fp16_arithmetic\": " + std::string(use_fp16_arithmetic ? "true" : "false") + ",\n";
+    json += "    \"use_image_storage\": " + std::string(use_image_storage ? "true" : "false") + ",\n";
+    json += "    \"use_shader_pack8\": " + std::string(use_shader_pack8 ? "true" : "false") + "\n";
+    json += "  }\n";
+    json += "}\n";
+    return json;
+}
 } // namespace ImGui
@@ -5,16 +5,28 @@
 #include "immat.h"
 #include "imvk_substract_mean_normalize.h"
 #include "imvk_copy_make_border.h"
+#include "imvk_preprocess.h"
+#include "imvk_scheduler.h"
 #include "filters/ColorConvert_vulkan.h"
 #include "filters/Resize_vulkan.h"
 #include <vulkan/vulkan.h>
+#include <string>
 
 namespace ImGui
 {
     VKSHADER_API void ImMatToImVulkanMat(const ImMat &src, VkMat &dst);
     VKSHADER_API void ImVulkanVkMatToImMat(const VkMat &src, ImMat &dst);
     VKSHADER_API void ImVulkanVkMatToVkImageMat(const VkMat &src, VkImageMat &dst);
+    // store a gray, rgb or rgba mat of any type into a caller owned 2D RGBA8 storage image, e.g. the back image of an
+    // ImGui texture. without signal_semaphore it waits for the store and leaves the image in VK_IMAGE_LAYOUT_GENERAL.
+    // with it the store waits wait_semaphore, signals signal_semaphore and returns at once, the source is kept alive
+    // until done. an image read on another queue family is released to dst_queue_family_index with the transition
+    // from GENERAL to SHADER_READ_ONLY_OPTIMAL, the reader records the acquire half. false when nothing was submitted
+    VKSHADER_API bool ImVulkanVkMatToTexture(const VkMat &src, VkImageMat &dst, VkSemaphore wait_semaphore = VK_NULL_HANDLE, VkSemaphore signal_semaphore = VK_NULL_HANDLE, uint32_t dst_queue_family_index = VK_QUEUE_FAMILY_IGNORED);
     VKSHADER_API void ImVulkanShaderInit();
     VKSHADER_API void ImVulkanShaderClear();
     VKSHADER_API float ImVulkanPeak(VulkanDevice* vkdev, int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type);
+    // device report as JSON: arithmetic peak, host/device transfer, dispatch overhead, shared memory,
+    // buffer vs image storage, filter ms at 720p/1080p/2160p and the Option defaults they suggest
+    VKSHADER_API std::string ImVulkanCharacterize(VulkanDevice* vkdev, int loop = 10);
 } //namespace ImGui
\ No newline at end of file
@@ -34,7 +34,7 @@ layout (push_constant) uniform parameter \n\
 void main() \n\
 { \n\
     ivec2 uv = ivec2(gl_GlobalInvocationID.xy); \n\
-    if (uv.x >= p.w || uv.y >= p.h) \n\
+    if (uv.x >= p.out_w || uv.y >= p.out_h) \n\
         return; \n\
     sfpvec4 result; \n\
     sfpvec4 rgba_src2 = load_rgba_src2(uv.x, uv.y, p.w2, p.cstep2, p.in_format2, p.in_type2); \n\
@@ -74,7 +74,7 @@ SHADER_ALPHA_MAIN
 void main() \n\
 { \n\
     ivec2 uv = ivec2(gl_GlobalInvocationID.xy); \n\
-    if (uv.x >= p.w || uv.y >= p.h) \n\
+    if (uv.x >= p.out_w || uv.y >= p.out_h) \n\
         return; \n\
     sfpvec4 result; \n\
     sfpvec4 rgba_src2 = load_rgba_src2(uv.x, uv.y, p.w2, p.cstep2, p.in_format2, p.in_type2); \n\
@@ -106,4 +106,123 @@ SHADER_LOAD_RGBA
 SHADER_LOAD_RGBA_NAME(src2)
 SHADER_STORE_RGBA
 SHADER_ALPHA_WITH_ALPHA_MAIN
-;
\ No newline at end of file
+;
+#define SHADER_COMPOSITE_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_format; \n\
+    int in_type; \n\
+\n\
+    int out_w; \n\
+    int out_h; \n\
+    int out_cstep; \n\
+    int out_format; \n\
+    int out_type; \n\
+\n\
+    int x_offset; \n\
+    int y_offset; \n\
+    int rect_x; \n\
+    int rect_y; \n\
+    float scale_x; \n\
+    float scale_y; \n\
+    float opacity; \n\
+    int mode; \n\
+    int pass; \n\
+} p; \
+"
+
+// blend modes and passes, same values as ImBlendMode and AlphaBlending_vulkan::composite
+#define SHADER_COMPOSITE_BLEND \
+" \n\
+#define BLEND_NORMAL        0 \n\
+#define BLEND_ADD           1 \n\
+#define BLEND_MULTIPLY      2 \n\
+#define BLEND_SCREEN        3 \n\
+#define BLEND_OVERLAY       4 \n\
+#define BLEND_DARKEN        5 \n\
+#define BLEND_LIGHTEN       6 \n\
+#define BLEND_DIFFERENCE    7 \n\
+#define PASS_OVER           0 \n\
+#define PASS_FIRST          1 \n\
+#define PASS_RESOLVE        2 \n\
+\n\
+sfpvec3 blend_mode(sfpvec3 b, sfpvec3 s) \n\
+{ \n\
+    if (p.mode == BLEND_ADD) \n\
+        return min(b + s, sfpvec3(1.f)); \n\
+    else if (p.mode == BLEND_MULTIPLY) \n\
+        return b * s; \n\
+    else if (p.mode == BLEND_SCREEN) \n\
+        return b + s - b * s; \n\
+    else if (p.mode == BLEND_OVERLAY) \n\
+        return mix(sfp(2.f) * b * s, sfpvec3(1.f) - sfp(2.f) * (sfpvec3(1.f) - b) * (sfpvec3(1.f) - s), step(sfpvec3(0.5f), b)); \n\
+    else if (p.mode == BLEND_DARKEN) \n\
+        return min(b, s); \n\
+    else if (p.mode == BLEND_LIGHTEN) \n\
+        return max(b, s); \n\
+    else if (p.mode == BLEND_DIFFERENCE) \n\
+        return abs(b - s); \n\
+    return s; \n\
+} \n\
+\n\
+// bilinear inside the scaled layer, edge clamped, alpha 0 outside \n\
+sfpvec4 load_layer(int x, int y) \n\
+{ \n\
+    vec2 pos = vec2(float(x - p.x_offset) + 0.5f, float(y - p.y_offset) + 0.5f) / vec2(p.scale_x, p.scale_y); \n\
+    if (pos.x < 0.f || pos.y < 0.f || pos.x >= float(p.w) || pos.y >= float(p.h)) \n\
+        return sfpvec4(0.f); \n\
+    if (p.scale_x == 1.f && p.scale_y == 1.f) \n\
+        return load_rgba(x - p.x_offset, y - p.y_offset, p.w, p.cstep, p.in_format, p.in_type); \n\
+    vec2 c = pos - 0.5f; \n\
+    ivec2 i = ivec2(floor(c)); \n\
+    vec2 f = c - vec2(i); \n\
+    int x0 = clamp(i.x, 0, p.w - 1), x1 = clamp(i.x + 1, 0, p.w - 1); \n\
+    int y0 = clamp(i.y, 0, p.h - 1), y1 = clamp(i.y + 1, 0, p.h - 1); \n\
+    vec4 v00 = vec4(load_rgba(x0, y0, p.w, p.cstep, p.in_format, p.in_type)); \n\
+    vec4 v10 = vec4(load_rgba(x1, y0, p.w, p.cstep, p.in_format, p.in_type)); \n\
+    vec4 v01 = vec4(load_rgba(x0, y1, p.w, p.cstep, p.in_format, p.in_type)); \n\
+    vec4 v11 = vec4(load_rgba(x1, y1, p.w, p.cstep, p.in_format, p.in_type)); \n\
+    return sfpvec4(mix(mix(v00, v10, f.x), mix(v01, v11, f.x), f.y)); \n\
+} \
+"
+
+// one layer over the accumulator in place, only the layer rect is dispatched,
+// first pass covers the whole canvas over transparent, resolve copies the accumulator to the output
+#define SHADER_COMPOSITE_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    int gx = int(gl_GlobalInvocationID.x) + p.rect_x; \n\
+    int gy = int(gl_GlobalInvocationID.y) + p.rect_y; \n\
+    if (gx >= p.out_w || gy >= p.out_h) \n\
+        return; \n\
+    if (p.pass == PASS_RESOLVE) \n\
+    { \n\
+        store_rgba(load_rgba(gx, gy, p.w, p.cstep, p.in_format, p.in_type), gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+        return; \n\
+    } \n\
+    sfpvec4 backdrop = p.pass == PASS_FIRST ? sfpvec4(0.f) : load_dst_rgba(gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+    sfpvec4 layer = load_layer(gx, gy); \n\
+    sfp a = layer.a * sfp(p.opacity); \n\
+    sfpvec4 result; \n\
+    result.rgb = mix(backdrop.rgb, blend_mode(backdrop.rgb, layer.rgb), a); \n\
+    result.a = backdrop.a + a * (sfp(1.f) - backdrop.a); \n\
+    store_rgba(result, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+} \
+"
+
+static const char AlphaBlending_composite_data[] = 
+SHADER_HEADER
+SHADER_COMPOSITE_PARAM
+SHADER_INPUT_DATA
+SHADER_OUTPUT_RDWR_DATA
+SHADER_LOAD_RGBA
+SHADER_LOAD_DST_RGBA
+SHADER_STORE_RGBA
+SHADER_COMPOSITE_BLEND
+SHADER_COMPOSITE_MAIN
+;
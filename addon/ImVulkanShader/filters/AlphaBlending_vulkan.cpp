@@ -1,17 +1,19 @@
 #include "AlphaBlending_vulkan.h"
 #include "AlphaBlending_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
+#include <algorithm>
 
 namespace ImGui 
 {
 AlphaBlending_vulkan::AlphaBlending_vulkan(int gpu)
 {
     vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
 
     std::vector<vk_specialization_type> specializations(0);
@@ -32,6 +34,14 @@ AlphaBlending_vulkan::AlphaBlending_vulkan(int gpu)
         pipe_alpha->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
+
+    if (compile_spirv_module(AlphaBlending_composite_data, opt, spirv_data) == 0)
+    {
+        pipe_composite = new Pipeline(vkdev);
+        pipe_composite->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_composite->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        spirv_data.clear();
+    }
     cmd->reset();
 }
 
@@ -40,6 +50,8 @@ AlphaBlending_vulkan::~AlphaBlending_vulkan()
     if (vkdev)
     {
         if (pipe) { delete pipe; pipe = nullptr; }
+        if (pipe_alpha) { delete pipe_alpha; pipe_alpha = nullptr; }
+        if (pipe_composite) { delete pipe_composite; pipe_composite = nullptr; }
         if (cmd) { delete cmd; cmd = nullptr; }
         if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
         if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
@@ -87,11 +99,6 @@ void AlphaBlending_vulkan::upload_param(const VkMat& src1, const VkMat& src2, Vk
 
 void AlphaBlending_vulkan::blend(const ImMat& src1, const ImMat& src2, ImMat& dst, int x, int y) const
 {
-    if (!vkdev || !pipe || !cmd)
-    {
-        return;
-    }
-
     // TODO::Dicky need check dims?
     //if (src1.dims != src2.dims || src1.color_space != src2.color_space || src1.color_range != src2.color_range)
     //    return;
@@ -99,6 +106,17 @@ void AlphaBlending_vulkan::blend(const ImMat& src1, const ImMat& src2, ImMat& ds
     if (x >= src2.w || y >= src2.h || x <= -src1.w || y <= -src1.h)
         return;
 
+    if (!vkdev)
+    {
+        if (src1.device == IM_DD_CPU && src2.device == IM_DD_CPU)
+            CPU::AlphaBlend(src1, src2, dst, x, y);
+        return;
+    }
+    if (!pipe || !cmd)
+    {
+        return;
+    }
+
     VkMat dst_gpu;
     dst_gpu.create_type(src2.w, src2.h, 4, dst.type, opt.blob_vkallocator);
 
@@ -175,11 +193,6 @@ void AlphaBlending_vulkan::upload_param(const VkMat& src1, const VkMat& src2, Vk
 
 void AlphaBlending_vulkan::blend(const ImMat& src1, const ImMat& src2, ImMat& dst, float alpha, int x, int y) const
 {
-    if (!vkdev || !pipe_alpha || !cmd)
-    {
-        return;
-    }
-
     // TODO::Dicky need check dims?
     //if (src1.dims != src2.dims || src1.color_space != src2.color_space || src1.color_range != src2.color_range)
     //    return;
@@ -187,6 +200,17 @@ void AlphaBlending_vulkan::blend(const ImMat& src1, const ImMat& src2, ImMat& ds
     if (x >= src2.w || y >= src2.h || x <= -src1.w || y <= -src1.h)
         return;
 
+    if (!vkdev)
+    {
+        if (src1.device == IM_DD_CPU && src2.device == IM_DD_CPU)
+            CPU::AlphaBlend(src1, src2, dst, alpha, x, y);
+        return;
+    }
+    if (!pipe_alpha || !cmd)
+    {
+        return;
+    }
+
     VkMat dst_gpu;
     dst_gpu.create_type(src2.w, src2.h, 4, dst.type, opt.blob_vkallocator);
 
@@ -221,4 +245,136 @@ void AlphaBlending_vulkan::blend(const ImMat& src1, const ImMat& src2, ImMat& ds
     cmd->reset();
 }
 
+enum CompositePass
+{
+    PASS_OVER = 0,
+    PASS_FIRST,
+    PASS_RESOLVE,
+};
+
+void AlphaBlending_vulkan::upload_param(const VkMat& src, VkMat& dst, const ImBlendLayer& layer, int pass, int rect_x, int rect_y, int rect_w, int rect_h) const
+{
+    std::vector<VkMat> bindings(8);
+    if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
+    else if (dst.type == IM_DT_INT16)    bindings[1] = dst;
+    else if (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
+    else if (dst.type == IM_DT_FLOAT32)  bindings[3] = dst;
+
+    if      (src.type == IM_DT_INT8)     bindings[4] = src;
+    else if (src.type == IM_DT_INT16)    bindings[5] = src;
+    else if (src.type == IM_DT_FLOAT16)  bindings[6] = src;
+    else if (src.type == IM_DT_FLOAT32)  bindings[7] = src;
+
+    std::vector<vk_constant_type> constants(19);
+    constants[0].i = src.w;
+    constants[1].i = src.h;
+    constants[2].i = src.c;
+    constants[3].i = src.color_format;
+    constants[4].i = src.type;
+    constants[5].i = dst.w;
+    constants[6].i = dst.h;
+    constants[7].i = dst.c;
+    constants[8].i = dst.color_format;
+    constants[9].i = dst.type;
+    constants[10].i = layer.x;
+    constants[11].i = layer.y;
+    constants[12].i = rect_x;
+    constants[13].i = rect_y;
+    constants[14].f = layer.scale_x;
+    constants[15].f = layer.scale_y;
+    constants[16].f = layer.opacity;
+    constants[17].i = layer.mode;
+    constants[18].i = pass;
+    // only the layer rect is dispatched
+    ImMat dispatcher(rect_w, rect_h, 1, (void*)0);
+    cmd->record_pipeline(pipe_composite, bindings, std::vector<VkImageMat>(), constants, dispatcher);
+}
+
+void AlphaBlending_vulkan::composite(const std::vector<ImBlendLayer>& layers, ImMat& dst) const
+{
+    if (layers.empty() || layers[0].mat.empty())
+        return;
+
+    int width = dst.w, height = dst.h;
+    if (width <= 0 || height <= 0)
+    {
+        width = (int)(layers[0].mat.w * layers[0].scale_x + 0.5f);
+        height = (int)(layers[0].mat.h * layers[0].scale_y + 0.5f);
+    }
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (!vkdev)
+    {
+        bool on_cpu = true;
+        for (auto& layer : layers)
+            on_cpu = on_cpu && layer.mat.device == IM_DD_CPU;
+        if (on_cpu)
+            CPU::Composite(layers, dst, width, height);
+        return;
+    }
+    if (!pipe_composite || !cmd)
+    {
+        return;
+    }
+
+    // canvas stays on gpu in fp16 so stacked layers do not round to the output depth
+    VkMat canvas;
+    canvas.create_type(width, height, 4, intermediate_type(), opt.blob_vkallocator);
+
+    std::vector<VkMat> layers_gpu(layers.size());
+    bool first = true;
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const ImBlendLayer& layer = layers[i];
+        if (layer.mat.empty() || layer.scale_x <= 0.f || layer.scale_y <= 0.f)
+            continue;
+        if (layer.mat.device == IM_DD_VULKAN)
+            layers_gpu[i] = layer.mat;
+        else if (layer.mat.device == IM_DD_CPU)
+            cmd->record_clone(layer.mat, layers_gpu[i], opt);
+        else
+            continue;
+
+        if (first)
+        {
+            // first layer also clears the canvas
+            upload_param(layers_gpu[i], canvas, layer, PASS_FIRST, 0, 0, width, height);
+            first = false;
+            continue;
+        }
+        // clip the scaled layer to the canvas, layers fully outside record nothing
+        int x0 = std::max(layer.x, 0);
+        int y0 = std::max(layer.y, 0);
+        int x1 = std::min(layer.x + (int)ceilf(layer.mat.w * layer.scale_x), width);
+        int y1 = std::min(layer.y + (int)ceilf(layer.mat.h * layer.scale_y), height);
+        if (x1 <= x0 || y1 <= y0)
+            continue;
+        upload_param(layers_gpu[i], canvas, layer, PASS_OVER, x0, y0, x1 - x0, y1 - y0);
+    }
+
+    VkMat dst_gpu;
+    if (first)
+    {
+        cmd->reset();
+        return;
+    }
+    if (dst.type == IM_DT_FLOAT16)
+    {
+        dst_gpu = canvas;
+    }
+    else
+    {
+        dst_gpu.create_type(width, height, 4, dst.type, opt.blob_vkallocator);
+        upload_param(canvas, dst_gpu, ImBlendLayer(), PASS_RESOLVE, 0, 0, width, height);
+    }
+
+    // download
+    if (dst.device == IM_DD_CPU)
+        cmd->record_clone(dst_gpu, dst, opt);
+    else if (dst.device == IM_DD_VULKAN)
+        dst = dst_gpu;
+    cmd->submit_and_wait();
+    cmd->reset();
+}
 } //namespace ImGui 
@@ -5,6 +5,30 @@
 
 namespace ImGui 
 {
+enum ImBlendMode
+{
+    IM_BLEND_NORMAL = 0,
+    IM_BLEND_ADD,
+    IM_BLEND_MULTIPLY,
+    IM_BLEND_SCREEN,
+    IM_BLEND_OVERLAY,
+    IM_BLEND_DARKEN,
+    IM_BLEND_LIGHTEN,
+    IM_BLEND_DIFFERENCE,
+};
+
+// one layer of composite, mat is scaled by scale_x/scale_y then placed with its top left at (x, y)
+struct ImBlendLayer
+{
+    ImMat mat;
+    int x           {0};
+    int y           {0};
+    float scale_x   {1.f};
+    float scale_y   {1.f};
+    float opacity   {1.f};
+    int mode        {IM_BLEND_NORMAL};
+};
+
 class VKSHADER_API AlphaBlending_vulkan
 {
 public:
@@ -20,15 +44,22 @@ public:
     // src2.rgb * (1 - alpha) + src1.rgb * src1.a * aplha, dst alpha is src2.a
     virtual void blend(const ImMat& src1, const ImMat& src2, ImMat& dst, float alpha, int x = 0, int y = 0) const;
 
+    // composite layers bottom to top over a transparent canvas of dst.w x dst.h, or of the first layer
+    // scaled size when dst has no size, each layer rgb = mix(canvas.rgb, mode(canvas.rgb, layer.rgb), layer.a * opacity).
+    // All layers are recorded into one submit with the canvas kept on gpu in fp16.
+    virtual void composite(const std::vector<ImBlendLayer>& layers, ImMat& dst) const;
+
 public:
     const VulkanDevice* vkdev {nullptr};
     Pipeline * pipe           {nullptr};
     Pipeline * pipe_alpha     {nullptr};
+    Pipeline * pipe_composite {nullptr};
     VkCompute * cmd           {nullptr};
     Option opt;
 
 private:
     void upload_param(const VkMat& src1, const VkMat& src2, VkMat& dst, int x, int y) const;
     void upload_param(const VkMat& src1, const VkMat& src2, VkMat& dst, float alpha, int x, int y) const;
+    void upload_param(const VkMat& src, VkMat& dst, const ImBlendLayer& layer, int pass, int rect_x, int rect_y, int rect_w, int rect_h) const;
 };
 } // namespace ImGui 
\ No newline at end of file
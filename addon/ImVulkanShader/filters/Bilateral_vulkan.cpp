@@ -10,8 +10,7 @@ Bilateral_vulkan::Bilateral_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
 
     std::vector<vk_specialization_type> specializations(0);
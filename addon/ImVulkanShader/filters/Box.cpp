@@ -33,9 +33,12 @@ void BoxBlur_vulkan::prepare_kernel()
         }
 
     }
-    VkTransfer tran(vkdev);
-    tran.record_upload(kernel, vk_kernel, opt, false);
-    tran.submit_and_wait();
+    if (vkdev)
+    {
+        VkTransfer tran(vkdev);
+        tran.record_upload(kernel, vk_kernel, opt, false);
+        tran.submit_and_wait();
+    }
 }
 
 void BoxBlur_vulkan::SetParam(int _xSize, int _ySize)
@@ -16,6 +16,7 @@ layout (push_constant) uniform parameter \n\
     int outcstep; \n\
 \n\
     int cie; \n\
+    int stride; \n\
 \n\
 } p; \
 "
@@ -79,7 +80,7 @@ void cie(int x, int y) \n\
     { \n\
         memoryBarrierBuffer(); \n\
         int offset = ixy.y * p.outw + ixy.x; \n\
-        atomicAdd(alpha_blob_data[offset], 1); \n\
+        atomicAdd(alpha_blob_data[offset], p.stride * p.stride); \n\
         memoryBarrierBuffer(); \n\
     } \n\
 } \
@@ -89,8 +90,8 @@ void cie(int x, int y) \n\
 " \n\
 void main() \n\
 { \n\
-    int gx = int(gl_GlobalInvocationID.x); \n\
-    int gy = int(gl_GlobalInvocationID.y); \n\
+    int gx = int(gl_GlobalInvocationID.x) * p.stride; \n\
+    int gy = int(gl_GlobalInvocationID.y) * p.stride; \n\
     if (gx >= p.w || gy >= p.h) \n\
         return; \n\
 \n\
@@ -1046,7 +1046,7 @@ CIE_vulkan::CIE_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = false;
+    apply_precision(opt, IM_PRECISION_FP32);
     cmd = new ImGui::VkCompute(vkdev);
 
     std::vector<ImGui::vk_specialization_type> specializations(0);
@@ -1181,7 +1181,7 @@ void CIE_vulkan::draw_backbroud()
     }
 }
 
-void CIE_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, bool show_color)
+void CIE_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, bool show_color, int stride)
 {
     std::vector<ImGui::VkMat> bindings_set(1);
     bindings_set[0] = buffer;
@@ -1197,7 +1197,7 @@ void CIE_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float
     else if (src.type == IM_DT_FLOAT32)  bindings[3] = src;
     bindings[4] = buffer;
     bindings[5] = xyz_matrix_gpu;
-    std::vector<ImGui::vk_constant_type> constants(9);
+    std::vector<ImGui::vk_constant_type> constants(10);
     constants[0].i = src.w;
     constants[1].i = src.h;
     constants[2].i = src.c;
@@ -1207,7 +1207,9 @@ void CIE_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float
     constants[6].i = buffer.h;
     constants[7].i = 1;
     constants[8].i = cie;
-    cmd->record_pipeline(pipe, bindings, constants, buffer);
+    constants[9].i = stride;
+    ImGui::ImMat dispatcher((src.w + stride - 1) / stride, (src.h + stride - 1) / stride, 1, (void*)0);
+    cmd->record_pipeline(pipe, bindings, std::vector<ImGui::VkImageMat>(), constants, dispatcher);
 
     std::vector<ImGui::VkMat> bindings_merge(9);
     if      (dst.type == IM_DT_INT8)     bindings_merge[0] = dst;
@@ -1237,7 +1239,7 @@ void CIE_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float
     cmd->record_pipeline(pipe_merge, bindings_merge, constants_merge, dst);
 }
 
-void CIE_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity, bool show_color)
+void CIE_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity, bool show_color, int stride)
 {
     if (!vkdev || !pipe_set || !pipe || !pipe_merge || !cmd)
     {
@@ -1257,7 +1259,7 @@ void CIE_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensi
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, intensity, show_color);
+    upload_param(src_gpu, dst_gpu, intensity, show_color, std::max(stride, 1));
 
     // download
     if (dst.device == IM_DD_CPU)
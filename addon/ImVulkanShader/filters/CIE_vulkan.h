@@ -36,7 +36,8 @@ public:
 
     void SetParam(int _color_system, int _cie, int _size, int _gamuts, float _contrast, bool _correct_gamma);
 
-    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity = 0.01, bool show_color = true);
+    // stride > 1 reads one pixel of every stride x stride block, see Waveform_vulkan.h for the error bound
+    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity = 0.01, bool show_color = true, int stride = 1);
 
 public:
     void GetWhitePoint(ColorsSystems cs, float w, float h, float* x, float* y);
@@ -70,6 +71,6 @@ private:
 
 private:
     void draw_backbroud();
-    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, bool show_color);
+    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, bool show_color, int stride);
 };
 } // namespace ImGui
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 #include <imvk_mat_shader.h>
 
-#define DSOBEL_PARAM \
+#define SOBEL_NMS_PARAM \
 " \n\
 layout (push_constant) uniform parameter \n\
 { \n\
@@ -18,117 +18,78 @@ layout (push_constant) uniform parameter \n\
     int out_type; \n\
     \n\
     float edgeStrength; \n\
-} p; \
-"
-
-#define SHADER_DSOBEL_MAIN \
-" \n\
-const sfp horizontKernel[9] = { sfp(-1.0f), sfp(-2.0f), sfp(-1.0f), \n\
-                                sfp( 0.0f), sfp( 0.0f), sfp( 0.0f), \n\
-                                sfp( 1.0f), sfp( 2.0f), sfp( 1.0f)}; \n\
-const sfp verticalKernel[9] = { sfp(-1.0f), sfp( 0.0f), sfp( 1.0f), \n\
-                                sfp(-2.0f), sfp( 0.0f), sfp( 2.0f), \n\
-                                sfp(-1.0f), sfp( 0.0f), sfp( 1.0f)}; \n\
-void main() \n\
-{ \n\
-    int gx = int(gl_GlobalInvocationID.x); \n\
-    int gy = int(gl_GlobalInvocationID.y); \n\
-    if (gx >= p.out_w || gy >= p.out_h) \n\
-        return; \n\
-    sfp vertical = sfp(0.0f); \n\
-    sfp horizont = sfp(0.0f); \n\
-    for (int i = 0; i < 3; ++i) \n\
-    { \n\
-        for (int j = 0; j < 3; ++j) \n\
-        { \n\
-            int x = gx - 1 + j; \n\
-            int y = gy - 1 + i; \n\
-            // REPLICATE border \n\
-            x = max(0, min(x, p.out_w - 1)); \n\
-            y = max(0, min(y, p.out_h - 1)); \n\
-            int index = j + i * 3; \n\
-            sfp value = load_rgba(x, y, p.w, p.cstep, p.in_format, p.in_type).r; \n\
-            vertical += value * verticalKernel[index]; \n\
-            horizont += value * horizontKernel[index]; \n\
-        } \n\
-    } \n\
-    sfpvec3 sum = sfpvec3(0.0f); \n\
-    sum.x = length(sfpvec2(horizont, vertical)) * sfp(p.edgeStrength); \n\
-    // dx 奇怪了?y/z是否反了,但是GPUImage逻辑确实是这样 \n\
-    sum.y = vertical; \n\
-    // dy \n\
-    sum.z = horizont; \n\
-    store_rgb_float_no_clamp(sum, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
-} \
-"
-
-static const char DSobelFilter_data[] = 
-SHADER_HEADER
-DSOBEL_PARAM
-SHADER_INPUT_OUTPUT_DATA
-SHADER_LOAD_RGBA
-SHADER_STORE_RGB_FLOAT_NO_CLAMP // 保存的数值包括矢量, 不可做clamp
-SHADER_DSOBEL_MAIN
-;
-
-#define NMS_SHADER_PARAM \
-" \n\
-layout (push_constant) uniform parameter \n\
-{ \n\
-    int w; \n\
-    int h; \n\
-    int cstep; \n\
-    int in_format; \n\
-    int in_type; \n\
-    \n\
-    int out_w; \n\
-    int out_h; \n\
-    int out_cstep; \n\
-    int out_format; \n\
-    int out_type; \n\
-    \n\
     float minThreshold; \n\
     float maxThreshold; \n\
 } p; \
 "
 
-#define SHADER_NMS_MAIN \
+// sobel gradient and non-maximum suppression in one pass, a 16x16 tile keeps
+// the blurred luminance with 2 pixels halo and the gradient with 1 pixel halo
+// in shared memory, so the gradient never goes through global memory
+#define SHADER_SOBEL_NMS_MAIN \
 " \n\
-sfpvec2 normDirection(sfpvec2 dxy) \n\
-{ \n\
-    sfpvec2 normalizedDirection = normalize(dxy); \n\
-    // Offset by 1-sin(pi/8) to set to 0 if near axis, 1 if away \n\
-    normalizedDirection = sign(normalizedDirection) * floor(abs(normalizedDirection) + sfp(0.617316f)); \n\
-    // Place -1.0 - 1.0 within 0 - 1.0 \n\
-    //normalizedDirection = (normalizedDirection + 1.0) * 0.5; \n\
-    return normalizedDirection; \n\
-} \n\
+#define TILE_SIZE 16 \n\
+#define LUM_SIZE (TILE_SIZE + 4) \n\
+#define GRAD_SIZE (TILE_SIZE + 2) \n\
+shared float lum_shared[LUM_SIZE][LUM_SIZE]; \n\
+shared vec3 grad_shared[GRAD_SIZE][GRAD_SIZE]; \n\
 void main() \n\
 { \n\
     int gx = int(gl_GlobalInvocationID.x); \n\
     int gy = int(gl_GlobalInvocationID.y); \n\
+    int lx = int(gl_LocalInvocationID.x); \n\
+    int ly = int(gl_LocalInvocationID.y); \n\
+    int lid = ly * TILE_SIZE + lx; \n\
+    ivec2 base = ivec2(gl_WorkGroupID.xy) * TILE_SIZE - 2; \n\
+    for (int i = lid; i < LUM_SIZE * LUM_SIZE; i += TILE_SIZE * TILE_SIZE) \n\
+    { \n\
+        // REPLICATE border \n\
+        int x = clamp(base.x + i % LUM_SIZE, 0, p.w - 1); \n\
+        int y = clamp(base.y + i / LUM_SIZE, 0, p.h - 1); \n\
+        lum_shared[i / LUM_SIZE][i % LUM_SIZE] = float(load_rgba(x, y, p.w, p.cstep, p.in_format, p.in_type).r); \n\
+    } \n\
+    memoryBarrierShared(); \n\
+    barrier(); \n\
+    for (int i = lid; i < GRAD_SIZE * GRAD_SIZE; i += TILE_SIZE * TILE_SIZE) \n\
+    { \n\
+        int tx = i % GRAD_SIZE + 1; \n\
+        int ty = i / GRAD_SIZE + 1; \n\
+        float tl = lum_shared[ty - 1][tx - 1], t = lum_shared[ty - 1][tx], tr = lum_shared[ty - 1][tx + 1]; \n\
+        float l  = lum_shared[ty    ][tx - 1],                             r  = lum_shared[ty    ][tx + 1]; \n\
+        float bl = lum_shared[ty + 1][tx - 1], b = lum_shared[ty + 1][tx], br = lum_shared[ty + 1][tx + 1]; \n\
+        float horizont = (bl + 2.f * b + br) - (tl + 2.f * t + tr); \n\
+        float vertical = (tr + 2.f * r + br) - (tl + 2.f * l + bl); \n\
+        // magnitude, dx, dy in the same order as GPUImage \n\
+        grad_shared[ty - 1][tx - 1] = vec3(length(vec2(horizont, vertical)) * p.edgeStrength, vertical, horizont); \n\
+    } \n\
+    memoryBarrierShared(); \n\
+    barrier(); \n\
     if (gx >= p.out_w || gy >= p.out_h) \n\
         return; \n\
-    //sfpvec2 suv = sfpvec2(gx, gy) + sfpvec2(0.5f); \n\
-    sfpvec3 gradinetAndDirection = load_rgb(gx, gy, p.w, p.cstep, p.in_format, p.in_type); \n\
-    sfpvec2 direction = normDirection(gradinetAndDirection.yz); \n\
-    sfp firstGradientMagnitude = load_rgb(gx + int(direction.x), gy + int(direction.y), p.w, p.cstep, p.in_format, p.in_type).x; \n\
-    sfp secondGradientMagnitude = load_rgb(gx - int(direction.x), gy - int(direction.y), p.w, p.cstep, p.in_format, p.in_type).x; \n\
-    sfp multiplier = step(firstGradientMagnitude, gradinetAndDirection.x); \n\
+    vec3 gradinetAndDirection = grad_shared[ly + 1][lx + 1]; \n\
+    vec2 direction = length(gradinetAndDirection.yz) > 0.f ? normalize(gradinetAndDirection.yz) : vec2(0.f); \n\
+    // Offset by 1-sin(pi/8) to set to 0 if near axis, 1 if away \n\
+    ivec2 offset = ivec2(sign(direction) * floor(abs(direction) + 0.617316f)); \n\
+    float firstGradientMagnitude = grad_shared[ly + 1 + offset.y][lx + 1 + offset.x].x; \n\
+    float secondGradientMagnitude = grad_shared[ly + 1 - offset.y][lx + 1 - offset.x].x; \n\
+    float multiplier = step(firstGradientMagnitude, gradinetAndDirection.x); \n\
     multiplier = multiplier * step(secondGradientMagnitude, gradinetAndDirection.x); \n\
-    sfp thresholdCompliance = smoothstep(sfp(p.minThreshold), sfp(p.maxThreshold), gradinetAndDirection.x); \n\
+    float thresholdCompliance = smoothstep(p.minThreshold, p.maxThreshold, gradinetAndDirection.x); \n\
     multiplier = multiplier * thresholdCompliance; \n\
-    store_gray(multiplier, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+    store_gray(sfp(multiplier), gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
 } \
 "
 
-static const char NMSFilter_data[] = 
+static const char SobelNMSFilter_data[] = 
 SHADER_HEADER
-NMS_SHADER_PARAM
+R"(
+layout (local_size_x = 16, local_size_y = 16) in;
+)"
+SOBEL_NMS_PARAM
 SHADER_INPUT_OUTPUT_DATA
-SHADER_LOAD_RGB
+SHADER_LOAD_RGBA
 SHADER_STORE_GRAY
-SHADER_NMS_MAIN
+SHADER_SOBEL_NMS_MAIN
 ;
 
 #define CANNY_SHADER_PARAM \
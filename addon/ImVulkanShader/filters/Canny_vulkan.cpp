@@ -11,25 +11,17 @@ Canny_vulkan::Canny_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
 
-    if (compile_spirv_module(DSobelFilter_data, opt, spirv_data) == 0)
+    if (compile_spirv_module(SobelNMSFilter_data, opt, spirv_data) == 0)
     {
-        pipe_dsobel = new Pipeline(vkdev);
-        pipe_dsobel->set_optimal_local_size_xyz(16, 16, 1);
-        pipe_dsobel->create(spirv_data.data(), spirv_data.size() * 4, specializations);
-        spirv_data.clear();
-    }
-
-    if (compile_spirv_module(NMSFilter_data, opt, spirv_data) == 0)
-    {
-        pipe_nms = new Pipeline(vkdev);
-        pipe_nms->set_optimal_local_size_xyz(16, 16, 1);
-        pipe_nms->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        // shared memory tile is sized for exactly 16x16
+        pipe_sobel_nms = new Pipeline(vkdev);
+        pipe_sobel_nms->set_local_size_xyz(16, 16, 1);
+        pipe_sobel_nms->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
 
@@ -43,16 +35,18 @@ Canny_vulkan::Canny_vulkan(int gpu)
 
     if (compile_spirv_module(FilterColumn_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_column = new Pipeline(vkdev);
-        pipe_column->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_column->set_local_size_xyz(16, 16, 1);
         pipe_column->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
 
     if (compile_spirv_module(FilterRow_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_row = new Pipeline(vkdev);
-        pipe_row->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_row->set_local_size_xyz(16, 16, 1);
         pipe_row->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
@@ -67,8 +61,7 @@ Canny_vulkan::~Canny_vulkan()
     if (vkdev)
     {
         if (pipe) { delete pipe; pipe = nullptr; }
-        if (pipe_dsobel) { delete pipe_dsobel; pipe_dsobel = nullptr; }
-        if (pipe_nms) { delete pipe_nms; pipe_nms = nullptr; }
+        if (pipe_sobel_nms) { delete pipe_sobel_nms; pipe_sobel_nms = nullptr; }
         if (pipe_column) { delete pipe_column; pipe_column = nullptr; }
         if (pipe_row) { delete pipe_row; pipe_row = nullptr; }
         if (cmd) { delete cmd; cmd = nullptr; }
@@ -97,31 +90,36 @@ void Canny_vulkan::prepare_kernel()
 
     sum = 1.0 / sum;
     kernel *= (float)(sum);
-    VkTransfer tran(vkdev);
-    tran.record_upload(kernel, vk_kernel, opt, false);
-    tran.submit_and_wait();
+    // recorded into the compute command, no extra submit
+    cmd->record_clone(kernel, vk_kernel, opt);
 
     xksize = yksize = ksize;
     xanchor = yanchor = blurRadius;
 }
 
-void Canny_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius, float minThreshold, float maxThreshold)
+void Canny_vulkan::SetParam(int _blurRadius, float _minThreshold, float _maxThreshold)
 {
     if (blurRadius != _blurRadius)
     {
         blurRadius = _blurRadius;
         prepare_kernel();
     }
+    minThreshold = _minThreshold;
+    maxThreshold = _maxThreshold;
+}
 
+void Canny_vulkan::upload_param(const VkMat& src, VkMat& dst, std::vector<VkMat>& intermediates)
+{
     // need float16/float32 as middle buffer only
-    VkMat vk_bobel;
-    vk_bobel.create_type(dst.w, dst.h, 3, IM_DT_FLOAT16, opt.blob_vkallocator);
     VkMat vk_nms;
-    vk_nms.create_type(dst.w, dst.h, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_nms.create_type(dst.w, dst.h, intermediate_type(), opt.blob_vkallocator);
     VkMat vk_column;
-    vk_column.create_type(dst.w, dst.h, dst.c, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_column.create_type(dst.w, dst.h, dst.c, intermediate_type(), opt.blob_vkallocator);
     VkMat vk_blur;
-    vk_blur.create_type(dst.w, dst.h, dst.c, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_blur.create_type(dst.w, dst.h, dst.c, intermediate_type(), opt.blob_vkallocator);
+    intermediates.push_back(vk_nms);
+    intermediates.push_back(vk_column);
+    intermediates.push_back(vk_blur);
 
     std::vector<vk_constant_type> column_constants(14);
     column_constants[0].i = src.w;
@@ -181,55 +179,32 @@ void Canny_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius, f
     row_bindings[8] = vk_kernel;
     cmd->record_pipeline(pipe_row, row_bindings, row_constants, vk_blur);
 
-    std::vector<VkMat> sobel_bindings(8);
-    if      (vk_bobel.type == IM_DT_INT8)     sobel_bindings[0] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_INT16)    sobel_bindings[1] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_FLOAT16)  sobel_bindings[2] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_FLOAT32)  sobel_bindings[3] = vk_bobel;
-
-    if      (vk_blur.type == IM_DT_INT8)     sobel_bindings[4] = vk_blur;
-    else if (vk_blur.type == IM_DT_INT16)    sobel_bindings[5] = vk_blur;
-    else if (vk_blur.type == IM_DT_FLOAT16)  sobel_bindings[6] = vk_blur;
-    else if (vk_blur.type == IM_DT_FLOAT32)  sobel_bindings[7] = vk_blur;
-
-    std::vector<vk_constant_type> sobel_constants(11);
-    sobel_constants[0].i = vk_blur.w;
-    sobel_constants[1].i = vk_blur.h;
-    sobel_constants[2].i = vk_blur.c;
-    sobel_constants[3].i = vk_blur.color_format;
-    sobel_constants[4].i = vk_blur.type;
-    sobel_constants[5].i = vk_bobel.w;
-    sobel_constants[6].i = vk_bobel.h;
-    sobel_constants[7].i = vk_bobel.c;
-    sobel_constants[8].i = vk_bobel.color_format;
-    sobel_constants[9].i = vk_bobel.type;
-    sobel_constants[10].f = 1.f;
-    cmd->record_pipeline(pipe_dsobel, sobel_bindings, sobel_constants, vk_bobel);
-
-    std::vector<VkMat> nms_bindings(8);
-    if      (vk_nms.type == IM_DT_INT8)     nms_bindings[0] = vk_nms;
-    else if (vk_nms.type == IM_DT_INT16)    nms_bindings[1] = vk_nms;
-    else if (vk_nms.type == IM_DT_FLOAT16)  nms_bindings[2] = vk_nms;
-    else if (vk_nms.type == IM_DT_FLOAT32)  nms_bindings[3] = vk_nms;
-
-    if      (vk_bobel.type == IM_DT_INT8)     nms_bindings[4] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_INT16)    nms_bindings[5] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_FLOAT16)  nms_bindings[6] = vk_bobel;
-    else if (vk_bobel.type == IM_DT_FLOAT32)  nms_bindings[7] = vk_bobel;
-    std::vector<vk_constant_type> nms_constants(12);
-    nms_constants[0].i = vk_bobel.w;
-    nms_constants[1].i = vk_bobel.h;
-    nms_constants[2].i = vk_bobel.c;
-    nms_constants[3].i = vk_bobel.color_format;
-    nms_constants[4].i = vk_bobel.type;
-    nms_constants[5].i = vk_nms.w;
-    nms_constants[6].i = vk_nms.h;
-    nms_constants[7].i = vk_nms.c;
-    nms_constants[8].i = vk_nms.color_format;
-    nms_constants[9].i = vk_nms.type;
-    nms_constants[10].f = minThreshold;
-    nms_constants[11].f = maxThreshold;
-    cmd->record_pipeline(pipe_nms, nms_bindings, nms_constants, vk_nms);
+    std::vector<VkMat> sobel_nms_bindings(8);
+    if      (vk_nms.type == IM_DT_INT8)     sobel_nms_bindings[0] = vk_nms;
+    else if (vk_nms.type == IM_DT_INT16)    sobel_nms_bindings[1] = vk_nms;
+    else if (vk_nms.type == IM_DT_FLOAT16)  sobel_nms_bindings[2] = vk_nms;
+    else if (vk_nms.type == IM_DT_FLOAT32)  sobel_nms_bindings[3] = vk_nms;
+
+    if      (vk_blur.type == IM_DT_INT8)     sobel_nms_bindings[4] = vk_blur;
+    else if (vk_blur.type == IM_DT_INT16)    sobel_nms_bindings[5] = vk_blur;
+    else if (vk_blur.type == IM_DT_FLOAT16)  sobel_nms_bindings[6] = vk_blur;
+    else if (vk_blur.type == IM_DT_FLOAT32)  sobel_nms_bindings[7] = vk_blur;
+
+    std::vector<vk_constant_type> sobel_nms_constants(13);
+    sobel_nms_constants[0].i = vk_blur.w;
+    sobel_nms_constants[1].i = vk_blur.h;
+    sobel_nms_constants[2].i = vk_blur.c;
+    sobel_nms_constants[3].i = vk_blur.color_format;
+    sobel_nms_constants[4].i = vk_blur.type;
+    sobel_nms_constants[5].i = vk_nms.w;
+    sobel_nms_constants[6].i = vk_nms.h;
+    sobel_nms_constants[7].i = vk_nms.c;
+    sobel_nms_constants[8].i = vk_nms.color_format;
+    sobel_nms_constants[9].i = vk_nms.type;
+    sobel_nms_constants[10].f = 1.f;
+    sobel_nms_constants[11].f = minThreshold;
+    sobel_nms_constants[12].f = maxThreshold;
+    cmd->record_pipeline(pipe_sobel_nms, sobel_nms_bindings, sobel_nms_constants, vk_nms);
 
     std::vector<VkMat> canny_bindings(8);
     if      (dst.type == IM_DT_INT8)     canny_bindings[0] = dst;
@@ -256,13 +231,8 @@ void Canny_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius, f
     cmd->record_pipeline(pipe, canny_bindings, canny_constants, dst);
 }
 
-void Canny_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float minThreshold, float maxThreshold)
+void Canny_vulkan::record_frame(const ImMat& src, ImMat& dst, std::vector<VkMat>& intermediates)
 {
-    if (!vkdev || !pipe || !pipe_dsobel || !pipe_nms || !pipe_column || !pipe_row || !cmd)
-    {
-        return;
-    }
-
     VkMat dst_gpu;
     dst_gpu.create_type(src.w, src.h, 4, dst.type, opt.blob_vkallocator);
 
@@ -276,13 +246,56 @@ void Canny_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float m
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, _blurRadius, minThreshold, maxThreshold);
+    upload_param(src_gpu, dst_gpu, intermediates);
 
     // download
     if (dst.device == IM_DD_CPU)
         cmd->record_clone(dst_gpu, dst, opt);
     else if (dst.device == IM_DD_VULKAN)
         dst = dst_gpu;
+    intermediates.push_back(src_gpu);
+    intermediates.push_back(dst_gpu);
+}
+
+void Canny_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float minThreshold, float maxThreshold)
+{
+    SetParam(_blurRadius, minThreshold, maxThreshold);
+    filter(src, dst);
+}
+
+void Canny_vulkan::filter(const ImMat& src, ImMat& dst)
+{
+    if (!vkdev || !pipe || !pipe_sobel_nms || !pipe_column || !pipe_row || !cmd)
+    {
+        return;
+    }
+
+    std::vector<VkMat> intermediates;
+    record_frame(src, dst, intermediates);
+    cmd->submit_and_wait();
+    cmd->reset();
+}
+
+void Canny_vulkan::filter(const std::vector<ImMat>& src, std::vector<ImMat>& dst)
+{
+    if (!vkdev || !pipe || !pipe_sobel_nms || !pipe_column || !pipe_row || !cmd || src.empty())
+    {
+        return;
+    }
+
+    // new outputs follow the first one
+    ImMat dst_template = dst.empty() ? ImMat() : dst[0];
+    while (dst.size() < src.size())
+    {
+        ImMat mat;
+        mat.type = dst.empty() ? src[dst.size()].type : dst_template.type;
+        mat.device = dst.empty() ? IM_DD_CPU : dst_template.device;
+        dst.push_back(mat);
+    }
+
+    std::vector<VkMat> intermediates;
+    for (size_t i = 0; i < src.size(); i++)
+        record_frame(src[i], dst[i], intermediates);
     cmd->submit_and_wait();
     cmd->reset();
 }
@@ -10,15 +10,19 @@ class VKSHADER_API Canny_vulkan
 public:
     Canny_vulkan(int gpu = 0);
     ~Canny_vulkan();
-    
+
+    // blur kernel is rebuilt only when the radius changes, its upload rides on the next submit
+    void SetParam(int _blurRadius, float _minThreshold, float _maxThreshold);
     void filter(const ImMat& src, ImMat& dst, int _blurRadius, float minThreshold, float maxThreshold);
+    void filter(const ImMat& src, ImMat& dst);
+    // record all frames and submit once
+    void filter(const std::vector<ImMat>& src, std::vector<ImMat>& dst);
 
 private:
     VulkanDevice* vkdev      {nullptr};
     Option opt;
     Pipeline* pipe           {nullptr};
-    Pipeline* pipe_dsobel    {nullptr};
-    Pipeline* pipe_nms       {nullptr};
+    Pipeline* pipe_sobel_nms {nullptr};
     Pipeline * pipe_column   {nullptr};
     Pipeline * pipe_row      {nullptr};
     VkCompute * cmd          {nullptr};
@@ -27,6 +31,8 @@ private:
     ImMat kernel;
     VkMat vk_kernel;
     int blurRadius  {3};
+    float minThreshold {0.1};
+    float maxThreshold {0.45};
     int xksize;
     int yksize;
     int xanchor;
@@ -34,8 +40,8 @@ private:
     float sigma     {0};
 
 private:
-    void upload_param(const VkMat& src, VkMat& dst, int _blurRadius, float minThreshold, float maxThreshold);
+    void upload_param(const VkMat& src, VkMat& dst, std::vector<VkMat>& intermediates);
+    void record_frame(const ImMat& src, ImMat& dst, std::vector<VkMat>& intermediates);
     void prepare_kernel();
 };
 } // namespace ImGui
-
@@ -11,8 +11,7 @@ ChromaKey_vulkan::ChromaKey_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
 
     std::vector<vk_specialization_type> specializations(0);
@@ -135,7 +134,7 @@ void ChromaKey_vulkan::upload_param(const VkMat& src, VkMat& dst,
 {
     
     VkMat alpha_mat;
-    alpha_mat.create_type(src.w, src.h, 1, IM_DT_FLOAT16, opt.blob_vkallocator);
+    alpha_mat.create_type(src.w, src.h, 1, intermediate_type(), opt.blob_vkallocator);
 
     std::vector<VkMat> bindings(5);
     if      (src.type == IM_DT_INT8)     bindings[0] = src;
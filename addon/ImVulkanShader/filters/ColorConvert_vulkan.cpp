@@ -1,6 +1,7 @@
 #include <sstream>
 #include "ColorConvert_vulkan.h"
 #include "ColorConvert_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 
 namespace ImGui 
@@ -9,11 +10,11 @@ extern const ImMat * color_table[2][2][4];
 ColorConvert_vulkan::ColorConvert_vulkan(int gpu)
 {
     vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = false;   // fp16 has accuracy issue for int16 convert
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);   // fp16 has accuracy issue for int16 convert
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -102,6 +103,22 @@ bool ColorConvert_vulkan::ConvertColorFormat(const ImMat& srcMat, ImMat& dstMat,
         dstMat.color_range = IM_CR_FULL_RANGE;
     }
 
+    if (!vkdev)
+    {
+        if (srcMat.device != IM_DD_CPU)
+        {
+            mErrMsg = "No vulkan device, 'srcMat' must be on cpu!";
+            return false;
+        }
+        ImMat tmp;
+        tmp.create_type(dstMat.w > 0 ? dstMat.w : srcMat.w, dstMat.h > 0 ? dstMat.h : srcMat.h, GetChannelCountByColorFormat(dstMat.color_format), dstMat.type);
+        tmp.color_format = dstMat.color_format;
+        tmp.color_range = dstMat.color_range;
+        tmp.color_space = srcMat.color_space;
+        dstMat = tmp;
+        return ConvertCPU(srcMat, dstMat, type);
+    }
+
     // prepare source vulkan mat
     VkMat srcVkMat;
     if (srcMat.device == IM_DD_VULKAN)
@@ -149,6 +166,40 @@ bool ColorConvert_vulkan::ConvertColorFormat(const ImMat& srcMat, ImMat& dstMat,
     return true;
 }
 
+bool ColorConvert_vulkan::ConvertCPU(const ImMat& src, ImMat& dst, ImInterpolateMode type)
+{
+    int srcClrCatg = GetColorFormatCategory(src.color_format);
+    int dstClrCatg = GetColorFormatCategory(dst.color_format);
+    if (srcClrCatg == 0 && dstClrCatg == 1)
+    {
+        int bitDepth = src.depth != 0 ? src.depth : src.type == IM_DT_INT8 ? 8 : src.type == IM_DT_INT16 ? 16 : 8;
+        CPU::GRAY2RGBA(src, dst, (float)((1 << bitDepth) - 1));
+    }
+    else if (srcClrCatg == 2 && dstClrCatg == 1)
+    {
+        int bitDepth = src.depth != 0 ? src.depth : src.type == IM_DT_INT8 ? 8 : src.type == IM_DT_INT16 ? 16 : 8;
+        CPU::YUV2RGBA(src, dst, src.color_format, src.color_space, src.color_range, (float)((1 << bitDepth) - 1), type);
+    }
+    else if (srcClrCatg == 1 && dstClrCatg == 2)
+    {
+        int bitDepth = dst.depth != 0 ? dst.depth : dst.type == IM_DT_INT8 ? 8 : dst.type == IM_DT_INT16 ? 16 : 8;
+        CPU::RGBA2YUV(src, dst, (float)((1 << bitDepth) - 1));
+    }
+    else if (srcClrCatg >= 0 && srcClrCatg == dstClrCatg)
+    {
+        CPU::Conv(src, dst);
+    }
+    else
+    {
+        std::ostringstream oss;
+        oss << "Unsupported color format conversion! 'src.color_format' is " << src.color_format
+            << ", 'dst.color_format' is " << dst.color_format << ".";
+        mErrMsg = oss.str();
+        return false;
+    }
+    return true;
+}
+
 bool ColorConvert_vulkan::UploadParam(const VkMat& src, VkMat& dst, ImInterpolateMode type)
 {
     int srcClrCatg = GetColorFormatCategory(src.color_format);
@@ -342,7 +393,16 @@ void ColorConvert_vulkan::upload_param(const VkMat& Im_YUV, VkMat& dst, ImColorF
 
 void ColorConvert_vulkan::YUV2RGBA(const ImMat& im_YUV, ImMat & im_RGB, ImColorFormat color_format, ImColorSpace color_space, ImColorRange color_range, int video_depth, int video_shift) const
 {
-    if (!vkdev || !pipeline_yuv_rgb || !cmd)
+    if (!vkdev)
+    {
+        if (im_YUV.device == IM_DD_CPU)
+        {
+            im_RGB.create_type(im_YUV.w, im_YUV.h, 4, im_RGB.type);
+            CPU::YUV2RGBA(im_YUV, im_RGB, color_format, color_space, color_range, (float)((1 << video_shift) - 1), IM_INTERPOLATE_NEAREST);
+        }
+        return;
+    }
+    if (!pipeline_yuv_rgb || !cmd)
     {
         return;
     }
@@ -408,7 +468,19 @@ void ColorConvert_vulkan::upload_param(const VkMat& Im_RGB, VkMat& dst, ImColorF
 
 void ColorConvert_vulkan::RGBA2YUV(const ImMat& im_RGB, ImMat & im_YUV, ImColorFormat color_format, ImColorSpace color_space, ImColorRange color_range, int video_shift) const
 {
-    if (!vkdev || !pipeline_rgb_yuv || !cmd)
+    if (!vkdev)
+    {
+        if (im_RGB.device == IM_DD_CPU)
+        {
+            im_YUV.create_type(im_RGB.w, im_RGB.h, 4, im_YUV.type);
+            im_YUV.color_format = color_format;
+            im_YUV.color_space = color_space;
+            im_YUV.color_range = color_range;
+            CPU::RGBA2YUV(im_RGB, im_YUV, (float)((1 << video_shift) - 1));
+        }
+        return;
+    }
+    if (!pipeline_rgb_yuv || !cmd)
     {
         return;
     }
@@ -467,7 +539,16 @@ void ColorConvert_vulkan::upload_param(const VkMat& Im, VkMat& dst, ImColorSpace
 
 void ColorConvert_vulkan::GRAY2RGBA(const ImMat& im, ImMat & im_RGB, ImColorSpace color_space, ImColorRange color_range, int video_depth, int video_shift) const
 {
-    if (!vkdev || !pipeline_gray_rgb || !cmd)
+    if (!vkdev)
+    {
+        if (im.device == IM_DD_CPU)
+        {
+            im_RGB.create_type(im.w, im.h, 4, im_RGB.type);
+            CPU::GRAY2RGBA(im, im_RGB, (float)((1 << video_shift) - 1));
+        }
+        return;
+    }
+    if (!pipeline_gray_rgb || !cmd)
     {
         return;
     }
@@ -525,7 +606,16 @@ void ColorConvert_vulkan::upload_param(const VkMat& Im, VkMat& dst) const
 
 void ColorConvert_vulkan::Conv(const ImMat& im, ImMat & om) const
 {
-    if (!vkdev || !pipeline_conv || !cmd)
+    if (!vkdev)
+    {
+        if (im.device == IM_DD_CPU)
+        {
+            om.create_type(im.w, im.h, 4, om.type);
+            CPU::Conv(im, om);
+        }
+        return;
+    }
+    if (!pipeline_conv || !cmd)
     {
         return;
     }
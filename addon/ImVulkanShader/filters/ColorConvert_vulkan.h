@@ -20,7 +20,7 @@ public:
     virtual void Conv(const ImMat& im, ImMat & om) const;
 
 public:
-    const VulkanDevice* vkdev;
+    const VulkanDevice* vkdev {nullptr};
     Pipeline * pipeline_yuv_rgb = nullptr;
     Pipeline * pipeline_rgb_yuv = nullptr;
     Pipeline * pipeline_gray_rgb = nullptr;
@@ -35,6 +35,7 @@ private:
     void upload_param(const VkMat& Im, VkMat& dst) const;
 
     bool UploadParam(const VkMat& src, VkMat& dst, ImInterpolateMode type);
+    bool ConvertCPU(const ImMat& src, ImMat& dst, ImInterpolateMode type);
 
     std::string mErrMsg;
 };
@@ -0,0 +1,206 @@
+#pragma once
+#include <imvk_mat_shader.h>
+
+#define SHADER_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_format; \n\
+    int in_type; \n\
+    \n\
+    int out_w; \n\
+    int out_h; \n\
+    int out_cstep; \n\
+    int out_format; \n\
+    int out_type; \n\
+    \n\
+    int stages; \n\
+    float exposure; \n\
+    float temperature; \n\
+    \n\
+    float red_shadow; \n\
+    float green_shadows; \n\
+    float blue_shadows; \n\
+    float red_midtones; \n\
+    float green_midtones; \n\
+    float blue_midtones; \n\
+    float red_highlights; \n\
+    float green_highlights; \n\
+    float blue_highlights; \n\
+    int preserve_lightness; \n\
+    \n\
+    float brightness; \n\
+    float contrast; \n\
+    float gamma; \n\
+    float saturation; \n\
+    float vibrance; \n\
+    float hue; \n\
+} p; \
+"
+
+// stage bits, same values as ColorGrade_vulkan
+#define SHADER_STAGES \
+" \n\
+#define STAGE_EXPOSURE      (1 << 0) \n\
+#define STAGE_WHITEBALANCE  (1 << 1) \n\
+#define STAGE_COLORBALANCE  (1 << 2) \n\
+#define STAGE_BRIGHTNESS    (1 << 3) \n\
+#define STAGE_CONTRAST      (1 << 4) \n\
+#define STAGE_GAMMA         (1 << 5) \n\
+#define STAGE_SATURATION    (1 << 6) \n\
+#define STAGE_VIBRANCE      (1 << 7) \n\
+#define STAGE_HUE           (1 << 8) \n\
+"
+
+// stage math is the one of each single adjustment filter
+#define SHADER_WHITEBALANCE \
+" \n\
+const sfpvec3 warmFilter = sfpvec3(sfp(0.93f), sfp(0.54f), sfp(0.0f)); \n\
+const sfpmat3 RGBtoYIQ = sfpmat3(sfp(0.299f), sfp(0.587f), sfp(0.114f), sfp(0.596f), sfp(-0.274f), sfp(-0.322f), sfp(0.212f), sfp(-0.523f), sfp(0.311f)); \n\
+const sfpmat3 YIQtoRGB = sfpmat3(sfp(1.0f), sfp(0.956f), sfp(0.621f), sfp(1.0f), sfp(-0.272f), sfp(-0.647f), sfp(1.0f), sfp(-1.105f), sfp(1.702f)); \n\
+sfpvec3 whitebalance(sfpvec3 color) \n\
+{ \n\
+    sfpvec3 yiq = RGBtoYIQ * color.rgb; \n\
+    yiq.b = clamp(yiq.b, sfp(-0.5226f), sfp(0.5226f)); \n\
+    sfpvec3 rgb = YIQtoRGB * yiq; \n\
+    sfpvec3 processed = sfpvec3((rgb.r < sfp(0.5f) ? (sfp(2.0f) * rgb.r * warmFilter.r) : (sfp(1.0f) - sfp(2.0f) * (sfp(1.0f) - rgb.r) * (sfp(1.0f) - warmFilter.r))), \n\
+                        (rgb.g < sfp(0.5f) ? (sfp(2.0f) * rgb.g * warmFilter.g) : (sfp(1.0f) - sfp(2.0f) * (sfp(1.0f) - rgb.g) * (sfp(1.0f) - warmFilter.g))), \n\
+                        (rgb.b < sfp(0.5f) ? (sfp(2.0f) * rgb.b * warmFilter.b) : (sfp(1.0f) - sfp(2.0f) * (sfp(1.0f) - rgb.b) * (sfp(1.0f) - warmFilter.b)))); \n\
+    return mix(rgb, processed, sfp(p.temperature)); \n\
+} \
+"
+
+#define SHADER_COLORBALANCE \
+" \n\
+sfp hfun(sfp n, sfp h, sfp s, sfp l) \n\
+{ \n\
+    sfp a = s * min(l, sfp(1.f) - l); \n\
+    sfp k = mod(n + h / sfp(30.f), sfp(12.f)); \n\
+    return clamp(l - a * max(min(k - sfp(3.f), min(sfp(9.f) - k, sfp(1.0))), sfp(-1.f)), sfp(0.f), sfp(1.f)); \n\
+} \n\
+\n\
+sfpvec3 preservel(sfpvec3 rgb, sfp l) \n\
+{ \n\
+    sfpvec3 val = sfpvec3(0.f); \n\
+    sfp vmax = max(rgb.r, max(rgb.g, rgb.b)); \n\
+    sfp vmin = min(rgb.r, min(rgb.g, rgb.b)); \n\
+    sfp h, s; \n\
+    l *= sfp(0.5f); \n\
+    if (rgb.r == rgb.g && rgb.g == rgb.b) \n\
+        h = sfp(0.f); \n\
+    else if (vmax == rgb.r) \n\
+        h = sfp(60.f) * (sfp(0.f) + (rgb.g - rgb.b) / (vmax - vmin)); \n\
+    else if (vmax == rgb.g) \n\
+        h = sfp(60.f) * (sfp(2.f) + (rgb.b - rgb.r) / (vmax - vmin)); \n\
+    else if (vmax == rgb.b) \n\
+        h = sfp(60.f) * (sfp(4.f) + (rgb.r - rgb.g) / (vmax - vmin)); \n\
+    else \n\
+        h = sfp(0.f); \n\
+    if (h < sfp(0.f)) \n\
+        h += sfp(360.f); \n\
+    if (vmax == 1.f || vmin == 0.f) \n\
+        s = sfp(0.f); \n\
+    else \n\
+        s = (vmax - vmin) / (sfp(1.f) - (abs(sfp(2.f) * l - sfp(1.f)))); \n\
+    val.r = hfun(sfp(0.f), h, s, l); \n\
+    val.g = hfun(sfp(8.f), h, s, l); \n\
+    val.b = hfun(sfp(4.f), h, s, l); \n\
+    return val; \n\
+} \n\
+\n\
+sfp get_component(sfp v, sfp l, sfp s, sfp m, sfp h) \n\
+{ \n\
+    sfp a = sfp(4.f), b = sfp(0.333f), scale = sfp(0.7f); \n\
+    s *= clamp((b - l) * a + sfp(0.5f), sfp(0.f), sfp(1.f)) * scale; \n\
+    m *= clamp((l - b) * a + sfp(0.5f), sfp(0.f), sfp(1.f)) * clamp((sfp(1.f) - l - b) * a + sfp(0.5f), sfp(0.f), sfp(1.f)) * scale; \n\
+    h *= clamp((l + b - sfp(1.f)) * a + sfp(0.5f), sfp(0.f), sfp(1.f)) * scale; \n\
+    return clamp(v + s + m + h, sfp(0.f), sfp(1.f)); \n\
+} \n\
+\n\
+sfpvec3 balance(sfpvec3 rgb) \n\
+{ \n\
+    sfpvec3 value = sfpvec3(0.f); \n\
+    sfp l = max(rgb.r, max(rgb.g, rgb.b)) + min(rgb.r, min(rgb.g, rgb.b)); \n\
+    value.r = get_component(rgb.r, l, sfp(p.red_shadow),    sfp(p.red_midtones),    sfp(p.red_highlights)); \n\
+    value.g = get_component(rgb.g, l, sfp(p.green_shadows), sfp(p.green_midtones),  sfp(p.green_highlights)); \n\
+    value.b = get_component(rgb.b, l, sfp(p.blue_shadows),  sfp(p.blue_midtones),   sfp(p.blue_highlights)); \n\
+    if (p.preserve_lightness == 1) \n\
+        value = preservel(value, l); \n\
+    return value; \n\
+} \
+"
+
+#define SHADER_HUE \
+" \n\
+const sfpvec3  kRGBToYPrime = sfpvec3(sfp(0.299f), sfp(0.587f), sfp(0.114f)); \n\
+const sfpvec3  kRGBToI      = sfpvec3(sfp(0.595716f), sfp(-0.274453f), sfp(-0.321263f)); \n\
+const sfpvec3  kRGBToQ      = sfpvec3(sfp(0.211456f), sfp(-0.522591f), sfp(0.31135f)); \n\
+const sfpvec3  kYIQToR      = sfpvec3(sfp(1.0f), sfp(0.9563f), sfp(0.6210f)); \n\
+const sfpvec3  kYIQToG      = sfpvec3(sfp(1.0f), sfp(-0.2721f), sfp(-0.6474f)); \n\
+const sfpvec3  kYIQToB      = sfpvec3(sfp(1.0f), sfp(-1.1070f), sfp(1.7046f)); \n\
+sfpvec3 hue(sfpvec3 color) \n\
+{ \n\
+    sfp   YPrime    = dot(color, kRGBToYPrime); \n\
+    sfp   I         = dot(color, kRGBToI); \n\
+    sfp   Q         = dot(color, kRGBToQ); \n\
+    sfp   hue       = atan (Q, I) - sfp(p.hue); \n\
+    sfp   chroma    = sqrt (I * I + Q * Q); \n\
+    sfpvec3    yIQ   = sfpvec3 (YPrime, chroma * cos (hue), chroma * sin (hue)); \n\
+    return sfpvec3(dot(yIQ, kYIQToR), dot(yIQ, kYIQToG), dot(yIQ, kYIQToB)); \n\
+} \
+"
+
+// every enabled stage clamps like the single filter stores, order is
+// exposure, white balance, color balance, brightness, contrast, gamma, saturation, vibrance, hue
+#define SHADER_MAIN \
+" \n\
+const sfpvec3 W = sfpvec3(sfp(0.2125f), sfp(0.7154f), sfp(0.0721f)); \n\
+void main() \n\
+{ \n\
+    int gx = int(gl_GlobalInvocationID.x); \n\
+    int gy = int(gl_GlobalInvocationID.y); \n\
+    if (gx >= p.out_w || gy >= p.out_h) \n\
+        return; \n\
+    sfpvec3 color = load_rgba(gx, gy, p.w, p.cstep, p.in_format, p.in_type).rgb; \n\
+    if ((p.stages & STAGE_EXPOSURE) != 0) \n\
+        color = clamp(color * pow(sfp(2.0f), sfp(p.exposure)), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_WHITEBALANCE) != 0) \n\
+        color = clamp(whitebalance(color), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_COLORBALANCE) != 0) \n\
+        color = clamp(balance(color), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_BRIGHTNESS) != 0) \n\
+        color = clamp(color + sfpvec3(sfp(p.brightness)), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_CONTRAST) != 0) \n\
+        color = clamp((color - sfpvec3(0.5f)) * sfp(p.contrast) + sfpvec3(0.5f), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_GAMMA) != 0) \n\
+        color = clamp(pow(color, sfpvec3(sfp(p.gamma))), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_SATURATION) != 0) \n\
+        color = clamp(mix(sfpvec3(dot(color, W)), color, sfp(p.saturation)), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    if ((p.stages & STAGE_VIBRANCE) != 0) \n\
+    { \n\
+        sfp average = (color.r + color.g + color.b) / sfp(3.0f); \n\
+        sfp mx = max(color.r, max(color.g, color.b)); \n\
+        sfp amt = (mx - average) * sfp(-p.vibrance * 3.0f); \n\
+        color = clamp(mix(color, sfpvec3(mx), amt), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    } \n\
+    if ((p.stages & STAGE_HUE) != 0) \n\
+        color = clamp(hue(color), sfpvec3(0.f), sfpvec3(1.0f)); \n\
+    store_rgba(sfpvec4(color, 1.0f), gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+} \
+"
+
+static const char Filter_data[] = 
+SHADER_HEADER
+SHADER_PARAM
+SHADER_STAGES
+SHADER_INPUT_OUTPUT_DATA
+SHADER_LOAD_RGBA
+SHADER_STORE_RGBA
+SHADER_WHITEBALANCE
+SHADER_COLORBALANCE
+SHADER_HUE
+SHADER_MAIN
+;
@@ -0,0 +1,146 @@
+#include "ColorGrade_vulkan.h"
+#include "ColorGrade_shader.h"
+#include "ImVulkanShader.h"
+
+namespace ImGui 
+{
+enum ColorGradeStage
+{
+    STAGE_EXPOSURE      = 1 << 0,
+    STAGE_WHITEBALANCE  = 1 << 1,
+    STAGE_COLORBALANCE  = 1 << 2,
+    STAGE_BRIGHTNESS    = 1 << 3,
+    STAGE_CONTRAST      = 1 << 4,
+    STAGE_GAMMA         = 1 << 5,
+    STAGE_SATURATION    = 1 << 6,
+    STAGE_VIBRANCE      = 1 << 7,
+    STAGE_HUE           = 1 << 8,
+};
+
+static int grade_stages(const ColorGradeParam& param)
+{
+    auto is_zero = [](const ImVec4& v) { return v.x == 0.f && v.y == 0.f && v.z == 0.f; };
+    int stages = 0;
+    if (param.exposure != 0.f)      stages |= STAGE_EXPOSURE;
+    if (param.temperature != 0.f)   stages |= STAGE_WHITEBALANCE;
+    if (!is_zero(param.shadows) || !is_zero(param.midtones) || !is_zero(param.highlights) || param.preserve_lightness)
+                                    stages |= STAGE_COLORBALANCE;
+    if (param.brightness != 0.f)    stages |= STAGE_BRIGHTNESS;
+    if (param.contrast != 1.f)      stages |= STAGE_CONTRAST;
+    if (param.gamma != 1.f)         stages |= STAGE_GAMMA;
+    if (param.saturation != 1.f)    stages |= STAGE_SATURATION;
+    if (param.vibrance != 0.f)      stages |= STAGE_VIBRANCE;
+    if (param.hue != 0.f)           stages |= STAGE_HUE;
+    return stages;
+}
+
+ColorGrade_vulkan::ColorGrade_vulkan(int gpu)
+{
+    vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    opt.use_image_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
+    cmd = new VkCompute(vkdev);
+
+    std::vector<vk_specialization_type> specializations(0);
+    std::vector<uint32_t> spirv_data;
+
+    if (compile_spirv_module(Filter_data, opt, spirv_data) == 0)
+    {
+        pipe = new Pipeline(vkdev);
+        pipe->set_optimal_local_size_xyz(16, 16, 1);
+        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+    }
+    
+    cmd->reset();
+}
+
+ColorGrade_vulkan::~ColorGrade_vulkan()
+{
+    if (vkdev)
+    {
+        if (pipe) { delete pipe; pipe = nullptr; }
+        if (cmd) { delete cmd; cmd = nullptr; }
+        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
+        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
+    }
+}
+
+void ColorGrade_vulkan::upload_param(const VkMat& src, VkMat& dst, const ColorGradeParam& param) const
+{
+    std::vector<VkMat> bindings(8);
+    if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
+    else if (dst.type == IM_DT_INT16)    bindings[1] = dst;
+    else if (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
+    else if (dst.type == IM_DT_FLOAT32)  bindings[3] = dst;
+
+    if      (src.type == IM_DT_INT8)     bindings[4] = src;
+    else if (src.type == IM_DT_INT16)    bindings[5] = src;
+    else if (src.type == IM_DT_FLOAT16)  bindings[6] = src;
+    else if (src.type == IM_DT_FLOAT32)  bindings[7] = src;
+    std::vector<vk_constant_type> constants(29);
+    constants[0].i = src.w;
+    constants[1].i = src.h;
+    constants[2].i = src.c;
+    constants[3].i = src.color_format;
+    constants[4].i = src.type;
+    constants[5].i = dst.w;
+    constants[6].i = dst.h;
+    constants[7].i = dst.c;
+    constants[8].i = dst.color_format;
+    constants[9].i = dst.type;
+    constants[10].i = grade_stages(param);
+    constants[11].f = param.exposure;
+    constants[12].f = param.temperature;
+    constants[13].f = param.shadows.x;
+    constants[14].f = param.shadows.y;
+    constants[15].f = param.shadows.z;
+    constants[16].f = param.midtones.x;
+    constants[17].f = param.midtones.y;
+    constants[18].f = param.midtones.z;
+    constants[19].f = param.highlights.x;
+    constants[20].f = param.highlights.y;
+    constants[21].f = param.highlights.z;
+    constants[22].i = param.preserve_lightness ? 1 : 0;
+    constants[23].f = param.brightness;
+    constants[24].f = param.contrast;
+    constants[25].f = param.gamma;
+    constants[26].f = param.saturation;
+    constants[27].f = param.vibrance;
+    constants[28].f = param.hue;
+    cmd->record_pipeline(pipe, bindings, constants, dst);
+}
+
+void ColorGrade_vulkan::filter(const ImMat& src, ImMat& dst, const ColorGradeParam& param) const
+{
+    if (!vkdev || !pipe || !cmd)
+    {
+        return;
+    }
+
+    VkMat dst_gpu;
+    dst_gpu.create_type(src.w, src.h, 4, dst.type, opt.blob_vkallocator);
+
+    VkMat src_gpu;
+    if (src.device == IM_DD_VULKAN)
+    {
+        src_gpu = src;
+    }
+    else if (src.device == IM_DD_CPU)
+    {
+        cmd->record_clone(src, src_gpu, opt);
+    }
+
+    upload_param(src_gpu, dst_gpu, param);
+
+    // download
+    if (dst.device == IM_DD_CPU)
+        cmd->record_clone(dst_gpu, dst, opt);
+    else if (dst.device == IM_DD_VULKAN)
+        dst = dst_gpu;
+    cmd->submit_and_wait();
+    cmd->reset();
+}
+} //namespace ImGui 
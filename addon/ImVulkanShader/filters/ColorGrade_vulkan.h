@@ -0,0 +1,46 @@
+#pragma once
+#include <imvk_gpu.h>
+#include <imvk_pipeline.h>
+#include <immat.h>
+#define NO_STB_IMAGE
+#include <imgui.h>
+
+namespace ImGui 
+{
+// parameters of the single adjustment filters, defaults are identity
+struct ColorGradeParam
+{
+    float exposure      {0.f};
+    float temperature   {0.f};
+    ImVec4 shadows      {0.f, 0.f, 0.f, 0.f};
+    ImVec4 midtones     {0.f, 0.f, 0.f, 0.f};
+    ImVec4 highlights   {0.f, 0.f, 0.f, 0.f};
+    bool preserve_lightness {false};
+    float brightness    {0.f};
+    float contrast      {1.f};
+    float gamma         {1.f};
+    float saturation    {1.f};
+    float vibrance      {0.f};
+    float hue           {0.f};
+};
+
+// Exposure, WhiteBalance, ColorBalance, Brightness, Contrast, Gamma, Saturation, Vibrance and Hue
+// in one dispatch, applied in that order, stages left at identity are skipped
+class VKSHADER_API ColorGrade_vulkan
+{
+public:
+    ColorGrade_vulkan(int gpu = -1);
+    ~ColorGrade_vulkan();
+
+    virtual void filter(const ImMat& src, ImMat& dst, const ColorGradeParam& param) const;
+
+public:
+    const VulkanDevice* vkdev {nullptr};
+    Pipeline * pipe           {nullptr};
+    VkCompute * cmd           {nullptr};
+    Option opt;
+
+private:
+    void upload_param(const VkMat& src, VkMat& dst, const ColorGradeParam& param) const;
+};
+} // namespace ImGui 
@@ -1,5 +1,6 @@
 #include "Filter2DS_vulkan.h"
 #include "Filter2DS_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 
 namespace ImGui 
@@ -7,11 +8,11 @@ namespace ImGui
 Filter2DS_vulkan::Filter2DS_vulkan(int gpu)
 {
     vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
 
     std::vector<vk_specialization_type> specializations(0);
@@ -19,16 +20,18 @@ Filter2DS_vulkan::Filter2DS_vulkan(int gpu)
 
     if (compile_spirv_module(FilterColumn_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_column = new Pipeline(vkdev);
-        pipe_column->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_column->set_local_size_xyz(16, 16, 1);
         pipe_column->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
 
     if (compile_spirv_module(FilterRow_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_row = new Pipeline(vkdev);
-        pipe_row->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_row->set_local_size_xyz(16, 16, 1);
         pipe_row->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
@@ -66,14 +69,17 @@ void Filter2DS_vulkan::upload_param(const VkMat& src, VkMat& dst) const
     constants[12].i = xanchor;
     constants[13].i = yanchor;
 
+    // column result in the intermediate type, not quantized to an int8 dst between the passes
     VkMat vk_column;
-    vk_column.create_like(dst, opt.blob_vkallocator);
+    vk_column.create_type(dst.w, dst.h, dst.c, intermediate_type(IM_PRECISION_FP16_STORAGE), opt.blob_vkallocator);
+    vk_column.color_format = dst.color_format;
+    constants[9].i = vk_column.type;
 
     std::vector<VkMat> column_bindings(9);
-    if      (dst.type == IM_DT_INT8)     column_bindings[0] = vk_column;
-    else if (dst.type == IM_DT_INT16)    column_bindings[1] = vk_column;
-    else if (dst.type == IM_DT_FLOAT16)  column_bindings[2] = vk_column;
-    else if (dst.type == IM_DT_FLOAT32)  column_bindings[3] = vk_column;
+    if      (vk_column.type == IM_DT_INT8)     column_bindings[0] = vk_column;
+    else if (vk_column.type == IM_DT_INT16)    column_bindings[1] = vk_column;
+    else if (vk_column.type == IM_DT_FLOAT16)  column_bindings[2] = vk_column;
+    else if (vk_column.type == IM_DT_FLOAT32)  column_bindings[3] = vk_column;
 
     if      (src.type == IM_DT_INT8)      column_bindings[4] = src;
     else if (src.type == IM_DT_INT16)     column_bindings[5] = src;
@@ -87,6 +93,7 @@ void Filter2DS_vulkan::upload_param(const VkMat& src, VkMat& dst) const
     constants[2].i = vk_column.c;
     constants[3].i = vk_column.color_format;
     constants[4].i = vk_column.type;
+    constants[9].i = dst.type;
 
     std::vector<VkMat> row_bindings(9);
     if      (dst.type == IM_DT_INT8)     row_bindings[0] = dst;
@@ -104,7 +111,13 @@ void Filter2DS_vulkan::upload_param(const VkMat& src, VkMat& dst) const
 
 void Filter2DS_vulkan::filter(const ImMat& src, ImMat& dst) const
 {
-    if (!vkdev || !pipe_column || !pipe_row || !cmd)
+    if (!vkdev)
+    {
+        if (src.device == IM_DD_CPU)
+            CPU::Filter2DS(src, dst, kernel, xksize, yksize, xanchor, yanchor);
+        return;
+    }
+    if (!pipe_column || !pipe_row || !cmd)
     {
         return;
     }
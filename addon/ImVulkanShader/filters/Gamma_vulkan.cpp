@@ -1,5 +1,6 @@
 #include "Gamma_vulkan.h"
 #include "Gamma_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 
 namespace ImGui 
@@ -7,11 +8,11 @@ namespace ImGui
 Gamma_vulkan::Gamma_vulkan(int gpu)
 {
     vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
 
     std::vector<vk_specialization_type> specializations(0);
@@ -67,7 +68,13 @@ void Gamma_vulkan::upload_param(const VkMat& src, VkMat& dst, float gamma) const
 
 void Gamma_vulkan::filter(const ImMat& src, ImMat& dst, float gamma) const
 {
-    if (!vkdev || !pipe || !cmd)
+    if (!vkdev)
+    {
+        if (src.device == IM_DD_CPU)
+            CPU::Gamma(src, dst, gamma);
+        return;
+    }
+    if (!pipe || !cmd)
     {
         return;
     }
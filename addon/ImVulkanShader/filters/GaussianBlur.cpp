@@ -47,9 +47,12 @@ void GaussianBlur_vulkan::prepare_kernel()
 #endif
     sum = 1.0 / sum;
     kernel *= (float)(sum);
-    VkTransfer tran(vkdev);
-    tran.record_upload(kernel, vk_kernel, opt, false);
-    tran.submit_and_wait();
+    if (vkdev)
+    {
+        VkTransfer tran(vkdev);
+        tran.record_upload(kernel, vk_kernel, opt, false);
+        tran.submit_and_wait();
+    }
 
     xksize = yksize = ksize;
     xanchor = yanchor = blurRadius;
@@ -0,0 +1,197 @@
+#pragma once
+#include <imvk_mat_shader.h>
+
+#define SHADER_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_format; \n\
+    int in_type; \n\
+    \n\
+    int out_w; \n\
+    int out_h; \n\
+    int out_cstep; \n\
+    int out_format; \n\
+    int out_type; \n\
+    \n\
+    int crop_x; \n\
+    int crop_y; \n\
+    int crop_w; \n\
+    int crop_h; \n\
+    int flip_x; \n\
+    int flip_y; \n\
+    int transpose; \n\
+    int interp_type; \n\
+} p; \
+"
+
+// Map output pixel to a continuous position inside the crop rect, pixel
+// edges at integer and centers at +0.5. Output is scaled over the crop
+// after transpose, then transposed back and mirrored in crop space.
+// scale returns the footprint of one output pixel in crop space.
+#define GEOMETRY_COORD \
+" \n\
+vec2 geometry_coord(int x, int y, out vec2 scale) \n\
+{ \n\
+    int tw = p.transpose != 0 ? p.crop_h : p.crop_w; \n\
+    int th = p.transpose != 0 ? p.crop_w : p.crop_h; \n\
+    vec2 s = vec2(float(tw) / float(p.out_w), float(th) / float(p.out_h)); \n\
+    vec2 pos = (vec2(x, y) + 0.5f) * s; \n\
+    if (p.transpose != 0) \n\
+    { \n\
+        pos = pos.yx; \n\
+        s = s.yx; \n\
+    } \n\
+    if (p.flip_x != 0) \n\
+        pos.x = float(p.crop_w) - pos.x; \n\
+    if (p.flip_y != 0) \n\
+        pos.y = float(p.crop_h) - pos.y; \n\
+    scale = s; \n\
+    return pos; \n\
+} \n\
+\n\
+vec4 load_crop(int x, int y) \n\
+{ \n\
+    x = clamp(x, 0, p.crop_w - 1); \n\
+    y = clamp(y, 0, p.crop_h - 1); \n\
+    return vec4(load_rgba(p.crop_x + x, p.crop_y + y, p.w, p.cstep, p.in_format, p.in_type)); \n\
+} \
+"
+
+#define INTERPLATE_NEAREST \
+" \n\
+vec4 interplate_nearest(vec2 pos) \n\
+{ \n\
+    ivec2 i = ivec2(floor(pos)); \n\
+    return load_crop(i.x, i.y); \n\
+} \
+"
+
+#define INTERPLATE_BILINEAR \
+" \n\
+vec4 interplate_bilinear(vec2 pos) \n\
+{ \n\
+    vec2 c = pos - 0.5f; \n\
+    ivec2 i = ivec2(floor(c)); \n\
+    vec2 f = c - vec2(i); \n\
+    vec4 v00 = load_crop(i.x,     i.y); \n\
+    vec4 v10 = load_crop(i.x + 1, i.y); \n\
+    vec4 v01 = load_crop(i.x,     i.y + 1); \n\
+    vec4 v11 = load_crop(i.x + 1, i.y + 1); \n\
+    return mix(mix(v00, v10, f.x), mix(v01, v11, f.x), f.y); \n\
+} \
+"
+
+#define INTERPLATE_BICUBIC \
+" \n\
+vec4 cubic_weight(float f) \n\
+{ \n\
+    const float A = -0.75f; \n\
+    vec4 w; \n\
+    w.x = ((A * (f + 1.f) - 5.f * A) * (f + 1.f) + 8.f * A) * (f + 1.f) - 4.f * A; \n\
+    w.y = ((A + 2.f) * f - (A + 3.f)) * f * f + 1.f; \n\
+    w.z = ((A + 2.f) * (1.f - f) - (A + 3.f)) * (1.f - f) * (1.f - f) + 1.f; \n\
+    w.w = 1.f - w.x - w.y - w.z; \n\
+    return w; \n\
+} \n\
+\n\
+vec4 interplate_bicubic(vec2 pos) \n\
+{ \n\
+    vec2 c = pos - 0.5f; \n\
+    ivec2 i = ivec2(floor(c)); \n\
+    vec2 f = c - vec2(i); \n\
+    vec4 wx = cubic_weight(f.x); \n\
+    vec4 wy = cubic_weight(f.y); \n\
+    vec4 v = vec4(0.f); \n\
+    for (int j = 0; j < 4; j++) \n\
+    { \n\
+        vec4 row = load_crop(i.x - 1, i.y - 1 + j) * wx.x + \n\
+                   load_crop(i.x,     i.y - 1 + j) * wx.y + \n\
+                   load_crop(i.x + 1, i.y - 1 + j) * wx.z + \n\
+                   load_crop(i.x + 2, i.y - 1 + j) * wx.w; \n\
+        v += row * wy[j]; \n\
+    } \n\
+    return v; \n\
+} \
+"
+
+// box of one output pixel footprint, edge pixels weighted by coverage,
+// on upscale the box is smaller than a pixel and blends at most 2x2 pixels
+#define INTERPLATE_AREA \
+" \n\
+vec4 interplate_area(vec2 pos, vec2 scale) \n\
+{ \n\
+    vec2 b0 = max(pos - scale * 0.5f, vec2(0.f)); \n\
+    vec2 b1 = min(pos + scale * 0.5f, vec2(p.crop_w, p.crop_h)); \n\
+    int sx1 = int(floor(b0.x)), sx2 = int(ceil(b1.x)); \n\
+    int sy1 = int(floor(b0.y)), sy2 = int(ceil(b1.y)); \n\
+    vec4 sum = vec4(0.f); \n\
+    float area = 0.f; \n\
+    for (int j = sy1; j < sy2; j++) \n\
+    { \n\
+        float dy = min(float(j + 1), b1.y) - max(float(j), b0.y); \n\
+        for (int i = sx1; i < sx2; i++) \n\
+        { \n\
+            float dx = min(float(i + 1), b1.x) - max(float(i), b0.x); \n\
+            sum += load_crop(i, j) * (dx * dy); \n\
+            area += dx * dy; \n\
+        } \n\
+    } \n\
+    return area > 0.f ? sum / area : interplate_nearest(pos); \n\
+} \
+"
+
+#define INTERPLATE \
+" \n\
+sfpvec4 interplate(int x, int y) \n\
+{ \n\
+    vec2 scale; \n\
+    vec2 pos = geometry_coord(x, y, scale); \n\
+    if (p.interp_type == INTERPOLATE_BILINEAR) \n\
+        return sfpvec4(interplate_bilinear(pos)); \n\
+    else if (p.interp_type == INTERPOLATE_BICUBIC) \n\
+        return sfpvec4(interplate_bicubic(pos)); \n\
+    else if (p.interp_type == INTERPOLATE_AREA || p.interp_type == INTERPOLATE_PYRAMID) \n\
+        return sfpvec4(interplate_area(pos, scale)); \n\
+    else \n\
+        return sfpvec4(interplate_nearest(pos)); \n\
+} \
+"
+
+#define SHADER_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    int gx = int(gl_GlobalInvocationID.x); \n\
+    int gy = int(gl_GlobalInvocationID.y); \n\
+    if (gx >= p.out_w || gy >= p.out_h) \n\
+        return; \n\
+    sfpvec4 v = interplate(gx, gy); \n\
+    if (p.out_cstep == 4) \n\
+        store_rgba(v, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+    else if (p.out_cstep == 3) \n\
+        store_rgb(v.rgb, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+    else if (p.out_cstep == 1) \n\
+        store_gray(v.r, gx, gy, p.out_w, p.out_cstep, p.out_format, p.out_type); \n\
+} \
+"
+
+static const char Geometry_data[] =
+SHADER_HEADER
+SHADER_PARAM
+SHADER_INPUT_OUTPUT_DATA
+SHADER_LOAD_RGBA
+SHADER_STORE_RGBA
+SHADER_STORE_RGB
+SHADER_STORE_GRAY
+GEOMETRY_COORD
+INTERPLATE_NEAREST
+INTERPLATE_BILINEAR
+INTERPLATE_BICUBIC
+INTERPLATE_AREA
+INTERPLATE
+SHADER_MAIN
+;
@@ -0,0 +1,133 @@
+#include "Geometry_vulkan.h"
+#include "Geometry_shader.h"
+#include "Reference_cpu.h"
+#include "ImVulkanShader.h"
+
+namespace ImGui 
+{
+Geometry_vulkan::Geometry_vulkan(int gpu)
+{
+    vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    opt.use_image_storage = false;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
+    cmd = new VkCompute(vkdev);
+    std::vector<vk_specialization_type> specializations(0);
+    std::vector<uint32_t> spirv_data;
+
+    if (compile_spirv_module(Geometry_data, opt, spirv_data) == 0)
+    {
+        pipe = new Pipeline(vkdev);
+        pipe->set_optimal_local_size_xyz(16, 16, 1);
+        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+    }
+
+    cmd->reset();
+}
+
+Geometry_vulkan::~Geometry_vulkan()
+{
+    if (vkdev)
+    {
+        if (pipe) { delete pipe; pipe = nullptr; }
+        if (cmd) { delete cmd; cmd = nullptr; }
+        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
+        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
+    }
+}
+
+void Geometry_vulkan::upload_param(const VkMat& src, VkMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                                    bool flip_x, bool flip_y, bool transpose, ImInterpolateMode type) const
+{
+    std::vector<VkMat> bindings(8);
+    if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
+    else if (dst.type == IM_DT_INT16)    bindings[1] = dst;
+    else if (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
+    else if (dst.type == IM_DT_FLOAT32)  bindings[3] = dst;
+
+    if      (src.type == IM_DT_INT8)      bindings[4] = src;
+    else if (src.type == IM_DT_INT16)     bindings[5] = src;
+    else if (src.type == IM_DT_FLOAT16)   bindings[6] = src;
+    else if (src.type == IM_DT_FLOAT32)   bindings[7] = src;
+
+    std::vector<vk_constant_type> constants(18);
+    constants[0].i = src.w;
+    constants[1].i = src.h;
+    constants[2].i = src.c;
+    constants[3].i = src.color_format;
+    constants[4].i = src.type;
+    constants[5].i = dst.w;
+    constants[6].i = dst.h;
+    constants[7].i = dst.c;
+    constants[8].i = dst.color_format;
+    constants[9].i = dst.type;
+    constants[10].i = crop_x;
+    constants[11].i = crop_y;
+    constants[12].i = crop_w;
+    constants[13].i = crop_h;
+    constants[14].i = flip_x ? 1 : 0;
+    constants[15].i = flip_y ? 1 : 0;
+    constants[16].i = transpose ? 1 : 0;
+    constants[17].i = type;
+    cmd->record_pipeline(pipe, bindings, constants, dst);
+}
+
+void Geometry_vulkan::transform(const ImMat& src, ImMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                                bool flip_x, bool flip_y, bool transpose, int out_w, int out_h, ImInterpolateMode type) const
+{
+    if (crop_w <= 0 || crop_h <= 0)
+    {
+        crop_x = crop_y = 0;
+        crop_w = src.w;
+        crop_h = src.h;
+    }
+    crop_x = std::max(0, std::min(crop_x, src.w - 1));
+    crop_y = std::max(0, std::min(crop_y, src.h - 1));
+    crop_w = std::min(crop_w, src.w - crop_x);
+    crop_h = std::min(crop_h, src.h - crop_y);
+    if (out_w <= 0 || out_h <= 0)
+    {
+        out_w = transpose ? crop_h : crop_w;
+        out_h = transpose ? crop_w : crop_h;
+    }
+
+    if (!vkdev)
+    {
+        if (src.device == IM_DD_CPU)
+            CPU::Transform(src, dst, crop_x, crop_y, crop_w, crop_h, flip_x, flip_y, transpose, out_w, out_h, type);
+        return;
+    }
+    if (!pipe || !cmd)
+    {
+        return;
+    }
+
+    auto color_format = dst.color_format;
+    int channels = IM_ISALPHA(color_format) ? 4 : IM_ISRGB(color_format) ? 3 : IM_ISMONO(color_format) ? 1 : 4;
+    VkMat dst_gpu;
+    dst_gpu.create_type(out_w, out_h, channels, dst.type, opt.blob_vkallocator);
+    dst_gpu.color_format = color_format;
+
+    VkMat src_gpu;
+    if (src.device == IM_DD_VULKAN)
+    {
+        src_gpu = src;
+    }
+    else if (src.device == IM_DD_CPU)
+    {
+        cmd->record_clone(src, src_gpu, opt);
+    }
+
+    upload_param(src_gpu, dst_gpu, crop_x, crop_y, crop_w, crop_h, flip_x, flip_y, transpose, type);
+
+    // download
+    if (dst.device == IM_DD_CPU)
+        cmd->record_clone(dst_gpu, dst, opt);
+    else if (dst.device == IM_DD_VULKAN)
+        dst = dst_gpu;
+    cmd->submit_and_wait();
+    cmd->reset();
+}
+} //namespace ImGui 
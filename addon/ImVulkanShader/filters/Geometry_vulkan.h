@@ -0,0 +1,34 @@
+#pragma once
+#include "imvk_gpu.h"
+#include "imvk_pipeline.h"
+#include "immat.h"
+
+namespace ImGui 
+{
+// Crop, flip, transpose and resize fused in one dispatch, every output pixel samples the source once.
+// Flips mirror the crop rect, transpose swaps its axes, then the result is scaled to out_w x out_h.
+//   rotate 90 clockwise        : transpose + flip_y
+//   rotate 90 counterclockwise : transpose + flip_x
+//   rotate 180                 : flip_x + flip_y
+class VKSHADER_API Geometry_vulkan
+{
+public:
+    Geometry_vulkan(int gpu = -1);
+    virtual ~Geometry_vulkan();
+
+    // crop_w/crop_h <= 0 take the whole frame, out_w/out_h <= 0 keep the size of the (transposed) crop
+    virtual void transform(const ImMat& src, ImMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                            bool flip_x, bool flip_y, bool transpose, int out_w = 0, int out_h = 0,
+                            ImInterpolateMode type = IM_INTERPOLATE_BILINEAR) const;
+
+public:
+    const VulkanDevice* vkdev {nullptr};
+    Pipeline * pipe           {nullptr};
+    VkCompute * cmd           {nullptr};
+    Option opt;
+
+protected:
+    void upload_param(const VkMat& src, VkMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                        bool flip_x, bool flip_y, bool transpose, ImInterpolateMode type) const;
+};
+} // namespace ImGui 
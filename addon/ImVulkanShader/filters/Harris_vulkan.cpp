@@ -11,8 +11,7 @@ Harris_vulkan::Harris_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -25,34 +24,29 @@ Harris_vulkan::Harris_vulkan(int gpu)
         spirv_data.clear();
     }
 
-    if (compile_spirv_module(NMSFilter_data, opt, spirv_data) == 0)
+    if (compile_spirv_module(HarrisNMSFilter_data, opt, spirv_data) == 0)
     {
-        pipe_nms = new Pipeline(vkdev);
-        pipe_nms->set_optimal_local_size_xyz(16, 16, 1);
-        pipe_nms->create(spirv_data.data(), spirv_data.size() * 4, specializations);
-        spirv_data.clear();
-    }
-
-    if (compile_spirv_module(HarrisFilter_data, opt, spirv_data) == 0)
-    {
-        pipe_harris = new Pipeline(vkdev);
-        pipe_harris->set_optimal_local_size_xyz(16, 16, 1);
-        pipe_harris->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        // shared memory tile is sized for exactly 16x16
+        pipe_harris_nms = new Pipeline(vkdev);
+        pipe_harris_nms->set_local_size_xyz(16, 16, 1);
+        pipe_harris_nms->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
 
     if (compile_spirv_module(FilterColumn_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_column = new Pipeline(vkdev);
-        pipe_column->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_column->set_local_size_xyz(16, 16, 1);
         pipe_column->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
 
     if (compile_spirv_module(FilterRow_data, opt, spirv_data) == 0)
     {
+        // shared memory rows are sized for exactly 16x16
         pipe_row = new Pipeline(vkdev);
-        pipe_row->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_row->set_local_size_xyz(16, 16, 1);
         pipe_row->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
@@ -66,9 +60,8 @@ Harris_vulkan::~Harris_vulkan()
 {
     if (vkdev)
     {
-        if (pipe_harris) { delete pipe_harris; pipe_harris = nullptr; }
         if (pipe_prewitt) { delete pipe_prewitt; pipe_prewitt = nullptr; }
-        if (pipe_nms) { delete pipe_nms; pipe_nms = nullptr; }
+        if (pipe_harris_nms) { delete pipe_harris_nms; pipe_harris_nms = nullptr; }
         if (pipe_column) { delete pipe_column; pipe_column = nullptr; }
         if (pipe_row) { delete pipe_row; pipe_row = nullptr; }
         if (cmd) { delete cmd; cmd = nullptr; }
@@ -97,23 +90,31 @@ void Harris_vulkan::prepare_kernel()
 
     sum = 1.0 / sum;
     kernel *= (float)(sum);
-    VkTransfer tran(vkdev);
-    tran.record_upload(kernel, vk_kernel, opt, false);
-    tran.submit_and_wait();
+    // recorded into the compute command, no extra submit
+    cmd->record_clone(kernel, vk_kernel, opt);
 
     xksize = yksize = ksize;
     xanchor = yanchor = blurRadius;
 }
 
-void Harris_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius, float edgeStrength, float threshold, float harris, float sensitivity)
+void Harris_vulkan::SetParam(int _blurRadius, float _edgeStrength, float _threshold, float _harris, float _sensitivity)
 {
     if (blurRadius != _blurRadius)
     {
         blurRadius = _blurRadius;
         prepare_kernel();
     }
+    edgeStrength = _edgeStrength;
+    threshold = _threshold;
+    harris = _harris;
+    sensitivity = _sensitivity;
+}
+
+void Harris_vulkan::upload_param(const VkMat& src, VkMat& dst, std::vector<VkMat>& intermediates)
+{
     VkMat vk_prewitt;
-    vk_prewitt.create_type(dst.w, dst.h, 4, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_prewitt.create_type(dst.w, dst.h, 4, intermediate_type(), opt.blob_vkallocator);
+    intermediates.push_back(vk_prewitt);
 
     std::vector<VkMat> prewitt_bindings(8);
     if      (vk_prewitt.type == IM_DT_INT8)     prewitt_bindings[0] = vk_prewitt;
@@ -141,6 +142,7 @@ void Harris_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius,
 
     VkMat vk_column;
     vk_column.create_like(vk_prewitt, opt.blob_vkallocator);
+    intermediates.push_back(vk_column);
     std::vector<VkMat> column_bindings(9);
     if      (vk_column.type == IM_DT_INT8)     column_bindings[0] = vk_column;
     else if (vk_column.type == IM_DT_INT16)    column_bindings[1] = vk_column;
@@ -171,6 +173,7 @@ void Harris_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius,
 
     VkMat vk_blur;
     vk_blur.create_like(vk_prewitt, opt.blob_vkallocator);
+    intermediates.push_back(vk_blur);
 
     std::vector<VkMat> row_bindings(9);
     if      (vk_blur.type == IM_DT_INT8)     row_bindings[0] = vk_blur;
@@ -200,77 +203,46 @@ void Harris_vulkan::upload_param(const VkMat& src, VkMat& dst, int _blurRadius,
     row_constants[13].i = yanchor;
     cmd->record_pipeline(pipe_row, row_bindings, row_constants, vk_blur);
 
-    VkMat vk_harris;
-    vk_harris.create_type(dst.w, dst.h, vk_harris.type, opt.blob_vkallocator);
-    std::vector<VkMat> harris_bindings(8);
-    if      (vk_harris.type == IM_DT_INT8)     harris_bindings[0] = vk_harris;
-    else if (vk_harris.type == IM_DT_INT16)    harris_bindings[1] = vk_harris;
-    else if (vk_harris.type == IM_DT_FLOAT16)  harris_bindings[2] = vk_harris;
-    else if (vk_harris.type == IM_DT_FLOAT32)  harris_bindings[3] = vk_harris;
-
-    if      (vk_blur.type == IM_DT_INT8)     harris_bindings[4] = vk_blur;
-    else if (vk_blur.type == IM_DT_INT16)    harris_bindings[5] = vk_blur;
-    else if (vk_blur.type == IM_DT_FLOAT16)  harris_bindings[6] = vk_blur;
-    else if (vk_blur.type == IM_DT_FLOAT32)  harris_bindings[7] = vk_blur;
-
-    std::vector<vk_constant_type> harris_constants(12);
-    harris_constants[0].i = vk_blur.w;
-    harris_constants[1].i = vk_blur.h;
-    harris_constants[2].i = vk_blur.c;
-    harris_constants[3].i = vk_blur.color_format;
-    harris_constants[4].i = vk_blur.type;
-    harris_constants[5].i = vk_harris.w;
-    harris_constants[6].i = vk_harris.h;
-    harris_constants[7].i = vk_harris.c;
-    harris_constants[8].i = vk_harris.color_format;
-    harris_constants[9].i = vk_harris.type;
-    harris_constants[10].f = harris;
-    harris_constants[11].f = sensitivity;
-    cmd->record_pipeline(pipe_harris, harris_bindings, harris_constants, vk_harris);
-
-    std::vector<VkMat> nms_bindings(12);
-    if      (dst.type == IM_DT_INT8)     nms_bindings[0] = dst;
-    else if (dst.type == IM_DT_INT16)    nms_bindings[1] = dst;
-    else if (dst.type == IM_DT_FLOAT16)  nms_bindings[2] = dst;
-    else if (dst.type == IM_DT_FLOAT32)  nms_bindings[3] = dst;
-
-    if      (src.type == IM_DT_INT8)     nms_bindings[4] = src;
-    else if (src.type == IM_DT_INT16)    nms_bindings[5] = src;
-    else if (src.type == IM_DT_FLOAT16)  nms_bindings[6] = src;
-    else if (src.type == IM_DT_FLOAT32)  nms_bindings[7] = src;
-
-    if      (vk_harris.type == IM_DT_INT8)     nms_bindings[8] = vk_harris;
-    else if (vk_harris.type == IM_DT_INT16)    nms_bindings[9] = vk_harris;
-    else if (vk_harris.type == IM_DT_FLOAT16)  nms_bindings[10] = vk_harris;
-    else if (vk_harris.type == IM_DT_FLOAT32)  nms_bindings[11] = vk_harris;
-
-    std::vector<vk_constant_type> nms_constants(16);
-    nms_constants[0].i = src.w;
-    nms_constants[1].i = src.h;
-    nms_constants[2].i = src.c;
-    nms_constants[3].i = src.color_format;
-    nms_constants[4].i = src.type;
-    nms_constants[5].i = vk_harris.w;
-    nms_constants[6].i = vk_harris.h;
-    nms_constants[7].i = vk_harris.c;
-    nms_constants[8].i = vk_harris.color_format;
-    nms_constants[9].i = vk_harris.type;
-    nms_constants[10].i = dst.w;
-    nms_constants[11].i = dst.h;
-    nms_constants[12].i = dst.c;
-    nms_constants[13].i = dst.color_format;
-    nms_constants[14].i = dst.type;
-    nms_constants[15].f = threshold;
-    cmd->record_pipeline(pipe_nms, nms_bindings, nms_constants, dst);
+    std::vector<VkMat> harris_nms_bindings(12);
+    if      (dst.type == IM_DT_INT8)     harris_nms_bindings[0] = dst;
+    else if (dst.type == IM_DT_INT16)    harris_nms_bindings[1] = dst;
+    else if (dst.type == IM_DT_FLOAT16)  harris_nms_bindings[2] = dst;
+    else if (dst.type == IM_DT_FLOAT32)  harris_nms_bindings[3] = dst;
+
+    if      (src.type == IM_DT_INT8)     harris_nms_bindings[4] = src;
+    else if (src.type == IM_DT_INT16)    harris_nms_bindings[5] = src;
+    else if (src.type == IM_DT_FLOAT16)  harris_nms_bindings[6] = src;
+    else if (src.type == IM_DT_FLOAT32)  harris_nms_bindings[7] = src;
+
+    if      (vk_blur.type == IM_DT_INT8)     harris_nms_bindings[8] = vk_blur;
+    else if (vk_blur.type == IM_DT_INT16)    harris_nms_bindings[9] = vk_blur;
+    else if (vk_blur.type == IM_DT_FLOAT16)  harris_nms_bindings[10] = vk_blur;
+    else if (vk_blur.type == IM_DT_FLOAT32)  harris_nms_bindings[11] = vk_blur;
+
+    std::vector<vk_constant_type> harris_nms_constants(18);
+    harris_nms_constants[0].i = src.w;
+    harris_nms_constants[1].i = src.h;
+    harris_nms_constants[2].i = src.c;
+    harris_nms_constants[3].i = src.color_format;
+    harris_nms_constants[4].i = src.type;
+    harris_nms_constants[5].i = vk_blur.w;
+    harris_nms_constants[6].i = vk_blur.h;
+    harris_nms_constants[7].i = vk_blur.c;
+    harris_nms_constants[8].i = vk_blur.color_format;
+    harris_nms_constants[9].i = vk_blur.type;
+    harris_nms_constants[10].i = dst.w;
+    harris_nms_constants[11].i = dst.h;
+    harris_nms_constants[12].i = dst.c;
+    harris_nms_constants[13].i = dst.color_format;
+    harris_nms_constants[14].i = dst.type;
+    harris_nms_constants[15].f = harris;
+    harris_nms_constants[16].f = sensitivity;
+    harris_nms_constants[17].f = threshold;
+    cmd->record_pipeline(pipe_harris_nms, harris_nms_bindings, harris_nms_constants, dst);
 }
 
-void Harris_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float edgeStrength, float threshold, float harris, float sensitivity)
+void Harris_vulkan::record_frame(const ImMat& src, ImMat& dst, std::vector<VkMat>& intermediates)
 {
-    if (!vkdev || !pipe_harris || !cmd)
-    {
-        return;
-    }
-
     VkMat dst_gpu;
     dst_gpu.create_type(src.w, src.h, 4, dst.type, opt.blob_vkallocator);
 
@@ -284,13 +256,56 @@ void Harris_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, _blurRadius, edgeStrength, threshold, harris, sensitivity);
+    upload_param(src_gpu, dst_gpu, intermediates);
 
     // download
     if (dst.device == IM_DD_CPU)
         cmd->record_clone(dst_gpu, dst, opt);
     else if (dst.device == IM_DD_VULKAN)
         dst = dst_gpu;
+    intermediates.push_back(src_gpu);
+    intermediates.push_back(dst_gpu);
+}
+
+void Harris_vulkan::filter(const ImMat& src, ImMat& dst, int _blurRadius, float edgeStrength, float threshold, float harris, float sensitivity)
+{
+    SetParam(_blurRadius, edgeStrength, threshold, harris, sensitivity);
+    filter(src, dst);
+}
+
+void Harris_vulkan::filter(const ImMat& src, ImMat& dst)
+{
+    if (!vkdev || !pipe_prewitt || !pipe_harris_nms || !pipe_column || !pipe_row || !cmd)
+    {
+        return;
+    }
+
+    std::vector<VkMat> intermediates;
+    record_frame(src, dst, intermediates);
+    cmd->submit_and_wait();
+    cmd->reset();
+}
+
+void Harris_vulkan::filter(const std::vector<ImMat>& src, std::vector<ImMat>& dst)
+{
+    if (!vkdev || !pipe_prewitt || !pipe_harris_nms || !pipe_column || !pipe_row || !cmd || src.empty())
+    {
+        return;
+    }
+
+    // new outputs follow the first one
+    ImMat dst_template = dst.empty() ? ImMat() : dst[0];
+    while (dst.size() < src.size())
+    {
+        ImMat mat;
+        mat.type = dst.empty() ? src[dst.size()].type : dst_template.type;
+        mat.device = dst.empty() ? IM_DD_CPU : dst_template.device;
+        dst.push_back(mat);
+    }
+
+    std::vector<VkMat> intermediates;
+    for (size_t i = 0; i < src.size(); i++)
+        record_frame(src[i], dst[i], intermediates);
     cmd->submit_and_wait();
     cmd->reset();
 }
@@ -11,14 +11,18 @@ public:
     Harris_vulkan(int gpu = 0);
     ~Harris_vulkan();
     
+    // blur kernel is rebuilt only when the radius changes, its upload rides on the next submit
+    void SetParam(int _blurRadius, float _edgeStrength, float _threshold, float _harris, float _sensitivity);
     void filter(const ImMat& src, ImMat& dst, int _blurRadius, float edgeStrength, float threshold, float harris, float sensitivity);
+    void filter(const ImMat& src, ImMat& dst);
+    // record all frames and submit once
+    void filter(const std::vector<ImMat>& src, std::vector<ImMat>& dst);
 
 private:
     VulkanDevice* vkdev      {nullptr};
     Option opt;
-    Pipeline* pipe_harris    {nullptr};
     Pipeline* pipe_prewitt   {nullptr};
-    Pipeline* pipe_nms       {nullptr};
+    Pipeline* pipe_harris_nms {nullptr};
     Pipeline * pipe_column   {nullptr};
     Pipeline * pipe_row      {nullptr};
     VkCompute * cmd          {nullptr};
@@ -27,6 +31,10 @@ private:
     ImMat kernel;
     VkMat vk_kernel;
     int blurRadius  {3};
+    float edgeStrength {1.0};
+    float threshold {0.1};
+    float harris    {0.04};
+    float sensitivity {5.0};
     int xksize;
     int yksize;
     int xanchor;
@@ -34,7 +42,8 @@ private:
     float sigma     {0};
 
 private:
-    void upload_param(const VkMat& src, VkMat& dst, int _blurRadius, float edgeStrength, float threshold, float harris, float sensitivity);
+    void upload_param(const VkMat& src, VkMat& dst, std::vector<VkMat>& intermediates);
+    void record_frame(const ImMat& src, ImMat& dst, std::vector<VkMat>& intermediates);
     void prepare_kernel();
 };
 } // namespace ImGui
@@ -10,15 +10,15 @@ Histogram_vulkan::Histogram_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = false;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
     if (compile_spirv_module(Histogram_data, opt, spirv_data) == 0)
     {
         pipe = new Pipeline(vkdev);
-        pipe->set_optimal_local_size_xyz(1, 512, 1);
+        // one invocation per shared bin, keep it out of the local size tuner
+        pipe->set_local_size_xyz(16, 16, 1);
         pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
         spirv_data.clear();
     }
@@ -52,7 +52,7 @@ Histogram_vulkan::~Histogram_vulkan()
     }
 }
 
-void Histogram_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float scale, bool log_view)
+void Histogram_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float scale, bool log_view, int stride)
 {
     ImGui::VkMat dst_gpu_int32;
     dst_gpu_int32.create_type(dst.w, dst.h, dst.c, IM_DT_INT32, opt.blob_vkallocator);
@@ -70,7 +70,7 @@ void Histogram_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst,
     else if (src.type == IM_DT_FLOAT16)  bindings[2] = src;
     else if (src.type == IM_DT_FLOAT32)  bindings[3] = src;
     bindings[4] = dst_gpu_int32;
-    std::vector<vk_constant_type> constants(10);
+    std::vector<vk_constant_type> constants(11);
     constants[0].i = src.w;
     constants[1].i = src.h;
     constants[2].i = src.c;
@@ -81,7 +81,9 @@ void Histogram_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst,
     constants[7].i = dst_gpu_int32.cstep;
     constants[8].i = dst_gpu_int32.color_format;
     constants[9].i = dst_gpu_int32.type;
-    cmd->record_pipeline(pipe, bindings, constants, dst_gpu_int32);
+    constants[10].i = stride;
+    ImGui::ImMat dispatcher((src.w + stride - 1) / stride, (src.h + stride - 1) / stride, 1, (void*)0);
+    cmd->record_pipeline(pipe, bindings, std::vector<VkImageMat>(), constants, dispatcher);
 
     std::vector<VkMat> conv_bindings(2);
     conv_bindings[0] = dst_gpu_int32;
@@ -96,7 +98,7 @@ void Histogram_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst,
     cmd->record_pipeline(pipe_conv, conv_bindings, conv_constants, dst);
 }
 
-void Histogram_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level, float scale, bool log_view)
+void Histogram_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level, float scale, bool log_view, int stride)
 {
     if (!vkdev || !pipe || !pipe_zero || !pipe_conv || !cmd)
     {
@@ -115,7 +117,7 @@ void Histogram_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int lev
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, scale, log_view);
+    upload_param(src_gpu, dst_gpu, scale, log_view, std::max(stride, 1));
 
     // download
     if (dst.device == IM_DD_CPU)
@@ -11,7 +11,8 @@ public:
     Histogram_vulkan(int gpu = 0);
     ~Histogram_vulkan();
 
-    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level = 256, float scale = 1.0, bool log_view = false);
+    // stride > 1 reads one pixel of every stride x stride block and weights it by stride^2, see Waveform_vulkan.h for the error bound
+    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level = 256, float scale = 1.0, bool log_view = false, int stride = 1);
 
 private:
     ImGui::VulkanDevice* vkdev      {nullptr};
@@ -22,6 +23,6 @@ private:
     ImGui::Pipeline* pipe_conv      {nullptr};
 
 private:
-    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float scale, bool log_view);
+    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float scale, bool log_view, int stride);
 };
 } // namespace ImGui
\ No newline at end of file
@@ -0,0 +1,246 @@
+#pragma once
+#include <imvk_mat_shader.h>
+
+// one partial per workgroup, count/mean/m2 merge with Chan's pairwise update so variance doesn't
+// cancel the way sum and sum of squares does in float. arg is the linear pixel index y * w + x,
+// ties keep the lowest index. count n == 0 marks an empty partial.
+#define SHADER_REDUCE_COMMON \
+" \n\
+#if ImVulkan_subgroup_shuffle \n\
+#extension GL_KHR_shader_subgroup_basic: require \n\
+#extension GL_KHR_shader_subgroup_shuffle: require \n\
+#endif \n\
+struct Stat \n\
+{ \n\
+    vec4 mn; \n\
+    vec4 mx; \n\
+    vec4 mean; \n\
+    vec4 m2; \n\
+    ivec4 amin; \n\
+    ivec4 amax; \n\
+    float n; \n\
+}; \n\
+Stat stat_empty() \n\
+{ \n\
+    Stat s; \n\
+    s.mn = vec4(3.4e38); \n\
+    s.mx = vec4(-3.4e38); \n\
+    s.mean = vec4(0.f); \n\
+    s.m2 = vec4(0.f); \n\
+    s.amin = ivec4(0); \n\
+    s.amax = ivec4(0); \n\
+    s.n = 0.f; \n\
+    return s; \n\
+} \n\
+void stat_add(inout Stat s, vec4 v, int index) \n\
+{ \n\
+    bvec4 lt = lessThan(v, s.mn); \n\
+    bvec4 gt = greaterThan(v, s.mx); \n\
+    s.mn = mix(s.mn, v, lt); \n\
+    s.amin = mix(s.amin, ivec4(index), lt); \n\
+    s.mx = mix(s.mx, v, gt); \n\
+    s.amax = mix(s.amax, ivec4(index), gt); \n\
+    s.n += 1.f; \n\
+    vec4 delta = v - s.mean; \n\
+    s.mean += delta / s.n; \n\
+    s.m2 += delta * (v - s.mean); \n\
+} \n\
+Stat stat_merge(Stat a, Stat b) \n\
+{ \n\
+    if (b.n == 0.f) return a; \n\
+    if (a.n == 0.f) return b; \n\
+    Stat r; \n\
+    bvec4 take_min = bvec4(uvec4(lessThan(b.mn, a.mn)) | (uvec4(equal(b.mn, a.mn)) & uvec4(lessThan(b.amin, a.amin)))); \n\
+    bvec4 take_max = bvec4(uvec4(greaterThan(b.mx, a.mx)) | (uvec4(equal(b.mx, a.mx)) & uvec4(lessThan(b.amax, a.amax)))); \n\
+    r.mn = mix(a.mn, b.mn, take_min); \n\
+    r.amin = mix(a.amin, b.amin, take_min); \n\
+    r.mx = mix(a.mx, b.mx, take_max); \n\
+    r.amax = mix(a.amax, b.amax, take_max); \n\
+    r.n = a.n + b.n; \n\
+    vec4 delta = b.mean - a.mean; \n\
+    r.mean = a.mean + delta * (b.n / r.n); \n\
+    r.m2 = a.m2 + b.m2 + delta * delta * (a.n * b.n / r.n); \n\
+    return r; \n\
+} \n\
+#if ImVulkan_subgroup_shuffle \n\
+Stat stat_shuffle_xor(Stat s, uint mask) \n\
+{ \n\
+    Stat r; \n\
+    r.mn = subgroupShuffleXor(s.mn, mask); \n\
+    r.mx = subgroupShuffleXor(s.mx, mask); \n\
+    r.mean = subgroupShuffleXor(s.mean, mask); \n\
+    r.m2 = subgroupShuffleXor(s.m2, mask); \n\
+    r.amin = subgroupShuffleXor(s.amin, mask); \n\
+    r.amax = subgroupShuffleXor(s.amax, mask); \n\
+    r.n = subgroupShuffleXor(s.n, mask); \n\
+    return r; \n\
+} \n\
+#endif \n\
+shared Stat sdata[128]; \n\
+// workgroup of 128 invocations down to one Stat, butterfly over subgroup lanes first when available \n\
+Stat workgroup_reduce(Stat s) \n\
+{ \n\
+    int tid = int(gl_LocalInvocationIndex); \n\
+#if ImVulkan_subgroup_shuffle \n\
+    for (uint mask = gl_SubgroupSize / 2; mask > 0; mask >>= 1) \n\
+        s = stat_merge(s, stat_shuffle_xor(s, mask)); \n\
+    if (subgroupElect()) \n\
+        sdata[gl_SubgroupID] = s; \n\
+    memoryBarrierShared(); \n\
+    barrier(); \n\
+    if (tid == 0) \n\
+    { \n\
+        for (uint i = 1; i < gl_NumSubgroups; i++) \n\
+            s = stat_merge(s, sdata[i]); \n\
+    } \n\
+#else \n\
+    sdata[tid] = s; \n\
+    memoryBarrierShared(); \n\
+    barrier(); \n\
+    for (int stride = 64; stride > 0; stride >>= 1) \n\
+    { \n\
+        if (tid < stride) \n\
+            sdata[tid] = stat_merge(sdata[tid], sdata[tid + stride]); \n\
+        memoryBarrierShared(); \n\
+        barrier(); \n\
+    } \n\
+    s = sdata[0]; \n\
+#endif \n\
+    return s; \n\
+} \n\
+"
+
+#define SHADER_REDUCE_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_format; \n\
+    int in_type; \n\
+} p; \
+"
+
+// 16x8 invocations, each folds a 4x4 pixel block at 16x8 pixel pitch so neighbours read neighbours
+#define SHADER_REDUCE_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    ivec2 base = ivec2(gl_WorkGroupID.xy) * ivec2(64, 32) + ivec2(gl_LocalInvocationID.xy); \n\
+    Stat s = stat_empty(); \n\
+    for (int j = 0; j < 4; j++) \n\
+    { \n\
+        int y = base.y + j * 8; \n\
+        if (y >= p.h) break; \n\
+        for (int i = 0; i < 4; i++) \n\
+        { \n\
+            int x = base.x + i * 16; \n\
+            if (x >= p.w) break; \n\
+            vec4 v = vec4(load_rgba(x, y, p.w, p.cstep, p.in_format, p.in_type)); \n\
+            stat_add(s, v, y * p.w + x); \n\
+        } \n\
+    } \n\
+    s = workgroup_reduce(s); \n\
+    if (gl_LocalInvocationIndex == 0) \n\
+        partial_data[gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x] = s; \n\
+} \
+"
+
+static const char Reduce_data[] =
+SHADER_HEADER
+SHADER_REDUCE_COMMON
+SHADER_REDUCE_PARAM
+SHADER_SRC_DATA
+R"(
+layout (std430, binding = 4) writeonly buffer partial { Stat partial_data[]; };
+)"
+SHADER_LOAD_RGBA
+SHADER_REDUCE_MAIN
+;
+
+#define SHADER_MERGE_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int count; \n\
+} p; \
+"
+
+// 128 invocations, each merges 8 partials at 128 pitch, one output partial per workgroup
+#define SHADER_MERGE_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    int base = int(gl_WorkGroupID.x) * 1024 + int(gl_LocalInvocationID.x); \n\
+    Stat s = stat_empty(); \n\
+    for (int i = 0; i < 8; i++) \n\
+    { \n\
+        int index = base + i * 128; \n\
+        if (index >= p.count) break; \n\
+        s = stat_merge(s, in_data[index]); \n\
+    } \n\
+    s = workgroup_reduce(s); \n\
+    if (gl_LocalInvocationIndex == 0) \n\
+        out_data[gl_WorkGroupID.x] = s; \n\
+} \
+"
+
+static const char Merge_data[] =
+SHADER_HEADER
+SHADER_REDUCE_COMMON
+SHADER_MERGE_PARAM
+R"(
+layout (std430, binding = 0) readonly buffer partial_in { Stat in_data[]; };
+layout (std430, binding = 1) writeonly buffer partial_out { Stat out_data[]; };
+)"
+SHADER_MERGE_MAIN
+;
+
+#define SHADER_FINAL_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int arg; \n\
+} p; \
+"
+
+// rows of the 4 channel float output: min, max, sum, mean, variance
+// or with arg: min, max, argmin x, argmin y, argmax x, argmax y
+#define SHADER_FINAL_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    int c = int(gl_GlobalInvocationID.x); \n\
+    if (c >= 4) \n\
+        return; \n\
+    Stat s = in_data[0]; \n\
+    out_data[0 * 4 + c] = s.mn[c]; \n\
+    out_data[1 * 4 + c] = s.mx[c]; \n\
+    if (p.arg == 1) \n\
+    { \n\
+        out_data[2 * 4 + c] = float(s.amin[c] % p.w); \n\
+        out_data[3 * 4 + c] = float(s.amin[c] / p.w); \n\
+        out_data[4 * 4 + c] = float(s.amax[c] % p.w); \n\
+        out_data[5 * 4 + c] = float(s.amax[c] / p.w); \n\
+    } \n\
+    else \n\
+    { \n\
+        out_data[2 * 4 + c] = s.mean[c] * s.n; \n\
+        out_data[3 * 4 + c] = s.mean[c]; \n\
+        out_data[4 * 4 + c] = s.n > 0.f ? s.m2[c] / s.n : 0.f; \n\
+    } \n\
+} \
+"
+
+static const char Final_data[] =
+SHADER_HEADER
+SHADER_REDUCE_COMMON
+SHADER_FINAL_PARAM
+R"(
+layout (std430, binding = 0) readonly buffer partial_in { Stat in_data[]; };
+layout (binding = 1) writeonly buffer stat_out { float out_data[]; };
+)"
+SHADER_FINAL_MAIN
+;
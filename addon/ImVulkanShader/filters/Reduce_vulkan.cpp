@@ -0,0 +1,162 @@
+#include "Reduce_vulkan.h"
+#include "Reduce_shader.h"
+#include "Reference_cpu.h"
+#include "ImVulkanShader.h"
+
+// float count of one Stat partial, std430 size of the shader struct
+#define STAT_FLOATS 28
+
+namespace ImGui
+{
+Reduce_vulkan::Reduce_vulkan(int gpu)
+{
+    vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    opt.use_image_storage = false;
+    // statistics accumulate in fp32 whatever the source type
+    apply_precision(opt, IM_PRECISION_FP32);
+    opt.use_subgroup_basic = vkdev->info.support_subgroup_basic() && vkdev->info.support_subgroup_shuffle();
+    opt.use_subgroup_shuffle = opt.use_subgroup_basic;
+    cmd = new VkCompute(vkdev);
+
+    std::vector<vk_specialization_type> specializations(0);
+    std::vector<uint32_t> spirv_data;
+
+    // local sizes are fixed by the 128 entry shared array, keep them out of the tuner
+    if (compile_spirv_module(Reduce_data, opt, spirv_data) == 0)
+    {
+        pipe = new Pipeline(vkdev);
+        pipe->set_local_size_xyz(16, 8, 1);
+        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        spirv_data.clear();
+    }
+    if (compile_spirv_module(Merge_data, opt, spirv_data) == 0)
+    {
+        pipe_merge = new Pipeline(vkdev);
+        pipe_merge->set_local_size_xyz(128, 1, 1);
+        pipe_merge->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        spirv_data.clear();
+    }
+    if (compile_spirv_module(Final_data, opt, spirv_data) == 0)
+    {
+        pipe_final = new Pipeline(vkdev);
+        pipe_final->set_local_size_xyz(4, 1, 1);
+        pipe_final->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        spirv_data.clear();
+    }
+
+    cmd->reset();
+}
+
+Reduce_vulkan::~Reduce_vulkan()
+{
+    if (vkdev)
+    {
+        if (pipe) { delete pipe; pipe = nullptr; }
+        if (pipe_merge) { delete pipe_merge; pipe_merge = nullptr; }
+        if (pipe_final) { delete pipe_final; pipe_final = nullptr; }
+        if (cmd) { delete cmd; cmd = nullptr; }
+        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
+        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
+    }
+}
+
+void Reduce_vulkan::run(const ImMat& src, ImMat& dst, bool arg) const
+{
+    if (src.empty())
+        return;
+    if (!vkdev)
+    {
+        if (src.device == IM_DD_CPU)
+            CPU::Reduce(src, dst, arg);
+        return;
+    }
+    if (!pipe || !pipe_merge || !pipe_final || !cmd)
+    {
+        return;
+    }
+
+    VkMat src_gpu;
+    if (src.device == IM_DD_VULKAN)
+    {
+        src_gpu = src;
+    }
+    else if (src.device == IM_DD_CPU)
+    {
+        cmd->record_clone(src, src_gpu, opt);
+    }
+
+    // tiles of 64x32 pixels to partials
+    const int groups_x = (src.w + 63) / 64;
+    const int groups_y = (src.h + 31) / 32;
+    int count = groups_x * groups_y;
+    VkMat partial;
+    partial.create(count * STAT_FLOATS, 4u, opt.blob_vkallocator);
+    {
+        std::vector<VkMat> bindings(5);
+        if      (src_gpu.type == IM_DT_INT8)     bindings[0] = src_gpu;
+        else if (src_gpu.type == IM_DT_INT16)    bindings[1] = src_gpu;
+        else if (src_gpu.type == IM_DT_FLOAT16)  bindings[2] = src_gpu;
+        else if (src_gpu.type == IM_DT_FLOAT32)  bindings[3] = src_gpu;
+        bindings[4] = partial;
+        std::vector<vk_constant_type> constants(5);
+        constants[0].i = src_gpu.w;
+        constants[1].i = src_gpu.h;
+        constants[2].i = src_gpu.c;
+        constants[3].i = src_gpu.color_format;
+        constants[4].i = src_gpu.type;
+        ImMat dispatcher(groups_x * 16, groups_y * 8, 1, (void*)0);
+        cmd->record_pipeline(pipe, bindings, std::vector<VkImageMat>(), constants, dispatcher);
+    }
+
+    // 1024 partials to one per pass, 4K needs one pass and 8K two
+    while (count > 1)
+    {
+        int merged = (count + 1023) / 1024;
+        VkMat partial_merged;
+        partial_merged.create(merged * STAT_FLOATS, 4u, opt.blob_vkallocator);
+        std::vector<VkMat> bindings(2);
+        bindings[0] = partial;
+        bindings[1] = partial_merged;
+        std::vector<vk_constant_type> constants(1);
+        constants[0].i = count;
+        ImMat dispatcher(merged * 128, 1, 1, (void*)0);
+        cmd->record_pipeline(pipe_merge, bindings, std::vector<VkImageMat>(), constants, dispatcher);
+        partial = partial_merged;
+        count = merged;
+    }
+
+    VkMat dst_gpu;
+    dst_gpu.create_type(4, arg ? 6 : 5, IM_DT_FLOAT32, opt.blob_vkallocator);
+    {
+        std::vector<VkMat> bindings(2);
+        bindings[0] = partial;
+        bindings[1] = dst_gpu;
+        std::vector<vk_constant_type> constants(2);
+        constants[0].i = src_gpu.w;
+        constants[1].i = arg ? 1 : 0;
+        ImMat dispatcher(4, 1, 1, (void*)0);
+        cmd->record_pipeline(pipe_final, bindings, std::vector<VkImageMat>(), constants, dispatcher);
+    }
+
+    // download
+    if (dst.device == IM_DD_CPU)
+        cmd->record_clone(dst_gpu, dst, opt);
+    else if (dst.device == IM_DD_VULKAN)
+        dst = dst_gpu;
+    cmd->submit_and_wait();
+    cmd->reset();
+}
+
+void Reduce_vulkan::reduce(const ImMat& src, ImMat& dst) const
+{
+    run(src, dst, false);
+}
+
+void Reduce_vulkan::reduce_arg(const ImMat& src, ImMat& dst) const
+{
+    run(src, dst, true);
+}
+} // namespace ImGui
@@ -0,0 +1,35 @@
+#pragma once
+#include "imvk_gpu.h"
+#include "imvk_pipeline.h"
+#include "immat.h"
+
+namespace ImGui
+{
+// Per channel statistics of a 4 channel frame on the device. The frame is folded into one partial per
+// 64x32 tile, partials are merged 1024 to 1 until one is left, so only the result leaves the device.
+// dst is float32, 4 columns (r, g, b, a in the 0..1 range load_rgba gives) by one row per statistic:
+//   reduce      min, max, sum, mean, variance (population)
+//   reduce_arg  min, max, argmin x, argmin y, argmax x, argmax y, ties report the first pixel in scan order
+// A dst on IM_DD_VULKAN keeps the result on the device for a following dispatch, otherwise it's 80/96 bytes
+// to download. Workgroups merge over subgroup shuffles when the device supports them.
+class VKSHADER_API Reduce_vulkan
+{
+public:
+    Reduce_vulkan(int gpu = -1);
+    ~Reduce_vulkan();
+
+    void reduce(const ImMat& src, ImMat& dst) const;
+    void reduce_arg(const ImMat& src, ImMat& dst) const;
+
+public:
+    const VulkanDevice* vkdev {nullptr};
+    Pipeline * pipe           {nullptr};
+    Pipeline * pipe_merge     {nullptr};
+    Pipeline * pipe_final     {nullptr};
+    VkCompute * cmd           {nullptr};
+    Option opt;
+
+private:
+    void run(const ImMat& src, ImMat& dst, bool arg) const;
+};
+} // namespace ImGui
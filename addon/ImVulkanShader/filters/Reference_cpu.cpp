@@ -0,0 +1,1001 @@
+#include "Reference_cpu.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ImGui
+{
+extern const ImMat * color_table[2][2][4];
+namespace CPU
+{
+static const int order_direct[4] = {0, 1, 2, 3};
+static const int order_swap[4]   = {2, 1, 0, 3};
+
+static inline float clamp01(float v)
+{
+    return std::min(std::max(v, 0.f), 1.f);
+}
+
+// channel offsets of r, g, b, a inside one pixel, as load_rgb/load_rgba pick them
+static inline const int* channel_order(const ImMat& m)
+{
+    bool direct = m.c == 3 ? m.color_format == IM_CF_BGR : m.color_format == IM_CF_ABGR;
+    return direct ? order_direct : order_swap;
+}
+
+static inline float load_value(const ImMat& m, size_t offset)
+{
+    switch (m.type)
+    {
+        case IM_DT_INT8:    return ((const uint8_t *)m.data)[offset] / 255.f;
+        case IM_DT_INT16:   return ((const uint16_t *)m.data)[offset] / 65535.f;
+        case IM_DT_FLOAT16: return im_float16_to_float32(((const unsigned short *)m.data)[offset]);
+        case IM_DT_FLOAT32: return ((const float *)m.data)[offset];
+        default:            return 0.f;
+    }
+}
+
+static inline void store_value(ImMat& m, size_t offset, float v)
+{
+    switch (m.type)
+    {
+        case IM_DT_INT8:    ((uint8_t *)m.data)[offset] = (uint8_t)std::min(std::max(floorf(v * 255.f), 0.f), 255.f); break;
+        case IM_DT_INT16:   ((uint16_t *)m.data)[offset] = (uint16_t)std::min(std::max(floorf(v * 65535.f), 0.f), 65535.f); break;
+        case IM_DT_FLOAT16: ((unsigned short *)m.data)[offset] = im_float32_to_float16(clamp01(v)); break;
+        case IM_DT_FLOAT32: ((float *)m.data)[offset] = clamp01(v); break;
+        default: break;
+    }
+}
+
+// gray is replicated to rgb, missing alpha reads as 1
+static inline void load_pixel(const ImMat& m, int x, int y, float* v)
+{
+    size_t offset = ((size_t)y * m.w + x) * m.c;
+    if (m.c < 3)
+    {
+        v[0] = v[1] = v[2] = load_value(m, offset);
+        v[3] = 1.f;
+        return;
+    }
+    const int* order = channel_order(m);
+    v[0] = load_value(m, offset + order[0]);
+    v[1] = load_value(m, offset + order[1]);
+    v[2] = load_value(m, offset + order[2]);
+    v[3] = m.c > 3 ? load_value(m, offset + order[3]) : 1.f;
+}
+
+// stores as many channels as dst has, like the shaders pick store_rgba/store_rgb/store_gray by out_cstep
+static inline void store_pixel(ImMat& m, int x, int y, const float* v)
+{
+    size_t offset = ((size_t)y * m.w + x) * m.c;
+    if (m.c < 3)
+    {
+        store_value(m, offset, v[0]);
+        return;
+    }
+    const int* order = channel_order(m);
+    store_value(m, offset + order[0], v[0]);
+    store_value(m, offset + order[1], v[1]);
+    store_value(m, offset + order[2], v[2]);
+    if (m.c > 3)
+        store_value(m, offset + order[3], v[3]);
+}
+
+static inline void load_row(const ImMat& m, int y, float* row)
+{
+    for (int x = 0; x < m.w; x++)
+        load_pixel(m, x, y, row + x * 4);
+}
+
+static inline void store_row(ImMat& m, int y, const float* row)
+{
+    for (int x = 0; x < m.w; x++)
+        store_pixel(m, x, y, row + x * 4);
+}
+
+// rows are converted to float rgba, op works on a whole row so the compiler can vectorize it
+template <typename Op>
+static void point_filter(const ImMat& src, ImMat& dst, Op op)
+{
+    dst.create_type(src.w, src.h, 4, dst.type);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src.h; y++)
+    {
+        std::vector<float> row((size_t)src.w * 4);
+        load_row(src, y, row.data());
+        op(row.data(), src.w);
+        store_row(dst, y, row.data());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// color convert
+///////////////////////////////////////////////////////////////////////////////
+void Conv(const ImMat& src, ImMat& dst)
+{
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < dst.h; y++)
+    {
+        float v[4];
+        for (int x = 0; x < dst.w; x++)
+        {
+            load_pixel(src, x, y, v);
+            store_pixel(dst, x, y, v);
+        }
+    }
+}
+
+void GRAY2RGBA(const ImMat& src, ImMat& dst, float in_scale)
+{
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < dst.h; y++)
+    {
+        float v[4];
+        for (int x = 0; x < dst.w; x++)
+        {
+            size_t offset = (size_t)y * src.w + x;
+            float gray = src.type == IM_DT_INT8  ? ((const uint8_t *)src.data)[offset] / in_scale :
+                         src.type == IM_DT_INT16 ? ((const uint16_t *)src.data)[offset] / in_scale :
+                         load_value(src, offset);
+            v[0] = v[1] = v[2] = gray;
+            v[3] = 1.f;
+            store_pixel(dst, x, y, v);
+        }
+    }
+}
+
+struct YUVSource
+{
+    const ImMat& src;
+    ImColorFormat format;
+    float scale;
+    int sw, sh;
+
+    YUVSource(const ImMat& m, ImColorFormat f, float s) : src(m), format(f), scale(s)
+    {
+        sw = format == IM_CF_YUV420 || format == IM_CF_YUV422 ? 2 : 1;
+        sh = format == IM_CF_YUV420 || format == IM_CF_NV12 || format == IM_CF_P010LE ? 2 : 1;
+    }
+
+    inline float value(size_t offset, bool p010) const
+    {
+        if (src.type == IM_DT_INT8)
+            return ((const uint8_t *)src.data)[offset] / scale;
+        else if (src.type == IM_DT_INT16)
+            return ((const uint16_t *)src.data)[offset] / (p010 ? 65535.f : scale);
+        return load_value(src, offset);
+    }
+
+    // same plane layout as load_src_yuv in ColorConvert_shader.h
+    inline void load(int x, int y, float* yuv) const
+    {
+        size_t w = src.w, h = src.h;
+        size_t y_offset = (size_t)y * w + x;
+        size_t u_offset = w * h + (y / sh) * w / sw + x / sw;
+        size_t v_offset = (format == IM_CF_YUV444 ? w * h * 2 : w * h + (w / sw) * (h / sh)) + (y / sh) * w / sw + x / sw;
+        size_t uv_offset = w * h + ((y / 2) * w / 2 + x / 2) * 2;
+        bool p010 = format == IM_CF_P010LE;
+        bool semi_planar = format == IM_CF_NV12 || (p010 && src.type == IM_DT_INT16);
+        yuv[0] = value(y_offset, p010);
+        yuv[1] = value(semi_planar ? uv_offset : u_offset, p010);
+        yuv[2] = value(semi_planar ? uv_offset + 1 : v_offset, p010);
+    }
+};
+
+static inline void mat3_mul(const float* m, const float* v, float* out)
+{
+    out[0] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2];
+    out[1] = m[3] * v[0] + m[4] * v[1] + m[5] * v[2];
+    out[2] = m[6] * v[0] + m[7] * v[1] + m[8] * v[2];
+}
+
+static inline void cubic_weights(float f, float* w)
+{
+    const float A = -0.75f;
+    w[0] = ((A * (f + 1.f) - 5.f * A) * (f + 1.f) + 8.f * A) * (f + 1.f) - 4.f * A;
+    w[1] = ((A + 2.f) * f - (A + 3.f)) * f * f + 1.f;
+    w[2] = ((A + 2.f) * (1.f - f) - (A + 3.f)) * (1.f - f) * (1.f - f) + 1.f;
+    w[3] = 1.f - w[0] - w[1] - w[2];
+}
+
+// resize sampling of the yuv2rgb shader, kept as is so both paths agree
+static void yuv_interplate(const YUVSource& s, int x, int y, int out_w, int out_h, ImInterpolateMode type, float* yuv)
+{
+    const int w = s.src.w, h = s.src.h;
+    float t[3];
+    yuv[0] = yuv[1] = yuv[2] = 0.f;
+    if (type == IM_INTERPOLATE_BILINEAR)
+    {
+        float srcx = x / ((float)out_w / w);
+        float srcy = y / ((float)out_h / h);
+        int _x = (int)floorf(srcx), _y = (int)floorf(srcy);
+        float u = srcx - _x, v = srcy - _y;
+        if (u < 0.f) { _x = 0; u = 0.f; }
+        if (_x >= w - 1) { _x = w - 2; u = 1.f; }
+        if (v < 0.f) { _y = 0; v = 0.f; }
+        if (_y >= h - 1) { _y = h - 2; v = 1.f; }
+        const float wt[4] = { (1.f - u) * (1.f - v), (1.f - u) * v, u * (1.f - v), u * v };
+        const int px[4] = { _x, _x, _x + 1, _x + 1 };
+        const int py[4] = { _y, _y + 1, _y, _y + 1 };
+        for (int i = 0; i < 4; i++)
+        {
+            s.load(px[i], py[i], t);
+            for (int c = 0; c < 3; c++) yuv[c] += t[c] * wt[i];
+        }
+    }
+    else if (type == IM_INTERPOLATE_BICUBIC)
+    {
+        float scale_x = (float)w / out_w, scale_y = (float)h / out_h;
+        float fx = (x + 0.5f) * scale_x - 0.5f;
+        int sx = (int)floorf(fx);
+        fx -= sx;
+        if (sx < 1) { fx = 0.f; sx = 1; }
+        if (sx >= w - 3) { fx = 0.f; sx = w - 3; }
+        float fy = (y + 0.5f) * scale_y - 0.5f;
+        int sy = (int)floorf(fy);
+        fy -= sy;
+        sy = std::max(1, std::min(sy, h - 3));
+        float wx[4], wy[4];
+        cubic_weights(fx, wx);
+        cubic_weights(fy, wy);
+        for (int j = 0; j < 4; j++)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                s.load(sx - 1 + i, sy - 1 + j, t);
+                for (int c = 0; c < 3; c++) yuv[c] += t[c] * wx[i] * wy[j];
+            }
+        }
+    }
+    else if (type == IM_INTERPOLATE_AREA)
+    {
+        float scale_x = (float)w / out_w, scale_y = (float)h / out_h;
+        if (scale_x > 2.f && scale_y > 2.f)
+        {
+            int sx1 = std::max((int)floorf(x * scale_x), 0), sx2 = std::min((int)ceilf(x * scale_x + scale_x), w - 1);
+            int sy1 = std::max((int)floorf(y * scale_y), 0), sy2 = std::min((int)ceilf(y * scale_y + scale_y), h - 1);
+            for (int j = sy1; j < sy2; j++)
+            {
+                for (int i = sx1; i < sx2; i++)
+                {
+                    s.load(i, j, t);
+                    for (int c = 0; c < 3; c++) yuv[c] += t[c];
+                }
+            }
+            float area = (float)((sx2 - sx1) * (sy2 - sy1));
+            for (int c = 0; c < 3; c++) yuv[c] /= area;
+        }
+        else
+        {
+            int sx = (int)floorf(x * scale_x);
+            float fx = (x + 1) - (sx + 1) / scale_x;
+            fx = fx < 0.f ? 0.f : fx - floorf(fx);
+            if (sx < 0) { fx = 0.f; sx = 0; }
+            if (sx >= w - 1) { fx = 0.f; sx = w - 2; }
+            int sy = (int)floorf(y * scale_y);
+            float fy = (y + 1) - (sy + 1) / scale_y;
+            fy = fy <= 0.f ? 0.f : fy - floorf(fy);
+            sy = std::min(sy, h - 2);
+            const float wt[4] = { (1.f - fx) * (1.f - fy), (1.f - fx) * fy, fx * (1.f - fy), fx * fy };
+            const int px[4] = { sx, sx, sx + 1, sx + 1 };
+            const int py[4] = { sy, sy + 1, sy, sy + 1 };
+            for (int i = 0; i < 4; i++)
+            {
+                s.load(px[i], py[i], t);
+                for (int c = 0; c < 3; c++) yuv[c] += t[c] * wt[i];
+            }
+        }
+    }
+    else
+    {
+        int srcx = std::min((int)floorf(x / ((float)out_w / w)), w - 1);
+        int srcy = std::min((int)floorf(y / ((float)out_h / h)), h - 1);
+        s.load(srcx, srcy, yuv);
+    }
+}
+
+void YUV2RGBA(const ImMat& src, ImMat& dst, ImColorFormat in_format, ImColorSpace in_space, ImColorRange in_range, float in_scale, ImInterpolateMode type)
+{
+    const float* matrix = (const float *)color_table[0][in_range][in_space]->data;
+    const float offset[3] = { in_range == IM_CR_NARROW_RANGE ? 16.f / 255.f : 0.f, 0.5f, 0.5f };
+    bool resize = dst.w != src.w || dst.h != src.h;
+    YUVSource source(src, in_format, in_scale);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < dst.h; y++)
+    {
+        float yuv[3], rgba[4];
+        for (int x = 0; x < dst.w; x++)
+        {
+            if (resize)
+                yuv_interplate(source, x, y, dst.w, dst.h, type, yuv);
+            else
+                source.load(x, y, yuv);
+            for (int c = 0; c < 3; c++) yuv[c] -= offset[c];
+            mat3_mul(matrix, yuv, rgba);
+            for (int c = 0; c < 3; c++) rgba[c] = clamp01(rgba[c]);
+            rgba[3] = 1.f;
+            store_pixel(dst, x, y, rgba);
+        }
+    }
+}
+
+static inline void store_yuv_value(ImMat& dst, size_t offset, float v, float out_scale, bool p010)
+{
+    if (dst.type == IM_DT_INT16 && p010)
+        ((uint16_t *)dst.data)[offset] = (uint16_t)((uint32_t)floorf(v * 255.f) | (uint32_t)floorf(v * 65535.f));
+    else if (dst.type == IM_DT_INT16)
+        ((uint16_t *)dst.data)[offset] = (uint16_t)std::min(std::max(floorf(v * out_scale), 0.f), out_scale);
+    else
+        store_value(dst, offset, v);
+}
+
+void RGBA2YUV(const ImMat& src, ImMat& dst, float out_scale)
+{
+    const ImColorFormat format = dst.color_format;
+    const float* matrix = (const float *)color_table[1][dst.color_range][dst.color_space]->data;
+    const float offset[3] = { dst.color_range == IM_CR_NARROW_RANGE ? 16.f / 255.f : 0.f, 0.5f, 0.5f };
+    const int sw = format == IM_CF_YUV420 || format == IM_CF_YUV422 ? 2 : 1;
+    const int sh = format == IM_CF_YUV420 || format == IM_CF_NV12 ? 2 : 1;
+    const size_t w = src.w, h = src.h, plane = dst.cstep;
+    const bool p010 = format == IM_CF_P010LE;
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src.h; y++)
+    {
+        float rgba[4], yuv[3];
+        for (int x = 0; x < src.w; x++)
+        {
+            load_pixel(src, x, y, rgba);
+            mat3_mul(matrix, rgba, yuv);
+            for (int c = 0; c < 3; c++) yuv[c] = clamp01(yuv[c] + offset[c]);
+            size_t y_offset = (size_t)y * w + x;
+            size_t u_offset = plane + (y / sh) * w / sw + x / sw;
+            size_t v_offset = (format == IM_CF_YUV444 ? plane * 2 : plane + (w / sw) * (h / sh)) + (y / sh) * w / sw + x / sw;
+            size_t uv_offset = plane + ((y / 2) * w / 2 + x / 2) * 2;
+            bool semi_planar = format == IM_CF_NV12 || (p010 && dst.type == IM_DT_INT16);
+            store_yuv_value(dst, y_offset, yuv[0], out_scale, p010);
+            store_yuv_value(dst, semi_planar ? uv_offset : u_offset, yuv[1], out_scale, p010);
+            store_yuv_value(dst, semi_planar ? uv_offset + 1 : v_offset, yuv[2], out_scale, p010);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// geometry
+///////////////////////////////////////////////////////////////////////////////
+struct CropSource
+{
+    const ImMat& src;
+    int x0, y0, w, h;
+
+    inline void load(int x, int y, float* v) const
+    {
+        x = std::max(0, std::min(x, w - 1));
+        y = std::max(0, std::min(y, h - 1));
+        load_pixel(src, x0 + x, y0 + y, v);
+    }
+};
+
+static void interplate_nearest(const CropSource& s, float px, float py, float* v)
+{
+    s.load((int)floorf(px), (int)floorf(py), v);
+}
+
+static void interplate_bilinear(const CropSource& s, float px, float py, float* v)
+{
+    float cx = px - 0.5f, cy = py - 0.5f;
+    int ix = (int)floorf(cx), iy = (int)floorf(cy);
+    float fx = cx - ix, fy = cy - iy;
+    float v00[4], v10[4], v01[4], v11[4];
+    s.load(ix, iy, v00);
+    s.load(ix + 1, iy, v10);
+    s.load(ix, iy + 1, v01);
+    s.load(ix + 1, iy + 1, v11);
+    for (int c = 0; c < 4; c++)
+    {
+        float top = v00[c] + (v10[c] - v00[c]) * fx;
+        float bottom = v01[c] + (v11[c] - v01[c]) * fx;
+        v[c] = top + (bottom - top) * fy;
+    }
+}
+
+static void interplate_bicubic(const CropSource& s, float px, float py, float* v)
+{
+    float cx = px - 0.5f, cy = py - 0.5f;
+    int ix = (int)floorf(cx), iy = (int)floorf(cy);
+    float wx[4], wy[4], t[4];
+    cubic_weights(cx - ix, wx);
+    cubic_weights(cy - iy, wy);
+    v[0] = v[1] = v[2] = v[3] = 0.f;
+    for (int j = 0; j < 4; j++)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            s.load(ix - 1 + i, iy - 1 + j, t);
+            for (int c = 0; c < 4; c++) v[c] += t[c] * wx[i] * wy[j];
+        }
+    }
+}
+
+static void interplate_area(const CropSource& s, float px, float py, float scale_x, float scale_y, float* v)
+{
+    float bx0 = std::max(px - scale_x * 0.5f, 0.f), bx1 = std::min(px + scale_x * 0.5f, (float)s.w);
+    float by0 = std::max(py - scale_y * 0.5f, 0.f), by1 = std::min(py + scale_y * 0.5f, (float)s.h);
+    int sx1 = (int)floorf(bx0), sx2 = (int)ceilf(bx1);
+    int sy1 = (int)floorf(by0), sy2 = (int)ceilf(by1);
+    float sum[4] = {0.f, 0.f, 0.f, 0.f}, t[4];
+    float area = 0.f;
+    for (int j = sy1; j < sy2; j++)
+    {
+        float dy = std::min((float)(j + 1), by1) - std::max((float)j, by0);
+        for (int i = sx1; i < sx2; i++)
+        {
+            float dx = std::min((float)(i + 1), bx1) - std::max((float)i, bx0);
+            s.load(i, j, t);
+            for (int c = 0; c < 4; c++) sum[c] += t[c] * dx * dy;
+            area += dx * dy;
+        }
+    }
+    if (area > 0.f)
+        for (int c = 0; c < 4; c++) v[c] = sum[c] / area;
+    else
+        interplate_nearest(s, px, py, v);
+}
+
+void Transform(const ImMat& src, ImMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                bool flip_x, bool flip_y, bool transpose, int out_w, int out_h, ImInterpolateMode type)
+{
+    auto color_format = dst.color_format;
+    int channels = IM_ISALPHA(color_format) ? 4 : IM_ISRGB(color_format) ? 3 : IM_ISMONO(color_format) ? 1 : 4;
+    dst.create_type(out_w, out_h, channels, dst.type);
+    dst.color_format = color_format;
+
+    CropSource s = { src, crop_x, crop_y, crop_w, crop_h };
+    int tw = transpose ? crop_h : crop_w;
+    int th = transpose ? crop_w : crop_h;
+    float scale_x = (float)tw / out_w, scale_y = (float)th / out_h;
+    if (transpose) std::swap(scale_x, scale_y);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < out_h; y++)
+    {
+        float v[4];
+        for (int x = 0; x < out_w; x++)
+        {
+            // geometry_coord in Geometry_shader.h
+            float px = (x + 0.5f) * ((float)tw / out_w);
+            float py = (y + 0.5f) * ((float)th / out_h);
+            if (transpose) std::swap(px, py);
+            if (flip_x) px = crop_w - px;
+            if (flip_y) py = crop_h - py;
+            if (type == IM_INTERPOLATE_BILINEAR)
+                interplate_bilinear(s, px, py, v);
+            else if (type == IM_INTERPOLATE_BICUBIC)
+                interplate_bicubic(s, px, py, v);
+            else if (type == IM_INTERPOLATE_AREA || type == IM_INTERPOLATE_PYRAMID)
+                interplate_area(s, px, py, scale_x, scale_y, v);
+            else
+                interplate_nearest(s, px, py, v);
+            store_pixel(dst, x, y, v);
+        }
+    }
+}
+
+static inline float lanczos3_weight(float x)
+{
+    x = fabsf(x);
+    if (x < 1e-5f)
+        return 1.f;
+    if (x >= 3.f)
+        return 0.f;
+    float px = 3.14159265f * x;
+    return 3.f * sinf(px) * sinf(px / 3.f) / (px * px);
+}
+
+// normalized taps of one output position, same window as lanczos3 in Resize_shader.h
+static void lanczos3_taps(int in_size, int out_size, int pos, int& start, std::vector<float>& taps)
+{
+    float scale = (float)in_size / out_size;
+    float support = 3.f * std::max(scale, 1.f);
+    float inv_filter_scale = 1.f / std::max(scale, 1.f);
+    float center = (pos + 0.5f) * scale;
+    start = std::max((int)floorf(center - support), 0);
+    int end = std::min((int)ceilf(center + support), in_size);
+    taps.resize(std::max(end - start, 0));
+    float weight = 0.f;
+    for (int i = start; i < end; i++)
+    {
+        taps[i - start] = lanczos3_weight((i + 0.5f - center) * inv_filter_scale);
+        weight += taps[i - start];
+    }
+    for (auto& t : taps) t /= weight;
+}
+
+void ResizeLanczos(const ImMat& src, ImMat& dst, int out_w, int out_h)
+{
+    auto color_format = dst.color_format;
+    int channels = IM_ISALPHA(color_format) ? 4 : IM_ISRGB(color_format) ? 3 : IM_ISMONO(color_format) ? 1 : 4;
+    dst.create_type(out_w, out_h, channels, dst.type);
+    dst.color_format = color_format;
+
+    // horizontal pass into a float rgba image, clamped like the fp16 intermediate of the shader path
+    std::vector<float> tmp((size_t)out_w * src.h * 4);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src.h; y++)
+    {
+        std::vector<float> row((size_t)src.w * 4), taps;
+        load_row(src, y, row.data());
+        float* out = tmp.data() + (size_t)y * out_w * 4;
+        for (int x = 0; x < out_w; x++)
+        {
+            int start;
+            lanczos3_taps(src.w, out_w, x, start, taps);
+            float sum[4] = {0.f, 0.f, 0.f, 0.f};
+            for (size_t k = 0; k < taps.size(); k++)
+                for (int c = 0; c < 4; c++) sum[c] += row[(start + k) * 4 + c] * taps[k];
+            for (int c = 0; c < 4; c++) out[x * 4 + c] = clamp01(sum[c]);
+        }
+    }
+
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < out_h; y++)
+    {
+        std::vector<float> row((size_t)out_w * 4, 0.f), taps;
+        int start;
+        lanczos3_taps(src.h, out_h, y, start, taps);
+        for (size_t k = 0; k < taps.size(); k++)
+        {
+            const float* in = tmp.data() + (start + k) * out_w * 4;
+            const float t = taps[k];
+            for (int i = 0; i < out_w * 4; i++) row[i] += in[i] * t;
+        }
+        for (int x = 0; x < out_w; x++)
+            store_pixel(dst, x, y, row.data() + x * 4);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// separable filter
+///////////////////////////////////////////////////////////////////////////////
+// one pass of Filter2DS_shader.h, replicate border, alpha set to 1, out is created by caller
+static void separable_pass(const ImMat& src, ImMat& out, const float* kernel, int ksize, int anchor, bool vertical)
+{
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src.h; y++)
+    {
+        std::vector<float> row((size_t)src.w * 4, 0.f), line((size_t)src.w * 4);
+        if (vertical)
+        {
+            for (int k = 0; k < ksize; k++)
+            {
+                int yy = std::max(0, std::min(y - anchor + k, src.h - 1));
+                load_row(src, yy, line.data());
+                const float t = kernel[k];
+                for (int i = 0; i < src.w * 4; i++) row[i] += line[i] * t;
+            }
+        }
+        else
+        {
+            load_row(src, y, line.data());
+            for (int x = 0; x < src.w; x++)
+            {
+                for (int k = 0; k < ksize; k++)
+                {
+                    int xx = std::max(0, std::min(x - anchor + k, src.w - 1));
+                    const float t = kernel[k];
+                    for (int c = 0; c < 3; c++) row[x * 4 + c] += line[xx * 4 + c] * t;
+                }
+            }
+        }
+        for (int x = 0; x < src.w; x++)
+            row[x * 4 + 3] = 1.f;
+        store_row(out, y, row.data());
+    }
+}
+
+void Filter2DS(const ImMat& src, ImMat& dst, const ImMat& kernel, int xksize, int yksize, int xanchor, int yanchor)
+{
+    // the shader path keeps the column result in the intermediate type, so does this one
+    ImMat column;
+    column.create_type(src.w, src.h, 4, intermediate_type(IM_PRECISION_FP16_STORAGE));
+    separable_pass(src, column, (const float *)kernel.data, yksize, yanchor, true);
+    dst.create_type(src.w, src.h, 4, dst.type);
+    separable_pass(column, dst, (const float *)kernel.data, xksize, xanchor, false);
+}
+
+void USM(const ImMat& src, ImMat& dst, const ImMat& kernel, int ksize, int anchor, float amount, float threshold)
+{
+    ImMat column, blur;
+    column.create_type(src.w, src.h, 4, intermediate_type(IM_PRECISION_FP16_STORAGE));
+    blur.create_type(src.w, src.h, 4, intermediate_type(IM_PRECISION_FP16_STORAGE));
+    separable_pass(src, column, (const float *)kernel.data, ksize, anchor, true);
+    separable_pass(column, blur, (const float *)kernel.data, ksize, anchor, false);
+    dst.create_type(src.w, src.h, 4, dst.type);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src.h; y++)
+    {
+        std::vector<float> row((size_t)src.w * 4), blur_row((size_t)src.w * 4);
+        load_row(src, y, row.data());
+        load_row(blur, y, blur_row.data());
+        for (int x = 0; x < src.w; x++)
+        {
+            float* v = row.data() + x * 4;
+            const float* b = blur_row.data() + x * 4;
+            for (int c = 0; c < 3; c++)
+            {
+                if (fabsf(v[c] - b[c]) <= threshold)
+                    v[c] = clamp01(v[c] * amount + b[c] * (1.f - amount));
+            }
+            v[3] = 1.f;
+        }
+        store_row(dst, y, row.data());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// color adjust
+///////////////////////////////////////////////////////////////////////////////
+void Brightness(const ImMat& src, ImMat& dst, float brightness)
+{
+    point_filter(src, dst, [brightness](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            v[0] = clamp01(v[0] + brightness);
+            v[1] = clamp01(v[1] + brightness);
+            v[2] = clamp01(v[2] + brightness);
+            v[3] = 1.f;
+        }
+    });
+}
+
+void Contrast(const ImMat& src, ImMat& dst, float contrast)
+{
+    point_filter(src, dst, [contrast](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            v[0] = clamp01((v[0] - 0.5f) * contrast + 0.5f);
+            v[1] = clamp01((v[1] - 0.5f) * contrast + 0.5f);
+            v[2] = clamp01((v[2] - 0.5f) * contrast + 0.5f);
+            v[3] = 1.f;
+        }
+    });
+}
+
+void Gamma(const ImMat& src, ImMat& dst, float gamma)
+{
+    point_filter(src, dst, [gamma](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            v[0] = clamp01(powf(v[0], gamma));
+            v[1] = clamp01(powf(v[1], gamma));
+            v[2] = clamp01(powf(v[2], gamma));
+            v[3] = 1.f;
+        }
+    });
+}
+
+void Saturation(const ImMat& src, ImMat& dst, float saturation)
+{
+    point_filter(src, dst, [saturation](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            float luminance = v[0] * 0.2125f + v[1] * 0.7154f + v[2] * 0.0721f;
+            v[0] = clamp01(luminance + (v[0] - luminance) * saturation);
+            v[1] = clamp01(luminance + (v[1] - luminance) * saturation);
+            v[2] = clamp01(luminance + (v[2] - luminance) * saturation);
+            v[3] = 1.f;
+        }
+    });
+}
+
+void Hue(const ImMat& src, ImMat& dst, float hue)
+{
+    point_filter(src, dst, [hue](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            float Y = v[0] * 0.299f    + v[1] *  0.587f    + v[2] *  0.114f;
+            float I = v[0] * 0.595716f + v[1] * -0.274453f + v[2] * -0.321263f;
+            float Q = v[0] * 0.211456f + v[1] * -0.522591f + v[2] *  0.31135f;
+            float angle = atan2f(Q, I) - hue;
+            float chroma = sqrtf(I * I + Q * Q);
+            Q = chroma * sinf(angle);
+            I = chroma * cosf(angle);
+            v[0] = clamp01(Y + I *  0.9563f + Q *  0.6210f);
+            v[1] = clamp01(Y + I * -0.2721f + Q * -0.6474f);
+            v[2] = clamp01(Y + I * -1.1070f + Q *  1.7046f);
+            v[3] = 1.f;
+        }
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// blend
+///////////////////////////////////////////////////////////////////////////////
+// src1 is placed at (x, y) over src2, dst has the size of src2
+template <typename Op>
+static void blend_filter(const ImMat& src1, const ImMat& src2, ImMat& dst, int x_offset, int y_offset, Op op)
+{
+    dst.create_type(src2.w, src2.h, 4, dst.type);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < src2.h; y++)
+    {
+        std::vector<float> row((size_t)src2.w * 4);
+        load_row(src2, y, row.data());
+        int sy = y - y_offset;
+        if (sy >= 0 && sy < src1.h)
+        {
+            int x0 = std::max(x_offset, 0), x1 = std::min(x_offset + src1.w, src2.w);
+            float top[4];
+            for (int x = x0; x < x1; x++)
+            {
+                load_pixel(src1, x - x_offset, sy, top);
+                op(row.data() + x * 4, top);
+            }
+        }
+        store_row(dst, y, row.data());
+    }
+}
+
+void AlphaBlend(const ImMat& src1, const ImMat& src2, ImMat& dst, int x, int y)
+{
+    blend_filter(src1, src2, dst, x, y, [](float* v, const float* top)
+    {
+        for (int c = 0; c < 3; c++) v[c] += (top[c] - v[c]) * top[3];
+    });
+}
+
+void AlphaBlend(const ImMat& src1, const ImMat& src2, ImMat& dst, float alpha, int x, int y)
+{
+    blend_filter(src1, src2, dst, x, y, [alpha](float* v, const float* top)
+    {
+        for (int c = 0; c < 3; c++) v[c] += (top[c] * top[3] - v[c]) * alpha;
+    });
+}
+
+static inline float blend_mode(int mode, float b, float s)
+{
+    switch (mode)
+    {
+        case IM_BLEND_ADD:          return std::min(b + s, 1.f);
+        case IM_BLEND_MULTIPLY:     return b * s;
+        case IM_BLEND_SCREEN:       return b + s - b * s;
+        case IM_BLEND_OVERLAY:      return b < 0.5f ? 2.f * b * s : 1.f - 2.f * (1.f - b) * (1.f - s);
+        case IM_BLEND_DARKEN:       return std::min(b, s);
+        case IM_BLEND_LIGHTEN:      return std::max(b, s);
+        case IM_BLEND_DIFFERENCE:   return fabsf(b - s);
+        default:                    return s;
+    }
+}
+
+// bilinear inside the scaled layer, edge clamped, alpha 0 outside
+static inline void load_layer(const ImBlendLayer& layer, int x, int y, float* v)
+{
+    const ImMat& m = layer.mat;
+    float px = (x - layer.x + 0.5f) / layer.scale_x;
+    float py = (y - layer.y + 0.5f) / layer.scale_y;
+    if (px < 0.f || py < 0.f || px >= m.w || py >= m.h)
+    {
+        v[0] = v[1] = v[2] = v[3] = 0.f;
+        return;
+    }
+    if (layer.scale_x == 1.f && layer.scale_y == 1.f)
+    {
+        load_pixel(m, x - layer.x, y - layer.y, v);
+        return;
+    }
+    float cx = px - 0.5f, cy = py - 0.5f;
+    int ix = (int)floorf(cx), iy = (int)floorf(cy);
+    float fx = cx - ix, fy = cy - iy;
+    int x0 = std::min(std::max(ix, 0), m.w - 1), x1 = std::min(std::max(ix + 1, 0), m.w - 1);
+    int y0 = std::min(std::max(iy, 0), m.h - 1), y1 = std::min(std::max(iy + 1, 0), m.h - 1);
+    float v00[4], v10[4], v01[4], v11[4];
+    load_pixel(m, x0, y0, v00);
+    load_pixel(m, x1, y0, v10);
+    load_pixel(m, x0, y1, v01);
+    load_pixel(m, x1, y1, v11);
+    for (int c = 0; c < 4; c++)
+    {
+        float top = v00[c] + (v10[c] - v00[c]) * fx;
+        float bottom = v01[c] + (v11[c] - v01[c]) * fx;
+        v[c] = top + (bottom - top) * fy;
+    }
+}
+
+void Composite(const std::vector<ImBlendLayer>& layers, ImMat& dst, int width, int height)
+{
+    dst.create_type(width, height, 4, dst.type);
+    #pragma omp parallel for num_threads(OMP_THREADS)
+    for (int y = 0; y < height; y++)
+    {
+        std::vector<float> row((size_t)width * 4, 0.f);
+        for (auto& layer : layers)
+        {
+            if (layer.mat.empty() || layer.scale_x <= 0.f || layer.scale_y <= 0.f)
+                continue;
+            if (y < layer.y || y >= layer.y + (int)ceilf(layer.mat.h * layer.scale_y))
+                continue;
+            int x0 = std::max(layer.x, 0);
+            int x1 = std::min(layer.x + (int)ceilf(layer.mat.w * layer.scale_x), width);
+            float top[4];
+            for (int x = x0; x < x1; x++)
+            {
+                float* v = row.data() + x * 4;
+                load_layer(layer, x, y, top);
+                float a = top[3] * layer.opacity;
+                for (int c = 0; c < 3; c++) v[c] += (blend_mode(layer.mode, v[c], top[c]) - v[c]) * a;
+                v[3] += a * (1.f - v[3]);
+            }
+        }
+        store_row(dst, y, row.data());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// lut3d
+///////////////////////////////////////////////////////////////////////////////
+struct LutTable
+{
+    const float* lut;
+    int size;
+    inline const float* fetch(int r, int g, int b) const { return lut + (((size_t)r * size + g) * size + b) * 4; }
+};
+
+// interp_trilinear and interp_tetrahedral of Lut3D_Shader.h
+static void lut_trilinear(const LutTable& t, const int* prev, const int* next, const float* d, float* out)
+{
+    const float* c000 = t.fetch(prev[0], prev[1], prev[2]);
+    const float* c001 = t.fetch(prev[0], prev[1], next[2]);
+    const float* c010 = t.fetch(prev[0], next[1], prev[2]);
+    const float* c011 = t.fetch(prev[0], next[1], next[2]);
+    const float* c100 = t.fetch(next[0], prev[1], prev[2]);
+    const float* c101 = t.fetch(next[0], prev[1], next[2]);
+    const float* c110 = t.fetch(next[0], next[1], prev[2]);
+    const float* c111 = t.fetch(next[0], next[1], next[2]);
+    for (int c = 0; c < 3; c++)
+    {
+        float c00 = c000[c] + (c100[c] - c000[c]) * d[0];
+        float c10 = c010[c] + (c110[c] - c010[c]) * d[0];
+        float c01 = c001[c] + (c101[c] - c001[c]) * d[0];
+        float c11 = c011[c] + (c111[c] - c011[c]) * d[0];
+        float c0 = c00 + (c10 - c00) * d[1];
+        float c1 = c01 + (c11 - c01) * d[1];
+        out[c] = c0 + (c1 - c0) * d[2];
+    }
+}
+
+static void lut_tetrahedral(const LutTable& t, const int* prev, const int* next, const float* d, float* out)
+{
+    const float dr = d[0], dg = d[1], db = d[2];
+    const float* c0 = t.fetch(prev[0], prev[1], prev[2]);
+    const float* c3 = t.fetch(next[0], next[1], next[2]);
+    const float *c1, *c2;
+    float w0, w1, w2, w3;
+    if (dr > dg)
+    {
+        if (dg > db)
+        {
+            c1 = t.fetch(next[0], prev[1], prev[2]); c2 = t.fetch(next[0], next[1], prev[2]);
+            w0 = 1.f - dr; w1 = dr - dg; w2 = dg - db; w3 = db;
+        }
+        else if (dr > db)
+        {
+            c1 = t.fetch(next[0], prev[1], prev[2]); c2 = t.fetch(next[0], prev[1], next[2]);
+            w0 = 1.f - dr; w1 = dr - db; w2 = db - dg; w3 = dg;
+        }
+        else
+        {
+            c1 = t.fetch(prev[0], prev[1], next[2]); c2 = t.fetch(next[0], prev[1], next[2]);
+            w0 = 1.f - db; w1 = db - dr; w2 = dr - dg; w3 = dg;
+        }
+    }
+    else
+    {
+        if (db > dg)
+        {
+            c1 = t.fetch(prev[0], prev[1], next[2]); c2 = t.fetch(prev[0], next[1], next[2]);
+            w0 = 1.f - db; w1 = db - dg; w2 = dg - dr; w3 = dr;
+        }
+        else if (db > dr)
+        {
+            c1 = t.fetch(prev[0], next[1], prev[2]); c2 = t.fetch(prev[0], next[1], next[2]);
+            w0 = 1.f - dg; w1 = dg - db; w2 = db - dr; w3 = dr;
+        }
+        else
+        {
+            c1 = t.fetch(prev[0], next[1], prev[2]); c2 = t.fetch(next[0], next[1], prev[2]);
+            w0 = 1.f - dg; w1 = dg - dr; w2 = dr - db; w3 = db;
+        }
+    }
+    for (int c = 0; c < 3; c++)
+        out[c] = w0 * c0[c] + w1 * c1[c] + w2 * c2[c] + w3 * c3[c];
+}
+
+void Lut3D(const ImMat& src, ImMat& dst, const float* lut, int lutsize, int interpolation)
+{
+    LutTable table = { lut, lutsize };
+    point_filter(src, dst, [&table, lutsize, interpolation](float* row, int w)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            float* v = row + x * 4;
+            float s[3], out[3];
+            for (int c = 0; c < 3; c++) s[c] = clamp01(v[c]) * (lutsize - 1);
+            if (interpolation == IM_INTERPOLATE_NEAREST)
+            {
+                const float* e = table.fetch((int)(s[0] + .5f), (int)(s[1] + .5f), (int)(s[2] + .5f));
+                out[0] = e[0]; out[1] = e[1]; out[2] = e[2];
+            }
+            else if (interpolation == IM_INTERPOLATE_TRILINEAR || interpolation == IM_INTERPOLATE_TETRAHEDRAL)
+            {
+                const int prev[3] = { (int)s[0], (int)s[1], (int)s[2] };
+                const int next[3] = { std::min(prev[0] + 1, lutsize - 1), std::min(prev[1] + 1, lutsize - 1), std::min(prev[2] + 1, lutsize - 1) };
+                const float d[3] = { s[0] - prev[0], s[1] - prev[1], s[2] - prev[2] };
+                if (interpolation == IM_INTERPOLATE_TRILINEAR)
+                    lut_trilinear(table, prev, next, d, out);
+                else
+                    lut_tetrahedral(table, prev, next, d, out);
+            }
+            else
+            {
+                out[0] = clamp01(v[0]); out[1] = clamp01(v[1]); out[2] = clamp01(v[2]);
+            }
+            v[0] = out[0]; v[1] = out[1]; v[2] = out[2];
+            v[3] = 1.f;
+        }
+    });
+}
+
+void Reduce(const ImMat& src, ImMat& dst, bool arg)
+{
+    double mn[4], mx[4], sum[4] = {0, 0, 0, 0}, sum2[4] = {0, 0, 0, 0};
+    int amin[4] = {0, 0, 0, 0}, amax[4] = {0, 0, 0, 0};
+    std::fill(mn, mn + 4, 3.4e38);
+    std::fill(mx, mx + 4, -3.4e38);
+    std::vector<float> row(src.w * 4);
+    for (int y = 0; y < src.h; y++)
+    {
+        load_row(src, y, row.data());
+        for (int x = 0; x < src.w; x++)
+        {
+            const float* v = row.data() + x * 4;
+            for (int c = 0; c < 4; c++)
+            {
+                if (v[c] < mn[c]) { mn[c] = v[c]; amin[c] = y * src.w + x; }
+                if (v[c] > mx[c]) { mx[c] = v[c]; amax[c] = y * src.w + x; }
+                sum[c] += v[c];
+                sum2[c] += (double)v[c] * v[c];
+            }
+        }
+    }
+    const double n = (double)src.w * src.h;
+    dst.create_type(4, arg ? 6 : 5, IM_DT_FLOAT32);
+    for (int c = 0; c < 4; c++)
+    {
+        dst.at<float>(c, 0) = (float)mn[c];
+        dst.at<float>(c, 1) = (float)mx[c];
+        if (arg)
+        {
+            dst.at<float>(c, 2) = (float)(amin[c] % src.w);
+            dst.at<float>(c, 3) = (float)(amin[c] / src.w);
+            dst.at<float>(c, 4) = (float)(amax[c] % src.w);
+            dst.at<float>(c, 5) = (float)(amax[c] / src.w);
+        }
+        else
+        {
+            double mean = sum[c] / n;
+            dst.at<float>(c, 2) = (float)sum[c];
+            dst.at<float>(c, 3) = (float)mean;
+            dst.at<float>(c, 4) = (float)std::max(sum2[c] / n - mean * mean, 0.0);
+        }
+    }
+}
+} // namespace CPU
+} // namespace ImGui
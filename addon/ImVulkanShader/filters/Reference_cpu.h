@@ -0,0 +1,50 @@
+#pragma once
+#include "imvk_platform.h"
+#include "immat.h"
+#include "AlphaBlending_vulkan.h"
+
+// CPU reference of the core filters, same pixel math as the shaders.
+// Filters fall back to it when the gpu index has no Vulkan device, and tests use it to cross check shader output.
+// Input must be on CPU, pixels are interleaved as the shaders see them, dst is created like the vulkan path creates it.
+namespace ImGui
+{
+namespace CPU
+{
+// color convert, dst is created by caller with its size, channels, type and color format
+VKSHADER_API void Conv(const ImMat& src, ImMat& dst);
+VKSHADER_API void GRAY2RGBA(const ImMat& src, ImMat& dst, float in_scale);
+// in_scale is (1 << bit depth) - 1, dst w/h different from src resizes with type
+VKSHADER_API void YUV2RGBA(const ImMat& src, ImMat& dst, ImColorFormat in_format, ImColorSpace in_space, ImColorRange in_range, float in_scale, ImInterpolateMode type = IM_INTERPOLATE_BICUBIC);
+// dst yuv format, space and range come from dst
+VKSHADER_API void RGBA2YUV(const ImMat& src, ImMat& dst, float out_scale);
+
+// crop, flip, transpose and resize as Geometry_vulkan::transform, crop rect must be already clamped,
+// dst channels follow dst.color_format
+VKSHADER_API void Transform(const ImMat& src, ImMat& dst, int crop_x, int crop_y, int crop_w, int crop_h,
+                            bool flip_x, bool flip_y, bool transpose, int out_w, int out_h, ImInterpolateMode type);
+VKSHADER_API void ResizeLanczos(const ImMat& src, ImMat& dst, int out_w, int out_h);
+
+// separable filter, kernel holds max(xksize, yksize) float taps shared by both passes
+VKSHADER_API void Filter2DS(const ImMat& src, ImMat& dst, const ImMat& kernel, int xksize, int yksize, int xanchor, int yanchor);
+VKSHADER_API void USM(const ImMat& src, ImMat& dst, const ImMat& kernel, int ksize, int anchor, float amount, float threshold);
+
+// color adjust
+VKSHADER_API void Brightness(const ImMat& src, ImMat& dst, float brightness);
+VKSHADER_API void Contrast(const ImMat& src, ImMat& dst, float contrast);
+VKSHADER_API void Gamma(const ImMat& src, ImMat& dst, float gamma);
+VKSHADER_API void Saturation(const ImMat& src, ImMat& dst, float saturation);
+VKSHADER_API void Hue(const ImMat& src, ImMat& dst, float hue);
+
+// blend
+VKSHADER_API void AlphaBlend(const ImMat& src1, const ImMat& src2, ImMat& dst, int x, int y);
+VKSHADER_API void AlphaBlend(const ImMat& src1, const ImMat& src2, ImMat& dst, float alpha, int x, int y);
+// layers over a transparent width x height canvas, as AlphaBlending_vulkan::composite
+VKSHADER_API void Composite(const std::vector<ImBlendLayer>& layers, ImMat& dst, int width, int height);
+
+// lut is lutsize^3 rgba float entries, entry of (r, g, b) at (r * lutsize + g) * lutsize + b
+VKSHADER_API void Lut3D(const ImMat& src, ImMat& dst, const float* lut, int lutsize, int interpolation);
+
+// per channel statistics as Reduce_vulkan, accumulated in double
+VKSHADER_API void Reduce(const ImMat& src, ImMat& dst, bool arg);
+} // namespace CPU
+} // namespace ImGui
@@ -1,43 +1,31 @@
 #include "Resize_vulkan.h"
 #include "Resize_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 
 namespace ImGui 
 {
 Resize_vulkan::Resize_vulkan(int gpu)
+    : Geometry_vulkan(gpu)
 {
-    vkdev = get_gpu_device(gpu);
-    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
-    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
-    opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
-    cmd = new VkCompute(vkdev);
+    if (!vkdev) return;
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
 
-    if (compile_spirv_module(Resize_data, opt, spirv_data) == 0)
+    if (compile_spirv_module(ResizeLanczos_data, opt, spirv_data) == 0)
     {
-        pipe = new Pipeline(vkdev);
-        pipe->set_optimal_local_size_xyz(16, 16, 1);
-        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+        pipe_lanczos = new Pipeline(vkdev);
+        pipe_lanczos->set_optimal_local_size_xyz(16, 16, 1);
+        pipe_lanczos->create(spirv_data.data(), spirv_data.size() * 4, specializations);
     }
-    
-    cmd->reset();
 }
 
 Resize_vulkan::~Resize_vulkan()
 {
-    if (vkdev)
-    {
-        if (pipe) { delete pipe; pipe = nullptr; }
-        if (cmd) { delete cmd; cmd = nullptr; }
-        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
-        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
-    }
+    if (pipe_lanczos) { delete pipe_lanczos; pipe_lanczos = nullptr; }
 }
 
-void Resize_vulkan::upload_param(const VkMat& src, VkMat& dst, ImInterpolateMode type) const
+void Resize_vulkan::upload_param_lanczos(const VkMat& src, VkMat& dst, int pass) const
 {
     std::vector<VkMat> bindings(8);
     if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
@@ -61,19 +49,30 @@ void Resize_vulkan::upload_param(const VkMat& src, VkMat& dst, ImInterpolateMode
     constants[7].i = dst.c;
     constants[8].i = dst.color_format;
     constants[9].i = dst.type;
-    constants[10].i = type;
-    cmd->record_pipeline(pipe, bindings, constants, dst);
+    constants[10].i = pass;
+    cmd->record_pipeline(pipe_lanczos, bindings, constants, dst);
 }
 
 void Resize_vulkan::Resize(const ImMat& src, ImMat& dst, float fx, float fy, ImInterpolateMode type) const
 {
-    if (!vkdev || !pipe || !cmd)
+    int dst_width = Im_AlignSize((fx == 0.f ? src.w : src.w * fx), 4);
+    int dst_height = Im_AlignSize((fx == 0.f ? src.h : fy == 0.f ? src.h * fx : src.h * fy), 4);
+    if (!vkdev)
+    {
+        // pyramid only approximates an area average, the cpu path does the exact one
+        if (src.device != IM_DD_CPU)
+            return;
+        if (type == IM_INTERPOLATE_LANCZOS)
+            CPU::ResizeLanczos(src, dst, dst_width, dst_height);
+        else
+            CPU::Transform(src, dst, 0, 0, src.w, src.h, false, false, false, dst_width, dst_height, type);
+        return;
+    }
+    if (!pipe || !cmd)
     {
         return;
     }
 
-    int dst_width = Im_AlignSize((fx == 0.f ? src.w : src.w * fx), 4);
-    int dst_height = Im_AlignSize((fx == 0.f ? src.h : fy == 0.f ? src.h * fx : src.h * fy), 4);\
     auto color_format = dst.color_format;
     int channels = IM_ISALPHA(color_format) ? 4 : IM_ISRGB(color_format) ? 3 : IM_ISMONO(color_format) ? 1 : 4;
     VkMat dst_gpu;
@@ -90,7 +89,35 @@ void Resize_vulkan::Resize(const ImMat& src, ImMat& dst, float fx, float fy, ImI
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, type);
+    // intermediate mats must stay alive until the command buffer is submitted
+    std::vector<VkMat> levels;
+    if (type == IM_INTERPOLATE_LANCZOS && pipe_lanczos)
+    {
+        VkMat tmp_gpu;
+        tmp_gpu.create_type(dst_width, src_gpu.h, 4, intermediate_type(IM_PRECISION_FP16_STORAGE), opt.blob_vkallocator);
+        tmp_gpu.color_format = IM_CF_ABGR;
+        upload_param_lanczos(src_gpu, tmp_gpu, 0);
+        upload_param_lanczos(tmp_gpu, dst_gpu, 1);
+        levels.push_back(tmp_gpu);
+    }
+    else if (type == IM_INTERPOLATE_PYRAMID)
+    {
+        VkMat level_gpu = src_gpu;
+        while (level_gpu.w / 2 >= dst_width && level_gpu.h / 2 >= dst_height)
+        {
+            VkMat half_gpu;
+            half_gpu.create_type(level_gpu.w / 2, level_gpu.h / 2, 4, intermediate_type(IM_PRECISION_FP16_STORAGE), opt.blob_vkallocator);
+            half_gpu.color_format = IM_CF_ABGR;
+            upload_param(level_gpu, half_gpu, 0, 0, level_gpu.w, level_gpu.h, false, false, false, IM_INTERPOLATE_AREA);
+            levels.push_back(half_gpu);
+            level_gpu = half_gpu;
+        }
+        upload_param(level_gpu, dst_gpu, 0, 0, level_gpu.w, level_gpu.h, false, false, false, IM_INTERPOLATE_AREA);
+    }
+    else
+    {
+        upload_param(src_gpu, dst_gpu, 0, 0, src_gpu.w, src_gpu.h, false, false, false, type);
+    }
 
     // download
     if (dst.device == IM_DD_CPU)
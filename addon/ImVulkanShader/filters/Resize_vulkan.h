@@ -1,24 +1,22 @@
 #pragma once
-#include "imvk_gpu.h"
-#include "imvk_pipeline.h"
+#include "Geometry_vulkan.h"
 
 namespace ImGui 
 {
-class VKSHADER_API Resize_vulkan
+class VKSHADER_API Resize_vulkan : public Geometry_vulkan
 {
 public:
     Resize_vulkan(int gpu = -1);
     ~Resize_vulkan();
 
+    // IM_INTERPOLATE_LANCZOS runs two 1D passes through a fp16 intermediate
+    // IM_INTERPOLATE_PYRAMID halves with area average until close to target, then area to target size
     virtual void Resize(const ImMat& src, ImMat& dst, float fx, float fy = 0.f, ImInterpolateMode type = IM_INTERPOLATE_BICUBIC) const;
 
 public:
-    const VulkanDevice* vkdev;
-    Pipeline * pipe = nullptr;
-    VkCompute * cmd = nullptr;
-    Option opt;
+    Pipeline * pipe_lanczos = nullptr;
 
 private:
-    void upload_param(const VkMat& src, VkMat& dst, ImInterpolateMode type) const;
+    void upload_param_lanczos(const VkMat& src, VkMat& dst, int pass) const;
 };
-} // namespace ImGui 
\ No newline at end of file
+} // namespace ImGui 
@@ -1,100 +1,18 @@
 #include "Transpose_vulkan.h"
-#include "Transpose_shader.h"
-#include "ImVulkanShader.h"
 
 namespace ImGui 
 {
 Transpose_vulkan::Transpose_vulkan(int gpu)
+    : Geometry_vulkan(gpu)
 {
-    vkdev = get_gpu_device(gpu);
-    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
-    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
-    opt.use_image_storage = true;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
-    cmd = new VkCompute(vkdev);
-
-    std::vector<vk_specialization_type> specializations(0);
-    std::vector<uint32_t> spirv_data;
-
-    if (compile_spirv_module(Filter_data, opt, spirv_data) == 0)
-    {
-        pipe = new Pipeline(vkdev);
-        pipe->set_optimal_local_size_xyz(16, 16, 1);
-        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
-    }
-    
-    cmd->reset();
 }
 
 Transpose_vulkan::~Transpose_vulkan()
 {
-    if (vkdev)
-    {
-        if (pipe) { delete pipe; pipe = nullptr; }
-        if (cmd) { delete cmd; cmd = nullptr; }
-        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
-        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
-    }
-}
-
-void Transpose_vulkan::upload_param(const VkMat& src, VkMat& dst, bool bFlipX, bool bFlipY) const
-{
-    std::vector<VkMat> bindings(8);
-    if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
-    else if (dst.type == IM_DT_INT16)    bindings[1] = dst;
-    else if (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
-    else if (dst.type == IM_DT_FLOAT32)  bindings[3] = dst;
-
-    if      (src.type == IM_DT_INT8)      bindings[4] = src;
-    else if (src.type == IM_DT_INT16)     bindings[5] = src;
-    else if (src.type == IM_DT_FLOAT16)   bindings[6] = src;
-    else if (src.type == IM_DT_FLOAT32)   bindings[7] = src;
-    
-    std::vector<vk_constant_type> constants(12);
-    constants[0].i = src.w;
-    constants[1].i = src.h;
-    constants[2].i = src.c;
-    constants[3].i = src.color_format;
-    constants[4].i = src.type;
-    constants[5].i = dst.w;
-    constants[6].i = dst.h;
-    constants[7].i = dst.c;
-    constants[8].i = dst.color_format;
-    constants[9].i = dst.type;
-    constants[10].i = bFlipX ? 1 : 0;
-    constants[11].i = bFlipY ? 1 : 0;
-    cmd->record_pipeline(pipe, bindings, constants, dst);
 }
 
 void Transpose_vulkan::transpose(const ImMat& src, ImMat& dst, bool bFlipX, bool bFlipY) const
 {
-    if (!vkdev || !pipe || !cmd)
-    {
-        return;
-    }
-
-    VkMat dst_gpu;
-    dst_gpu.create_type(src.h, src.w, 4, dst.type, opt.blob_vkallocator);
-
-    VkMat src_gpu;
-    if (src.device == IM_DD_VULKAN)
-    {
-        src_gpu = src;
-    }
-    else if (src.device == IM_DD_CPU)
-    {
-        cmd->record_clone(src, src_gpu, opt);
-    }
-
-    upload_param(src_gpu, dst_gpu, bFlipX, bFlipY);
-
-    // download
-    if (dst.device == IM_DD_CPU)
-        cmd->record_clone(dst_gpu, dst, opt);
-    else if (dst.device == IM_DD_VULKAN)
-        dst = dst_gpu;
-    cmd->submit_and_wait();
-    cmd->reset();
+    transform(src, dst, 0, 0, src.w, src.h, bFlipX, bFlipY, true, src.h, src.w, IM_INTERPOLATE_NEAREST);
 }
 } //namespace ImGui 
@@ -1,6 +1,7 @@
 #include "USM_vulkan.h"
 #include "Filter2DS_shader.h"
 #include "USM_shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 
 namespace ImGui
@@ -8,11 +9,15 @@ namespace ImGui
 USM_vulkan::USM_vulkan(int gpu)
 {
     vkdev = get_gpu_device(gpu);
+    if (!vkdev)
+    {
+        prepare_kernel();
+        return;
+    }
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -79,9 +84,12 @@ void USM_vulkan::prepare_kernel()
 
     sum = 1.0 / sum;
     kernel *= (float)(sum);
-    VkTransfer tran(vkdev);
-    tran.record_upload(kernel, vk_kernel, opt, false);
-    tran.submit_and_wait();
+    if (vkdev)
+    {
+        VkTransfer tran(vkdev);
+        tran.record_upload(kernel, vk_kernel, opt, false);
+        tran.submit_and_wait();
+    }
 
     xksize = yksize = ksize;
     xanchor = yanchor = blurRadius;
@@ -96,10 +104,10 @@ void USM_vulkan::upload_param(const VkMat& src, VkMat& dst, float _sigma, float
     }
 
     VkMat vk_column;
-    vk_column.create_type(dst.w, dst.h, dst.c, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_column.create_type(dst.w, dst.h, dst.c, intermediate_type(IM_PRECISION_FP16_STORAGE), opt.blob_vkallocator);
 
     VkMat vk_blur;
-    vk_blur.create_type(dst.w, dst.h, dst.c, IM_DT_FLOAT16, opt.blob_vkallocator);
+    vk_blur.create_type(dst.w, dst.h, dst.c, intermediate_type(IM_PRECISION_FP16_STORAGE), opt.blob_vkallocator);
 
     std::vector<vk_constant_type> column_constants(14);
     column_constants[0].i = src.w;
@@ -197,7 +205,19 @@ void USM_vulkan::upload_param(const VkMat& src, VkMat& dst, float _sigma, float
 
 void USM_vulkan::filter(const ImMat& src, ImMat& dst, float sigma, float amount, float threshold)
 {
-    if (!vkdev || !pipe || !pipe_column || !pipe_row || !cmd)
+    if (!vkdev)
+    {
+        if (src.device != IM_DD_CPU)
+            return;
+        if (this->sigma != sigma)
+        {
+            this->sigma = sigma;
+            prepare_kernel();
+        }
+        CPU::USM(src, dst, kernel, xksize, xanchor, amount, threshold);
+        return;
+    }
+    if (!pipe || !pipe_column || !pipe_row || !cmd)
     {
         return;
     }
@@ -15,6 +15,7 @@ layout (push_constant) uniform parameter \n\
     int outh; \n\
     int outcstep; \n\
 \n\
+    int stride; \n\
 } p; \
 "
 
@@ -58,8 +59,8 @@ sfpvec2 hs_to_point(sfpvec4 hs) \n\
 } \n\
 void main() \n\
 { \n\
-    int gx = int(gl_GlobalInvocationID.x); \n\
-    int gy = int(gl_GlobalInvocationID.y); \n\
+    int gx = int(gl_GlobalInvocationID.x) * p.stride; \n\
+    int gy = int(gl_GlobalInvocationID.y) * p.stride; \n\
     if (gx >= p.w || gy >= p.h) \n\
         return; \n\
     sfpvec4 rgba = load_rgba(gx, gy, p.w, p.cstep, p.format, p.type); \n\
@@ -73,7 +74,7 @@ void main() \n\
     { \n\
         memoryBarrierBuffer(); \n\
         int offset = point.y * p.outw + point.x; \n\
-        atomicAdd(alpha_blob_data[offset], length); \n\
+        atomicAdd(alpha_blob_data[offset], length * p.stride * p.stride); \n\
         memoryBarrierBuffer(); \n\
     } \n\
 } \
@@ -10,8 +10,7 @@ Vector_vulkan::Vector_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = false;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -54,7 +53,7 @@ Vector_vulkan::~Vector_vulkan()
     }
 }
 
-void Vector_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity)
+void Vector_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, int stride)
 {
     ImGui::VkMat buffer_gpu;
     buffer_gpu.create_type(size, size, 1, IM_DT_INT32, opt.blob_vkallocator);
@@ -73,7 +72,7 @@ void Vector_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, flo
     else if (src.type == IM_DT_FLOAT16)  bindings[2] = src;
     else if (src.type == IM_DT_FLOAT32)  bindings[3] = src;
     bindings[4] = buffer_gpu;
-    std::vector<ImGui::vk_constant_type> constants(8);
+    std::vector<ImGui::vk_constant_type> constants(9);
     constants[0].i = src.w;
     constants[1].i = src.h;
     constants[2].i = src.c;
@@ -82,7 +81,9 @@ void Vector_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, flo
     constants[5].i = buffer_gpu.w;
     constants[6].i = buffer_gpu.h;
     constants[7].i = buffer_gpu.c;
-    cmd->record_pipeline(pipe, bindings, constants, buffer_gpu);
+    constants[8].i = stride;
+    ImGui::ImMat dispatcher((src.w + stride - 1) / stride, (src.h + stride - 1) / stride, 1, (void*)0);
+    cmd->record_pipeline(pipe, bindings, std::vector<ImGui::VkImageMat>(), constants, dispatcher);
 
     std::vector<ImGui::VkMat> bindings_merge(5);
     if      (dst.type == IM_DT_INT8)     bindings_merge[0] = dst;
@@ -106,7 +107,7 @@ void Vector_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, flo
     cmd->record_pipeline(pipe_merge, bindings_merge, constants_merge, dst);
 }
 
-void Vector_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity)
+void Vector_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity, int stride)
 {
     if (!vkdev || !pipe || !pipe_zero || !pipe_merge || !cmd)
     {
@@ -126,7 +127,7 @@ void Vector_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float inte
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, intensity);
+    upload_param(src_gpu, dst_gpu, intensity, std::max(stride, 1));
 
     // download
     if (dst.device == IM_DD_CPU)
@@ -10,7 +10,8 @@ public:
     Vector_vulkan(int gpu = 0);
     ~Vector_vulkan();
 
-    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity = 0.01);
+    // stride > 1 reads one pixel of every stride x stride block, see Waveform_vulkan.h for the error bound
+    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, float intensity = 0.01, int stride = 1);
 
 private:
     ImGui::VulkanDevice* vkdev      {nullptr};
@@ -24,6 +25,6 @@ private:
     int size {512};
 
 private:
-    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity);
+    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float intensity, int stride);
 };
 } // namespace ImGui
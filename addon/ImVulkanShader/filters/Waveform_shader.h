@@ -17,6 +17,7 @@ layout (push_constant) uniform parameter \n\
     int out_type; \n\
     \n\
     int separate; \n\
+    int stride; \n\
 } p; \
 "
 
@@ -26,11 +27,13 @@ void main() \n\
 { \n\
     int gx = int(gl_GlobalInvocationID.x); \n\
     int gy = int(gl_GlobalInvocationID.y); \n\
-    if (gx >= p.w || gy >= p.h) \n\
+    int sx = gx * p.stride; \n\
+    int sy = gy * p.stride; \n\
+    if (sx >= p.w || sy >= p.h) \n\
         return; \n\
     int dx = p.separate == 1 ? gx / 3 : gx; \n\
     int ox = p.separate == 1 ? p.out_w / 3 : 0; \n\
-    sfpvec4 rgba = load_rgba(gx, gy, p.w, p.cstep, p.in_format, p.in_type); \n\
+    sfpvec4 rgba = load_rgba(sx, sy, p.w, p.cstep, p.in_format, p.in_type); \n\
     int dyr = int(rgba.r * (p.out_h - 1)); \n\
     ivec4 offset_r = (dyr * p.out_w + dx) * p.out_cstep + ivec4(0, 1, 2, 3); \n\
     int dyg = int(rgba.g * (p.out_h - 1)); \n\
@@ -40,10 +43,10 @@ void main() \n\
     //int dya = int(rgba.a * (p.out_h - 1)); \n\
     //ivec4 offset_a = (dya * p.out_w + dx + ox + ox + ox) * p.out_cstep + ivec4(0, 1, 2, 3); \n\
     memoryBarrierBuffer(); \n\
-    atomicAdd(waveform_int32_data[offset_r.r], 1); \n\
-    atomicAdd(waveform_int32_data[offset_g.g], 1); \n\
-    atomicAdd(waveform_int32_data[offset_b.b], 1); \n\
-    //atomicAdd(waveform_int32_data[offset_a.a], 1); \n\
+    atomicAdd(waveform_int32_data[offset_r.r], p.stride); \n\
+    atomicAdd(waveform_int32_data[offset_g.g], p.stride); \n\
+    atomicAdd(waveform_int32_data[offset_b.b], p.stride); \n\
+    //atomicAdd(waveform_int32_data[offset_a.a], p.stride); \n\
     memoryBarrierBuffer(); \n\
 } \
 "
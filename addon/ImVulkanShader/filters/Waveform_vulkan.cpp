@@ -10,8 +10,7 @@ Waveform_vulkan::Waveform_vulkan(int gpu)
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = false;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -52,7 +51,7 @@ Waveform_vulkan::~Waveform_vulkan()
     }
 }
 
-void Waveform_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float fintensity, bool separate)
+void Waveform_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float fintensity, bool separate, int stride)
 {
     ImGui::VkMat dst_gpu_int32;
     dst_gpu_int32.create_type(dst.w, dst.h, dst.c, IM_DT_INT32, opt.blob_vkallocator);
@@ -71,7 +70,7 @@ void Waveform_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, f
     else if (src.type == IM_DT_FLOAT16)  bindings[2] = src;
     else if (src.type == IM_DT_FLOAT32)  bindings[3] = src;
     bindings[4] = dst_gpu_int32;
-    std::vector<vk_constant_type> constants(11);
+    std::vector<vk_constant_type> constants(12);
     constants[0].i = src.w;
     constants[1].i = src.h;
     constants[2].i = src.c;
@@ -83,7 +82,9 @@ void Waveform_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, f
     constants[8].i = dst_gpu_int32.color_format;
     constants[9].i = dst_gpu_int32.type;
     constants[10].i = separate ? 1 : 0;
-    cmd->record_pipeline(pipe, bindings, constants, dst_gpu_int32);
+    constants[11].i = stride;
+    ImGui::ImMat dispatcher(dst_gpu_int32.w, (src.h + stride - 1) / stride, 1, (void*)0);
+    cmd->record_pipeline(pipe, bindings, std::vector<VkImageMat>(), constants, dispatcher);
 
     std::vector<VkMat> conv_bindings(2);
     conv_bindings[0] = dst_gpu_int32;
@@ -99,14 +100,15 @@ void Waveform_vulkan::upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, f
     cmd->record_pipeline(pipe_conv, conv_bindings, conv_constants, dst);
 }
 
-void Waveform_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level, float fintensity, bool separate)
+void Waveform_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level, float fintensity, bool separate, int stride)
 {
     if (!vkdev || !pipe || !pipe_zero || !pipe_conv || !cmd)
     {
         return;
     }
+    stride = std::max(stride, 1);
     VkMat dst_gpu;
-    dst_gpu.create_type(src.w, level, 4, IM_DT_INT8, opt.blob_vkallocator);
+    dst_gpu.create_type((src.w + stride - 1) / stride, level, 4, IM_DT_INT8, opt.blob_vkallocator);
 
     VkMat src_gpu;
     if (src.device == IM_DD_VULKAN)
@@ -118,7 +120,7 @@ void Waveform_vulkan::scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int leve
         cmd->record_clone(src, src_gpu, opt);
     }
 
-    upload_param(src_gpu, dst_gpu, fintensity, separate);
+    upload_param(src_gpu, dst_gpu, fintensity, separate, stride);
 
     // download
     if (dst.device == IM_DD_CPU)
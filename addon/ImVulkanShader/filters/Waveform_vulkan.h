@@ -11,7 +11,18 @@ public:
     Waveform_vulkan(int gpu = 0);
     ~Waveform_vulkan();
 
-    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level = 256, float fintensity = 0.1, bool separate = false);
+    // Decimated input for the scopes: with stride > 1 Waveform, Histogram, Vector and CIE read one pixel of
+    // every stride x stride block (stride 2 is the quarter-res input) and add it with weight stride^2
+    // (stride for the waveform, whose columns shrink to src.w / stride), so the intensity/scale settings keep
+    // their look. Point samples, not box averages: averaging would pull the distribution toward its mean.
+    // Error bound: a bin holding a fraction q of the frame is estimated from n = w * h / stride^2 samples
+    // with a standard error of sqrt(q * (1 - q) / n) <= 0.5 / sqrt(n) of the frame, i.e. a relative error
+    // of about 1 / sqrt(samples in the bin). For 3840x2160 at stride 4 (n = 518400) that is at most 0.07%
+    // of the pixel count per histogram bin and under 1% relative for any bin holding 10000+ samples;
+    // a waveform column (n = h / stride samples) is coarser, 540 samples at stride 4. The bound assumes
+    // the picture does not repeat with a period that divides stride, fine detail at exactly that
+    // frequency aliases.
+    void scope(const ImGui::ImMat& src, ImGui::ImMat& dst, int level = 256, float fintensity = 0.1, bool separate = false, int stride = 1);
 
 private:
     ImGui::VulkanDevice* vkdev      {nullptr};
@@ -22,6 +33,6 @@ private:
     ImGui::Pipeline* pipe_conv      {nullptr};
 
 private:
-    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float fintensity, bool separate);
+    void upload_param(const ImGui::VkMat& src, ImGui::VkMat& dst, float fintensity, bool separate, int stride);
 };
 } // namespace ImGui
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define DECLARE_ALIGNED(n,t,v)      t __attribute__ ((aligned (n))) v
 
 #include "Lut3D_Shader.h"
+#include "Reference_cpu.h"
 #include "ImVulkanShader.h"
 #include <algorithm>
+#include <sys/stat.h>
 #include "SDR709_HDR2020_HLG.h"
 #include "SDR709_HDR2020_PQ.h"
 #include "HDR2020_HLG_SDR709.h"
@@ -13,6 +15,8 @@
 
 #define MAX_LEVEL 256
 #define MAX_LINE_SIZE 512
+#define CUBE_CACHE_SUFFIX ".imlut"
+#define CUBE_CACHE_VERSION 2
 #define NEXT_LINE(loop_cond) do {                           \
     if (!fgets(line, sizeof(line), f)) {                    \
         fprintf(stderr, "Unexpected EOF\n");                \
@@ -98,18 +102,40 @@ static std::string path_to_name(const char* path, int up_low = 0)
     return prefix;
 }
 
+// binary cache of parsed cube file, stored next to the cube file
+typedef struct _tag_cube_cache_header
+{
+    char magic[8];          // "IMLUT3D"
+    int32_t version;
+    int32_t lutsize;
+    int64_t source_size;    // cube file size, cache is stale if changed
+    int64_t source_mtime;   // cube file modify time in nanoseconds, cache is stale if changed
+    rgbvec scale;
+} cube_cache_header;
+
+// modify time with sub-second precision, an edit within the same second must not hit a stale cache
+static inline int64_t stat_mtime_ns(const struct stat& file_stat)
+{
+#if defined(__APPLE__)
+    return (int64_t)file_stat.st_mtimespec.tv_sec * 1000000000 + file_stat.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    return (int64_t)file_stat.st_mtime * 1000000000;
+#else
+    return (int64_t)file_stat.st_mtim.tv_sec * 1000000000 + file_stat.st_mtim.tv_nsec;
+#endif
+}
+
 namespace ImGui 
 {
-LUT3D_vulkan::LUT3D_vulkan(int default_model, int interpolation, int gpu)
+LUT3D_vulkan::LUT3D_vulkan(int default_model, int interpolation, int gpu, bool fp16_lut)
 {
     if (default_model < 0 || default_model > NO_DEFAULT)
     {
         return;
     }
-    if (init(interpolation, gpu) != 0)
-    {
-        return;
-    }
+    use_fp16_lut = fp16_lut;
+    // without a vulkan device the table is still set up for the cpu path
+    init(interpolation, gpu);
 
     switch (default_model)
     {
@@ -165,17 +191,14 @@ LUT3D_vulkan::LUT3D_vulkan(int default_model, int interpolation, int gpu)
             break;
     }
 
-    ImMat lut_cpu;
-    lut_cpu.create_type(lutsize, lutsize * 4, lutsize, (void *)lut, IM_DT_FLOAT32);
-    VkTransfer tran(vkdev);
-    tran.record_upload(lut_cpu, lut_gpu, opt, false);
-    tran.submit_and_wait();
+    if (vkdev) upload_lut();
     from_file = false;
 }
 
-LUT3D_vulkan::LUT3D_vulkan(std::string lut_path, int interpolation, int gpu)
+LUT3D_vulkan::LUT3D_vulkan(std::string lut_path, int interpolation, int gpu, bool fp16_lut)
 {
     int ret = 0;
+    use_fp16_lut = fp16_lut;
     ret = parse_cube(lut_path);
     if (ret != 0 || lutsize == 0)
     {
@@ -186,24 +209,22 @@ LUT3D_vulkan::LUT3D_vulkan(std::string lut_path, int interpolation, int gpu)
         }
         return;
     }
+    from_file = true;
     if (init(interpolation, gpu) != 0)
     {
         return;
     }
 
-    ImMat lut_cpu;
-    lut_cpu.create_type(lutsize, lutsize * 4, lutsize, (void *)lut, IM_DT_FLOAT32);
-    VkTransfer tran(vkdev);
-    tran.record_upload(lut_cpu, lut_gpu, opt, false);
-    tran.submit_and_wait();
-    from_file = true;
+    upload_lut();
 }
 
 LUT3D_vulkan::~LUT3D_vulkan()
 {
     if (vkdev)
     {
+        if (pipeline_lut3d) { delete pipeline_lut3d; pipeline_lut3d = nullptr; }
         if (cmd) { delete cmd; cmd = nullptr; }
+        lut_gpu.release();
         if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
         if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
     }
@@ -212,13 +233,13 @@ LUT3D_vulkan::~LUT3D_vulkan()
 
 int LUT3D_vulkan::init(int interpolation, int gpu)
 {
+    interpolation_mode = interpolation;
     vkdev = get_gpu_device(gpu);
     if (vkdev == NULL) return -1;
     opt.blob_vkallocator = vkdev->acquire_blob_allocator();
     opt.staging_vkallocator = vkdev->acquire_staging_allocator();
     opt.use_image_storage = false;
-    opt.use_fp16_arithmetic = true;
-    opt.use_fp16_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16);
     cmd = new VkCompute(vkdev);
     std::vector<vk_specialization_type> specializations(0);
     std::vector<uint32_t> spirv_data;
@@ -231,7 +252,6 @@ int LUT3D_vulkan::init(int interpolation, int gpu)
     }
 
     cmd->reset();
-    interpolation_mode = interpolation;
     return 0;
 }
 
@@ -244,7 +264,8 @@ int LUT3D_vulkan::allocate_3dlut(int size)
         return -1;
     }
 
-    if (lut && from_file)
+    // only cube files allocate, lut is either null or a table allocated here (from_file is set after parsing)
+    if (lut)
     {
         free(lut);
         lut = nullptr;
@@ -257,7 +278,99 @@ int LUT3D_vulkan::allocate_3dlut(int size)
     return 0;
 }
 
+int LUT3D_vulkan::upload_lut()
+{
+    // lut as rgba 3d image, texel (x, y, z) is the entry of (b, g, r)
+    ImMat lut_cpu(lutsize, lutsize, lutsize, lut, 16u, 4);
+    Option upload_opt = opt;
+    upload_opt.use_fp16_storage = use_fp16_lut;
+    upload_opt.use_fp16_packed = use_fp16_lut;
+    VkTransfer tran(vkdev);
+    tran.record_upload(lut_cpu, lut_gpu, upload_opt);
+    if (tran.submit_and_wait() != 0 || lut_gpu.empty())
+        return -1;
+
+    // hardware trilinear only if the lut format is linear filterable, it is mandatory for fp16 but optional for fp32
+    VkFormatProperties format_properties;
+    VkFormat format = use_fp16_lut ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_R32G32B32A32_SFLOAT;
+    vkGetPhysicalDeviceFormatProperties(vkdev->info.physical_device(), format, &format_properties);
+    hw_filter = (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+    return 0;
+}
+
+int LUT3D_vulkan::load_cube_cache(std::string cache_file, int64_t source_size, int64_t source_mtime)
+{
+    FILE *f = fopen(cache_file.c_str(), "rb");
+    if (f == NULL) return -1;
+    cube_cache_header header;
+    if (fread(&header, sizeof(header), 1, f) != 1 ||
+        strncmp(header.magic, "IMLUT3D", 8) != 0 ||
+        header.version != CUBE_CACHE_VERSION ||
+        header.source_size != source_size ||
+        header.source_mtime != source_mtime ||
+        allocate_3dlut(header.lutsize) != 0)
+    {
+        fclose(f);
+        return -1;
+    }
+    size_t count = (size_t)lutsize * lutsize * lutsize;
+    if (fread(lut, sizeof(rgbvec), count, f) != count)
+    {
+        // truncated cache, drop the table before falling back to the cube file
+        free(lut);
+        lut = nullptr;
+        lutsize = 0;
+        fclose(f);
+        return -1;
+    }
+    scale = header.scale;
+    fclose(f);
+    return 0;
+}
+
+int LUT3D_vulkan::save_cube_cache(std::string cache_file, int64_t source_size, int64_t source_mtime)
+{
+    if (!lut || lutsize == 0) return -1;
+    FILE *f = fopen(cache_file.c_str(), "wb");
+    if (f == NULL) return -1;
+    cube_cache_header header;
+    memset(&header, 0, sizeof(header));
+    strncpy(header.magic, "IMLUT3D", 8);
+    header.version = CUBE_CACHE_VERSION;
+    header.lutsize = lutsize;
+    header.source_size = source_size;
+    header.source_mtime = source_mtime;
+    header.scale = scale;
+    size_t count = (size_t)lutsize * lutsize * lutsize;
+    bool done = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(lut, sizeof(rgbvec), count, f) == count;
+    fclose(f);
+    if (!done)
+    {
+        remove(cache_file.c_str());
+        return -1;
+    }
+    return 0;
+}
+
 int LUT3D_vulkan::parse_cube(std::string lut_file)
+{
+    struct stat lut_stat;
+    if (stat(lut_file.c_str(), &lut_stat) != 0)
+        return -1;
+    std::string cache_file = lut_file + CUBE_CACHE_SUFFIX;
+    const int64_t mtime_ns = stat_mtime_ns(lut_stat);
+    if (load_cube_cache(cache_file, lut_stat.st_size, mtime_ns) == 0)
+        return 0;
+    int ret = parse_cube_text(lut_file);
+    if (ret == 0 && lutsize > 0)
+    {
+        // cache is optional, ignore write failure on read-only location
+        save_cube_cache(cache_file, lut_stat.st_size, mtime_ns);
+    }
+    return ret;
+}
+
+int LUT3D_vulkan::parse_cube_text(std::string lut_file)
 {
     FILE *f = fopen(lut_file.c_str(), "r");
     if (f == NULL) return -1;
@@ -371,7 +484,7 @@ void LUT3D_vulkan::write_header_file(std::string filename)
 
 void LUT3D_vulkan::upload_param(const VkMat& src, VkMat& dst)
 {
-    std::vector<VkMat> bindings(9);
+    std::vector<VkMat> bindings(8);
     if      (dst.type == IM_DT_INT8)     bindings[0] = dst;
     else if (dst.type == IM_DT_INT16)    bindings[1] = dst;
     else if (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
@@ -381,8 +494,10 @@ void LUT3D_vulkan::upload_param(const VkMat& src, VkMat& dst)
     else if (src.type == IM_DT_INT16)    bindings[5] = src;
     else if (src.type == IM_DT_FLOAT16)  bindings[6] = src;
     else if (src.type == IM_DT_FLOAT32)  bindings[7] = src;
-    bindings[8] = lut_gpu;
-    std::vector<vk_constant_type> constants(12);
+    std::vector<VkImageMat> image_bindings(2);
+    image_bindings[0] = lut_gpu;
+    image_bindings[1] = lut_gpu;
+    std::vector<vk_constant_type> constants(13);
     constants[0].i = src.w;
     constants[1].i = src.h;
     constants[2].i = src.c;
@@ -394,13 +509,20 @@ void LUT3D_vulkan::upload_param(const VkMat& src, VkMat& dst)
     constants[8].i = dst.color_format;
     constants[9].i = dst.type;
     constants[10].i = interpolation_mode;
-    constants[11].i = lut_gpu.w;
-    cmd->record_pipeline(pipeline_lut3d, bindings, constants, dst);
+    constants[11].i = lutsize;
+    constants[12].i = hw_filter ? 1 : 0;
+    cmd->record_pipeline(pipeline_lut3d, bindings, image_bindings, constants, dst);
 }
 
 void LUT3D_vulkan::filter(const ImMat& src, ImMat& dst)
 {
-    if (!vkdev || !pipeline_lut3d || lut_gpu.empty() || !cmd)
+    if (!vkdev)
+    {
+        if (lut && src.device == IM_DD_CPU)
+            CPU::Lut3D(src, dst, (const float *)lut, lutsize, interpolation_mode);
+        return;
+    }
+    if (!pipeline_lut3d || lut_gpu.empty() || !cmd)
     {
         return;
     }
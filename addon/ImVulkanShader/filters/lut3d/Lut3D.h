@@ -23,8 +23,9 @@ namespace ImGui
 class VKSHADER_API LUT3D_vulkan
 {
 public:
-    LUT3D_vulkan(int default_model = SDR709_HDRHLG, int interpolation = IM_INTERPOLATE_TRILINEAR, int gpu = 0);
-    LUT3D_vulkan(std::string lut_path, int interpolation = IM_INTERPOLATE_TRILINEAR, int gpu = 0);
+    // fp16 lut stores the table as half float 3d image, half of the memory and hardware trilinear filterable
+    LUT3D_vulkan(int default_model = SDR709_HDRHLG, int interpolation = IM_INTERPOLATE_TRILINEAR, int gpu = 0, bool fp16_lut = true);
+    LUT3D_vulkan(std::string lut_path, int interpolation = IM_INTERPOLATE_TRILINEAR, int gpu = 0, bool fp16_lut = true);
     ~LUT3D_vulkan();
 
     void filter(const ImMat& src, ImMat& dst);
@@ -32,11 +33,11 @@ public:
     void write_header_file(std::string filename);
     
 public:
-    const VulkanDevice* vkdev;
+    const VulkanDevice* vkdev {nullptr};
     Pipeline * pipeline_lut3d = nullptr;
     VkCompute * cmd = nullptr;
     Option opt;
-    VkMat lut_gpu;
+    VkImageMat lut_gpu;
 
 private:
     void *lut {nullptr};
@@ -45,11 +46,17 @@ private:
     int rgba_map[4];
     int interpolation_mode {IM_INTERPOLATE_TRILINEAR};
     bool from_file {false};
+    bool use_fp16_lut {true};
+    bool hw_filter {false};
 
 private:
     int init(int interpolation, int gpu);
     int allocate_3dlut(int size);
+    int upload_lut();
     int parse_cube(std::string lut_file);
+    int parse_cube_text(std::string lut_file);
+    int load_cube_cache(std::string cache_file, int64_t source_size, int64_t source_mtime);
+    int save_cube_cache(std::string cache_file, int64_t source_size, int64_t source_mtime);
     void upload_param(const VkMat& src, VkMat& dst);
 };
 } // namespace ImGui 
\ No newline at end of file
@@ -19,18 +19,27 @@ layout (push_constant) uniform parameter \n\
     \n\
     int interp_type; \n\
     int lut_size; \n\
+    int hw_filter; \n\
 } p; \
 "
 
+// lut texel (x, y, z) holds the entry of (b, g, r)
+#define SHADER_LUT3D_FETCH \
+" \n\
+sfpvec4 lut_fetch(int r, int g, int b) \n\
+{ \n\
+    return sfpvec4(texelFetch(lut_table, ivec3(b, g, r), 0)); \n\
+} \
+"
+
 #define SHADER_LUT3D_NEARSET \
 " \n\
 sfpvec3 interp_nearest(sfpvec3 s) \n\
 { \n\
     int lutsize = p.lut_size; \n\
     s = s * sfp(lutsize - 1); \n\
-    int offset = (int(s.r + .5) * lutsize + int(s.g + .5)) * lutsize + int(s.b + .5); \n\
-    vec4 c = table_blob_data[offset]; \n\
-    return sfpvec3(sfp(c.r), sfp(c.g), sfp(c.b)); \n\
+    sfpvec4 c = lut_fetch(int(s.r + .5), int(s.g + .5), int(s.b + .5)); \n\
+    return c.rgb; \n\
 } \
 "
 
@@ -56,30 +65,16 @@ sfpvec3 interp_trilinear(sfpvec3 s) \n\
                         (int(s.g) + 1 > lutsize - 1) ? lutsize - 1 : int(s.g) + 1, \n\
                         (int(s.b) + 1 > lutsize - 1) ? lutsize - 1 : int(s.b) + 1}; \n\
     const sfpvec3 d = {s.r - sfp(prev[0]), s.g - sfp(prev[1]), s.b - sfp(prev[2])}; \n\
-    int index[8]; \n\
     sfpvec4 cccc[8]; \n\
-    int p02 = prev[0] * lutsize * lutsize; \n\
-    int n02 = next[0] * lutsize * lutsize; \n\
-    int p10 = prev[1] * lutsize; \n\
-    int n10 = next[1] * lutsize; \n\
-\n\
-    index[0] = p02 + p10 + prev[2]; \n\
-    index[1] = p02 + p10 + next[2]; \n\
-    index[2] = p02 + n10 + prev[2]; \n\
-    index[3] = p02 + n10 + next[2]; \n\
-    index[4] = n02 + p10 + prev[2]; \n\
-    index[5] = n02 + p10 + next[2]; \n\
-    index[6] = n02 + n10 + prev[2]; \n\
-    index[7] = n02 + n10 + next[2]; \n\
 \n\
-    cccc[0] = sfpvec4(table_blob_data[index[0]]); \n\
-    cccc[1] = sfpvec4(table_blob_data[index[1]]); \n\
-    cccc[2] = sfpvec4(table_blob_data[index[2]]); \n\
-    cccc[3] = sfpvec4(table_blob_data[index[3]]); \n\
-    cccc[4] = sfpvec4(table_blob_data[index[4]]); \n\
-    cccc[5] = sfpvec4(table_blob_data[index[5]]); \n\
-    cccc[6] = sfpvec4(table_blob_data[index[6]]); \n\
-    cccc[7] = sfpvec4(table_blob_data[index[7]]); \n\
+    cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+    cccc[1] = lut_fetch(prev[0], prev[1], next[2]); \n\
+    cccc[2] = lut_fetch(prev[0], next[1], prev[2]); \n\
+    cccc[3] = lut_fetch(prev[0], next[1], next[2]); \n\
+    cccc[4] = lut_fetch(next[0], prev[1], prev[2]); \n\
+    cccc[5] = lut_fetch(next[0], prev[1], next[2]); \n\
+    cccc[6] = lut_fetch(next[0], next[1], prev[2]); \n\
+    cccc[7] = lut_fetch(next[0], next[1], next[2]); \n\
 \n\
     const sfpvec4 c00 = lerp(cccc[0], cccc[4], d.r); \n\
     const sfpvec4 c10 = lerp(cccc[2], cccc[6], d.r); \n\
@@ -93,6 +88,18 @@ sfpvec3 interp_trilinear(sfpvec3 s) \n\
 } \
 "
 
+// hardware filter with 3d image sampler, texel centers are at (i + 0.5) / lutsize
+#define SHADER_LUT3D_TRILINEAR_HW \
+" \n\
+sfpvec3 interp_trilinear_hw(sfpvec3 s) \n\
+{ \n\
+    float lutsize = float(p.lut_size); \n\
+    vec3 coord = (vec3(s.b, s.g, s.r) * (lutsize - 1.f) + 0.5f) / lutsize; \n\
+    vec4 c = texture(lut_table_linear, coord); \n\
+    return sfpvec3(c.rgb); \n\
+} \
+"
+
 #define SHADER_LUT3D_TETRAHEDRAL \
 " \n\
 sfpvec3 interp_tetrahedral(sfpvec3 s) \n\
@@ -105,10 +112,6 @@ sfpvec3 interp_tetrahedral(sfpvec3 s) \n\
                         (int(s.b) + 1 > lutsize - 1) ? lutsize - 1 : int(s.b) + 1}; \n\
     const sfpvec3 d = {s.r - sfp(prev[0]), s.g - sfp(prev[1]), s.b - sfp(prev[2])}; \n\
     sfpvec4 cccc[4]; \n\
-    int p02 = prev[0] * lutsize * lutsize; \n\
-    int n02 = next[0] * lutsize * lutsize; \n\
-    int p10 = prev[1] * lutsize; \n\
-    int n10 = next[1] * lutsize; \n\
 \n\
     sfp one_sub_r = sfp(1.0f) - d.r; \n\
     sfp one_sub_b = sfp(1.0f) - d.b; \n\
@@ -125,30 +128,30 @@ sfpvec3 interp_tetrahedral(sfpvec3 s) \n\
     { \n\
         if (d.g > d.b)  \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[n02 + p10 + prev[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[n02 + n10 + prev[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(next[0], prev[1], prev[2]); \n\
+            cccc[2] = lut_fetch(next[0], next[1], prev[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_r * cccc[0].r + r_sub_g * cccc[1].r + g_sub_b * cccc[2].r + (d.b) * cccc[3].r; \n\
             c.g = one_sub_r * cccc[0].g + r_sub_g * cccc[1].g + g_sub_b * cccc[2].g + (d.b) * cccc[3].g; \n\
             c.b = one_sub_r * cccc[0].b + r_sub_g * cccc[1].b + g_sub_b * cccc[2].b + (d.b) * cccc[3].b; \n\
         } \n\
         else if (d.r > d.b) \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[n02 + p10 + prev[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[n02 + p10 + next[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(next[0], prev[1], prev[2]); \n\
+            cccc[2] = lut_fetch(next[0], prev[1], next[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_r * cccc[0].r + r_sub_b * cccc[1].r + b_sub_g * cccc[2].r + (d.g) * cccc[3].r; \n\
             c.g = one_sub_r * cccc[0].g + r_sub_b * cccc[1].g + b_sub_g * cccc[2].g + (d.g) * cccc[3].g; \n\
             c.b = one_sub_r * cccc[0].b + r_sub_b * cccc[1].b + b_sub_g * cccc[2].b + (d.g) * cccc[3].b; \n\
         } \n\
         else \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[p02 + p10 + next[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[n02 + p10 + next[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(prev[0], prev[1], next[2]); \n\
+            cccc[2] = lut_fetch(next[0], prev[1], next[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_b * cccc[0].r + b_sub_r * cccc[1].r + r_sub_g * cccc[2].r + (d.g) * cccc[3].r; \n\
             c.g = one_sub_b * cccc[0].g + b_sub_r * cccc[1].g + r_sub_g * cccc[2].g + (d.g) * cccc[3].g; \n\
             c.b = one_sub_b * cccc[0].b + b_sub_r * cccc[1].b + r_sub_g * cccc[2].b + (d.g) * cccc[3].b; \n\
@@ -158,30 +161,30 @@ sfpvec3 interp_tetrahedral(sfpvec3 s) \n\
     { \n\
         if (d.b > d.g) \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[p02 + p10 + next[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[p02 + n10 + next[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(prev[0], prev[1], next[2]); \n\
+            cccc[2] = lut_fetch(prev[0], next[1], next[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_b * cccc[0].r + b_sub_g * cccc[1].r + g_sub_r * cccc[2].r + (d.r) * cccc[3].r; \n\
             c.g = one_sub_b * cccc[0].g + b_sub_g * cccc[1].g + g_sub_r * cccc[2].g + (d.r) * cccc[3].g; \n\
             c.b = one_sub_b * cccc[0].b + b_sub_g * cccc[1].b + g_sub_r * cccc[2].b + (d.r) * cccc[3].b; \n\
         } \n\
         else if (d.b > d.r) \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[p02 + n10 + prev[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[p02 + n10 + next[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(prev[0], next[1], prev[2]); \n\
+            cccc[2] = lut_fetch(prev[0], next[1], next[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_g * cccc[0].r + g_sub_b * cccc[1].r + b_sub_r * cccc[2].r + (d.r) * cccc[3].r; \n\
             c.g = one_sub_g * cccc[0].g + g_sub_b * cccc[1].g + b_sub_r * cccc[2].g + (d.r) * cccc[3].g; \n\
             c.b = one_sub_g * cccc[0].b + g_sub_b * cccc[1].b + b_sub_r * cccc[2].b + (d.r) * cccc[3].b; \n\
         } \n\
         else \n\
         { \n\
-            cccc[0] = sfpvec4(table_blob_data[p02 + p10 + prev[2]]); \n\
-            cccc[1] = sfpvec4(table_blob_data[p02 + n10 + prev[2]]); \n\
-            cccc[2] = sfpvec4(table_blob_data[n02 + n10 + prev[2]]); \n\
-            cccc[3] = sfpvec4(table_blob_data[n02 + n10 + next[2]]); \n\
+            cccc[0] = lut_fetch(prev[0], prev[1], prev[2]); \n\
+            cccc[1] = lut_fetch(prev[0], next[1], prev[2]); \n\
+            cccc[2] = lut_fetch(next[0], next[1], prev[2]); \n\
+            cccc[3] = lut_fetch(next[0], next[1], next[2]); \n\
             c.r = one_sub_g * cccc[0].r + g_sub_r * cccc[1].r + r_sub_b * cccc[2].r + (d.b) * cccc[3].r; \n\
             c.g = one_sub_g * cccc[0].g + g_sub_r * cccc[1].g + r_sub_b * cccc[2].g + (d.b) * cccc[3].g; \n\
             c.b = one_sub_g * cccc[0].b + g_sub_r * cccc[1].b + r_sub_b * cccc[2].b + (d.b) * cccc[3].b; \n\
@@ -195,10 +198,11 @@ sfpvec3 interp_tetrahedral(sfpvec3 s) \n\
 " \n\
 sfpvec3 rgb_lut3d(sfpvec3 rgb) \n\
 { \n\
+    rgb = clamp(rgb, sfpvec3(0.f), sfpvec3(1.f)); \n\
     if (p.interp_type == INTERPOLATE_NEAREST) \n\
         return interp_nearest(rgb); \n\
     else if (p.interp_type == INTERPOLATE_TRILINEAR) \n\
-        return interp_trilinear(rgb); \n\
+        return p.hw_filter == 1 ? interp_trilinear_hw(rgb) : interp_trilinear(rgb); \n\
     else if (p.interp_type == INTERPOLATE_TETRAHEDRAL) \n\
         return interp_tetrahedral(rgb); \n\
     else \n\
@@ -225,12 +229,15 @@ SHADER_HEADER
 SHADER_PARAM
 SHADER_INPUT_OUTPUT_DATA
 R"(
-layout (binding = 8) readonly buffer table_blob { vec4 table_blob_data[]; };
+layout (binding = 8) uniform sampler3D lut_table;
+layout (binding = 9) uniform sampler3D lut_table_linear;
 )"
 SHADER_LOAD_RGBA
 SHADER_STORE_RGBA
+SHADER_LUT3D_FETCH
 SHADER_LUT3D_NEARSET
 SHADER_LUT3D_TRILINEAR
+SHADER_LUT3D_TRILINEAR_HW
 SHADER_LUT3D_TETRAHEDRAL
 SHADER_LUT3D
 SHADER_LUT3D_MAIN
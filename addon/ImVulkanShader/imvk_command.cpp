@@ -1540,6 +1540,10 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
 
 void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMat>& buffer_bindings, const std::vector<VkImageMat>& image_bindings, const std::vector<vk_constant_type>& constants, const ImMat& dispatcher)
 {
+    // tuned workgroup size, the tuner replays buffer bindings only
+    if (image_bindings.empty())
+        pipeline = pipeline->tuned(buffer_bindings, constants, dispatcher);
+
     const int buffer_binding_count = (int)buffer_bindings.size();
     const int image_binding_count = (int)image_bindings.size();
     const int constant_count = (int)constants.size();
@@ -1582,7 +1586,7 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
             IM_XADD(&_b_data->command_refcount, 1);
             d->image_blocks_to_destroy.push_back(_b_data);
         }
-        else // if (binding_type == 3)
+        else // if (binding_type == 3 || binding_type == 4)
         {
             const VkImageMat& binding = image_bindings[image_index].empty() ? vkdev->get_dummy_image_readonly() : image_bindings[image_index];
             image_index++;
@@ -1655,7 +1659,7 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
                     memcpy(p_descriptorInfos, &descriptorBufferInfo, sizeof(VkDescriptorBufferInfo));
                     p_descriptorInfos += sizeof(VkDescriptorBufferInfo);
                 }
-                else //if (binding_type == 2 || binding_type == 3)
+                else //if (binding_type == 2 || binding_type == 3 || binding_type == 4)
                 {
                     const VkImageMat& binding = image_bindings[descriptorImageInfo_index].empty() ? vkdev->get_dummy_image() : image_bindings[descriptorImageInfo_index];
                     descriptorImageInfo_index++;
@@ -1690,7 +1694,7 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
 
                     if (binding_type == 2)
                         image_binding_count++;
-                    else // if (binding_type == 3)
+                    else // if (binding_type == 3 || binding_type == 4)
                         sampler_binding_count++;
                 }
 
@@ -1776,7 +1780,7 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
 
                             p_descriptorInfos += sizeof(VkDescriptorImageInfo);
                         }
-                        else // if (binding_type == 3)
+                        else // if (binding_type == 3 || binding_type == 4)
                         {
                             writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
                             writeDescriptorSets[i].pImageInfo = (const VkDescriptorImageInfo*)p_descriptorInfos;
@@ -1848,6 +1852,55 @@ void VkCompute::record_pipeline(const Pipeline* pipeline, const std::vector<VkMa
     }
 }
 
+void VkCompute::record_queue_release(const VkImageMat& image, VkImageLayout new_layout, uint32_t dst_queue_family_index)
+{
+    VkImageMemory* _data = (VkImageMemory*)image.data;
+    const uint32_t src_queue_family_index = vkdev->info.compute_queue_family_index();
+    const bool transfer = dst_queue_family_index != src_queue_family_index;
+
+    // release half of the ownership transfer, the other queue records the acquire half with the same layouts
+    VkImageMemoryBarrier* barriers = new VkImageMemoryBarrier[1];
+    barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barriers[0].pNext = 0;
+    barriers[0].srcAccessMask = _data->access_flags;
+    barriers[0].dstAccessMask = transfer ? 0 : VK_ACCESS_SHADER_READ_BIT;
+    barriers[0].oldLayout = _data->image_layout;
+    barriers[0].newLayout = new_layout;
+    barriers[0].srcQueueFamilyIndex = transfer ? src_queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+    barriers[0].dstQueueFamilyIndex = transfer ? dst_queue_family_index : VK_QUEUE_FAMILY_IGNORED;
+    barriers[0].image = image.image();
+    barriers[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barriers[0].subresourceRange.baseMipLevel = 0;
+    barriers[0].subresourceRange.levelCount = 1;
+    barriers[0].subresourceRange.baseArrayLayer = 0;
+    barriers[0].subresourceRange.layerCount = 1;
+
+    VkPipelineStageFlags src_stage = _data->stage_flags;
+    VkPipelineStageFlags dst_stage = transfer ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    if (vkdev->info.support_VK_KHR_push_descriptor())
+    {
+        vkCmdPipelineBarrier(d->compute_command_buffer, src_stage, dst_stage, 0, 0, 0, 0, 0, 1, barriers);
+        delete[] barriers;
+    }
+    else
+    {
+        VkComputePrivate::record r;
+        r.type = VkComputePrivate::record::TYPE_image_barrers;
+        r.command_buffer = d->compute_command_buffer;
+        r.image_barrers.src_stage = src_stage;
+        r.image_barrers.dst_stage = dst_stage;
+        r.image_barrers.barrier_count = 1;
+        r.image_barrers.barriers = barriers;
+        d->delayed_records.push_back(r);
+    }
+
+    // no longer ours to track
+    _data->access_flags = 0;
+    _data->image_layout = new_layout;
+    _data->stage_flags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+}
+
 #ifdef VULKAN_SHADER_BENCHMARK
 void VkCompute::record_write_timestamp(uint32_t query)
 {
@@ -1869,6 +1922,15 @@ void VkCompute::record_write_timestamp(uint32_t query)
 
 
 int VkCompute::submit_and_wait()
+{
+    int ret = submit(0, 0, 0);
+    if (ret != 0)
+        return ret;
+
+    return wait();
+}
+
+int VkCompute::submit(VkSemaphore wait_semaphore, VkPipelineStageFlags wait_stage, VkSemaphore signal_semaphore)
 {
     if (!vkdev->info.support_VK_KHR_push_descriptor())
     {
@@ -1985,13 +2047,13 @@ int VkCompute::submit_and_wait()
         VkSubmitInfo submitInfo;
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.pNext = 0;
-        submitInfo.waitSemaphoreCount = 0;
-        submitInfo.pWaitSemaphores = 0;
-        submitInfo.pWaitDstStageMask = 0;
+        submitInfo.waitSemaphoreCount = wait_semaphore ? 1 : 0;
+        submitInfo.pWaitSemaphores = wait_semaphore ? &wait_semaphore : 0;
+        submitInfo.pWaitDstStageMask = wait_semaphore ? &wait_stage : 0;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &d->compute_command_buffer;
-        submitInfo.signalSemaphoreCount = 0;
-        submitInfo.pSignalSemaphores = 0;
+        submitInfo.signalSemaphoreCount = signal_semaphore ? 1 : 0;
+        submitInfo.pSignalSemaphores = signal_semaphore ? &signal_semaphore : 0;
 
         VkResult ret = vkQueueSubmit(compute_queue, 1, &submitInfo, d->compute_command_fence);
         if (ret != VK_SUCCESS)
@@ -2004,6 +2066,11 @@ int VkCompute::submit_and_wait()
 
     vkdev->reclaim_queue(vkdev->info.compute_queue_family_index(), compute_queue);
 
+    return 0;
+}
+
+int VkCompute::wait()
+{
     // wait
     {
         VkResult ret = vkWaitForFences(vkdev->vkdevice(), 1, &d->compute_command_fence, VK_TRUE, (uint64_t)-1);
@@ -2050,6 +2117,11 @@ int VkCompute::submit_and_wait()
     return 0;
 }
 
+bool VkCompute::finished() const
+{
+    return vkGetFenceStatus(vkdev->vkdevice(), d->compute_command_fence) == VK_SUCCESS;
+}
+
 void VkCompute::flash()
 {
     VkResult ret;
@@ -55,8 +55,20 @@ public:
     void record_write_timestamp(uint32_t query);
 #endif // VULKAN_SHADER_BENCHMARK
 
+    // release the image to another queue family in new_layout, that queue records the matching acquire barrier.
+    // on the compute queue family itself this is a plain layout transition
+    void record_queue_release(const VkImageMat& image, VkImageLayout new_layout, uint32_t dst_queue_family_index);
+
     int submit_and_wait();
 
+    // submit without waiting, the batch waits wait_semaphore at wait_stage and signals signal_semaphore when set.
+    // wait() before resetting or destroying the command, finished() polls it
+    int submit(VkSemaphore wait_semaphore, VkPipelineStageFlags wait_stage, VkSemaphore signal_semaphore);
+
+    int wait();
+
+    bool finished() const;
+
     int reset();
 
     void flash();
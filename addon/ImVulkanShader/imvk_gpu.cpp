@@ -1656,6 +1656,9 @@ public:
     // nearest sampler for texelfetch
     VkSampler texelfetch_sampler;
 
+    // linear sampler with normalized coordinates for hardware filtering
+    VkSampler linear_sampler;
+
     // dummy buffer and image
     VkAllocator* dummy_allocator;
     VkMat dummy_buffer;
@@ -2091,6 +2094,36 @@ VulkanDevice::VulkanDevice(int device_index)
         }
     }
 
+    // prepare immutable linear sampler
+    {
+        VkSamplerCreateInfo samplerCreateInfo;
+        samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerCreateInfo.pNext = 0;
+        samplerCreateInfo.flags = 0;
+        samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+        samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+        samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerCreateInfo.mipLodBias = 0.0f;
+        samplerCreateInfo.anisotropyEnable = VK_FALSE;
+        samplerCreateInfo.maxAnisotropy = 1;
+        samplerCreateInfo.compareEnable = VK_FALSE;
+        samplerCreateInfo.compareOp = VK_COMPARE_OP_NEVER;
+        samplerCreateInfo.minLod = 0.0f;
+        samplerCreateInfo.maxLod = 0.0f;
+        samplerCreateInfo.borderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        samplerCreateInfo.unnormalizedCoordinates = VK_FALSE; // 3d imageview requires normalized coordinates
+
+        d->linear_sampler = 0;
+        ret = vkCreateSampler(d->device, &samplerCreateInfo, 0, &d->linear_sampler);
+        if (ret != VK_SUCCESS)
+        {
+            fprintf(stderr, "vkCreateSampler failed %d", ret);
+        }
+    }
+
     d->create_dummy_buffer_image();
 
     d->pipeline_cache = new PipelineCache(this);
@@ -2109,6 +2142,11 @@ VulkanDevice::~VulkanDevice()
         vkDestroySampler(d->device, d->texelfetch_sampler, 0);
     }
 
+    if (d->linear_sampler)
+    {
+        vkDestroySampler(d->device, d->linear_sampler, 0);
+    }
+
     for (size_t i = 0; i < d->blob_allocators.size(); i++)
     {
         delete d->blob_allocators[i];
@@ -2299,6 +2337,11 @@ int VulkanDevice::create_descriptorset_layout(int binding_count, const int* bind
             descriptorSetLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             descriptorSetLayoutBindings[i].pImmutableSamplers = 0;
         }
+        else if (binding_type == 4)
+        {
+            descriptorSetLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptorSetLayoutBindings[i].pImmutableSamplers = immutable_linear_sampler();
+        }
         else // if (binding_type == 3)
         {
             descriptorSetLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -2447,7 +2490,7 @@ int VulkanDevice::create_descriptor_update_template(int binding_count, const int
             descriptorUpdateTemplateEntries[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
             descriptorUpdateTemplateEntries[i].stride = sizeof(VkDescriptorImageInfo);
         }
-        else // if (binding_type == 3)
+        else // if (binding_type == 3 || binding_type == 4)
         {
             descriptorUpdateTemplateEntries[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             descriptorUpdateTemplateEntries[i].stride = sizeof(VkDescriptorImageInfo);
@@ -2757,6 +2800,11 @@ const VkSampler* VulkanDevice::immutable_texelfetch_sampler() const
     return &d->texelfetch_sampler;
 }
 
+const VkSampler* VulkanDevice::immutable_linear_sampler() const
+{
+    return &d->linear_sampler;
+}
+
 VkMat VulkanDevice::get_dummy_buffer() const
 {
     return d->dummy_buffer;
@@ -3809,11 +3857,15 @@ int resolve_shader_info(const uint32_t* spv_data, size_t spv_data_size, ShaderIn
     // binding_id -> binding_type
     std::vector<int> binding_types;
 
+    // id -> sampled with linear filter
+    std::vector<int> id_linear;
+
     const uint32_t* p = spv_data;
 
     int bound = p[3];
 
     id_types.resize(bound);
+    id_linear.resize(bound);
 
     // skip magic version generator bound schema
     p += 5;
@@ -3834,6 +3886,12 @@ int resolve_shader_info(const uint32_t* spv_data, size_t spv_data_size, ShaderIn
             {
                 parameter_id = id;
             }
+            // sampler named with _linear suffix is bound with the immutable linear sampler
+            size_t name_len = strlen(name);
+            if (name_len > 7 && strcmp(name + name_len - 7, "_linear") == 0)
+            {
+                id_linear[id] = 1;
+            }
         }
         else if (op == 6) // OpMemberName
         {
@@ -3929,6 +3987,8 @@ int resolve_shader_info(const uint32_t* spv_data, size_t spv_data_size, ShaderIn
     for (int i = 0; i < binding_count; i++)
     {
         shader_info.binding_types[i] = id_types[binding_types[i]];
+        if (shader_info.binding_types[i] == 3 && id_linear[binding_types[i]])
+            shader_info.binding_types[i] = 4;
     }
 
     return 0;
@@ -229,6 +229,9 @@ public:
     // immutable sampler for texelfetch
     const VkSampler* immutable_texelfetch_sampler() const;
 
+    // immutable sampler for hardware linear filtering
+    const VkSampler* immutable_linear_sampler() const;
+
     // dummy buffer image
     VkMat get_dummy_buffer() const;
     VkImageMat get_dummy_image() const;
@@ -328,6 +331,7 @@ public:
     // 1 = storage buffer
     // 2 = storage image
     // 3 = combined image sampler
+    // 4 = combined image sampler with linear filter
     int binding_types[16]; // 16 is large enough I think ...
 
     int reserved_0;
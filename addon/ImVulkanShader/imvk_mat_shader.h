@@ -122,6 +122,91 @@ void main()
 }
 )";
 
+// one invocation storing one value, dispatch cost without any work
+static const char glsl_dispatch_data[] = R"(
+#version 450
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+void main()
+{
+    if (gl_GlobalInvocationID.x == 0)
+        c_blob_data[0] = 1.f;
+}
+)";
+
+// workgroup of 128 reading 4 vec4 from shared memory per loop
+static const char glsl_shared_data[] = R"(
+#version 450
+layout (constant_id = 0) const int count = 0;
+layout (constant_id = 1) const int loop = 1;
+layout (binding = 0) writeonly buffer c_blob { vec4 c_blob_data[]; };
+shared vec4 tmp[128];
+void main()
+{
+    int gx = int(gl_GlobalInvocationID.x);
+    int lx = int(gl_LocalInvocationID.x);
+    tmp[lx] = vec4(float(lx));
+    memoryBarrierShared();
+    barrier();
+    vec4 sum = vec4(0.f);
+    for (int i = 0; i < loop; i++)
+    {
+        sum += tmp[(lx + i) & 127];
+        sum += tmp[(lx + i + 32) & 127];
+        sum += tmp[(lx + i + 64) & 127];
+        sum += tmp[(lx + i + 96) & 127];
+    }
+    if (gx < count)
+        c_blob_data[gx] = sum;
+}
+)";
+
+// 3x3 box over a w x h vec4 plane, from buffer or from image with use_image_storage
+static const char glsl_box_data[] = R"(
+#version 450
+#if ImVulkan_fp16_storage
+#extension GL_EXT_shader_16bit_storage: require
+#endif
+#if ImVulkan_fp16_arithmetic
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#endif
+layout (constant_id = 0) const int w = 0;
+layout (constant_id = 1) const int h = 0;
+#if ImVulkan_image_shader
+layout (binding = 0) uniform unfp sampler3D a_blob;
+layout (binding = 1, imfmtc4) writeonly uniform unfp image3D c_blob;
+#else
+layout (binding = 0) readonly buffer a_blob { sfpvec4 a_blob_data[]; };
+layout (binding = 1) writeonly buffer c_blob { sfpvec4 c_blob_data[]; };
+#endif
+void main()
+{
+    int gx = int(gl_GlobalInvocationID.x);
+    int gy = int(gl_GlobalInvocationID.y);
+    if (gx >= w || gy >= h)
+        return;
+    afpvec4 sum = afpvec4(0.f);
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            int sx = clamp(gx + x, 0, w - 1);
+            int sy = clamp(gy + y, 0, h - 1);
+#if ImVulkan_image_shader
+            sum += image3d_ld4(a_blob, ivec3(sx, sy, 0));
+#else
+            sum += buffer_ld4(a_blob_data, sy * w + sx);
+#endif
+        }
+    }
+    sum = sum / afp(9.f);
+#if ImVulkan_image_shader
+    image3d_st4(c_blob, ivec3(gx, gy, 0), sum);
+#else
+    buffer_st4(c_blob_data, gy * w + gx, sum);
+#endif
+}
+)";
+
 #define SHADER_HEADER \
 "\
 #version 450 \n\
@@ -151,6 +236,8 @@ void main()
 #define INTERPOLATE_AREA        3 \n\
 #define INTERPOLATE_TRILINEAR   4 \n\
 #define INTERPOLATE_TETRAHEDRAL 5 \n\
+#define INTERPOLATE_LANCZOS     6 \n\
+#define INTERPOLATE_PYRAMID     7 \n\
 #define CS_SRGB     0 \n\
 #define CS_BT601    1 \n\
 #define CS_BT709    2 \n\
@@ -1113,3 +1200,45 @@ sfpvec4 hsv_to_rgb(sfpvec4 hsv) \n\
     return rgba; \n\
 } \
 "
+
+// Store a gray, rgb or rgba mat into a rgba8 storage image, channels keep their memory order like a buffer to image copy
+#define SHADER_STORE_TEXTURE_MAIN \
+" \n\
+layout (binding = 4, rgba8) writeonly uniform image2D dst_image; \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_type; \n\
+} p; \n\
+void main() \n\
+{ \n\
+    int gx = int(gl_GlobalInvocationID.x); \n\
+    int gy = int(gl_GlobalInvocationID.y); \n\
+    if (gx >= p.w || gy >= p.h) \n\
+        return; \n\
+    int offset = (gy * p.w + gx) * p.cstep; \n\
+    vec4 rgba = vec4(0.f, 0.f, 0.f, 1.f); \n\
+    for (int i = 0; i < p.cstep && i < 4; i++) \n\
+    { \n\
+        if (p.in_type == DT_INT8) \n\
+            rgba[i] = float(uint(src_data_int8[offset + i])) / 255.f; \n\
+        else if (p.in_type == DT_INT16) \n\
+            rgba[i] = float(uint(src_data_int16[offset + i])) / 65535.f; \n\
+        else if (p.in_type == DT_FLOAT16) \n\
+            rgba[i] = float(src_data_float16[offset + i]); \n\
+        else if (p.in_type == DT_FLOAT32) \n\
+            rgba[i] = src_data_float32[offset + i]; \n\
+    } \n\
+    if (p.cstep == 1) \n\
+        rgba.gb = rgba.rr; \n\
+    imageStore(dst_image, ivec2(gx, gy), clamp(rgba, vec4(0.f), vec4(1.f))); \n\
+} \
+"
+
+static const char store_texture_data[] =
+SHADER_HEADER
+SHADER_SRC_DATA
+SHADER_STORE_TEXTURE_MAIN
+;
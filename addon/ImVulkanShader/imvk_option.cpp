@@ -41,4 +41,28 @@ Option::Option()
     use_cooperative_matrix = true;
 }
 
+static ImDataType g_intermediate_type = IM_DT_FLOAT16;
+
+void set_intermediate_type(ImDataType type)
+{
+    g_intermediate_type = type == IM_DT_FLOAT32 ? IM_DT_FLOAT32 : IM_DT_FLOAT16;
+}
+
+ImDataType get_intermediate_type()
+{
+    return g_intermediate_type;
+}
+
+ImDataType intermediate_type(ImPrecision precision)
+{
+    return precision == IM_PRECISION_FP32 ? IM_DT_FLOAT32 : g_intermediate_type;
+}
+
+void apply_precision(Option& opt, ImPrecision precision)
+{
+    // sfp, the type shaders load into and mostly compute in, is half with use_fp16_storage
+    bool half = g_intermediate_type == IM_DT_FLOAT16;
+    opt.use_fp16_storage = half && precision == IM_PRECISION_FP16;
+    opt.use_fp16_arithmetic = half && precision != IM_PRECISION_FP32;
+}
 } // namespace ImGui
@@ -1,5 +1,6 @@
 #pragma once
 #include "imvk_platform.h"
+#include "immat.h"
 
 namespace ImGui 
 {
@@ -82,5 +83,27 @@ public:
     bool use_reserved_11;
 };
 
+// Chain-wide precision policy. Every filter declares what it needs with apply_precision(opt, ...) in its
+// constructor, and device resident frames passed between filters take intermediate_type(...):
+//   IM_PRECISION_FP16          point ops on 0..1 values, half storage and half math
+//   IM_PRECISION_FP16_STORAGE  half intermediates but fp32 math, for kernels and resamplers summing many taps
+//                              and for int16 sources whose 16 bit steps half floats can't hold
+//   IM_PRECISION_FP32          fp32 end to end, statistics and color science
+// With set_intermediate_type(IM_DT_FLOAT32) every filter built afterwards runs fp32 end to end, the
+// reference a half chain is checked against. IM_DT_FLOAT16 is the default and halves the bandwidth of
+// every intermediate against fp32. Options are read when a filter is constructed.
+enum ImPrecision
+{
+    IM_PRECISION_FP16 = 0,
+    IM_PRECISION_FP16_STORAGE,
+    IM_PRECISION_FP32,
+};
+
+VKSHADER_API void set_intermediate_type(ImDataType type);
+VKSHADER_API ImDataType get_intermediate_type();
+// type for a device resident intermediate written by a filter of that precision
+VKSHADER_API ImDataType intermediate_type(ImPrecision precision = IM_PRECISION_FP16);
+// use_fp16_storage / use_fp16_arithmetic for a filter of that precision under the current policy
+VKSHADER_API void apply_precision(Option& opt, ImPrecision precision);
 } // namespace ImGui
 
@@ -1,8 +1,10 @@
 #include "imvk_pipeline.h"
 #include "imvk_pipelinecache.h"
 #include "imvk_option.h"
+#include "imvk_command.h"
 
 #include <math.h>
+#include <string.h>
 
 namespace ImGui 
 {
@@ -20,8 +22,41 @@ public:
     uint32_t local_size_x;
     uint32_t local_size_y;
     uint32_t local_size_z;
+
+    // set_optimal_local_size_xyz pipelines keep their spirv for tuned variants
+    bool tunable;
+    std::vector<uint32_t> spv;
+    std::vector<vk_specialization_type> specializations;
+    // variant per resolution class, this pipeline itself when its local size won
+    mutable const Pipeline* variants[4];
+    mutable Mutex variants_lock;
 };
 
+// 720p, 1080p, 2160p and above
+static int resolution_class(const ImMat& dispatcher)
+{
+    size_t size = (size_t)dispatcher.w * dispatcher.h * dispatcher.c;
+    return size <= 1280 * 720 ? 0 : size <= 1920 * 1080 ? 1 : size <= 3840 * 2160 ? 2 : 3;
+}
+
+// shared arrays are sized for the local size the shader was written for, another one would index out of them
+static bool has_workgroup_memory(const uint32_t* spv_data, size_t spv_data_size)
+{
+    const uint32_t* p = spv_data + 5;
+    const uint32_t* end = spv_data + spv_data_size / 4;
+    while (p < end)
+    {
+        uint16_t wordcount = p[0] >> 16;
+        uint16_t op = p[0] & 0xffff;
+        if (wordcount == 0)
+            break;
+        if (op == 59 && wordcount >= 4 && p[3] == 4) // OpVariable in Workgroup storage
+            return true;
+        p += wordcount;
+    }
+    return false;
+}
+
 Pipeline::Pipeline(const VulkanDevice* _vkdev)
     : vkdev(_vkdev), d(new PipelinePrivate)
 {
@@ -34,10 +69,19 @@ Pipeline::Pipeline(const VulkanDevice* _vkdev)
     d->local_size_x = 1;
     d->local_size_y = 1;
     d->local_size_z = 1;
+
+    d->tunable = false;
+    for (int i = 0; i < 4; i++)
+        d->variants[i] = 0;
 }
 
 Pipeline::~Pipeline()
 {
+    for (int i = 0; i < 4; i++)
+    {
+        if (d->variants[i] != this)
+            delete d->variants[i];
+    }
     delete d;
 }
 
@@ -74,21 +118,20 @@ void Pipeline::set_optimal_local_size_xyz(const ImMat& local_size_xyz)
     h = std::min(h, (int)vkdev->info.max_workgroup_size_y());
     c = std::min(c, (int)vkdev->info.max_workgroup_size_z());
 
-    if (w * h * c <= (int)vkdev->info.max_workgroup_invocations())
-    {
-        return set_local_size_xyz(w, h, c);
-    }
-
-    int max_local_size_xy = (int)vkdev->info.max_workgroup_invocations() / c;
-
-    int wh_max = std::max(1, (int)sqrt(max_local_size_xy));
-    while (w * h >= wh_max)
+    if (w * h * c > (int)vkdev->info.max_workgroup_invocations())
     {
-        w = std::max(1, w / 2);
-        h = std::max(1, h / 2);
+        int max_local_size_xy = (int)vkdev->info.max_workgroup_invocations() / c;
+
+        int wh_max = std::max(1, (int)sqrt(max_local_size_xy));
+        while (w * h >= wh_max)
+        {
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+        }
     }
 
     set_local_size_xyz(w, h, c);
+    d->tunable = true;
 }
 
 void Pipeline::set_local_size_xyz(int w, int h, int c)
@@ -96,12 +139,22 @@ void Pipeline::set_local_size_xyz(int w, int h, int c)
     d->local_size_x = w;
     d->local_size_y = h;
     d->local_size_z = c;
+    d->tunable = false;
 }
 
 int Pipeline::create(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations)
 {
     const PipelineCache* pipeline_cache = vkdev->get_pipeline_cache();
 
+    if (d->tunable && has_workgroup_memory(spv_data, spv_data_size))
+        d->tunable = false;
+
+    if (d->tunable)
+    {
+        d->spv.assign(spv_data, spv_data + spv_data_size / 4);
+        d->specializations = specializations;
+    }
+
     // get from pipeline cache
     return pipeline_cache->get_pipeline(spv_data, spv_data_size, specializations, d->local_size_x, d->local_size_y, d->local_size_z,
                                         &d->shader_module, &d->descriptorset_layout, &d->pipeline_layout, &d->pipeline, &d->descriptor_update_template,
@@ -160,6 +213,133 @@ uint32_t Pipeline::local_size_z() const
     return d->local_size_z;
 }
 
+const Pipeline* Pipeline::tuned(const std::vector<VkMat>& bindings, const std::vector<vk_constant_type>& constants, const ImMat& dispatcher) const
+{
+    if (!d->tunable || d->spv.empty() || !get_local_size_tuning())
+        return this;
+
+    const int size_class = resolution_class(dispatcher);
+    MutexLockGuard lock(d->variants_lock);
+    if (d->variants[size_class])
+        return d->variants[size_class];
+
+    const PipelineCache* pipeline_cache = vkdev->get_pipeline_cache();
+    const uint32_t* spv_data = d->spv.data();
+    const size_t spv_data_size = d->spv.size() * 4;
+    uint32_t x, y, z;
+    if (pipeline_cache->get_tuned_local_size(spv_data, spv_data_size, d->specializations, size_class, &x, &y, &z) != 0)
+    {
+        // candidates for the dispatch shape, the current local size first
+        struct local_size { int w, h, c; };
+        std::vector<local_size> candidates;
+        candidates.push_back({ (int)d->local_size_x, (int)d->local_size_y, (int)d->local_size_z });
+        int subgroup = std::max(8, (int)vkdev->info.subgroup_size());
+        if (dispatcher.h == 1 && dispatcher.c == 1)
+        {
+            const int sizes[] = { 64, 128, 256, subgroup };
+            for (int s : sizes) candidates.push_back({ s, 1, 1 });
+        }
+        else if (dispatcher.c == 1)
+        {
+            const int sizes[][2] = { { 8, 8 }, { 16, 8 }, { 16, 16 }, { 32, 8 }, { 32, 4 }, { 64, 4 }, { subgroup, 4 } };
+            for (auto& s : sizes) candidates.push_back({ s[0], s[1], 1 });
+        }
+        else
+        {
+            const int sizes[][3] = { { 4, 4, 4 }, { 8, 8, 1 }, { 8, 8, 4 }, { 16, 16, 1 }, { 32, 8, 1 } };
+            for (auto& s : sizes) candidates.push_back({ s[0], s[1], s[2] });
+        }
+
+        // the tuning dispatches never touch the caller's buffers: shaders may write them in place and
+        // their inputs aren't filled before the caller's command runs. time on zero filled scratch
+        // buffers shaped like the bindings instead, aliased bindings stay aliased
+        Option opt;
+        opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+        opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+        std::vector<VkMat> scratch(bindings.size());
+        {
+            VkCompute cmd(vkdev);
+            for (size_t i = 0; i < bindings.size(); i++)
+            {
+                if (bindings[i].empty()) continue;
+                for (size_t j = 0; j < i && scratch[i].empty(); j++)
+                {
+                    if (bindings[j].data == bindings[i].data)
+                        scratch[i] = scratch[j];
+                }
+                if (!scratch[i].empty()) continue;
+                ImMat zero;
+                zero.create_like(bindings[i]);
+                memset(zero.data, 0, zero.total() * zero.elemsize);
+                cmd.record_clone(zero, scratch[i], opt);
+            }
+            cmd.submit_and_wait();
+        }
+
+        double best_time = 0;
+        x = d->local_size_x;
+        y = d->local_size_y;
+        z = d->local_size_z;
+        std::vector<local_size> tested;
+        for (auto& candidate : candidates)
+        {
+            int w = std::min(candidate.w, (int)vkdev->info.max_workgroup_size_x());
+            int h = std::min(candidate.h, (int)vkdev->info.max_workgroup_size_y());
+            int c = std::min(candidate.c, (int)vkdev->info.max_workgroup_size_z());
+            if (w * h * c > (int)vkdev->info.max_workgroup_invocations())
+                continue;
+            bool duplicate = false;
+            for (auto& t : tested)
+                duplicate |= t.w == w && t.h == h && t.c == c;
+            if (duplicate)
+                continue;
+            tested.push_back({ w, h, c });
+
+            Pipeline variant(vkdev);
+            variant.set_local_size_xyz(w, h, c);
+            if (variant.create(spv_data, spv_data_size, d->specializations) != 0)
+                continue;
+            VkCompute cmd(vkdev);
+            cmd.record_pipeline(&variant, scratch, std::vector<VkImageMat>(), constants, dispatcher); // warm up
+            cmd.submit_and_wait();
+            cmd.reset();
+            for (int i = 0; i < 3; i++)
+                cmd.record_pipeline(&variant, scratch, std::vector<VkImageMat>(), constants, dispatcher);
+            double t0 = get_current_time();
+            cmd.submit_and_wait();
+            double time = get_current_time() - t0;
+            if (best_time == 0 || time < best_time)
+            {
+                best_time = time;
+                x = w;
+                y = h;
+                z = c;
+            }
+        }
+
+        scratch.clear();
+        vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+        vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+        pipeline_cache->set_tuned_local_size(spv_data, spv_data_size, d->specializations, size_class, x, y, z);
+    }
+
+    if (x == d->local_size_x && y == d->local_size_y && z == d->local_size_z)
+    {
+        d->variants[size_class] = this;
+        return this;
+    }
+    Pipeline* variant = new Pipeline(vkdev);
+    variant->set_local_size_xyz(x, y, z);
+    if (variant->create(spv_data, spv_data_size, d->specializations) != 0)
+    {
+        delete variant;
+        d->variants[size_class] = this;
+        return this;
+    }
+    d->variants[size_class] = variant;
+    return variant;
+}
+
 void Pipeline::set_shader_module(VkShaderModule shader_module)
 {
     d->shader_module = shader_module;
@@ -7,6 +7,7 @@
 namespace ImGui 
 {
 class Option;
+class VkMat;
 class PipelinePrivate;
 class ShaderInfo;
 class VKSHADER_API Pipeline
@@ -36,6 +37,12 @@ public:
     uint32_t local_size_y() const;
     uint32_t local_size_z() const;
 
+    // with set_local_size_tuning on, the variant to dispatch for this size: the first dispatch of a
+    // resolution class times a few local sizes on scratch buffers shaped like the given bindings
+    // and keeps the fastest, the bindings themselves are never read or written.
+    // pipelines with a fixed local size or shared memory in their shader are returned as is
+    const Pipeline* tuned(const std::vector<VkMat>& bindings, const std::vector<vk_constant_type>& constants, const ImMat& dispatcher) const;
+
 protected:
     void set_shader_module(VkShaderModule shader_module);
     void set_descriptorset_layout(VkDescriptorSetLayout descriptorset_layout);
@@ -1,8 +1,23 @@
 #include "imvk_pipelinecache.h"
 #include "imvk_gpu.h"
+#include <stdio.h>
 
 namespace ImGui 
 {
+static bool g_local_size_tuning = false;
+static std::string g_local_size_tuning_dir;
+
+void set_local_size_tuning(bool enable, const std::string& dir)
+{
+    g_local_size_tuning = enable;
+    g_local_size_tuning_dir = dir;
+}
+
+bool get_local_size_tuning()
+{
+    return g_local_size_tuning;
+}
+
 static uint32_t murmur3_32(const uint32_t* data, int size)
 {
     uint32_t h = 0;
@@ -105,8 +120,22 @@ public:
     mutable std::vector<pipeline_cache_digest> cache_digests;
     mutable std::vector<pipeline_cache_artifact> cache_artifacts;
     mutable Mutex cache_lock;
+
+    // digest with the resolution class in place of local size -> tuned local size
+    mutable std::vector<pipeline_cache_digest> tuned_digests;
+    mutable std::vector<uint32_t> tuned_local_sizes;
+    mutable bool tuned_loaded {false};
 };
 
+static std::string tuned_local_size_path(const VulkanDevice* vkdev)
+{
+    if (g_local_size_tuning_dir.empty())
+        return std::string();
+    char name[64];
+    snprintf(name, sizeof(name), "/imvk_local_size_%04x_%04x.txt", vkdev->info.vendor_id(), vkdev->info.device_id());
+    return g_local_size_tuning_dir + name;
+}
+
 PipelineCachePrivate::pipeline_cache_digest::pipeline_cache_digest(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations,
         uint32_t local_size_x, uint32_t local_size_y, uint32_t local_size_z)
 {
@@ -292,6 +321,67 @@ int PipelineCache::get_pipeline(const uint32_t* spv_data, size_t spv_data_size,
     return 0;
 }
 
+int PipelineCache::get_tuned_local_size(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations, int size_class,
+                                        uint32_t* local_size_x, uint32_t* local_size_y, uint32_t* local_size_z) const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    if (!d->tuned_loaded)
+    {
+        // one line per winner, d0 d1 and local size packed as x | y << 10 | z << 20
+        d->tuned_loaded = true;
+        std::string path = tuned_local_size_path(vkdev);
+        FILE* fp = path.empty() ? nullptr : fopen(path.c_str(), "rb");
+        if (fp)
+        {
+            unsigned long long d0, d1;
+            unsigned int size;
+            while (fscanf(fp, "%llx %llx %x", &d0, &d1, &size) == 3)
+            {
+                PipelineCachePrivate::pipeline_cache_digest key(spv_data, 0, specializations, 0, 0, 0);
+                key.d0 = d0;
+                key.d1 = d1;
+                d->tuned_digests.push_back(key);
+                d->tuned_local_sizes.push_back(size);
+            }
+            fclose(fp);
+        }
+    }
+
+    PipelineCachePrivate::pipeline_cache_digest key(spv_data, spv_data_size, specializations, size_class, 0, 0);
+    // last one wins, the file is append only
+    for (int i = (int)d->tuned_digests.size() - 1; i >= 0; i--)
+    {
+        if (d->tuned_digests[i] != key)
+            continue;
+        uint32_t size = d->tuned_local_sizes[i];
+        *local_size_x = size & 0x3ff;
+        *local_size_y = (size >> 10) & 0x3ff;
+        *local_size_z = (size >> 20) & 0x3ff;
+        return 0;
+    }
+    return -1;
+}
+
+void PipelineCache::set_tuned_local_size(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations, int size_class,
+                                        uint32_t local_size_x, uint32_t local_size_y, uint32_t local_size_z) const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    PipelineCachePrivate::pipeline_cache_digest key(spv_data, spv_data_size, specializations, size_class, 0, 0);
+    uint32_t size = local_size_x | local_size_y << 10 | local_size_z << 20;
+    d->tuned_digests.push_back(key);
+    d->tuned_local_sizes.push_back(size);
+
+    std::string path = tuned_local_size_path(vkdev);
+    FILE* fp = path.empty() ? nullptr : fopen(path.c_str(), "ab");
+    if (fp)
+    {
+        fprintf(fp, "%016llx %016llx %08x\n", (unsigned long long)key.d0, (unsigned long long)key.d1, size);
+        fclose(fp);
+    }
+}
+
 int PipelineCache::new_pipeline(VkShaderModule shader_module, const ShaderInfo& shader_info, const std::vector<vk_specialization_type>& specializations,
                                 VkDescriptorSetLayout* _descriptorset_layout,
                                 VkPipelineLayout* _pipeline_layout,
@@ -2,9 +2,16 @@
 #include "imvk_platform.h"
 #include "imvk_gpu.h"
 #include <vulkan/vulkan.h>
+#include <string>
 
 namespace ImGui 
 {
+// workgroup size auto tuning of pipelines set with set_optimal_local_size_xyz, off by default.
+// winners are kept per device in the pipeline cache, a non empty dir also stores them on disk
+// (one file per device) so later runs apply them without benchmarking again.
+VKSHADER_API void set_local_size_tuning(bool enable, const std::string& dir = "");
+VKSHADER_API bool get_local_size_tuning();
+
 class VulkanDevice;
 class PipelineCachePrivate;
 class VKSHADER_API PipelineCache
@@ -25,6 +32,12 @@ public:
                     VkDescriptorUpdateTemplateKHR* descriptor_update_template,
                     ShaderInfo& shader_info) const;
 
+    // tuned local size of a shader for a resolution class, return -1 when not tuned yet
+    int get_tuned_local_size(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations, int size_class,
+                            uint32_t* local_size_x, uint32_t* local_size_y, uint32_t* local_size_z) const;
+    void set_tuned_local_size(const uint32_t* spv_data, size_t spv_data_size, const std::vector<vk_specialization_type>& specializations, int size_class,
+                            uint32_t local_size_x, uint32_t local_size_y, uint32_t local_size_z) const;
+
 protected:
     int new_pipeline(VkShaderModule shader_module, const ShaderInfo& shader_info, const std::vector<vk_specialization_type>& specializations,
                     VkDescriptorSetLayout* descriptorset_layout,
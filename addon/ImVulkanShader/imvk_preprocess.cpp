@@ -0,0 +1,148 @@
+#include "imvk_preprocess.h"
+#include "imvk_command.h"
+#include "imvk_preprocess_shader.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ImGui 
+{
+extern const ImMat * color_table[2][2][4];
+Preprocess_vulkan::Preprocess_vulkan(int gpu)
+{
+    vkdev = get_gpu_device(gpu);
+    if (!vkdev) return;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    opt.use_image_storage = true;
+    apply_precision(opt, IM_PRECISION_FP16_STORAGE);
+    cmd = new VkCompute(vkdev);
+
+    std::vector<vk_specialization_type> specializations(0);
+    std::vector<uint32_t> spirv_data;
+
+    if (compile_spirv_module(Preprocess_data, opt, spirv_data) == 0)
+    {
+        pipe = new Pipeline(vkdev);
+        pipe->set_optimal_local_size_xyz(16, 16, 1);
+        pipe->create(spirv_data.data(), spirv_data.size() * 4, specializations);
+    }
+    
+    cmd->reset();
+}
+
+Preprocess_vulkan::~Preprocess_vulkan()
+{
+    if (vkdev)
+    {
+        matrix_y2r.release();
+        if (pipe) { delete pipe; pipe = nullptr; }
+        if (cmd) { delete cmd; cmd = nullptr; }
+        if (opt.blob_vkallocator) { vkdev->reclaim_blob_allocator(opt.blob_vkallocator); opt.blob_vkallocator = nullptr; }
+        if (opt.staging_vkallocator) { vkdev->reclaim_staging_allocator(opt.staging_vkallocator); opt.staging_vkallocator = nullptr; }
+    }
+}
+
+void Preprocess_vulkan::upload_param(const VkMat& src, VkMat& dst, std::vector<float>& mean_vals, std::vector<float>& norm_vals, float pad_value, bool bgr, ImInterpolateMode type)
+{
+    int range = src.color_range == IM_CR_NARROW_RANGE ? 1 : 0;
+    int space = std::min(std::max((int)src.color_space, 0), 3);
+    if (matrix_index != range * 4 + space)
+    {
+        cmd->record_clone(*color_table[0][range][space], matrix_y2r, opt);
+        matrix_index = range * 4 + space;
+    }
+    int bitDepth = src.depth != 0 ? src.depth : src.type == IM_DT_INT8 ? 8 : src.type == IM_DT_INT16 ? 16 : 8;
+
+    std::vector<VkMat> bindings(9);
+    if      (dst.type == IM_DT_FLOAT16)  bindings[2] = dst;
+    else if (dst.type == IM_DT_FLOAT32)  bindings[3] = dst;
+
+    if      (src.type == IM_DT_INT8)     bindings[4] = src;
+    else if (src.type == IM_DT_INT16)    bindings[5] = src;
+    else if (src.type == IM_DT_FLOAT16)  bindings[6] = src;
+    else if (src.type == IM_DT_FLOAT32)  bindings[7] = src;
+    bindings[8] = matrix_y2r;
+
+    std::vector<vk_constant_type> constants(25);
+    constants[0].i = src.w;
+    constants[1].i = src.h;
+    constants[2].i = src.c;
+    constants[3].i = src.color_format;
+    constants[4].i = src.type;
+    constants[5].i = src.color_range;
+    constants[6].f = (float)((1 << bitDepth) - 1);
+    constants[7].i = dst.w;
+    constants[8].i = dst.h;
+    constants[9].i = (int)dst.cstep;
+    constants[10].i = dst.type;
+    constants[11].i = dst.elempack;
+    constants[12].i = bgr ? 1 : 0;
+    constants[13].i = type;
+    constants[14].i = roi_x;
+    constants[15].i = roi_y;
+    constants[16].i = roi_w;
+    constants[17].i = roi_h;
+    constants[18].f = pad_value;
+    constants[19].f = mean_vals[0];
+    constants[20].f = mean_vals[1];
+    constants[21].f = mean_vals[2];
+    constants[22].f = norm_vals[0];
+    constants[23].f = norm_vals[1];
+    constants[24].f = norm_vals[2];
+    cmd->record_pipeline(pipe, bindings, constants, dst);
+}
+
+void Preprocess_vulkan::forward(const ImMat& src, ImMat& dst, int out_w, int out_h, std::vector<float> mean_vals, std::vector<float> norm_vals,
+                                int elempack, bool letterbox, float pad_value, bool bgr, ImInterpolateMode type)
+{
+    if (!vkdev || !pipe || !cmd)
+    {
+        return;
+    }
+    if (src.empty() || out_w <= 0 || out_h <= 0 || (elempack != 1 && elempack != 4 && elempack != 8))
+        return;
+    mean_vals.resize(3, 0.f);
+    norm_vals.resize(3, 1.f);
+
+    roi_x = roi_y = 0;
+    roi_w = out_w;
+    roi_h = out_h;
+    if (letterbox)
+    {
+        float scale = std::min((float)out_w / src.w, (float)out_h / src.h);
+        roi_w = std::max(1, (int)roundf(src.w * scale));
+        roi_h = std::max(1, (int)roundf(src.h * scale));
+        roi_x = (out_w - roi_w) / 2;
+        roi_y = (out_h - roi_h) / 2;
+    }
+
+    // 3 planes, or one group of elempack lanes
+    ImDataType out_type = dst.type == IM_DT_FLOAT16 ? IM_DT_FLOAT16 : IM_DT_FLOAT32;
+    size_t elemsize = (out_type == IM_DT_FLOAT16 ? 2u : 4u) * elempack;
+    int out_c = elempack == 1 ? 3 : 1;
+
+    VkMat src_gpu;
+    if (src.device == IM_DD_VULKAN)
+        src_gpu = src;
+    else if (src.device == IM_DD_CPU)
+        cmd->record_clone(src, src_gpu, opt);
+
+    VkMat dst_gpu;
+    dst_gpu.create(out_w, out_h, out_c, elemsize, elempack, opt.blob_vkallocator);
+    dst_gpu.type = out_type;
+
+    upload_param(src_gpu, dst_gpu, mean_vals, norm_vals, pad_value, bgr, type);
+
+    // download
+    if (dst.device == IM_DD_CPU)
+    {
+        cmd->record_clone(dst_gpu, dst, opt);
+    }
+    else if (dst.device == IM_DD_VULKAN)
+        dst = dst_gpu;
+    cmd->submit_and_wait();
+    cmd->reset();
+    dst.type = out_type;
+    dst.time_stamp = src.time_stamp;
+}
+} // namespace ImGui
@@ -0,0 +1,44 @@
+#pragma once
+#include "imvk_gpu.h"
+#include "imvk_pipeline.h"
+#include <vector>
+
+namespace ImGui 
+{
+// Decoded frame to network input in one dispatch: yuv/rgb load, resize, letterbox, mean/norm and NCHW store.
+// Source is any ColorConvert_vulkan yuv format (NV12, P010, YUV420/422/444) or ABGR/ARGB/BGR/RGB.
+// Output is 3 channel fp16 or fp32 (dst.type, fp32 by default), planar for elempack 1, for elempack 4/8
+// the 3 channels are packed in one group padded with zero. Pixel values are in [0, 1] before
+// (v - mean) * norm, channel order is rgb unless bgr is set.
+// With letterbox the frame keeps its aspect and is centered, the border is pad_value like copy_make_border
+// then normalized with the frame, otherwise the frame is stretched to out_w x out_h.
+class VKSHADER_API Preprocess_vulkan
+{
+public:
+    Preprocess_vulkan(int gpu = -1);
+    ~Preprocess_vulkan();
+
+    void forward(const ImMat& src, ImMat& dst, int out_w, int out_h, std::vector<float> mean_vals, std::vector<float> norm_vals,
+                int elempack = 1, bool letterbox = true, float pad_value = 0.f, bool bgr = false, ImInterpolateMode type = IM_INTERPOLATE_BILINEAR);
+
+    // letterbox rect of the last forward, to map detections back to the frame
+    int roi_x {0};
+    int roi_y {0};
+    int roi_w {0};
+    int roi_h {0};
+
+public:
+    const VulkanDevice* vkdev   {nullptr};
+    Pipeline* pipe              {nullptr};
+    VkCompute * cmd             {nullptr};
+    Option opt;
+
+private:
+    // y2r matrix stays on gpu until the frame color space changes
+    VkMat matrix_y2r;
+    int matrix_index    {-1};
+
+private:
+    void upload_param(const VkMat& src, VkMat& dst, std::vector<float>& mean_vals, std::vector<float>& norm_vals, float pad_value, bool bgr, ImInterpolateMode type);
+};
+} // namespace ImGui
@@ -0,0 +1,176 @@
+#pragma once
+#include <imvk_mat_shader.h>
+#include "filters/ColorConvert_shader.h"
+
+#define PREPROCESS_PARAM \
+" \n\
+layout (push_constant) uniform parameter \n\
+{ \n\
+    int w; \n\
+    int h; \n\
+    int cstep; \n\
+    int in_format; \n\
+    int in_type; \n\
+    int in_range; \n\
+    float in_scale; \n\
+    \n\
+    int out_w; \n\
+    int out_h; \n\
+    int out_cstep; \n\
+    int out_type; \n\
+    int out_elempack; \n\
+    int swap_rb; \n\
+    int interp_type; \n\
+    \n\
+    int roi_x; \n\
+    int roi_y; \n\
+    int roi_w; \n\
+    int roi_h; \n\
+    float pad_value; \n\
+    \n\
+    float mean_r; \n\
+    float mean_g; \n\
+    float mean_b; \n\
+    float norm_r; \n\
+    float norm_g; \n\
+    float norm_b; \n\
+} p; \
+"
+
+// yuv loader of ColorConvert reads the frame through the common src bindings
+#define PREPROCESS_DATA \
+SHADER_INPUT_DATA \
+SHADER_OUTPUT_DATA \
+" \n\
+layout (binding = 8) readonly buffer mat_y2r { float convert_matrix_y2r[]; }; \n\
+#define YUV_data_int8    src_data_int8 \n\
+#define YUV_data_int16   src_data_int16 \n\
+#define YUV_data_float16 src_data_float16 \n\
+#define YUV_data_float32 src_data_float32 \n\
+"
+
+#define PREPROCESS_LOAD \
+" \n\
+bool is_yuv() \n\
+{ \n\
+    return p.in_format == CF_YUV420 || p.in_format == CF_YUV422 || p.in_format == CF_YUV444 || \n\
+           p.in_format == CF_NV12 || p.in_format == CF_P010LE; \n\
+} \n\
+\n\
+// yuv stays yuv until after filtering, the matrix is linear \n\
+sfpvec3 load_frame(int x, int y) \n\
+{ \n\
+    x = clamp(x, 0, p.w - 1); \n\
+    y = clamp(y, 0, p.h - 1); \n\
+    if (is_yuv()) \n\
+        return load_src_yuv(x, y); \n\
+    else if (p.cstep == 3) \n\
+        return load_rgb(x, y, p.w, p.cstep, p.in_format, p.in_type); \n\
+    else \n\
+        return load_rgba(x, y, p.w, p.cstep, p.in_format, p.in_type).rgb; \n\
+} \n\
+\n\
+sfpvec3 to_rgb(sfpvec3 v) \n\
+{ \n\
+    return is_yuv() ? yuv_to_rgb(v) : v; \n\
+} \n\
+\n\
+// pos is the continuous frame position of the output pixel center, scale the frame size of one output pixel \n\
+sfpvec3 sample_frame(vec2 pos, vec2 scale) \n\
+{ \n\
+    if (p.interp_type == INTERPOLATE_NEAREST) \n\
+    { \n\
+        ivec2 i = ivec2(floor(pos)); \n\
+        return load_frame(i.x, i.y); \n\
+    } \n\
+    else if (p.interp_type == INTERPOLATE_AREA && (scale.x > 1.f || scale.y > 1.f)) \n\
+    { \n\
+        vec2 b0 = max(pos - scale * 0.5f, vec2(0.f)); \n\
+        vec2 b1 = min(pos + scale * 0.5f, vec2(p.w, p.h)); \n\
+        int sx1 = int(floor(b0.x)), sx2 = int(ceil(b1.x)); \n\
+        int sy1 = int(floor(b0.y)), sy2 = int(ceil(b1.y)); \n\
+        vec3 sum = vec3(0.f); \n\
+        float area = 0.f; \n\
+        for (int j = sy1; j < sy2; j++) \n\
+        { \n\
+            float dy = min(float(j + 1), b1.y) - max(float(j), b0.y); \n\
+            for (int i = sx1; i < sx2; i++) \n\
+            { \n\
+                float dx = min(float(i + 1), b1.x) - max(float(i), b0.x); \n\
+                sum += vec3(load_frame(i, j)) * (dx * dy); \n\
+                area += dx * dy; \n\
+            } \n\
+        } \n\
+        return sfpvec3(sum / max(area, 1e-6f)); \n\
+    } \n\
+    vec2 c = pos - 0.5f; \n\
+    ivec2 i = ivec2(floor(c)); \n\
+    vec2 f = c - vec2(i); \n\
+    vec3 v00 = vec3(load_frame(i.x,     i.y)); \n\
+    vec3 v10 = vec3(load_frame(i.x + 1, i.y)); \n\
+    vec3 v01 = vec3(load_frame(i.x,     i.y + 1)); \n\
+    vec3 v11 = vec3(load_frame(i.x + 1, i.y + 1)); \n\
+    return sfpvec3(mix(mix(v00, v10, f.x), mix(v01, v11, f.x), f.y)); \n\
+} \
+"
+
+// one tensor value, planar for elempack 1, channels padded with zero up to the pack otherwise
+#define PREPROCESS_STORE \
+" \n\
+void store_value(float v, int x, int y, int ch) \n\
+{ \n\
+    int offset; \n\
+    if (p.out_elempack == 1) \n\
+        offset = ch * p.out_cstep + y * p.out_w + x; \n\
+    else \n\
+        offset = ((ch / p.out_elempack) * p.out_cstep + y * p.out_w + x) * p.out_elempack + ch % p.out_elempack; \n\
+    if (p.out_type == DT_FLOAT16) \n\
+        dst_data_float16[offset] = float16_t(v); \n\
+    else \n\
+        dst_data_float32[offset] = v; \n\
+} \
+"
+
+#define PREPROCESS_MAIN \
+" \n\
+void main() \n\
+{ \n\
+    int gx = int(gl_GlobalInvocationID.x); \n\
+    int gy = int(gl_GlobalInvocationID.y); \n\
+    if (gx >= p.out_w || gy >= p.out_h) \n\
+        return; \n\
+    vec3 rgb; \n\
+    if (gx < p.roi_x || gy < p.roi_y || gx >= p.roi_x + p.roi_w || gy >= p.roi_y + p.roi_h) \n\
+    { \n\
+        rgb = vec3(p.pad_value); \n\
+    } \n\
+    else \n\
+    { \n\
+        vec2 scale = vec2(float(p.w) / float(p.roi_w), float(p.h) / float(p.roi_h)); \n\
+        vec2 pos = (vec2(gx - p.roi_x, gy - p.roi_y) + 0.5f) * scale; \n\
+        rgb = vec3(to_rgb(sample_frame(pos, scale))); \n\
+    } \n\
+    if (p.swap_rb != 0) \n\
+        rgb = rgb.bgr; \n\
+    rgb = (rgb - vec3(p.mean_r, p.mean_g, p.mean_b)) * vec3(p.norm_r, p.norm_g, p.norm_b); \n\
+    store_value(rgb.r, gx, gy, 0); \n\
+    store_value(rgb.g, gx, gy, 1); \n\
+    store_value(rgb.b, gx, gy, 2); \n\
+    for (int ch = 3; ch < p.out_elempack; ch++) \n\
+        store_value(0.f, gx, gy, ch); \n\
+} \
+"
+
+static const char Preprocess_data[] =
+SHADER_HEADER
+PREPROCESS_PARAM
+PREPROCESS_DATA
+SHADER_MAT_Y2R
+SHADER_YUV2RGB
+SHADER_LOAD_SRC_YUV
+SHADER_LOAD_RGB
+SHADER_LOAD_RGBA
+PREPROCESS_LOAD
+PREPROCESS_STORE
+PREPROCESS_MAIN
+;
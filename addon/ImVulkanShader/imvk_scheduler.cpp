@@ -0,0 +1,225 @@
+#include "imvk_scheduler.h"
+#include "imvk_platform.h"
+#include <list>
+
+namespace ImGui
+{
+struct SchedulerJob
+{
+    std::function<void(int gpu)> func;
+    size_t bytes {0};
+};
+
+class GpuSchedulerPrivate;
+struct SchedulerLane
+{
+    GpuSchedulerPrivate* owner      {nullptr};
+    int gpu                         {-1};
+    const VulkanDevice* vkdev       {nullptr};   // null for the CPU lane
+    std::list<SchedulerJob> jobs;
+    int running                     {0};
+    size_t reserved_bytes           {0};
+    uint64_t completed              {0};
+    double busy_time                {0};
+    ConditionVariable cond;
+    Thread* thread                  {nullptr};
+};
+
+class GpuSchedulerPrivate
+{
+public:
+    std::vector<SchedulerLane*> lanes;
+    int max_queue_depth {2};
+    bool quit           {false};
+    double start_time   {0};
+    // guards every lane, workers signal idle_cond when a job ends
+    mutable Mutex mutex;
+    ConditionVariable idle_cond;
+};
+
+static void* scheduler_worker(void* args)
+{
+    SchedulerLane* lane = (SchedulerLane*)args;
+    GpuSchedulerPrivate* d = lane->owner;
+    while (true)
+    {
+        d->mutex.lock();
+        while (lane->jobs.empty() && !d->quit)
+            lane->cond.wait(d->mutex);
+        if (lane->jobs.empty())
+        {
+            // quit with the queue drained
+            d->mutex.unlock();
+            break;
+        }
+        SchedulerJob job = lane->jobs.front();
+        lane->jobs.pop_front();
+        lane->running++;
+        d->mutex.unlock();
+
+        double start = get_current_time();
+        job.func(lane->gpu);
+        double time = get_current_time() - start;
+
+        d->mutex.lock();
+        lane->running--;
+        lane->completed++;
+        lane->busy_time += time;
+        lane->reserved_bytes -= job.bytes;
+        d->idle_cond.broadcast();
+        d->mutex.unlock();
+    }
+    return 0;
+}
+
+GpuScheduler::GpuScheduler(bool cpu_lane, int max_queue_depth)
+    : d(new GpuSchedulerPrivate)
+{
+    d->max_queue_depth = std::max(max_queue_depth, 1);
+    int gpu_count = get_gpu_count();
+    for (int i = 0; i <= gpu_count; i++)
+    {
+        const VulkanDevice* vkdev = i < gpu_count ? get_gpu_device(i) : nullptr;
+        // without any device the CPU lane is the only way to run
+        if (i < gpu_count && !vkdev) continue;
+        if (i == gpu_count && !cpu_lane && !d->lanes.empty()) continue;
+        SchedulerLane* lane = new SchedulerLane;
+        lane->owner = d;
+        lane->gpu = i;
+        lane->vkdev = vkdev;
+        d->lanes.push_back(lane);
+    }
+    for (auto lane : d->lanes)
+        lane->thread = new Thread(scheduler_worker, lane);
+    d->start_time = get_current_time();
+}
+
+GpuScheduler::~GpuScheduler()
+{
+    d->mutex.lock();
+    d->quit = true;
+    for (auto lane : d->lanes)
+        lane->cond.signal();
+    d->mutex.unlock();
+    for (auto lane : d->lanes)
+    {
+        lane->thread->join();
+        delete lane->thread;
+        delete lane;
+    }
+    delete d;
+}
+
+int GpuScheduler::submit(const std::function<void(int gpu)>& job, size_t bytes)
+{
+    MutexLockGuard guard(d->mutex);
+    while (true)
+    {
+        // with nothing in flight no memory will come back, don't wait on the budget then
+        bool in_flight = false;
+        for (auto lane : d->lanes)
+            in_flight |= !lane->jobs.empty() || lane->running > 0;
+
+        int best = -1;
+        int best_depth = 0;
+        double best_cost = 0;
+        for (int i = 0; i < (int)d->lanes.size(); i++)
+        {
+            SchedulerLane* lane = d->lanes[i];
+            int depth = (int)lane->jobs.size() + lane->running;
+            if (depth >= d->max_queue_depth)
+                continue;
+            if (bytes > 0 && in_flight && lane->vkdev)
+            {
+                size_t need_mb = (lane->reserved_bytes + bytes) / 1024 / 1024;
+                if (lane->vkdev->get_heap_usage() + need_mb > lane->vkdev->get_heap_budget())
+                    continue;
+            }
+            // lanes without a finished job yet cost nothing, so every device gets measured first
+            double job_time = lane->completed ? lane->busy_time / lane->completed : 0;
+            double cost = (depth + 1) * job_time;
+            if (best < 0 || cost < best_cost || (cost == best_cost && depth < best_depth))
+            {
+                best = i;
+                best_cost = cost;
+                best_depth = depth;
+            }
+        }
+        if (best >= 0)
+        {
+            SchedulerLane* lane = d->lanes[best];
+            SchedulerJob sjob;
+            sjob.func = job;
+            sjob.bytes = bytes;
+            lane->jobs.push_back(sjob);
+            lane->reserved_bytes += bytes;
+            lane->cond.signal();
+            return lane->gpu;
+        }
+        d->idle_cond.wait(d->mutex);
+    }
+}
+
+void GpuScheduler::wait()
+{
+    MutexLockGuard guard(d->mutex);
+    while (true)
+    {
+        bool busy = false;
+        for (auto lane : d->lanes)
+            busy |= !lane->jobs.empty() || lane->running > 0;
+        if (!busy)
+            break;
+        d->idle_cond.wait(d->mutex);
+    }
+}
+
+int GpuScheduler::lane_count() const
+{
+    return (int)d->lanes.size();
+}
+
+std::vector<SchedulerLaneStat> GpuScheduler::stats() const
+{
+    std::vector<SchedulerLaneStat> result;
+    MutexLockGuard guard(d->mutex);
+    double elapsed = get_current_time() - d->start_time;
+    for (auto lane : d->lanes)
+    {
+        SchedulerLaneStat stat;
+        stat.gpu = lane->gpu;
+        stat.queue_depth = (int)lane->jobs.size() + lane->running;
+        stat.completed = lane->completed;
+        stat.busy_time = lane->busy_time;
+        stat.throughput = elapsed > 0 ? lane->completed / elapsed : 0;
+        if (lane->vkdev)
+        {
+            stat.heap_budget = lane->vkdev->get_heap_budget();
+            stat.heap_usage = lane->vkdev->get_heap_usage();
+        }
+        result.push_back(stat);
+    }
+    return result;
+}
+
+double GpuScheduler::throughput() const
+{
+    MutexLockGuard guard(d->mutex);
+    double elapsed = get_current_time() - d->start_time;
+    uint64_t completed = 0;
+    for (auto lane : d->lanes)
+        completed += lane->completed;
+    return elapsed > 0 ? completed / elapsed : 0;
+}
+
+void GpuScheduler::reset_stats()
+{
+    MutexLockGuard guard(d->mutex);
+    for (auto lane : d->lanes)
+    {
+        lane->completed = 0;
+        lane->busy_time = 0;
+    }
+    d->start_time = get_current_time();
+}
+} // namespace ImGui
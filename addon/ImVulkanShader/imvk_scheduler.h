@@ -0,0 +1,52 @@
+#pragma once
+#include "imvk_gpu.h"
+#include <functional>
+#include <vector>
+
+namespace ImGui
+{
+// Spreads independent jobs (frames, filter chains) over every vulkan device, plus a CPU lane on request.
+// Each lane has one worker thread and runs job(gpu) with its device index, the CPU lane gets get_gpu_count()
+// so filters constructed with it take their CPU path. Filters are bound to a device at construction, keep
+// one instance per index (get_gpu_count() + 1 slots) and create it lazily inside the job, a lane never runs
+// two jobs at once.
+// A job goes to the lane with the earliest expected finish (queue depth x measured job time), lanes at
+// max_queue_depth are skipped and so are devices where heap usage plus the bytes of their queued jobs would
+// pass the heap budget. submit blocks while no lane can take the job.
+struct VKSHADER_API SchedulerLaneStat
+{
+    int gpu                 {-1};
+    int queue_depth         {0};    // queued and running jobs
+    uint64_t completed      {0};
+    double busy_time        {0};    // seconds spent in jobs
+    double throughput       {0};    // jobs per second since start or reset_stats
+    uint32_t heap_budget    {0};    // MB, 0 for the CPU lane
+    uint32_t heap_usage     {0};    // MB, 0 for the CPU lane
+};
+
+class GpuSchedulerPrivate;
+class VKSHADER_API GpuScheduler
+{
+public:
+    GpuScheduler(bool cpu_lane = false, int max_queue_depth = 2);
+    ~GpuScheduler();
+
+    // bytes is the device memory the job will hold, 0 skips the budget check. return the gpu index it was queued on
+    int submit(const std::function<void(int gpu)>& job, size_t bytes = 0);
+    // block until every queued job is done
+    void wait();
+
+    int lane_count() const;
+    std::vector<SchedulerLaneStat> stats() const;
+    // jobs per second of all lanes since start or reset_stats
+    double throughput() const;
+    void reset_stats();
+
+private:
+    GpuScheduler(const GpuScheduler&);
+    GpuScheduler& operator=(const GpuScheduler&);
+
+private:
+    GpuSchedulerPrivate* const d;
+};
+} // namespace ImGui
@@ -17,6 +17,7 @@ typedef struct ApplicationWindowProperty
     bool auto_merge {true};
     bool center     {true};
     bool power_save {true};
+    bool damage_tracking {false};  // redraw only what changed and skip presenting unchanged frames, textures updated in place need ImGui::AddDamageTexture()
     void* handle    {nullptr};
 
 } ApplicationWindowProperty;
@@ -144,6 +144,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     io.Fonts->AddFontDefault();
     io.FontGlobalScale = property.scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking) io.ConfigDamageTracking = true;
     //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
     if (property.docking) io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
     if (property.viewport)io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
@@ -214,8 +215,14 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL3_ClearScreen(ImVec2(0, 0), io.DisplaySize, clear_color);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        bool main_changed = true;
+        if (io.ConfigDamageTracking)
+            main_changed = ImGui_ImplOpenGL3_RenderDrawDataDamage(ImGui::GetDrawData(), clear_color);
+        else
+        {
+            ImGui_ImplOpenGL3_ClearScreen(ImVec2(0, 0), io.DisplaySize, clear_color);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         // Update and Render additional Platform Windows
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -226,7 +233,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             wglMakeCurrent(dc, backup_context);
         }
 
-        SwapBuffers(dc);
+        if (main_changed)
+            SwapBuffers(dc);
     }
 
     Application_Finalize(&property.handle);
@@ -88,6 +88,7 @@ int main(int, char**)
     int w, h;
     glfwGetWindowSize(window, &w, &h);
     ImGui_ImplVulkanH_Window* wd = &g_MainWindowData;
+    wd->DamageEnable = property.damage_tracking;
     SetupVulkanWindow(wd, surface, w, h);
 
     ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -95,6 +96,7 @@ int main(int, char**)
     io.FontGlobalScale = property.scale;
     io.DisplayFramebufferScale = display_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking) io.ConfigDamageTracking = true;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
     //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
     if (property.docking) io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
@@ -73,6 +73,7 @@ int main(int, char**)
     io.Fonts->AddFontDefault();
     io.FontGlobalScale = property.scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnableLowRefreshMode;
+    if (property.damage_tracking) io.ConfigDamageTracking = true;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
     //io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
     if (property.docking) io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
@@ -89,6 +90,7 @@ int main(int, char**)
     int w, h;
     SDL_GetWindowSize(window, &w, &h);
     ImGui_ImplVulkanH_Window* wd = &g_MainWindowData;
+    wd->DamageEnable = property.damage_tracking;
     SetupVulkanWindow(wd, surface, w, h);
 
     // Setup Dear ImGui style
@@ -27,6 +27,8 @@ static VkDescriptorPool         g_DescriptorPool = VK_NULL_HANDLE;
 static ImGui_ImplVulkanH_Window g_MainWindowData;
 static uint32_t                 g_MinImageCount = 2;
 static bool                     g_SwapChainRebuild = false;
+static std::vector<ImVec4>      g_ImageDamage;          // Damage tracking: bounding box of the changes each swapchain image missed since it was last rendered
+static VkSwapchainKHR           g_ImageDamageSwapchain = VK_NULL_HANDLE;
 
 static void check_vk_result(VkResult err)
 {
@@ -295,6 +297,11 @@ static void CleanupVulkanWindow()
     ImGui_ImplVulkanH_DestroyWindow(g_Instance, g_Device, &g_MainWindowData, g_Allocator);
 }
 
+static ImVec4 DamageUnion(const ImVec4& a, const ImVec4& b)
+{
+    return ImVec4(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w);
+}
+
 static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
 {
     VkResult err;
@@ -339,7 +346,37 @@ static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
     }
 
     // Record dear imgui primitives into command buffer
-    ImGui_ImplVulkan_RenderDrawData(draw_data, fd->CommandBuffer);
+    if (wd->DamageEnable)
+    {
+        // The image still holds what was rendered into it ImageCount frames ago or so: redraw what changed since then
+        const ImVec4 full_rect(draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplayPos.x + draw_data->DisplaySize.x, draw_data->DisplayPos.y + draw_data->DisplaySize.y);
+        const ImVec4 empty_rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        if (g_ImageDamageSwapchain != wd->Swapchain || g_ImageDamage.size() != wd->ImageCount)
+        {
+            g_ImageDamage.assign(wd->ImageCount, full_rect);
+            g_ImageDamageSwapchain = wd->Swapchain;
+        }
+        ImVec4 frame_damage = draw_data->DamageValid ? empty_rect : full_rect;
+        for (int n = 0; n < draw_data->DamageRectsCount; n++)
+            frame_damage = DamageUnion(frame_damage, draw_data->DamageRects[n]);
+        const ImVec4 missed = g_ImageDamage[wd->FrameIndex];
+        for (size_t i = 0; i < g_ImageDamage.size(); i++)
+            g_ImageDamage[i] = DamageUnion(g_ImageDamage[i], frame_damage);
+        g_ImageDamage[wd->FrameIndex] = empty_rect;
+        if (draw_data->DamageValid && missed.x >= missed.z)
+        {
+            // Up to date with the previous frame, the exact rectangles are enough
+            ImGui_ImplVulkan_RenderDrawDataDamage(draw_data, fd->CommandBuffer, draw_data->DamageRects, draw_data->DamageRectsCount, &wd->ClearValue);
+        }
+        else
+        {
+            // RenderDrawDataDamage() clamps to the framebuffer
+            ImVec4 damage = DamageUnion(missed, frame_damage);
+            ImGui_ImplVulkan_RenderDrawDataDamage(draw_data, fd->CommandBuffer, &damage, 1, &wd->ClearValue);
+        }
+    }
+    else
+        ImGui_ImplVulkan_RenderDrawData(draw_data, fd->CommandBuffer);
 
     // Submit command buffer
     vkCmdEndRenderPass(fd->CommandBuffer);
@@ -394,7 +431,9 @@ static void FrameRendering(ImGui_ImplVulkanH_Window* wd)
     wd->ClearValue.color.float32[1] = clear_color.y * clear_color.w;
     wd->ClearValue.color.float32[2] = clear_color.z * clear_color.w;
     wd->ClearValue.color.float32[3] = clear_color.w;
-    if (!main_is_minimized)
+    // With damage tracking, a frame without any change keeps the image presented last on screen
+    const bool main_is_unchanged = wd->DamageEnable && main_draw_data->DamageValid && main_draw_data->DamageRectsCount == 0 && g_ImageDamageSwapchain == wd->Swapchain;
+    if (!main_is_minimized && !main_is_unchanged)
         FrameRender(wd, main_draw_data);
 
     // Update and Render additional Platform Windows
@@ -405,6 +444,6 @@ static void FrameRendering(ImGui_ImplVulkanH_Window* wd)
     }
 
     // Present Main Platform Window
-    if (!main_is_minimized)
+    if (!main_is_minimized && !main_is_unchanged)
         FramePresent(wd);
 }
@@ -7,6 +7,9 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with 'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'.
 //  [x] Renderer: Large meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
+//  [x] Renderer: Partial redraw of ImDrawData::DamageRects with ImGui_ImplOpenGL3_RenderDrawDataDamage() (OpenGL 3.0+ / ES 3.0).
+//  [x] Renderer: ImDrawVertCompact vertices and 16-bit indices with io.ConfigCompactVertices.
+//  [x] Renderer: Analytic rounded rectangles, circles and lines with io.ConfigAnalyticShapes (GLSL 1.30+ / ES 3.0).
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -16,6 +19,9 @@
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
+//  2022-XX-XX: OpenGL: Evaluate the shape quads of io.ConfigAnalyticShapes in the shaders, enable ImGuiBackendFlags_RendererHasAnalyticShapes with GLSL 1.30+.
+//  2022-XX-XX: OpenGL: Upload draw lists as ImDrawVertCompact vertices and 16-bit indices when io.ConfigCompactVertices is set.
+//  2022-XX-XX: OpenGL: Added ImGui_ImplOpenGL3_RenderDrawDataDamage(), redrawing only the damaged area into a retained framebuffer.
 //  2022-05-23: OpenGL: Reworking 2021-12-15 "Using buffer orphaning" so it only happens on Intel GPU, seems to cause problems otherwise. (#4468, #4825, #4832, #5127).
 //  2022-05-13: OpenGL: Fix state corruption on OpenGL ES 2.0 due to not preserving GL_ELEMENT_ARRAY_BUFFER_BINDING and vertex attribute states.
 //  2021-12-15: OpenGL: Using buffer orphaning + glBufferSubData(), seems to fix leaks with multi-viewports with some Intel HD drivers.
@@ -175,6 +181,11 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// GL 3.0+ and GL ES 3.0 have framebuffer objects and glBlitFramebuffer()
+#if !defined(IMGUI_IMPL_OPENGL_ES2)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_FRAMEBUFFER_BLIT
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -197,6 +208,13 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    GLuint          DamageFramebuffer;       // Retained copy of the viewport for ImGui_ImplOpenGL3_RenderDrawDataDamage()
+    GLuint          DamageTexture;
+    int             DamageWidth, DamageHeight;
+    bool            DamageFramebufferIncomplete; // The driver can't render to the retained copy, every frame is redrawn instead
+    float           ProjMtx[4][4];           // Set by ImGui_ImplOpenGL3_SetupRenderState(), offset for draw lists uploaded as ImDrawVertCompact
+    ImVector<ImDrawVertCompact> CompactVtxBuffer; // io.ConfigCompactVertices: staging buffers
+    ImVector<ImU16> Idx16Buffer;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -305,6 +323,12 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(bd->GlslVersionString, glsl_version);
     strcat(bd->GlslVersionString, "\n");
 
+    // Shape quads are decoded with integer math and flat varyings, not available in the GLSL 1.20 / ES 2.0 shaders
+    int glsl_version_number = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_number);
+    if (glsl_version_number >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasAnalyticShapes;
+
     // Make an arbitrary GL call (we don't actually need the result)
     // IF YOU GET A CRASH HERE: it probably means the OpenGL function loader didn't do its job. Let us know!
     GLint current_texture;
@@ -351,6 +375,31 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
+// Vertex attributes and projection for ImDrawVert, or for ImDrawVertCompact: fixed point positions relative to 'origin' are scaled back by the projection
+static void ImGui_ImplOpenGL3_SetupVertexLayout(bool compact, const ImVec2& origin)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    float projection[4][4];
+    memcpy(projection, bd->ProjMtx, sizeof(projection));
+    if (compact)
+    {
+        projection[3][0] += projection[0][0] * origin.x;
+        projection[3][1] += projection[1][1] * origin.y;
+        projection[0][0] /= IM_DRAWVERT_COMPACT_POS_SCALE;
+        projection[1][1] /= IM_DRAWVERT_COMPACT_POS_SCALE;
+        glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_SHORT,          GL_FALSE, sizeof(ImDrawVertCompact), (GLvoid*)IM_OFFSETOF(ImDrawVertCompact, pos));
+        glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_UNSIGNED_SHORT, GL_TRUE,  sizeof(ImDrawVertCompact), (GLvoid*)IM_OFFSETOF(ImDrawVertCompact, uv));
+        glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  sizeof(ImDrawVertCompact), (GLvoid*)IM_OFFSETOF(ImDrawVertCompact, col));
+    }
+    else
+    {
+        glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+        glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+        glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+    }
+    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &projection[0][0]);
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -399,9 +448,9 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
+    memcpy(bd->ProjMtx, ortho_projection, sizeof(ortho_projection));
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
-    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
@@ -419,15 +468,14 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glEnableVertexAttribArray(bd->AttribLocationVtxPos);
     glEnableVertexAttribArray(bd->AttribLocationVtxUV);
     glEnableVertexAttribArray(bd->AttribLocationVtxColor);
-    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+    ImGui_ImplOpenGL3_SetupVertexLayout(false, ImVec2(0.0f, 0.0f));
 }
 
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
-void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+// When damage_rects is not NULL, only the pixels inside those rectangles are drawn.
+static void ImGui_ImplOpenGL3_RenderDrawDataEx(ImDrawData* draw_data, const ImVec4* damage_rects, int damage_rects_count)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
     int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
@@ -490,16 +538,42 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
+    const bool compact_layouts = ImGui::GetIO().ConfigCompactVertices;
+    bool compact_vtx_bound = false;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
+        // With io.ConfigCompactVertices, pack the draw list as ImDrawVertCompact when it fits and its indices as 16-bit when it has few enough vertices
+        ImVec2 compact_origin(0.0f, 0.0f);
+        const bool compact_vtx = compact_layouts && cmd_list->CalcCompactVtxOrigin(&compact_origin);
+        const bool idx16 = compact_layouts && cmd_list->CanPackIdx16();
+        const GLvoid* vtx_data = (const GLvoid*)cmd_list->VtxBuffer.Data;
+        const GLvoid* idx_data = (const GLvoid*)cmd_list->IdxBuffer.Data;
+        const int idx_size = idx16 ? 2 : (int)sizeof(ImDrawIdx);
+        const GLenum idx_type = idx_size == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        if (compact_vtx)
+        {
+            bd->CompactVtxBuffer.resize(cmd_list->VtxBuffer.Size);
+            cmd_list->PackCompactVtx(bd->CompactVtxBuffer.Data, compact_origin);
+            vtx_data = (const GLvoid*)bd->CompactVtxBuffer.Data;
+        }
+        if (idx16 && sizeof(ImDrawIdx) != 2)
+        {
+            bd->Idx16Buffer.resize(cmd_list->IdxBuffer.Size);
+            cmd_list->PackIdx16(bd->Idx16Buffer.Data);
+            idx_data = (const GLvoid*)bd->Idx16Buffer.Data;
+        }
+        if (compact_vtx || compact_vtx_bound)
+            ImGui_ImplOpenGL3_SetupVertexLayout(compact_vtx, compact_origin);
+        compact_vtx_bound = compact_vtx;
+
         // Upload vertex/index buffers
         // - On Intel windows drivers we got reports that regular glBufferData() led to accumulating leaks when using multi-viewports, so we started using orphaning + glBufferSubData(). (See https://github.com/ocornut/imgui/issues/4468)
         // - On NVIDIA drivers we got reports that using orphaning + glBufferSubData() led to glitches when using multi-viewports.
         // - OpenGL drivers are in a very sorry state in 2022, for now we are switching code path based on vendors.
-        const GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
-        const GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        const GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)(compact_vtx ? sizeof(ImDrawVertCompact) : sizeof(ImDrawVert));
+        const GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * idx_size;
         if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
@@ -512,13 +586,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 bd->IndexBufferSize = idx_buffer_size;
                 glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->IndexBufferSize, NULL, GL_STREAM_DRAW);
             }
-            glBufferSubData(GL_ARRAY_BUFFER, 0, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data);
-            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, vtx_buffer_size, vtx_data);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, idx_buffer_size, idx_data);
         }
         else
         {
-            glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+            glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, vtx_data, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, idx_data, GL_STREAM_DRAW);
         }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
@@ -529,7 +603,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    if (compact_vtx)
+                        ImGui_ImplOpenGL3_SetupVertexLayout(true, compact_origin);
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -541,17 +619,34 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
-                // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
-
-                // Bind texture, Draw
-                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                // Damage rectangles don't overlap, drawing the command once per rectangle keeps the blending order
+                for (int damage_n = 0; damage_n < (damage_rects ? damage_rects_count : 1); damage_n++)
+                {
+                    ImVec2 draw_min = clip_min, draw_max = clip_max;
+                    if (damage_rects)
+                    {
+                        const ImVec2 damage_min((damage_rects[damage_n].x - clip_off.x) * clip_scale.x, (damage_rects[damage_n].y - clip_off.y) * clip_scale.y);
+                        const ImVec2 damage_max((damage_rects[damage_n].z - clip_off.x) * clip_scale.x, (damage_rects[damage_n].w - clip_off.y) * clip_scale.y);
+                        if (draw_min.x < damage_min.x) { draw_min.x = damage_min.x; }
+                        if (draw_min.y < damage_min.y) { draw_min.y = damage_min.y; }
+                        if (draw_max.x > damage_max.x) { draw_max.x = damage_max.x; }
+                        if (draw_max.y > damage_max.y) { draw_max.y = damage_max.y; }
+                        if (draw_max.x <= draw_min.x || draw_max.y <= draw_min.y)
+                            continue;
+                    }
+
+                    // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
+                    glScissor((int)draw_min.x, (int)((float)fb_height - draw_max.y), (int)(draw_max.x - draw_min.x), (int)(draw_max.y - draw_min.y));
+
+                    // Bind texture, Draw
+                    glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-                if (bd->GlVersion >= 320)
-                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
-                else
+                    if (bd->GlVersion >= 320)
+                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * idx_size), (GLint)pcmd->VtxOffset);
+                    else
 #endif
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, (void*)(intptr_t)(pcmd->IdxOffset * idx_size));
+                }
             }
         }
     }
@@ -598,6 +693,112 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     (void)bd; // Not all compilation paths use this
 }
 
+void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplOpenGL3_RenderDrawDataEx(draw_data, NULL, 0);
+}
+
+// The viewport is kept in a framebuffer object of ours: only the damaged rectangles are cleared and redrawn there,
+// then the whole of it is copied to the framebuffer bound by the caller. A swapchain back buffer can't be used directly
+// as its content is undefined after a swap.
+bool    ImGui_ImplOpenGL3_RenderDrawDataDamage(ImDrawData* draw_data, const ImVec4& clear_color)
+{
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return false;
+
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FRAMEBUFFER_BLIT
+    if (bd->GlVersion >= 300 && !bd->DamageFramebufferIncomplete)
+    {
+        GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+        GLint last_draw_framebuffer; glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &last_draw_framebuffer);
+        GLint last_read_framebuffer; glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &last_read_framebuffer);
+        bool full_redraw = !draw_data->DamageValid;
+        if (bd->DamageFramebuffer == 0 || bd->DamageWidth != fb_width || bd->DamageHeight != fb_height)
+        {
+            if (bd->DamageFramebuffer == 0)
+            {
+                glGenFramebuffers(1, &bd->DamageFramebuffer);
+                glGenTextures(1, &bd->DamageTexture);
+            }
+            glBindTexture(GL_TEXTURE_2D, bd->DamageTexture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, fb_width, fb_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            glBindTexture(GL_TEXTURE_2D, last_texture);
+            glBindFramebuffer(GL_FRAMEBUFFER, bd->DamageFramebuffer);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bd->DamageTexture, 0);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            {
+                // No retained copy from now on, take the full redraw path below
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, last_draw_framebuffer);
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, last_read_framebuffer);
+                glDeleteFramebuffers(1, &bd->DamageFramebuffer); bd->DamageFramebuffer = 0;
+                glDeleteTextures(1, &bd->DamageTexture); bd->DamageTexture = 0;
+                bd->DamageWidth = bd->DamageHeight = 0;
+                bd->DamageFramebufferIncomplete = true;
+                return ImGui_ImplOpenGL3_RenderDrawDataDamage(draw_data, clear_color);
+            }
+            bd->DamageWidth = fb_width;
+            bd->DamageHeight = fb_height;
+            full_redraw = true;
+        }
+        if (!full_redraw && draw_data->DamageRectsCount == 0)
+            return false;
+
+        GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+        GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
+        GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
+        glBindFramebuffer(GL_FRAMEBUFFER, bd->DamageFramebuffer);
+        glViewport(0, 0, fb_width, fb_height);
+        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+        if (full_redraw)
+        {
+            glDisable(GL_SCISSOR_TEST);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawDataEx(draw_data, NULL, 0);
+        }
+        else
+        {
+            const ImVec2 clip_off = draw_data->DisplayPos;
+            const ImVec2 clip_scale = draw_data->FramebufferScale;
+            glEnable(GL_SCISSOR_TEST);
+            for (int n = 0; n < draw_data->DamageRectsCount; n++)
+            {
+                const ImVec4& r = draw_data->DamageRects[n];
+                const int x1 = (int)((r.x - clip_off.x) * clip_scale.x), y1 = (int)((r.y - clip_off.y) * clip_scale.y);
+                const int x2 = (int)((r.z - clip_off.x) * clip_scale.x), y2 = (int)((r.w - clip_off.y) * clip_scale.y);
+                glScissor(x1, fb_height - y2, x2 - x1, y2 - y1);
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            ImGui_ImplOpenGL3_RenderDrawDataEx(draw_data, draw_data->DamageRects, draw_data->DamageRectsCount);
+        }
+
+        // Copy to the caller framebuffer
+        glDisable(GL_SCISSOR_TEST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, bd->DamageFramebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, last_draw_framebuffer);
+        glBlitFramebuffer(0, 0, fb_width, fb_height, 0, 0, fb_width, fb_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, last_read_framebuffer);
+        if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+        glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
+        glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
+        return true;
+    }
+#endif
+    // No framebuffer objects: redraw everything, still skipping frames without any change
+    if (draw_data->DamageValid && draw_data->DamageRectsCount == 0 && bd->DamageWidth == fb_width && bd->DamageHeight == fb_height)
+        return false;
+    bd->DamageWidth = fb_width;
+    bd->DamageHeight = fb_height;
+    glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ImGui_ImplOpenGL3_RenderDrawDataEx(draw_data, NULL, 0);
+    return true;
+}
+
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -711,6 +912,33 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // Analytic shapes (io.ConfigAnalyticShapes): the vertex shader decodes the uv of shape vertices (see IM_DRAWVERT_SHAPE_MARKER in imgui.h)
+    // into the half size, radius and thickness in Frag_Shape (x < 0 for textured vertices) and the position relative to the shape center.
+    // The fragment shader turns the distance to the rounded box into coverage over one pixel, like the tessellated anti-aliased fringes.
+#define IMGUI_IMPL_OPENGL3_SHAPE_VERTEX_GLSL \
+        "void DecodeShape(vec2 uv, out vec4 shape, out int corners, out vec2 shape_pos)\n" \
+        "{\n" \
+        "    shape = vec4(-1.0); corners = 0; shape_pos = vec2(0.0);\n" \
+        "    if (uv.x > -8388608.0) return;\n" \
+        "    int code_x = int(-uv.x - 8388608.0);\n" \
+        "    int code_y = int(uv.y);\n" \
+        "    shape = vec4(float(code_x & 8191), float(code_y & 8191), float((code_y >> 13) & 511), float((code_x >> 13) & 31)) * 0.25;\n" \
+        "    corners = (code_x >> 18) & 15;\n" \
+        "    int corner = (code_y >> 22) & 3;\n" \
+        "    vec2 extent = shape.xy + vec2(shape.w * 0.5 + 1.0);\n" \
+        "    shape_pos = vec2((corner & 1) != 0 ? extent.x : -extent.x, (corner & 2) != 0 ? extent.y : -extent.y);\n" \
+        "}\n"
+#define IMGUI_IMPL_OPENGL3_SHAPE_FRAGMENT_GLSL \
+        "highp float ShapeCoverage(highp vec2 p, highp vec4 shape, int corners)\n" \
+        "{\n" \
+        "    int quadrant = (p.x > 0.0 ? 1 : 0) + (p.y > 0.0 ? 2 : 0);\n" \
+        "    highp float r = ((corners >> quadrant) & 1) != 0 ? shape.z : 0.0;\n" \
+        "    highp vec2 q = abs(p) - shape.xy + vec2(r);\n" \
+        "    highp float d = length(max(q, vec2(0.0))) + min(max(q.x, q.y), 0.0) - r;\n" \
+        "    if (shape.w > 0.0) d = abs(d) - shape.w * 0.5;\n" \
+        "    return clamp(0.5 - d, 0.0, 1.0);\n" \
+        "}\n"
+
     const GLchar* vertex_shader_glsl_130 =
         "uniform mat4 ProjMtx;\n"
         "in vec2 Position;\n"
@@ -718,10 +946,15 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "in vec4 Color;\n"
         "out vec2 Frag_UV;\n"
         "out vec4 Frag_Color;\n"
+        "out vec2 Frag_ShapePos;\n"
+        "flat out vec4 Frag_Shape;\n"
+        "flat out int Frag_ShapeCorners;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_VERTEX_GLSL
         "void main()\n"
         "{\n"
         "    Frag_UV = UV;\n"
         "    Frag_Color = Color;\n"
+        "    DecodeShape(UV, Frag_Shape, Frag_ShapeCorners, Frag_ShapePos);\n"
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
@@ -733,10 +966,15 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "uniform mat4 ProjMtx;\n"
         "out vec2 Frag_UV;\n"
         "out vec4 Frag_Color;\n"
+        "out vec2 Frag_ShapePos;\n"
+        "flat out vec4 Frag_Shape;\n"
+        "flat out int Frag_ShapeCorners;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_VERTEX_GLSL
         "void main()\n"
         "{\n"
         "    Frag_UV = UV;\n"
         "    Frag_Color = Color;\n"
+        "    DecodeShape(UV, Frag_Shape, Frag_ShapeCorners, Frag_ShapePos);\n"
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
@@ -747,10 +985,15 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "uniform mat4 ProjMtx;\n"
         "out vec2 Frag_UV;\n"
         "out vec4 Frag_Color;\n"
+        "out vec2 Frag_ShapePos;\n"
+        "flat out vec4 Frag_Shape;\n"
+        "flat out int Frag_ShapeCorners;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_VERTEX_GLSL
         "void main()\n"
         "{\n"
         "    Frag_UV = UV;\n"
         "    Frag_Color = Color;\n"
+        "    DecodeShape(UV, Frag_Shape, Frag_ShapeCorners, Frag_ShapePos);\n"
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
@@ -770,10 +1013,17 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "uniform sampler2D Texture;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
+        "in vec2 Frag_ShapePos;\n"
+        "flat in vec4 Frag_Shape;\n"
+        "flat in int Frag_ShapeCorners;\n"
         "out vec4 Out_Color;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_FRAGMENT_GLSL
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    if (Frag_Shape.x >= 0.0)\n"
+        "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * ShapeCoverage(Frag_ShapePos, Frag_Shape, Frag_ShapeCorners));\n"
+        "    else\n"
+        "        Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
@@ -781,21 +1031,37 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "uniform sampler2D Texture;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
+        "in highp vec2 Frag_ShapePos;\n"
+        "flat in highp vec4 Frag_Shape;\n"
+        "flat in int Frag_ShapeCorners;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_FRAGMENT_GLSL
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    if (Frag_Shape.x >= 0.0)\n"
+        "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * ShapeCoverage(Frag_ShapePos, Frag_Shape, Frag_ShapeCorners));\n"
+        "    else\n"
+        "        Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
+        "in vec2 Frag_ShapePos;\n"
+        "flat in vec4 Frag_Shape;\n"
+        "flat in int Frag_ShapeCorners;\n"
         "uniform sampler2D Texture;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
+        IMGUI_IMPL_OPENGL3_SHAPE_FRAGMENT_GLSL
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    if (Frag_Shape.x >= 0.0)\n"
+        "        Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * ShapeCoverage(Frag_ShapePos, Frag_Shape, Frag_ShapeCorners));\n"
+        "    else\n"
+        "        Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
         "}\n";
+#undef IMGUI_IMPL_OPENGL3_SHAPE_VERTEX_GLSL
+#undef IMGUI_IMPL_OPENGL3_SHAPE_FRAGMENT_GLSL
 
     // Select shaders matching our GLSL versions
     const GLchar* vertex_shader = NULL;
@@ -874,6 +1140,12 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_FRAMEBUFFER_BLIT
+    if (bd->DamageFramebuffer) { glDeleteFramebuffers(1, &bd->DamageFramebuffer); bd->DamageFramebuffer = 0; }
+    if (bd->DamageTexture)  { glDeleteTextures(1, &bd->DamageTexture); bd->DamageTexture = 0; }
+#endif
+    bd->DamageWidth = bd->DamageHeight = 0;
+    bd->DamageFramebufferIncomplete = false;
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
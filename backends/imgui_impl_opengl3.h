@@ -7,6 +7,7 @@
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with 'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'.
 //  [x] Renderer: Large meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
+//  [x] Renderer: Partial redraw of ImDrawData::DamageRects with ImGui_ImplOpenGL3_RenderDrawDataDamage() (OpenGL 3.0+ / ES 3.0).
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -27,6 +28,9 @@ IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_Init(const char* glsl_version = NULL);
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data);
+// With io.ConfigDamageTracking: clear (with clear_color) and redraw only draw_data->DamageRects into a framebuffer kept by the backend, then copy it to the bound one.
+// Returns false when nothing changed since the previous call and nothing was drawn, the caller can skip presenting this frame.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_RenderDrawDataDamage(ImDrawData* draw_data, const ImVec4& clear_color);
 
 // (Optional) Called by Init/NewFrame/Shutdown
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateFontsTexture();
@@ -0,0 +1,911 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer, draws into an ImGui::ImMat
+// (Requires: nothing but std::thread, for servers and tests without any GPU)
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui::ImMat*' (4 channel IM_DT_INT8, elempack 4) as ImTextureID.
+//  [X] Renderer: Large meshes support (64k+ vertices).
+//  [X] Renderer: Multithreaded, the framebuffer is split in tiles and every tile runs its primitives in submission order.
+//  [X] Renderer: Axis aligned quads (rects, text) skip the triangle setup, solid spans blend 4 pixels at a time with SSE2.
+//  [X] Renderer: Analytic rounded rectangles, circles and lines with io.ConfigAnalyticShapes.
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: User callbacks run while the frame is binned, before any pixel of it is written.
+
+// Rasterization follows what the GL/Vulkan backends get from the hardware: pixel centers are sampled, shared
+// edges belong to exactly one triangle (fixed point edge functions with a top-left style tie break), textures
+// are sampled bilinear with clamp to edge, and blending is SRC_ALPHA, ONE_MINUS_SRC_ALPHA on color with
+// ONE, ONE_MINUS_SRC_ALPHA on alpha.
+
+#include "imgui.h"
+#include "imgui_internal.h"   // ImClamp, ImMin, ImMax, ImSwap
+#include "imgui_impl_soft.h"
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMGUI_IMPL_SOFT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#define SOFT_TILE_SIZE      64
+#define SOFT_SUBPIXEL_BITS  4       // edge functions run on 1/16 pixel fixed point
+#define SOFT_COORD_LIMIT    4000000.f
+
+enum ImGui_ImplSoft_PrimKind
+{
+    SoftPrim_Triangle,              // interpolated color and uv
+    SoftPrim_ShadedTriangle,        // interpolated color, constant uv (anti-aliased fringes)
+    SoftPrim_FlatTriangle,          // one color, constant uv
+    SoftPrim_Quad,                  // axis aligned, uv linear along x and y
+    SoftPrim_Fill,                  // axis aligned, one color
+    SoftPrim_Shape,                 // analytic rounded box, one color
+};
+
+struct ImGui_ImplSoft_Vert
+{
+    float   X, Y, U, V;
+    int     FX, FY;                 // fixed point position
+    ImU32   Col;
+};
+
+struct ImGui_ImplSoft_Texture
+{
+    ImTextureID     ID;
+    const ImU32*    Pixels;         // null samples as white
+    int             Width, Height;
+};
+
+struct ImGui_ImplSoft_Prim
+{
+    int     Kind;
+    int     X0, Y0, X1, Y1;         // covered pixels after the scissor, max exclusive
+    int     Vtx[3];                 // triangle corners with positive area, a quad keeps two opposite corners in Vtx[0] and Vtx[1]
+    int     Texture;                // index into the frame texture table
+    ImU32   Color;                  // Fill and FlatTriangle color with the texture already applied, ShadedTriangle texel
+    float   U0, DU, V0, DV;         // Quad uv at pixel center x + 0.5 is U0 + (x + 0.5) * DU
+    bool    Nearest;                // Quad texels land on pixel centers, bilinear would return the texel itself
+    float   ShapeX, ShapeY;         // Shape center, half size, corner radius and stroke thickness (0 when filled) in framebuffer pixels
+    float   ShapeHalfW, ShapeHalfH, ShapeRadius, ShapeThickness;
+    float   ShapeFringe;            // Shape anti-aliasing width, one display pixel
+    float   ShapeAxisX, ShapeAxisY; // Shape width direction, (1, 0) unless the quad is rotated (lines)
+    int     ShapeCorners;           // Shape rounded corners, bit 0 top-left, bit 1 top-right, bit 2 bottom-left, bit 3 bottom-right
+};
+
+struct ImGui_ImplSoft_Data
+{
+    ImGui::ImMat*                       FontTexture;
+    std::vector<std::thread>            Workers;
+    std::mutex                          Mutex;
+    std::condition_variable             StartCond;
+    std::condition_variable             DoneCond;
+    uint64_t                            Generation;
+    int                                 Pending;
+    bool                                Quit;
+    std::atomic<int>                    NextTile;
+
+    // frame being rendered
+    ImVector<ImGui_ImplSoft_Vert>       Verts;
+    ImVector<ImGui_ImplSoft_Prim>       Prims;
+    ImVector<ImGui_ImplSoft_Texture>    Textures;
+    std::vector<ImVector<int>>          Bins;
+    int                                 TilesX, TilesY;
+    ImU32*                              Target;
+    int                                 TargetWidth, TargetHeight;
+    bool                                Clear;
+    ImU32                               ClearColor;
+
+    ImGui_ImplSoft_Data() : FontTexture(NULL), Generation(0), Pending(0), Quit(false), NextTile(0), TilesX(0), TilesY(0),
+                            Target(NULL), TargetWidth(0), TargetHeight(0), Clear(false), ClearColor(0) {}
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplSoft_Data* ImGui_ImplSoft_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoft_Data*)ImGui::GetIO().BackendRendererUserData : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Pixel math
+//-----------------------------------------------------------------------------
+
+// round(x / 255) for x <= 255 * 255
+static inline ImU32 SoftDiv255(ImU32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline ImU32 SoftBlend(ImU32 dst, ImU32 src)
+{
+    ImU32 a = src >> IM_COL32_A_SHIFT;
+    if (a == 255) return src;
+    if (a == 0) return dst;
+    ImU32 ia = 255 - a;
+    ImU32 r = SoftDiv255(((src >> IM_COL32_R_SHIFT) & 0xFF) * a + ((dst >> IM_COL32_R_SHIFT) & 0xFF) * ia);
+    ImU32 g = SoftDiv255(((src >> IM_COL32_G_SHIFT) & 0xFF) * a + ((dst >> IM_COL32_G_SHIFT) & 0xFF) * ia);
+    ImU32 b = SoftDiv255(((src >> IM_COL32_B_SHIFT) & 0xFF) * a + ((dst >> IM_COL32_B_SHIFT) & 0xFF) * ia);
+    ImU32 o = SoftDiv255(a * 255 + ((dst >> IM_COL32_A_SHIFT) & 0xFF) * ia);
+    return (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (o << IM_COL32_A_SHIFT);
+}
+
+static inline ImU32 SoftModulate(ImU32 a, ImU32 b)
+{
+    if (b == IM_COL32_WHITE) return a;
+    ImU32 r = SoftDiv255(((a >> IM_COL32_R_SHIFT) & 0xFF) * ((b >> IM_COL32_R_SHIFT) & 0xFF));
+    ImU32 g = SoftDiv255(((a >> IM_COL32_G_SHIFT) & 0xFF) * ((b >> IM_COL32_G_SHIFT) & 0xFF));
+    ImU32 bl = SoftDiv255(((a >> IM_COL32_B_SHIFT) & 0xFF) * ((b >> IM_COL32_B_SHIFT) & 0xFF));
+    ImU32 o = SoftDiv255(((a >> IM_COL32_A_SHIFT) & 0xFF) * ((b >> IM_COL32_A_SHIFT) & 0xFF));
+    return (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (bl << IM_COL32_B_SHIFT) | (o << IM_COL32_A_SHIFT);
+}
+
+// one color over a run of pixels, 4 at a time in 16 bit lanes with SSE2
+static void SoftBlendSpan(ImU32* dst, int count, ImU32 src)
+{
+    ImU32 a = src >> IM_COL32_A_SHIFT;
+    if (a == 0 || count <= 0)
+        return;
+    if (a == 255)
+    {
+        for (int i = 0; i < count; i++)
+            dst[i] = src;
+        return;
+    }
+    int i = 0;
+#if IMGUI_IMPL_SOFT_SSE2
+    // lane k holds byte k of a pixel, the alpha byte keeps a * 255 so dst alpha ends up a + da * (1 - a)
+    short s[4];
+    for (int k = 0; k < 4; k++)
+        s[k] = (short)(k * 8 == IM_COL32_A_SHIFT ? a * 255 : ((src >> (k * 8)) & 0xFF) * a);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i inv = _mm_set1_epi16((short)(255 - a));
+    const __m128i s16 = _mm_set_epi16(s[3], s[2], s[1], s[0], s[3], s[2], s[1], s[0]);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv), s16), round);
+        __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv), s16), round);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = SoftBlend(dst[i], src);
+}
+
+// rgba in 0..255 floats, one SSE register per pixel so interpolation and filtering run on all channels at once
+#if IMGUI_IMPL_SOFT_SSE2
+struct SoftV4 { __m128 v; };
+static inline SoftV4 SoftV4Load(ImU32 c)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i i = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)c), zero), zero);
+    SoftV4 r = { _mm_cvtepi32_ps(i) };
+    return r;
+}
+static inline ImU32 SoftV4Store(SoftV4 a)
+{
+    __m128i i = _mm_cvtps_epi32(a.v);
+    i = _mm_packs_epi32(i, i);
+    i = _mm_packus_epi16(i, i);
+    return (ImU32)_mm_cvtsi128_si32(i);
+}
+static inline SoftV4 SoftV4Lerp(SoftV4 a, SoftV4 b, float t)    { SoftV4 r = { _mm_add_ps(a.v, _mm_mul_ps(_mm_sub_ps(b.v, a.v), _mm_set1_ps(t))) }; return r; }
+static inline SoftV4 SoftV4Mad(SoftV4 a, SoftV4 b, float t)     { SoftV4 r = { _mm_add_ps(a.v, _mm_mul_ps(b.v, _mm_set1_ps(t))) }; return r; }
+static inline SoftV4 SoftV4Add(SoftV4 a, SoftV4 b)              { SoftV4 r = { _mm_add_ps(a.v, b.v) }; return r; }
+static inline SoftV4 SoftV4Sub(SoftV4 a, SoftV4 b)              { SoftV4 r = { _mm_sub_ps(a.v, b.v) }; return r; }
+static inline SoftV4 SoftV4Modulate(SoftV4 a, SoftV4 b)         { SoftV4 r = { _mm_mul_ps(_mm_mul_ps(a.v, b.v), _mm_set1_ps(1.f / 255.f)) }; return r; }
+#else
+struct SoftV4 { float v[4]; };
+static inline SoftV4 SoftV4Load(ImU32 c)
+{
+    SoftV4 r;
+    for (int k = 0; k < 4; k++)
+        r.v[k] = (float)((c >> (k * 8)) & 0xFF);
+    return r;
+}
+static inline ImU32 SoftV4Store(SoftV4 a)
+{
+    ImU32 c = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        float f = a.v[k] < 0.f ? 0.f : a.v[k] > 255.f ? 255.f : a.v[k];
+        c |= (ImU32)(f + 0.5f) << (k * 8);
+    }
+    return c;
+}
+static inline SoftV4 SoftV4Lerp(SoftV4 a, SoftV4 b, float t)    { SoftV4 r; for (int k = 0; k < 4; k++) r.v[k] = a.v[k] + (b.v[k] - a.v[k]) * t; return r; }
+static inline SoftV4 SoftV4Mad(SoftV4 a, SoftV4 b, float t)     { SoftV4 r; for (int k = 0; k < 4; k++) r.v[k] = a.v[k] + b.v[k] * t; return r; }
+static inline SoftV4 SoftV4Add(SoftV4 a, SoftV4 b)              { SoftV4 r; for (int k = 0; k < 4; k++) r.v[k] = a.v[k] + b.v[k]; return r; }
+static inline SoftV4 SoftV4Sub(SoftV4 a, SoftV4 b)              { SoftV4 r; for (int k = 0; k < 4; k++) r.v[k] = a.v[k] - b.v[k]; return r; }
+static inline SoftV4 SoftV4Modulate(SoftV4 a, SoftV4 b)         { SoftV4 r; for (int k = 0; k < 4; k++) r.v[k] = a.v[k] * b.v[k] * (1.f / 255.f); return r; }
+#endif
+
+static inline SoftV4 SoftSampleBilinear(const ImGui_ImplSoft_Texture& tex, float u, float v)
+{
+    if (!tex.Pixels)
+        return SoftV4Load(IM_COL32_WHITE);
+    float fx = u * tex.Width - 0.5f;
+    float fy = v * tex.Height - 0.5f;
+    float flx = floorf(fx), fly = floorf(fy);
+    float ax = fx - flx, ay = fy - fly;
+    int x0 = ImClamp((int)flx, 0, tex.Width - 1), x1 = ImClamp((int)flx + 1, 0, tex.Width - 1);
+    int y0 = ImClamp((int)fly, 0, tex.Height - 1), y1 = ImClamp((int)fly + 1, 0, tex.Height - 1);
+    const ImU32* row0 = tex.Pixels + (size_t)y0 * tex.Width;
+    const ImU32* row1 = tex.Pixels + (size_t)y1 * tex.Width;
+    SoftV4 top = SoftV4Lerp(SoftV4Load(row0[x0]), SoftV4Load(row0[x1]), ax);
+    SoftV4 bottom = SoftV4Lerp(SoftV4Load(row1[x0]), SoftV4Load(row1[x1]), ax);
+    return SoftV4Lerp(top, bottom, ay);
+}
+
+static inline ImU32 SoftSampleNearest(const ImGui_ImplSoft_Texture& tex, float u, float v)
+{
+    if (!tex.Pixels)
+        return IM_COL32_WHITE;
+    int x = ImClamp((int)floorf(u * tex.Width), 0, tex.Width - 1);
+    int y = ImClamp((int)floorf(v * tex.Height), 0, tex.Height - 1);
+    return tex.Pixels[(size_t)y * tex.Width + x];
+}
+
+//-----------------------------------------------------------------------------
+// Primitive rasterization, each call is limited to one tile
+//-----------------------------------------------------------------------------
+
+static void ImGui_ImplSoft_RasterFill(const ImGui_ImplSoft_Prim& prim, ImU32* fb, int stride, int x0, int y0, int x1, int y1)
+{
+    for (int y = y0; y < y1; y++)
+        SoftBlendSpan(fb + (size_t)y * stride + x0, x1 - x0, prim.Color);
+}
+
+static void ImGui_ImplSoft_RasterQuad(const ImGui_ImplSoft_Data* bd, const ImGui_ImplSoft_Prim& prim, ImU32* fb, int stride, int x0, int y0, int x1, int y1)
+{
+    const ImGui_ImplSoft_Texture& tex = bd->Textures[prim.Texture];
+    const ImU32 col = bd->Verts[prim.Vtx[0]].Col;
+    const SoftV4 col4 = SoftV4Load(col);
+    for (int y = y0; y < y1; y++)
+    {
+        ImU32* dst = fb + (size_t)y * stride;
+        float v = prim.V0 + (y + 0.5f) * prim.DV;
+        if (prim.Nearest)
+        {
+            // text at 1:1, one texel per pixel
+            int ty = ImClamp((int)floorf(v * tex.Height), 0, tex.Height - 1);
+            const ImU32* row = tex.Pixels + (size_t)ty * tex.Width;
+            for (int x = x0; x < x1; x++)
+            {
+                int tx = ImClamp((int)floorf((prim.U0 + (x + 0.5f) * prim.DU) * tex.Width), 0, tex.Width - 1);
+                ImU32 texel = row[tx];
+                if ((texel >> IM_COL32_A_SHIFT) == 0)
+                    continue;
+                dst[x] = SoftBlend(dst[x], SoftModulate(col, texel));
+            }
+            continue;
+        }
+        for (int x = x0; x < x1; x++)
+        {
+            float u = prim.U0 + (x + 0.5f) * prim.DU;
+            ImU32 src = SoftV4Store(SoftV4Modulate(col4, SoftSampleBilinear(tex, u, v)));
+            dst[x] = SoftBlend(dst[x], src);
+        }
+    }
+}
+
+// Signed distance from the pixel center at (px, py) from the shape center to the shape outline (or stroke)
+static inline float SoftShapeDistance(const ImGui_ImplSoft_Prim& prim, float px, float py)
+{
+    const int quadrant = (px > 0.f ? 1 : 0) | (py > 0.f ? 2 : 0);
+    const float r = (prim.ShapeCorners & (1 << quadrant)) ? prim.ShapeRadius : 0.f;
+    const float qx = fabsf(px) - prim.ShapeHalfW + r, qy = fabsf(py) - prim.ShapeHalfH + r;
+    const float ox = ImMax(qx, 0.f), oy = ImMax(qy, 0.f);
+    float d = sqrtf(ox * ox + oy * oy) + ImMin(ImMax(qx, qy), 0.f) - r;
+    if (prim.ShapeThickness > 0.f)
+        d = fabsf(d) - prim.ShapeThickness * 0.5f;
+    return d;
+}
+
+static void ImGui_ImplSoft_RasterShape(const ImGui_ImplSoft_Prim& prim, ImU32* fb, int stride, int x0, int y0, int x1, int y1)
+{
+    const ImU32 col = prim.Color;
+    const float alpha = (float)(col >> IM_COL32_A_SHIFT);
+    if (prim.ShapeAxisY != 0.f)
+    {
+        // Rotated box: every pixel of the bounds measured in the frame of the box
+        for (int y = y0; y < y1; y++)
+        {
+            ImU32* dst = fb + (size_t)y * stride;
+            const float dy = y + 0.5f - prim.ShapeY;
+            for (int x = x0; x < x1; x++)
+            {
+                const float dx = x + 0.5f - prim.ShapeX;
+                const float px = dx * prim.ShapeAxisX + dy * prim.ShapeAxisY;
+                const float py = dy * prim.ShapeAxisX - dx * prim.ShapeAxisY;
+                const float coverage = ImClamp(0.5f - SoftShapeDistance(prim, px, py) / prim.ShapeFringe, 0.f, 1.f);
+                const ImU32 a = (ImU32)(alpha * coverage + 0.5f);
+                if (a != 0)
+                    dst[x] = SoftBlend(dst[x], (col & ~IM_COL32_A_MASK) | (a << IM_COL32_A_SHIFT));
+            }
+        }
+        return;
+    }
+    const bool filled = prim.ShapeThickness <= 0.f;
+    // Away from the corners the distance is max(|px| - half_w, |py| - half_h): the middle of those rows is fully
+    // covered (filled) or empty (stroke), only the pixels around the outline need the distance
+    const float inset = (filled ? 0.f : prim.ShapeThickness * 0.5f) + prim.ShapeFringe * 0.5f;
+    const float band = prim.ShapeHalfH - ImMax(inset, prim.ShapeCorners ? prim.ShapeRadius : 0.f);
+    const float inner = prim.ShapeHalfW - inset;
+    for (int y = y0; y < y1; y++)
+    {
+        ImU32* dst = fb + (size_t)y * stride;
+        const float py = y + 0.5f - prim.ShapeY;
+        int ix0 = x1, ix1 = x1;
+        if (fabsf(py) <= band && inner >= 0.f)
+        {
+            ix0 = ImClamp((int)ceilf(prim.ShapeX - inner - 0.5f), x0, x1);
+            ix1 = ImClamp((int)floorf(prim.ShapeX + inner - 0.5f) + 1, ix0, x1);
+            if (filled)
+                SoftBlendSpan(dst + ix0, ix1 - ix0, col);
+        }
+        for (int x = x0; x < x1; x++)
+        {
+            if (x == ix0)
+                x = ix1;
+            if (x >= x1)
+                break;
+            const float coverage = ImClamp(0.5f - SoftShapeDistance(prim, x + 0.5f - prim.ShapeX, py) / prim.ShapeFringe, 0.f, 1.f);
+            const ImU32 a = (ImU32)(alpha * coverage + 0.5f);
+            if (a != 0)
+                dst[x] = SoftBlend(dst[x], (col & ~IM_COL32_A_MASK) | (a << IM_COL32_A_SHIFT));
+        }
+    }
+}
+
+struct SoftEdge
+{
+    int64_t E;          // value at the first pixel center of the row, minus the tie break bias
+    int64_t StepX;
+    int64_t StepY;
+};
+
+// E(a->b, p) = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x), positive inside for the positive area winding.
+// On an edge (E == 0) the pixel goes to the triangle whose gradient points right (or down for horizontal edges),
+// the neighbour sharing the edge sees the opposite gradient, so no pixel is drawn twice or dropped.
+static inline SoftEdge SoftEdgeSetup(const ImGui_ImplSoft_Vert& a, const ImGui_ImplSoft_Vert& b, int px, int py)
+{
+    const int64_t one = 1 << SOFT_SUBPIXEL_BITS;
+    int64_t dx = (int64_t)b.FX - a.FX;
+    int64_t dy = (int64_t)b.FY - a.FY;
+    int64_t cx = ((int64_t)px << SOFT_SUBPIXEL_BITS) + one / 2;
+    int64_t cy = ((int64_t)py << SOFT_SUBPIXEL_BITS) + one / 2;
+    bool owner = -dy > 0 || (dy == 0 && dx > 0);
+    SoftEdge e;
+    e.E = dx * (cy - a.FY) - dy * (cx - a.FX) - (owner ? 0 : 1);
+    e.StepX = -dy * one;
+    e.StepY = dx * one;
+    return e;
+}
+
+// narrows [lo, hi) to the pixels of the row where E + StepX * i >= 0, so long thin triangles don't walk their bbox
+static inline void SoftEdgeSpan(const SoftEdge& e, int& lo, int& hi)
+{
+    if (e.StepX > 0)
+    {
+        if (e.E < 0)
+            lo = (int)ImMax((int64_t)lo, ImMin((int64_t)hi, (-e.E + e.StepX - 1) / e.StepX));
+    }
+    else if (e.StepX < 0)
+    {
+        hi = e.E < 0 ? lo : (int)ImMin((int64_t)hi, e.E / -e.StepX + 1);
+    }
+    else if (e.E < 0)
+    {
+        hi = lo;
+    }
+}
+
+static void ImGui_ImplSoft_RasterTriangle(const ImGui_ImplSoft_Data* bd, const ImGui_ImplSoft_Prim& prim, ImU32* fb, int stride, int x0, int y0, int x1, int y1)
+{
+    const ImGui_ImplSoft_Vert& v0 = bd->Verts[prim.Vtx[0]];
+    const ImGui_ImplSoft_Vert& v1 = bd->Verts[prim.Vtx[1]];
+    const ImGui_ImplSoft_Vert& v2 = bd->Verts[prim.Vtx[2]];
+    SoftEdge e0 = SoftEdgeSetup(v1, v2, x0, y0);
+    SoftEdge e1 = SoftEdgeSetup(v2, v0, x0, y0);
+    SoftEdge e2 = SoftEdgeSetup(v0, v1, x0, y0);
+
+    // barycentrics of v1 and v2 at the first pixel of the tile and their steps, attributes are stepped along the span
+    const ImGui_ImplSoft_Texture& tex = bd->Textures[prim.Texture];
+    const int64_t area = ((int64_t)v1.FX - v0.FX) * ((int64_t)v2.FY - v0.FY) - ((int64_t)v1.FY - v0.FY) * ((int64_t)v2.FX - v0.FX);
+    const float inv_area = 1.f / (float)area;
+    const float l1x = (float)e1.StepX * inv_area, l2x = (float)e2.StepX * inv_area;
+    const SoftV4 c0 = SoftV4Load(v0.Col);
+    const SoftV4 c10 = SoftV4Sub(SoftV4Load(v1.Col), c0);
+    const SoftV4 c20 = SoftV4Sub(SoftV4Load(v2.Col), c0);
+    const SoftV4 dcol = SoftV4Mad(SoftV4Mad(SoftV4Load(0), c10, l1x), c20, l2x);
+    const float du = (v1.U - v0.U) * l1x + (v2.U - v0.U) * l2x;
+    const float dv = (v1.V - v0.V) * l1x + (v2.V - v0.V) * l2x;
+    const SoftV4 texel = SoftV4Load(prim.Color);
+
+    for (int y = y0; y < y1; y++, e0.E += e0.StepY, e1.E += e1.StepY, e2.E += e2.StepY)
+    {
+        int lo = 0, hi = x1 - x0;
+        SoftEdgeSpan(e0, lo, hi);
+        SoftEdgeSpan(e1, lo, hi);
+        SoftEdgeSpan(e2, lo, hi);
+        if (lo >= hi)
+            continue;
+        ImU32* dst = fb + (size_t)y * stride + x0;
+        if (prim.Kind == SoftPrim_FlatTriangle)
+        {
+            SoftBlendSpan(dst + lo, hi - lo, prim.Color);
+            continue;
+        }
+        float l1 = (float)(e1.E + e1.StepX * lo) * inv_area;
+        float l2 = (float)(e2.E + e2.StepX * lo) * inv_area;
+        SoftV4 col = SoftV4Mad(SoftV4Mad(c0, c10, l1), c20, l2);
+        if (prim.Kind == SoftPrim_ShadedTriangle)
+        {
+            for (int x = lo; x < hi; x++, col = SoftV4Add(col, dcol))
+                dst[x] = SoftBlend(dst[x], SoftV4Store(SoftV4Modulate(col, texel)));
+            continue;
+        }
+        float u = v0.U + (v1.U - v0.U) * l1 + (v2.U - v0.U) * l2;
+        float v = v0.V + (v1.V - v0.V) * l1 + (v2.V - v0.V) * l2;
+        for (int x = lo; x < hi; x++, col = SoftV4Add(col, dcol), u += du, v += dv)
+            dst[x] = SoftBlend(dst[x], SoftV4Store(SoftV4Modulate(col, SoftSampleBilinear(tex, u, v))));
+    }
+}
+
+static void ImGui_ImplSoft_RasterTile(ImGui_ImplSoft_Data* bd, int tile)
+{
+    const int tx = tile % bd->TilesX;
+    const int ty = tile / bd->TilesX;
+    const int x0 = tx * SOFT_TILE_SIZE, y0 = ty * SOFT_TILE_SIZE;
+    const int x1 = ImMin(x0 + SOFT_TILE_SIZE, bd->TargetWidth), y1 = ImMin(y0 + SOFT_TILE_SIZE, bd->TargetHeight);
+    ImU32* fb = bd->Target;
+    const int stride = bd->TargetWidth;
+    if (bd->Clear)
+    {
+        for (int y = y0; y < y1; y++)
+            for (int x = x0; x < x1; x++)
+                fb[(size_t)y * stride + x] = bd->ClearColor;
+    }
+    const ImVector<int>& bin = bd->Bins[tile];
+    for (int i = 0; i < bin.Size; i++)
+    {
+        const ImGui_ImplSoft_Prim& prim = bd->Prims[bin[i]];
+        int px0 = ImMax(prim.X0, x0), py0 = ImMax(prim.Y0, y0);
+        int px1 = ImMin(prim.X1, x1), py1 = ImMin(prim.Y1, y1);
+        if (px0 >= px1 || py0 >= py1)
+            continue;
+        switch (prim.Kind)
+        {
+            case SoftPrim_Fill:         ImGui_ImplSoft_RasterFill(prim, fb, stride, px0, py0, px1, py1); break;
+            case SoftPrim_Quad:         ImGui_ImplSoft_RasterQuad(bd, prim, fb, stride, px0, py0, px1, py1); break;
+            case SoftPrim_Shape:        ImGui_ImplSoft_RasterShape(prim, fb, stride, px0, py0, px1, py1); break;
+            default:                    ImGui_ImplSoft_RasterTriangle(bd, prim, fb, stride, px0, py0, px1, py1); break;
+        }
+    }
+}
+
+static void ImGui_ImplSoft_RunTiles(ImGui_ImplSoft_Data* bd)
+{
+    const int count = bd->TilesX * bd->TilesY;
+    for (int tile = bd->NextTile.fetch_add(1); tile < count; tile = bd->NextTile.fetch_add(1))
+        ImGui_ImplSoft_RasterTile(bd, tile);
+}
+
+static void ImGui_ImplSoft_Worker(ImGui_ImplSoft_Data* bd)
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->StartCond.wait(lock, [&]() { return bd->Quit || bd->Generation != generation; });
+            if (bd->Quit)
+                return;
+            generation = bd->Generation;
+        }
+        ImGui_ImplSoft_RunTiles(bd);
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        if (--bd->Pending == 0)
+            bd->DoneCond.notify_one();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Frame setup and binning
+//-----------------------------------------------------------------------------
+
+static int ImGui_ImplSoft_TextureIndex(ImGui_ImplSoft_Data* bd, ImTextureID id)
+{
+    for (int i = bd->Textures.Size - 1; i >= 0; i--)
+        if (bd->Textures[i].ID == id)
+            return i;
+    ImGui_ImplSoft_Texture tex;
+    tex.ID = id;
+    tex.Pixels = NULL;
+    tex.Width = tex.Height = 0;
+    const ImGui::ImMat* mat = (const ImGui::ImMat*)id;
+    if (mat && !mat->empty())
+    {
+        IM_ASSERT(mat->c == 4 && mat->type == IM_DT_INT8 && "ImGui_ImplSoft textures are 4 channel 8-bit RGBA");
+        tex.Pixels = (const ImU32*)mat->data;
+        tex.Width = mat->w;
+        tex.Height = mat->h;
+    }
+    bd->Textures.push_back(tex);
+    return bd->Textures.Size - 1;
+}
+
+static void ImGui_ImplSoft_AddPrim(ImGui_ImplSoft_Data* bd, const ImGui_ImplSoft_Prim& prim)
+{
+    if (prim.X0 >= prim.X1 || prim.Y0 >= prim.Y1)
+        return;
+    const int index = bd->Prims.Size;
+    bd->Prims.push_back(prim);
+    const int tx1 = (prim.X1 - 1) / SOFT_TILE_SIZE, ty1 = (prim.Y1 - 1) / SOFT_TILE_SIZE;
+    for (int ty = prim.Y0 / SOFT_TILE_SIZE; ty <= ty1; ty++)
+        for (int tx = prim.X0 / SOFT_TILE_SIZE; tx <= tx1; tx++)
+            bd->Bins[ty * bd->TilesX + tx].push_back(index);
+}
+
+// ImDrawList::PrimRect/PrimRectUV layout: indices a b c a c d, corners a (min) b c (max) d with uv following the corners
+static bool ImGui_ImplSoft_IsQuad(const ImGui_ImplSoft_Vert* vtx, const ImDrawIdx* idx, int base)
+{
+    if (idx[0] != idx[3] || idx[2] != idx[4])
+        return false;
+    const ImGui_ImplSoft_Vert& a = vtx[base + idx[0]];
+    const ImGui_ImplSoft_Vert& b = vtx[base + idx[1]];
+    const ImGui_ImplSoft_Vert& c = vtx[base + idx[2]];
+    const ImGui_ImplSoft_Vert& d = vtx[base + idx[5]];
+    return a.Y == b.Y && b.X == c.X && c.Y == d.Y && d.X == a.X &&
+           a.V == b.V && b.U == c.U && c.V == d.V && d.U == a.U &&
+           a.Col == b.Col && a.Col == c.Col && a.Col == d.Col;
+}
+
+static void ImGui_ImplSoft_SetupQuad(ImGui_ImplSoft_Data* bd, int a, int c, int texture, const ImVec4& scissor)
+{
+    const ImGui_ImplSoft_Vert& va = bd->Verts[a];
+    const ImGui_ImplSoft_Vert& vc = bd->Verts[c];
+    if (va.X == vc.X || va.Y == vc.Y)
+        return;
+    ImGui_ImplSoft_Prim prim;
+    prim.Vtx[0] = a;
+    prim.Vtx[1] = c;
+    prim.Vtx[2] = c;
+    prim.Texture = texture;
+    // pixel centers inside [min, max)
+    prim.X0 = ImMax((int)ceilf(ImMin(va.X, vc.X) - 0.5f), (int)scissor.x);
+    prim.Y0 = ImMax((int)ceilf(ImMin(va.Y, vc.Y) - 0.5f), (int)scissor.y);
+    prim.X1 = ImMin((int)ceilf(ImMax(va.X, vc.X) - 0.5f), (int)scissor.z);
+    prim.Y1 = ImMin((int)ceilf(ImMax(va.Y, vc.Y) - 0.5f), (int)scissor.w);
+    prim.DU = (vc.U - va.U) / (vc.X - va.X);
+    prim.U0 = va.U - va.X * prim.DU;
+    prim.DV = (vc.V - va.V) / (vc.Y - va.Y);
+    prim.V0 = va.V - va.Y * prim.DV;
+    prim.Nearest = false;
+    const ImGui_ImplSoft_Texture& tex = bd->Textures[texture];
+    if (va.U == vc.U && va.V == vc.V)
+    {
+        // constant uv, the font white pixel for every filled rect
+        prim.Kind = SoftPrim_Fill;
+        prim.Color = SoftV4Store(SoftV4Modulate(SoftV4Load(va.Col), SoftSampleBilinear(tex, va.U, va.V)));
+        if ((prim.Color >> IM_COL32_A_SHIFT) == 0)
+            return;
+    }
+    else
+    {
+        prim.Kind = SoftPrim_Quad;
+        prim.Color = va.Col;
+        if (tex.Pixels && prim.X0 < prim.X1 && prim.Y0 < prim.Y1)
+        {
+            float tu = (prim.U0 + (prim.X0 + 0.5f) * prim.DU) * tex.Width;
+            float tv = (prim.V0 + (prim.Y0 + 0.5f) * prim.DV) * tex.Height;
+            prim.Nearest = fabsf(prim.DU * tex.Width - 1.f) < 1e-4f && fabsf(prim.DV * tex.Height - 1.f) < 1e-4f &&
+                           fabsf(tu - floorf(tu) - 0.5f) < 1e-3f && fabsf(tv - floorf(tv) - 0.5f) < 1e-3f;
+        }
+    }
+    ImGui_ImplSoft_AddPrim(bd, prim);
+}
+
+// Shape quad written by ImDrawList::_AddAnalyticShape(), corners a, b, c, d in its order (a and c opposite), see IM_DRAWVERT_SHAPE_MARKER
+static void ImGui_ImplSoft_SetupShape(ImGui_ImplSoft_Data* bd, int a, int b, int c, int d, float fb_scale, const ImVec4& scissor)
+{
+    const ImGui_ImplSoft_Vert& va = bd->Verts[a];
+    const ImGui_ImplSoft_Vert& vb = bd->Verts[b];
+    const ImGui_ImplSoft_Vert& vc = bd->Verts[c];
+    const ImGui_ImplSoft_Vert& vd = bd->Verts[d];
+    const int code_x = (int)(-va.U - IM_DRAWVERT_SHAPE_MARKER);
+    const int code_y = (int)va.V;
+    ImGui_ImplSoft_Prim prim;
+    prim.Kind = SoftPrim_Shape;
+    prim.Vtx[0] = a;
+    prim.Vtx[1] = prim.Vtx[2] = c;
+    prim.Texture = 0;
+    prim.Color = va.Col;
+    prim.U0 = prim.DU = prim.V0 = prim.DV = 0.f;
+    prim.Nearest = false;
+    prim.X0 = ImMax((int)ceilf(ImMin(ImMin(va.X, vb.X), ImMin(vc.X, vd.X)) - 0.5f), (int)scissor.x);
+    prim.Y0 = ImMax((int)ceilf(ImMin(ImMin(va.Y, vb.Y), ImMin(vc.Y, vd.Y)) - 0.5f), (int)scissor.y);
+    prim.X1 = ImMin((int)ceilf(ImMax(ImMax(va.X, vb.X), ImMax(vc.X, vd.X)) - 0.5f), (int)scissor.z);
+    prim.Y1 = ImMin((int)ceilf(ImMax(ImMax(va.Y, vb.Y), ImMax(vc.Y, vd.Y)) - 0.5f), (int)scissor.w);
+    const float edge_x = vb.X - va.X, edge_y = vb.Y - va.Y;
+    const float edge_length = sqrtf(edge_x * edge_x + edge_y * edge_y);
+    prim.ShapeAxisX = (edge_y == 0.f) ? 1.f : edge_x / edge_length;
+    prim.ShapeAxisY = (edge_y == 0.f) ? 0.f : edge_y / edge_length;
+    prim.ShapeX = (va.X + vc.X) * 0.5f;
+    prim.ShapeY = (va.Y + vc.Y) * 0.5f;
+    prim.ShapeHalfW = (code_x & 0x1FFF) * fb_scale / IM_DRAWVERT_SHAPE_UNIT;
+    prim.ShapeHalfH = (code_y & 0x1FFF) * fb_scale / IM_DRAWVERT_SHAPE_UNIT;
+    prim.ShapeRadius = ((code_y >> 13) & 0x1FF) * fb_scale / IM_DRAWVERT_SHAPE_UNIT;
+    prim.ShapeThickness = ((code_x >> 13) & 0x1F) * fb_scale / IM_DRAWVERT_SHAPE_UNIT;
+    prim.ShapeFringe = fb_scale;
+    prim.ShapeCorners = (code_x >> 18) & 0x0F;
+    if ((prim.Color >> IM_COL32_A_SHIFT) == 0)
+        return;
+    ImGui_ImplSoft_AddPrim(bd, prim);
+}
+
+static void ImGui_ImplSoft_SetupTriangle(ImGui_ImplSoft_Data* bd, int i0, int i1, int i2, int texture, const ImVec4& scissor)
+{
+    const ImGui_ImplSoft_Vert* v0 = &bd->Verts[i0];
+    const ImGui_ImplSoft_Vert* v1 = &bd->Verts[i1];
+    const ImGui_ImplSoft_Vert* v2 = &bd->Verts[i2];
+    int64_t area = ((int64_t)v1->FX - v0->FX) * ((int64_t)v2->FY - v0->FY) - ((int64_t)v1->FY - v0->FY) * ((int64_t)v2->FX - v0->FX);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImSwap(i1, i2);
+        ImSwap(v1, v2);
+    }
+    ImGui_ImplSoft_Prim prim;
+    prim.Vtx[0] = i0;
+    prim.Vtx[1] = i1;
+    prim.Vtx[2] = i2;
+    prim.Texture = texture;
+    prim.U0 = prim.DU = prim.V0 = prim.DV = 0.f;
+    prim.Nearest = false;
+    const int min_fx = ImMin(v0->FX, ImMin(v1->FX, v2->FX)), max_fx = ImMax(v0->FX, ImMax(v1->FX, v2->FX));
+    const int min_fy = ImMin(v0->FY, ImMin(v1->FY, v2->FY)), max_fy = ImMax(v0->FY, ImMax(v1->FY, v2->FY));
+    prim.X0 = ImMax(min_fx >> SOFT_SUBPIXEL_BITS, (int)scissor.x);
+    prim.Y0 = ImMax(min_fy >> SOFT_SUBPIXEL_BITS, (int)scissor.y);
+    prim.X1 = ImMin((max_fx >> SOFT_SUBPIXEL_BITS) + 1, (int)scissor.z);
+    prim.Y1 = ImMin((max_fy >> SOFT_SUBPIXEL_BITS) + 1, (int)scissor.w);
+    const bool const_uv = v0->U == v1->U && v0->U == v2->U && v0->V == v1->V && v0->V == v2->V;
+    if (const_uv && v0->Col == v1->Col && v0->Col == v2->Col)
+    {
+        prim.Kind = SoftPrim_FlatTriangle;
+        prim.Color = SoftV4Store(SoftV4Modulate(SoftV4Load(v0->Col), SoftSampleBilinear(bd->Textures[texture], v0->U, v0->V)));
+        if ((prim.Color >> IM_COL32_A_SHIFT) == 0)
+            return;
+    }
+    else if (const_uv)
+    {
+        prim.Kind = SoftPrim_ShadedTriangle;
+        prim.Color = SoftV4Store(SoftSampleBilinear(bd->Textures[texture], v0->U, v0->V));
+    }
+    else
+    {
+        prim.Kind = SoftPrim_Triangle;
+        prim.Color = 0;
+    }
+    ImGui_ImplSoft_AddPrim(bd, prim);
+}
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+bool ImGui_ImplSoft_Init(int threads)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendRendererUserData == NULL && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoft_Data* bd = IM_NEW(ImGui_ImplSoft_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasAnalyticShapes; // We can draw the shape quads of io.ConfigAnalyticShapes.
+
+    if (threads <= 0)
+        threads = ImMax((int)std::thread::hardware_concurrency(), 1);
+    // the calling thread renders too
+    for (int i = 1; i < threads; i++)
+        bd->Workers.push_back(std::thread(ImGui_ImplSoft_Worker, bd));
+    return true;
+}
+
+void ImGui_ImplSoft_Shutdown()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != NULL && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Quit = true;
+    }
+    bd->StartCond.notify_all();
+    for (auto& worker : bd->Workers)
+        worker.join();
+    ImGui_ImplSoft_DestroyFontsTexture();
+    io.BackendRendererName = NULL;
+    io.BackendRendererUserData = NULL;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasAnalyticShapes);
+    IM_DELETE(bd);
+}
+
+void ImGui_ImplSoft_NewFrame()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoft_Init()?");
+
+    if (!bd->FontTexture)
+        ImGui_ImplSoft_CreateFontsTexture();
+}
+
+void ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImGui::ImMat& target, bool clear, ImU32 clear_color)
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoft_Init()?");
+
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+    if (target.empty() || target.w != fb_width || target.h != fb_height || target.c != 4 || target.type != IM_DT_INT8 || target.elempack != 4)
+    {
+        target.create_type(fb_width, fb_height, 4, IM_DT_INT8);
+        target.elempack = 4;
+        clear = true;
+    }
+
+    bd->Target = (ImU32*)target.data;
+    bd->TargetWidth = fb_width;
+    bd->TargetHeight = fb_height;
+    bd->Clear = clear;
+    bd->ClearColor = clear_color;
+    bd->TilesX = (fb_width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    bd->TilesY = (fb_height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    if ((int)bd->Bins.size() < bd->TilesX * bd->TilesY)
+        bd->Bins.resize(bd->TilesX * bd->TilesY);
+    for (auto& bin : bd->Bins)
+        bin.resize(0);
+    bd->Verts.resize(0);
+    bd->Prims.resize(0);
+    bd->Textures.resize(0);
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    const float fixed_scale = (float)(1 << SOFT_SUBPIXEL_BITS);
+
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const int vtx_base = bd->Verts.Size;
+        bd->Verts.resize(vtx_base + cmd_list->VtxBuffer.Size);
+        for (int i = 0; i < cmd_list->VtxBuffer.Size; i++)
+        {
+            const ImDrawVert& src = cmd_list->VtxBuffer.Data[i];
+            ImGui_ImplSoft_Vert& dst = bd->Verts[vtx_base + i];
+            dst.X = ImClamp((src.pos.x - clip_off.x) * clip_scale.x, -SOFT_COORD_LIMIT, SOFT_COORD_LIMIT);
+            dst.Y = ImClamp((src.pos.y - clip_off.y) * clip_scale.y, -SOFT_COORD_LIMIT, SOFT_COORD_LIMIT);
+            dst.FX = (int)floorf(dst.X * fixed_scale + 0.5f);
+            dst.FY = (int)floorf(dst.Y * fixed_scale + 0.5f);
+            dst.U = src.uv.x;
+            dst.V = src.uv.y;
+            dst.Col = src.col;
+        }
+
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            ImVec4 scissor((float)(int)ImMax(clip_min.x, 0.f), (float)(int)ImMax(clip_min.y, 0.f),
+                           (float)(int)ImMin(clip_max.x, (float)fb_width), (float)(int)ImMin(clip_max.y, (float)fb_height));
+            if (scissor.z <= scissor.x || scissor.w <= scissor.y)
+                continue;
+
+            const int texture = ImGui_ImplSoft_TextureIndex(bd, pcmd->GetTexID());
+            const int base = vtx_base + (int)pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const int idx_count = (int)pcmd->ElemCount;
+            for (int i = 0; i + 3 <= idx_count; )
+            {
+                if (i + 6 <= idx_count && bd->Verts[base + idx[i]].U <= -IM_DRAWVERT_SHAPE_MARKER)
+                {
+                    ImGui_ImplSoft_SetupShape(bd, base + idx[i], base + idx[i + 1], base + idx[i + 2], base + idx[i + 5], clip_scale.x, scissor);
+                    i += 6;
+                }
+                else if (i + 6 <= idx_count && ImGui_ImplSoft_IsQuad(bd->Verts.Data, idx + i, base))
+                {
+                    ImGui_ImplSoft_SetupQuad(bd, base + idx[i], base + idx[i + 2], texture, scissor);
+                    i += 6;
+                }
+                else
+                {
+                    ImGui_ImplSoft_SetupTriangle(bd, base + idx[i], base + idx[i + 1], base + idx[i + 2], texture, scissor);
+                    i += 3;
+                }
+            }
+        }
+    }
+
+    bd->NextTile = 0;
+    if (!bd->Workers.empty())
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Pending = (int)bd->Workers.size();
+        bd->Generation++;
+    }
+    bd->StartCond.notify_all();
+    ImGui_ImplSoft_RunTiles(bd);
+    if (!bd->Workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(bd->Mutex);
+        bd->DoneCond.wait(lock, [&]() { return bd->Pending == 0; });
+    }
+}
+
+ImTextureID ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height)
+{
+    ImGui::ImMat* texture = IM_NEW(ImGui::ImMat)();
+    texture->create_type(width, height, 4, IM_DT_INT8);
+    texture->elempack = 4;
+    memcpy(texture->data, pixels, (size_t)width * height * 4);
+    return (ImTextureID)texture;
+}
+
+void ImGui_ImplSoft_DestroyTexture(ImTextureID texture)
+{
+    ImGui::ImMat* mat = (ImGui::ImMat*)texture;
+    if (mat)
+        IM_DELETE(mat);
+}
+
+bool ImGui_ImplSoft_CreateFontsTexture()
+{
+    // Build texture atlas
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontTexture = (ImGui::ImMat*)ImGui_ImplSoft_CreateTexture(pixels, width, height);
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)bd->FontTexture);
+    return true;
+}
+
+void ImGui_ImplSoft_DestroyFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    if (bd->FontTexture)
+    {
+        io.Fonts->SetTexID(0);
+        ImGui_ImplSoft_DestroyTexture((ImTextureID)bd->FontTexture);
+        bd->FontTexture = NULL;
+    }
+}
@@ -0,0 +1,30 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer, draws into an ImGui::ImMat
+// (Requires: nothing but std::thread, for servers and tests without any GPU)
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui::ImMat*' (4 channel IM_DT_INT8, elempack 4) as ImTextureID.
+//  [X] Renderer: Large meshes support (64k+ vertices).
+//  [X] Renderer: Multithreaded, the framebuffer is split in tiles and every tile runs its primitives in submission order.
+//  [X] Renderer: Axis aligned quads (rects, text) skip the triangle setup, solid spans blend 4 pixels at a time with SSE2.
+// Missing features:
+//  [ ] Renderer: Multi-viewport support (multiple windows).
+//  [ ] Renderer: User callbacks run while the frame is binned, before any pixel of it is written.
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#include "immat.h"
+
+// threads = 0 uses every hardware thread, 1 renders on the calling thread only
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init(int threads = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+// target is resized to DisplaySize * FramebufferScale as 4 channel IM_DT_INT8 RGBA, clear fills it with clear_color first
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImGui::ImMat& target, bool clear = true, ImU32 clear_color = 0);
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoft_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyFontsTexture();
+
+// pixels is 4 channel RGBA, the texture keeps its own copy
+IMGUI_IMPL_API ImTextureID ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height);
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyTexture(ImTextureID texture);
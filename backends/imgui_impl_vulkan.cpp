@@ -4,6 +4,9 @@
 // Implemented features:
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
 //  [x] Renderer: Multi-viewport / platform windows. With issues (flickering when creating a new viewport).
+//  [x] Renderer: Partial redraw of ImDrawData::DamageRects with ImGui_ImplVulkan_RenderDrawDataDamage(), swapchain images kept with ImGui_ImplVulkanH_Window::DamageEnable.
+//  [x] Renderer: ImDrawVertCompact vertices and 16-bit indices with io.ConfigCompactVertices (default pipeline only).
+//  [x] Renderer: Analytic rounded rectangles, circles and lines with io.ConfigAnalyticShapes (pipelines using the backend shaders).
 //  [!] Renderer: User texture binding. Use 'VkDescriptorSet' as ImTextureID. Read the FAQ about ImTextureID! See https://github.com/ocornut/imgui/pull/914 for discussions.
 
 // Important: on 32-bit systems, user texture binding is only supported if your imconfig file has '#define ImTextureID ImU64'.
@@ -32,6 +35,7 @@
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
+//  2022-XX-XX: Vulkan: Evaluate the shape quads of io.ConfigAnalyticShapes in the shaders, enable ImGuiBackendFlags_RendererHasAnalyticShapes.
 //  2021-10-15: Vulkan: Call vkCmdSetScissor() at the end of render a full-viewport to reduce likehood of issues with people using VK_DYNAMIC_STATE_SCISSOR in their app without calling vkCmdSetScissor() explicitly every frame.
 //  2021-06-29: Reorganized backend to pull data from a single structure to facilitate usage with multiple-contexts (all g_XXXX access changed to bd->XXXX).
 //  2021-03-22: Vulkan: Fix mapped memory validation error when buffer sizes are not multiple of VkPhysicalDeviceLimits::nonCoherentAtomSize.
@@ -67,6 +71,7 @@
 #include "imgui_impl_vulkan.h"
 #include <stdio.h>
 #include <stdexcept> // Add By Dicky
+#include <utility>
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -106,6 +111,16 @@ struct ImGui_ImplVulkan_ViewportData
     ~ImGui_ImplVulkan_ViewportData()        { }
 };
 
+// Where a draw list is uploaded in the vertex/index buffers with io.ConfigCompactVertices
+struct ImGui_ImplVulkan_DrawListLayout
+{
+    bool                CompactVtx;         // Uploaded as ImDrawVertCompact relative to Origin, drawn with PipelineCompact
+    bool                Idx16;
+    ImVec2              Origin;
+    VkDeviceSize        VtxBufferOffset;
+    VkDeviceSize        IdxBufferOffset;
+};
+
 // Vulkan data
 struct ImGui_ImplVulkan_Data
 {
@@ -117,6 +132,7 @@ struct ImGui_ImplVulkan_Data
     VkPipelineLayout            PipelineLayout;
     ImTextureVk                 FontTexture;  // add By Dicky
     VkPipeline                  Pipeline;
+    VkPipeline                  PipelineCompact;    // Same as Pipeline, reading ImDrawVertCompact
     uint32_t                    Subpass;
     VkShaderModule              ShaderModuleVert;
     VkShaderModule              ShaderModuleFrag;
@@ -132,6 +148,7 @@ struct ImGui_ImplVulkan_Data
 
     // Render buffers for main window
     ImGui_ImplVulkanH_WindowRenderBuffers MainWindowRenderBuffers;
+    ImVector<ImGui_ImplVulkan_DrawListLayout> DrawListLayouts;
 
     ImGui_ImplVulkan_Data()
     {
@@ -176,6 +193,7 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdBindIndexBuffer) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdBindPipeline) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdBindVertexBuffers) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdClearAttachments) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdCopyBufferToImage) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdDrawIndexed) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkCmdPipelineBarrier) \
@@ -216,7 +234,9 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkFreeCommandBuffers) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkFreeMemory) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetBufferMemoryRequirements) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetDeviceQueue) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetImageMemoryRequirements) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceFormatProperties) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceMemoryProperties) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfaceCapabilitiesKHR) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkGetPhysicalDeviceSurfaceFormatsKHR) \
@@ -234,6 +254,7 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkEndCommandBuffer) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetFences) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueSubmit) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueWaitIdle) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetCommandPool) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkAcquireNextImageKHR)
 
@@ -251,7 +272,9 @@ IMGUI_VULKAN_FUNC_MAP(IMGUI_VULKAN_FUNC_DEF)
 static void ImGui_ImplVulkan_InitPlatformInterface();
 static void ImGui_ImplVulkan_ShutdownPlatformInterface();
 
-// glsl_shader.vert, compiled with:
+// glsl_shader.vert, hand assembled: these words are not glslangValidator output and were not run through spirv-val.
+// They were checked by rendering textured and shape quads with the SwiftShader Vulkan driver against the OpenGL3
+// coverage. Replace them with the output of vulkan/generate_spv.sh:
 // # glslangValidator -V -x -o glsl_shader.vert.u32 glsl_shader.vert
 /*
 #version 450 core
@@ -259,101 +282,210 @@ layout(location = 0) in vec2 aPos;
 layout(location = 1) in vec2 aUV;
 layout(location = 2) in vec4 aColor;
 layout(push_constant) uniform uPushConstant { vec2 uScale; vec2 uTranslate; } pc;
-
 out gl_PerVertex { vec4 gl_Position; };
 layout(location = 0) out struct { vec4 Color; vec2 UV; } Out;
-
+// Analytic shapes (io.ConfigAnalyticShapes): shape vertices carry the half size, radius, thickness and corners in their uv
+// (see IM_DRAWVERT_SHAPE_MARKER in imgui.h), Shape.x < 0 for textured vertices.
+layout(location = 2) out vec2 ShapePos;
+layout(location = 3) flat out vec4 Shape;
+layout(location = 4) flat out uint ShapeCorners;
 void main()
 {
     Out.Color = aColor;
     Out.UV = aUV;
+    uint code_x = uint(clamp(-aUV.x - 8388608.0, 0.0, 16777215.0));
+    uint code_y = uint(clamp(aUV.y, 0.0, 16777215.0));
+    vec4 shape = vec4(float(code_x & 8191u), float(code_y & 8191u), float((code_y >> 13) & 511u), float((code_x >> 13) & 31u)) * 0.25;
+    vec2 extent = shape.xy + vec2(shape.w * 0.5 + 1.0);
+    uint corner = code_y >> 22;
+    ShapePos = vec2((corner & 1u) != 0u ? extent.x : -extent.x, (corner & 2u) != 0u ? extent.y : -extent.y);
+    Shape = aUV.x <= -8388608.0 ? shape : vec4(-1.0);
+    ShapeCorners = (code_x >> 18) & 15u;
     gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
 }
 */
 static uint32_t __glsl_shader_vert_spv[] =
 {
-    0x07230203,0x00010000,0x00080001,0x0000002e,0x00000000,0x00020011,0x00000001,0x0006000b,
+    0x07230203,0x00010000,0x00000000,0x00000071,0x00000000,0x00020011,0x00000001,0x0006000b,
     0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
-    0x000a000f,0x00000000,0x00000004,0x6e69616d,0x00000000,0x0000000b,0x0000000f,0x00000015,
-    0x0000001b,0x0000001c,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000004,0x6e69616d,
-    0x00000000,0x00030005,0x00000009,0x00000000,0x00050006,0x00000009,0x00000000,0x6f6c6f43,
-    0x00000072,0x00040006,0x00000009,0x00000001,0x00005655,0x00030005,0x0000000b,0x0074754f,
-    0x00040005,0x0000000f,0x6c6f4361,0x0000726f,0x00030005,0x00000015,0x00565561,0x00060005,
-    0x00000019,0x505f6c67,0x65567265,0x78657472,0x00000000,0x00060006,0x00000019,0x00000000,
-    0x505f6c67,0x7469736f,0x006e6f69,0x00030005,0x0000001b,0x00000000,0x00040005,0x0000001c,
-    0x736f5061,0x00000000,0x00060005,0x0000001e,0x73755075,0x6e6f4368,0x6e617473,0x00000074,
-    0x00050006,0x0000001e,0x00000000,0x61635375,0x0000656c,0x00060006,0x0000001e,0x00000001,
-    0x61725475,0x616c736e,0x00006574,0x00030005,0x00000020,0x00006370,0x00040047,0x0000000b,
-    0x0000001e,0x00000000,0x00040047,0x0000000f,0x0000001e,0x00000002,0x00040047,0x00000015,
-    0x0000001e,0x00000001,0x00050048,0x00000019,0x00000000,0x0000000b,0x00000000,0x00030047,
-    0x00000019,0x00000002,0x00040047,0x0000001c,0x0000001e,0x00000000,0x00050048,0x0000001e,
-    0x00000000,0x00000023,0x00000000,0x00050048,0x0000001e,0x00000001,0x00000023,0x00000008,
-    0x00030047,0x0000001e,0x00000002,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,
-    0x00030016,0x00000006,0x00000020,0x00040017,0x00000007,0x00000006,0x00000004,0x00040017,
-    0x00000008,0x00000006,0x00000002,0x0004001e,0x00000009,0x00000007,0x00000008,0x00040020,
-    0x0000000a,0x00000003,0x00000009,0x0004003b,0x0000000a,0x0000000b,0x00000003,0x00040015,
-    0x0000000c,0x00000020,0x00000001,0x0004002b,0x0000000c,0x0000000d,0x00000000,0x00040020,
-    0x0000000e,0x00000001,0x00000007,0x0004003b,0x0000000e,0x0000000f,0x00000001,0x00040020,
-    0x00000011,0x00000003,0x00000007,0x0004002b,0x0000000c,0x00000013,0x00000001,0x00040020,
-    0x00000014,0x00000001,0x00000008,0x0004003b,0x00000014,0x00000015,0x00000001,0x00040020,
-    0x00000017,0x00000003,0x00000008,0x0003001e,0x00000019,0x00000007,0x00040020,0x0000001a,
-    0x00000003,0x00000019,0x0004003b,0x0000001a,0x0000001b,0x00000003,0x0004003b,0x00000014,
-    0x0000001c,0x00000001,0x0004001e,0x0000001e,0x00000008,0x00000008,0x00040020,0x0000001f,
-    0x00000009,0x0000001e,0x0004003b,0x0000001f,0x00000020,0x00000009,0x00040020,0x00000021,
-    0x00000009,0x00000008,0x0004002b,0x00000006,0x00000028,0x00000000,0x0004002b,0x00000006,
-    0x00000029,0x3f800000,0x00050036,0x00000002,0x00000004,0x00000000,0x00000003,0x000200f8,
-    0x00000005,0x0004003d,0x00000007,0x00000010,0x0000000f,0x00050041,0x00000011,0x00000012,
-    0x0000000b,0x0000000d,0x0003003e,0x00000012,0x00000010,0x0004003d,0x00000008,0x00000016,
-    0x00000015,0x00050041,0x00000017,0x00000018,0x0000000b,0x00000013,0x0003003e,0x00000018,
-    0x00000016,0x0004003d,0x00000008,0x0000001d,0x0000001c,0x00050041,0x00000021,0x00000022,
-    0x00000020,0x0000000d,0x0004003d,0x00000008,0x00000023,0x00000022,0x00050085,0x00000008,
-    0x00000024,0x0000001d,0x00000023,0x00050041,0x00000021,0x00000025,0x00000020,0x00000013,
-    0x0004003d,0x00000008,0x00000026,0x00000025,0x00050081,0x00000008,0x00000027,0x00000024,
-    0x00000026,0x00050051,0x00000006,0x0000002a,0x00000027,0x00000000,0x00050051,0x00000006,
-    0x0000002b,0x00000027,0x00000001,0x00070050,0x00000007,0x0000002c,0x0000002a,0x0000002b,
-    0x00000028,0x00000029,0x00050041,0x00000011,0x0000002d,0x0000001b,0x0000000d,0x0003003e,
-    0x0000002d,0x0000002c,0x000100fd,0x00010038
+    0x000d000f,0x00000000,0x00000002,0x6e69616d,0x00000000,0x0000000e,0x00000014,0x00000015,
+    0x00000017,0x00000018,0x00000019,0x0000001c,0x00000016,0x00030003,0x00000002,0x000001c2,
+    0x00040005,0x00000002,0x6e69616d,0x00000000,0x00030005,0x0000000c,0x00000000,0x00050006,
+    0x0000000c,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x0000000c,0x00000001,0x00005655,
+    0x00030005,0x0000000e,0x0074754f,0x00040005,0x00000014,0x6c6f4361,0x0000726f,0x00030005,
+    0x00000015,0x00565561,0x00050005,0x00000017,0x70616853,0x736f5065,0x00000000,0x00040005,
+    0x00000018,0x70616853,0x00000065,0x00060005,0x00000019,0x70616853,0x726f4365,0x7372656e,
+    0x00000000,0x00060005,0x0000001a,0x505f6c67,0x65567265,0x78657472,0x00000000,0x00060006,
+    0x0000001a,0x00000000,0x505f6c67,0x7469736f,0x006e6f69,0x00030005,0x0000001c,0x00000000,
+    0x00040005,0x00000016,0x736f5061,0x00000000,0x00060005,0x0000001d,0x73755075,0x6e6f4368,
+    0x6e617473,0x00000074,0x00050006,0x0000001d,0x00000000,0x61635375,0x0000656c,0x00060006,
+    0x0000001d,0x00000001,0x61725475,0x616c736e,0x00006574,0x00030005,0x0000001f,0x00006370,
+    0x00040047,0x0000000e,0x0000001e,0x00000000,0x00040047,0x00000014,0x0000001e,0x00000002,
+    0x00040047,0x00000015,0x0000001e,0x00000001,0x00040047,0x00000017,0x0000001e,0x00000002,
+    0x00030047,0x00000018,0x0000000e,0x00040047,0x00000018,0x0000001e,0x00000003,0x00030047,
+    0x00000019,0x0000000e,0x00040047,0x00000019,0x0000001e,0x00000004,0x00050048,0x0000001a,
+    0x00000000,0x0000000b,0x00000000,0x00030047,0x0000001a,0x00000002,0x00040047,0x00000016,
+    0x0000001e,0x00000000,0x00050048,0x0000001d,0x00000000,0x00000023,0x00000000,0x00050048,
+    0x0000001d,0x00000001,0x00000023,0x00000008,0x00030047,0x0000001d,0x00000002,0x00020013,
+    0x00000003,0x00030021,0x00000004,0x00000003,0x00030016,0x00000005,0x00000020,0x00040017,
+    0x00000006,0x00000005,0x00000004,0x00040017,0x00000007,0x00000005,0x00000002,0x00040015,
+    0x00000008,0x00000020,0x00000001,0x00040015,0x00000009,0x00000020,0x00000000,0x00020014,
+    0x0000000a,0x00040017,0x0000000b,0x0000000a,0x00000004,0x0004001e,0x0000000c,0x00000006,
+    0x00000007,0x00040020,0x0000000d,0x00000003,0x0000000c,0x0004003b,0x0000000d,0x0000000e,
+    0x00000003,0x00040020,0x0000000f,0x00000001,0x00000006,0x00040020,0x00000010,0x00000001,
+    0x00000007,0x00040020,0x00000011,0x00000003,0x00000006,0x00040020,0x00000012,0x00000003,
+    0x00000007,0x00040020,0x00000013,0x00000003,0x00000009,0x0004003b,0x0000000f,0x00000014,
+    0x00000001,0x0004003b,0x00000010,0x00000015,0x00000001,0x0004003b,0x00000010,0x00000016,
+    0x00000001,0x0004003b,0x00000012,0x00000017,0x00000003,0x0004003b,0x00000011,0x00000018,
+    0x00000003,0x0004003b,0x00000013,0x00000019,0x00000003,0x0003001e,0x0000001a,0x00000006,
+    0x00040020,0x0000001b,0x00000003,0x0000001a,0x0004003b,0x0000001b,0x0000001c,0x00000003,
+    0x0004001e,0x0000001d,0x00000007,0x00000007,0x00040020,0x0000001e,0x00000009,0x0000001d,
+    0x0004003b,0x0000001e,0x0000001f,0x00000009,0x00040020,0x00000020,0x00000009,0x00000007,
+    0x0004002b,0x00000008,0x00000021,0x00000000,0x0004002b,0x00000008,0x00000022,0x00000001,
+    0x0004002b,0x00000005,0x00000023,0x00000000,0x0004002b,0x00000005,0x00000024,0x3f800000,
+    0x0004002b,0x00000005,0x00000025,0x4b000000,0x0004002b,0x00000005,0x00000026,0xcb000000,
+    0x0004002b,0x00000005,0x00000027,0x4b7fffff,0x0004002b,0x00000005,0x00000028,0x3e800000,
+    0x0004002b,0x00000005,0x00000029,0x3f000000,0x0004002b,0x00000005,0x0000002a,0xbf800000,
+    0x0007002c,0x00000006,0x0000002b,0x0000002a,0x0000002a,0x0000002a,0x0000002a,0x0004002b,
+    0x00000009,0x00000039,0x00001fff,0x0004002b,0x00000009,0x0000003e,0x0000000d,0x0004002b,
+    0x00000009,0x00000040,0x000001ff,0x0004002b,0x00000009,0x00000044,0x0000001f,0x0004002b,
+    0x00000009,0x0000004f,0x00000016,0x0004002b,0x00000009,0x00000052,0x00000001,0x0004002b,
+    0x00000009,0x00000054,0x00000000,0x0004002b,0x00000009,0x00000059,0x00000002,0x0004002b,
+    0x00000009,0x00000062,0x00000012,0x0004002b,0x00000009,0x00000064,0x0000000f,0x00050036,
+    0x00000003,0x00000002,0x00000000,0x00000004,0x000200f8,0x0000002c,0x0004003d,0x00000006,
+    0x0000002d,0x00000014,0x00050041,0x00000011,0x0000002e,0x0000000e,0x00000021,0x0003003e,
+    0x0000002e,0x0000002d,0x0004003d,0x00000007,0x0000002f,0x00000015,0x00050041,0x00000012,
+    0x00000030,0x0000000e,0x00000022,0x0003003e,0x00000030,0x0000002f,0x00050051,0x00000005,
+    0x00000031,0x0000002f,0x00000000,0x0004007f,0x00000005,0x00000032,0x00000031,0x00050083,
+    0x00000005,0x00000033,0x00000032,0x00000025,0x0008000c,0x00000005,0x00000034,0x00000001,
+    0x0000002b,0x00000033,0x00000023,0x00000027,0x0004006d,0x00000009,0x00000035,0x00000034,
+    0x00050051,0x00000005,0x00000036,0x0000002f,0x00000001,0x0008000c,0x00000005,0x00000037,
+    0x00000001,0x0000002b,0x00000036,0x00000023,0x00000027,0x0004006d,0x00000009,0x00000038,
+    0x00000037,0x000500c7,0x00000009,0x0000003a,0x00000035,0x00000039,0x00040070,0x00000005,
+    0x0000003b,0x0000003a,0x000500c7,0x00000009,0x0000003c,0x00000038,0x00000039,0x00040070,
+    0x00000005,0x0000003d,0x0000003c,0x000500c2,0x00000009,0x0000003f,0x00000038,0x0000003e,
+    0x000500c7,0x00000009,0x00000041,0x0000003f,0x00000040,0x00040070,0x00000005,0x00000042,
+    0x00000041,0x000500c2,0x00000009,0x00000043,0x00000035,0x0000003e,0x000500c7,0x00000009,
+    0x00000045,0x00000043,0x00000044,0x00040070,0x00000005,0x00000046,0x00000045,0x00070050,
+    0x00000006,0x00000047,0x0000003b,0x0000003d,0x00000042,0x00000046,0x0005008e,0x00000006,
+    0x00000048,0x00000047,0x00000028,0x00050051,0x00000005,0x00000049,0x00000048,0x00000003,
+    0x00050085,0x00000005,0x0000004a,0x00000049,0x00000029,0x00050081,0x00000005,0x0000004b,
+    0x0000004a,0x00000024,0x0007004f,0x00000007,0x0000004c,0x00000048,0x00000048,0x00000000,
+    0x00000001,0x00050050,0x00000007,0x0000004d,0x0000004b,0x0000004b,0x00050081,0x00000007,
+    0x0000004e,0x0000004c,0x0000004d,0x000500c2,0x00000009,0x00000050,0x00000038,0x0000004f,
+    0x00050051,0x00000005,0x00000051,0x0000004e,0x00000000,0x000500c7,0x00000009,0x00000053,
+    0x00000050,0x00000052,0x000500ab,0x0000000a,0x00000055,0x00000053,0x00000054,0x0004007f,
+    0x00000005,0x00000056,0x00000051,0x000600a9,0x00000005,0x00000057,0x00000055,0x00000051,
+    0x00000056,0x00050051,0x00000005,0x00000058,0x0000004e,0x00000001,0x000500c7,0x00000009,
+    0x0000005a,0x00000050,0x00000059,0x000500ab,0x0000000a,0x0000005b,0x0000005a,0x00000054,
+    0x0004007f,0x00000005,0x0000005c,0x00000058,0x000600a9,0x00000005,0x0000005d,0x0000005b,
+    0x00000058,0x0000005c,0x00050050,0x00000007,0x0000005e,0x00000057,0x0000005d,0x0003003e,
+    0x00000017,0x0000005e,0x000500bc,0x0000000a,0x0000005f,0x00000031,0x00000026,0x00070050,
+    0x0000000b,0x00000060,0x0000005f,0x0000005f,0x0000005f,0x0000005f,0x000600a9,0x00000006,
+    0x00000061,0x00000060,0x00000048,0x0000002b,0x0003003e,0x00000018,0x00000061,0x000500c2,
+    0x00000009,0x00000063,0x00000035,0x00000062,0x000500c7,0x00000009,0x00000065,0x00000063,
+    0x00000064,0x0003003e,0x00000019,0x00000065,0x0004003d,0x00000007,0x00000066,0x00000016,
+    0x00050041,0x00000020,0x00000067,0x0000001f,0x00000021,0x0004003d,0x00000007,0x00000068,
+    0x00000067,0x00050041,0x00000020,0x00000069,0x0000001f,0x00000022,0x0004003d,0x00000007,
+    0x0000006a,0x00000069,0x00050085,0x00000007,0x0000006b,0x00000066,0x00000068,0x00050081,
+    0x00000007,0x0000006c,0x0000006b,0x0000006a,0x00050051,0x00000005,0x0000006d,0x0000006c,
+    0x00000000,0x00050051,0x00000005,0x0000006e,0x0000006c,0x00000001,0x00070050,0x00000006,
+    0x0000006f,0x0000006d,0x0000006e,0x00000023,0x00000024,0x00050041,0x00000011,0x00000070,
+    0x0000001c,0x00000021,0x0003003e,0x00000070,0x0000006f,0x000100fd,0x00010038
 };
 
-// glsl_shader.frag, compiled with:
+// glsl_shader.frag, hand assembled like the vertex shader above, see there. Regenerate with:
 // # glslangValidator -V -x -o glsl_shader.frag.u32 glsl_shader.frag
 /*
 #version 450 core
 layout(location = 0) out vec4 fColor;
 layout(set=0, binding=0) uniform sampler2D sTexture;
 layout(location = 0) in struct { vec4 Color; vec2 UV; } In;
+layout(location = 2) in vec2 ShapePos;
+layout(location = 3) flat in vec4 Shape;
+layout(location = 4) flat in uint ShapeCorners;
 void main()
 {
-    fColor = In.Color * texture(sTexture, In.UV.st);
+    vec4 textured = In.Color * texture(sTexture, In.UV.st);
+    // Shape quads: coverage of the rounded box over one pixel, like the tessellated anti-aliased fringes
+    uint quadrant = (ShapePos.x > 0.0 ? 1u : 0u) + (ShapePos.y > 0.0 ? 2u : 0u);
+    float r = ((ShapeCorners >> quadrant) & 1u) != 0u ? Shape.z : 0.0;
+    vec2 q = abs(ShapePos) - Shape.xy + vec2(r);
+    float d = length(max(q, vec2(0.0))) + min(max(q.x, q.y), 0.0) - r;
+    d = Shape.w > 0.0 ? abs(d) - Shape.w * 0.5 : d;
+    vec4 shaped = vec4(In.Color.rgb, In.Color.a * clamp(0.5 - d, 0.0, 1.0));
+    fColor = Shape.x >= 0.0 ? shaped : textured;
 }
 */
 static uint32_t __glsl_shader_frag_spv[] =
 {
-    0x07230203,0x00010000,0x00080001,0x0000001e,0x00000000,0x00020011,0x00000001,0x0006000b,
+    0x07230203,0x00010000,0x00000000,0x0000005a,0x00000000,0x00020011,0x00000001,0x0006000b,
     0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
-    0x0007000f,0x00000004,0x00000004,0x6e69616d,0x00000000,0x00000009,0x0000000d,0x00030010,
-    0x00000004,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000004,0x6e69616d,
-    0x00000000,0x00040005,0x00000009,0x6c6f4366,0x0000726f,0x00030005,0x0000000b,0x00000000,
-    0x00050006,0x0000000b,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x0000000b,0x00000001,
-    0x00005655,0x00030005,0x0000000d,0x00006e49,0x00050005,0x00000016,0x78655473,0x65727574,
-    0x00000000,0x00040047,0x00000009,0x0000001e,0x00000000,0x00040047,0x0000000d,0x0000001e,
-    0x00000000,0x00040047,0x00000016,0x00000022,0x00000000,0x00040047,0x00000016,0x00000021,
-    0x00000000,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,0x00030016,0x00000006,
-    0x00000020,0x00040017,0x00000007,0x00000006,0x00000004,0x00040020,0x00000008,0x00000003,
-    0x00000007,0x0004003b,0x00000008,0x00000009,0x00000003,0x00040017,0x0000000a,0x00000006,
-    0x00000002,0x0004001e,0x0000000b,0x00000007,0x0000000a,0x00040020,0x0000000c,0x00000001,
-    0x0000000b,0x0004003b,0x0000000c,0x0000000d,0x00000001,0x00040015,0x0000000e,0x00000020,
-    0x00000001,0x0004002b,0x0000000e,0x0000000f,0x00000000,0x00040020,0x00000010,0x00000001,
-    0x00000007,0x00090019,0x00000013,0x00000006,0x00000001,0x00000000,0x00000000,0x00000000,
-    0x00000001,0x00000000,0x0003001b,0x00000014,0x00000013,0x00040020,0x00000015,0x00000000,
-    0x00000014,0x0004003b,0x00000015,0x00000016,0x00000000,0x0004002b,0x0000000e,0x00000018,
-    0x00000001,0x00040020,0x00000019,0x00000001,0x0000000a,0x00050036,0x00000002,0x00000004,
-    0x00000000,0x00000003,0x000200f8,0x00000005,0x00050041,0x00000010,0x00000011,0x0000000d,
-    0x0000000f,0x0004003d,0x00000007,0x00000012,0x00000011,0x0004003d,0x00000014,0x00000017,
-    0x00000016,0x00050041,0x00000019,0x0000001a,0x0000000d,0x00000018,0x0004003d,0x0000000a,
-    0x0000001b,0x0000001a,0x00050057,0x00000007,0x0000001c,0x00000017,0x0000001b,0x00050085,
-    0x00000007,0x0000001d,0x00000012,0x0000001c,0x0003003e,0x00000009,0x0000001d,0x000100fd,
-    0x00010038
+    0x000a000f,0x00000004,0x00000002,0x6e69616d,0x00000000,0x0000000d,0x00000010,0x00000018,
+    0x00000019,0x0000001a,0x00030010,0x00000002,0x00000007,0x00030003,0x00000002,0x000001c2,
+    0x00040005,0x00000002,0x6e69616d,0x00000000,0x00040005,0x0000000d,0x6c6f4366,0x0000726f,
+    0x00030005,0x0000000e,0x00000000,0x00050006,0x0000000e,0x00000000,0x6f6c6f43,0x00000072,
+    0x00040006,0x0000000e,0x00000001,0x00005655,0x00030005,0x00000010,0x00006e49,0x00050005,
+    0x00000017,0x78655473,0x65727574,0x00000000,0x00050005,0x00000018,0x70616853,0x736f5065,
+    0x00000000,0x00040005,0x00000019,0x70616853,0x00000065,0x00060005,0x0000001a,0x70616853,
+    0x726f4365,0x7372656e,0x00000000,0x00040047,0x0000000d,0x0000001e,0x00000000,0x00040047,
+    0x00000010,0x0000001e,0x00000000,0x00040047,0x00000017,0x00000022,0x00000000,0x00040047,
+    0x00000017,0x00000021,0x00000000,0x00040047,0x00000018,0x0000001e,0x00000002,0x00030047,
+    0x00000019,0x0000000e,0x00040047,0x00000019,0x0000001e,0x00000003,0x00030047,0x0000001a,
+    0x0000000e,0x00040047,0x0000001a,0x0000001e,0x00000004,0x00020013,0x00000003,0x00030021,
+    0x00000004,0x00000003,0x00030016,0x00000005,0x00000020,0x00040017,0x00000006,0x00000005,
+    0x00000004,0x00040017,0x00000007,0x00000005,0x00000002,0x00040015,0x00000008,0x00000020,
+    0x00000001,0x00040015,0x00000009,0x00000020,0x00000000,0x00020014,0x0000000a,0x00040017,
+    0x0000000b,0x0000000a,0x00000004,0x00040020,0x0000000c,0x00000003,0x00000006,0x0004003b,
+    0x0000000c,0x0000000d,0x00000003,0x0004001e,0x0000000e,0x00000006,0x00000007,0x00040020,
+    0x0000000f,0x00000001,0x0000000e,0x0004003b,0x0000000f,0x00000010,0x00000001,0x00040020,
+    0x00000011,0x00000001,0x00000006,0x00040020,0x00000012,0x00000001,0x00000007,0x00040020,
+    0x00000013,0x00000001,0x00000009,0x00090019,0x00000014,0x00000005,0x00000001,0x00000000,
+    0x00000000,0x00000000,0x00000001,0x00000000,0x0003001b,0x00000015,0x00000014,0x00040020,
+    0x00000016,0x00000000,0x00000015,0x0004003b,0x00000016,0x00000017,0x00000000,0x0004003b,
+    0x00000012,0x00000018,0x00000001,0x0004003b,0x00000011,0x00000019,0x00000001,0x0004003b,
+    0x00000013,0x0000001a,0x00000001,0x0004002b,0x00000008,0x0000001b,0x00000000,0x0004002b,
+    0x00000008,0x0000001c,0x00000001,0x0004002b,0x00000005,0x0000001d,0x00000000,0x0004002b,
+    0x00000005,0x0000001e,0x3f800000,0x0004002b,0x00000005,0x0000001f,0x3f000000,0x0005002c,
+    0x00000007,0x00000020,0x0000001d,0x0000001d,0x0004002b,0x00000009,0x0000002c,0x00000001,
+    0x0004002b,0x00000009,0x0000002d,0x00000000,0x0004002b,0x00000009,0x00000031,0x00000002,
+    0x00050036,0x00000003,0x00000002,0x00000000,0x00000004,0x000200f8,0x00000021,0x00050041,
+    0x00000011,0x00000022,0x00000010,0x0000001b,0x0004003d,0x00000006,0x00000023,0x00000022,
+    0x0004003d,0x00000015,0x00000024,0x00000017,0x00050041,0x00000012,0x00000025,0x00000010,
+    0x0000001c,0x0004003d,0x00000007,0x00000026,0x00000025,0x00050057,0x00000006,0x00000027,
+    0x00000024,0x00000026,0x00050085,0x00000006,0x00000028,0x00000023,0x00000027,0x0004003d,
+    0x00000007,0x00000029,0x00000018,0x00050051,0x00000005,0x0000002a,0x00000029,0x00000000,
+    0x000500ba,0x0000000a,0x0000002b,0x0000002a,0x0000001d,0x000600a9,0x00000009,0x0000002e,
+    0x0000002b,0x0000002c,0x0000002d,0x00050051,0x00000005,0x0000002f,0x00000029,0x00000001,
+    0x000500ba,0x0000000a,0x00000030,0x0000002f,0x0000001d,0x000600a9,0x00000009,0x00000032,
+    0x00000030,0x00000031,0x0000002d,0x00050080,0x00000009,0x00000033,0x0000002e,0x00000032,
+    0x0004003d,0x00000009,0x00000034,0x0000001a,0x0004003d,0x00000006,0x00000035,0x00000019,
+    0x000500c2,0x00000009,0x00000036,0x00000034,0x00000033,0x000500c7,0x00000009,0x00000037,
+    0x00000036,0x0000002c,0x000500ab,0x0000000a,0x00000038,0x00000037,0x0000002d,0x00050051,
+    0x00000005,0x00000039,0x00000035,0x00000002,0x000600a9,0x00000005,0x0000003a,0x00000038,
+    0x00000039,0x0000001d,0x0006000c,0x00000007,0x0000003b,0x00000001,0x00000004,0x00000029,
+    0x0007004f,0x00000007,0x0000003c,0x00000035,0x00000035,0x00000000,0x00000001,0x00050083,
+    0x00000007,0x0000003d,0x0000003b,0x0000003c,0x00050050,0x00000007,0x0000003e,0x0000003a,
+    0x0000003a,0x00050081,0x00000007,0x0000003f,0x0000003d,0x0000003e,0x0007000c,0x00000007,
+    0x00000040,0x00000001,0x00000028,0x0000003f,0x00000020,0x0006000c,0x00000005,0x00000041,
+    0x00000001,0x00000042,0x00000040,0x00050051,0x00000005,0x00000042,0x0000003f,0x00000000,
+    0x00050051,0x00000005,0x00000043,0x0000003f,0x00000001,0x0007000c,0x00000005,0x00000044,
+    0x00000001,0x00000028,0x00000042,0x00000043,0x0007000c,0x00000005,0x00000045,0x00000001,
+    0x00000025,0x00000044,0x0000001d,0x00050081,0x00000005,0x00000046,0x00000041,0x00000045,
+    0x00050083,0x00000005,0x00000047,0x00000046,0x0000003a,0x00050051,0x00000005,0x00000048,
+    0x00000035,0x00000003,0x0006000c,0x00000005,0x00000049,0x00000001,0x00000004,0x00000047,
+    0x00050085,0x00000005,0x0000004a,0x00000048,0x0000001f,0x00050083,0x00000005,0x0000004b,
+    0x00000049,0x0000004a,0x000500ba,0x0000000a,0x0000004c,0x00000048,0x0000001d,0x000600a9,
+    0x00000005,0x0000004d,0x0000004c,0x0000004b,0x00000047,0x00050083,0x00000005,0x0000004e,
+    0x0000001f,0x0000004d,0x0008000c,0x00000005,0x0000004f,0x00000001,0x0000002b,0x0000004e,
+    0x0000001d,0x0000001e,0x00050051,0x00000005,0x00000050,0x00000023,0x00000003,0x00050085,
+    0x00000005,0x00000051,0x00000050,0x0000004f,0x00050051,0x00000005,0x00000052,0x00000023,
+    0x00000000,0x00050051,0x00000005,0x00000053,0x00000023,0x00000001,0x00050051,0x00000005,
+    0x00000054,0x00000023,0x00000002,0x00070050,0x00000006,0x00000055,0x00000052,0x00000053,
+    0x00000054,0x00000051,0x00050051,0x00000005,0x00000056,0x00000035,0x00000000,0x000500be,
+    0x0000000a,0x00000057,0x00000056,0x0000001d,0x00070050,0x0000000b,0x00000058,0x00000057,
+    0x00000057,0x00000057,0x00000057,0x000600a9,0x00000006,0x00000059,0x00000058,0x00000055,
+    0x00000028,0x0003003e,0x0000000d,0x00000059,0x000100fd,0x00010038
 };
 
 //-----------------------------------------------------------------------------
@@ -467,8 +599,38 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline
     }
 }
 
+// Bind the part of the buffers holding a draw list uploaded with io.ConfigCompactVertices, with the pipeline of its vertex layout.
+// ImDrawVertCompact positions are read as normalized shorts, the scale and translation bring them back to ImGui space.
+static void ImGui_ImplVulkan_SetupDrawListState(ImDrawData* draw_data, VkCommandBuffer command_buffer, ImGui_ImplVulkanH_FrameRenderBuffers* rb, const ImGui_ImplVulkan_DrawListLayout& layout)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout.CompactVtx ? bd->PipelineCompact : bd->Pipeline);
+
+    VkBuffer vertex_buffers[1] = { rb->VertexBuffer };
+    VkDeviceSize vertex_offset[1] = { layout.VtxBufferOffset };
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, vertex_offset);
+    vkCmdBindIndexBuffer(command_buffer, rb->IndexBuffer, layout.IdxBufferOffset, (layout.Idx16 || sizeof(ImDrawIdx) == 2) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
+
+    float scale[2];
+    scale[0] = 2.0f / draw_data->DisplaySize.x;
+    scale[1] = 2.0f / draw_data->DisplaySize.y;
+    float translate[2];
+    translate[0] = -1.0f - draw_data->DisplayPos.x * scale[0];
+    translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
+    if (layout.CompactVtx)
+    {
+        translate[0] += layout.Origin.x * scale[0];
+        translate[1] += layout.Origin.y * scale[1];
+        scale[0] *= 32767.0f / IM_DRAWVERT_COMPACT_POS_SCALE;
+        scale[1] *= 32767.0f / IM_DRAWVERT_COMPACT_POS_SCALE;
+    }
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
+}
+
 // Render function
-void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline)
+// When damage_rects is not NULL, only the pixels inside those rectangles are drawn.
+static void ImGui_ImplVulkan_RenderDrawDataEx(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline, const ImVec4* damage_rects, int damage_rects_count)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
     int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
@@ -480,6 +642,7 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo; // modify by Dicky
     if (pipeline == VK_NULL_HANDLE)
         pipeline = bd->Pipeline;
+    const bool compact_layouts = ImGui::GetIO().ConfigCompactVertices && pipeline == bd->Pipeline && bd->PipelineCompact != VK_NULL_HANDLE;
 
     // Allocate array to store enough vertex/index buffers. Each unique viewport gets its own storage.
     ImGui_ImplVulkan_ViewportData* viewport_renderer_data = (ImGui_ImplVulkan_ViewportData*)draw_data->OwnerViewport->RendererUserData;
@@ -501,6 +664,24 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         // Create or resize the vertex/index buffers
         size_t vertex_size = draw_data->TotalVtxCount * sizeof(ImDrawVert);
         size_t index_size = draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+        if (compact_layouts)
+        {
+            // Index buffer offsets must be aligned on the index size
+            bd->DrawListLayouts.resize(draw_data->CmdListsCount);
+            vertex_size = index_size = 0;
+            for (int n = 0; n < draw_data->CmdListsCount; n++)
+            {
+                const ImDrawList* cmd_list = draw_data->CmdLists[n];
+                ImGui_ImplVulkan_DrawListLayout& layout = bd->DrawListLayouts[n];
+                layout.CompactVtx = cmd_list->CalcCompactVtxOrigin(&layout.Origin);
+                layout.Idx16 = cmd_list->CanPackIdx16();
+                layout.VtxBufferOffset = vertex_size;
+                layout.IdxBufferOffset = index_size;
+                vertex_size += cmd_list->VtxBuffer.Size * (layout.CompactVtx ? sizeof(ImDrawVertCompact) : sizeof(ImDrawVert));
+                index_size += cmd_list->IdxBuffer.Size * (layout.Idx16 ? sizeof(ImU16) : sizeof(ImDrawIdx));
+                index_size = (index_size + 3) & ~(size_t)3;
+            }
+        }
         if (rb->VertexBuffer == VK_NULL_HANDLE || rb->VertexBufferSize < vertex_size)
             CreateOrResizeBuffer(rb->VertexBuffer, rb->VertexBufferMemory, rb->VertexBufferSize, vertex_size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
         if (rb->IndexBuffer == VK_NULL_HANDLE || rb->IndexBufferSize < index_size)
@@ -516,6 +697,21 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         for (int n = 0; n < draw_data->CmdListsCount; n++)
         {
             const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            if (compact_layouts)
+            {
+                const ImGui_ImplVulkan_DrawListLayout& layout = bd->DrawListLayouts[n];
+                void* list_vtx_dst = (char*)(void*)vtx_dst + layout.VtxBufferOffset;
+                void* list_idx_dst = (char*)(void*)idx_dst + layout.IdxBufferOffset;
+                if (layout.CompactVtx)
+                    cmd_list->PackCompactVtx((ImDrawVertCompact*)list_vtx_dst, layout.Origin);
+                else
+                    memcpy(list_vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+                if (layout.Idx16)
+                    cmd_list->PackIdx16((ImU16*)list_idx_dst);
+                else
+                    memcpy(list_idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+                continue;
+            }
             memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
             memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
             vtx_dst += cmd_list->VtxBuffer.Size;
@@ -542,12 +738,14 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
-    // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    // (Because we merged all buffers into a single one, we maintain our own offset into them. Compact layouts bind each draw list at its own offset instead.)
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        if (compact_layouts && cmd_list->CmdBuffer.Size > 0)
+            ImGui_ImplVulkan_SetupDrawListState(draw_data, command_buffer, rb, bd->DrawListLayouts[n]);
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
@@ -556,7 +754,11 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
+                    if (compact_layouts)
+                        ImGui_ImplVulkan_SetupDrawListState(draw_data, command_buffer, rb, bd->DrawListLayouts[n]);
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -574,13 +776,6 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
-                // Apply scissor/clipping rectangle
-                VkRect2D scissor;
-                scissor.offset.x = (int32_t)(clip_min.x);
-                scissor.offset.y = (int32_t)(clip_min.y);
-                scissor.extent.width = (uint32_t)(clip_max.x - clip_min.x);
-                scissor.extent.height = (uint32_t)(clip_max.y - clip_min.y);
-                vkCmdSetScissor(command_buffer, 0, 1, &scissor);
                 // modify By Dicky
                 // Bind descriptorset with font or user texture
                 ImTextureVk texture = (ImTextureVk)(pcmd->TextureId);
@@ -596,14 +791,42 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                         VkDescriptorSet desc_set[1] = { texture->textureDescriptor };
                         vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, desc_set, 0, NULL);
                     }
-                    // Draw
-                    vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+                    // Damage rectangles don't overlap, drawing the command once per rectangle keeps the blending order
+                    for (int damage_n = 0; damage_n < (damage_rects ? damage_rects_count : 1); damage_n++)
+                    {
+                        ImVec2 draw_min = clip_min, draw_max = clip_max;
+                        if (damage_rects)
+                        {
+                            const ImVec2 damage_min((damage_rects[damage_n].x - clip_off.x) * clip_scale.x, (damage_rects[damage_n].y - clip_off.y) * clip_scale.y);
+                            const ImVec2 damage_max((damage_rects[damage_n].z - clip_off.x) * clip_scale.x, (damage_rects[damage_n].w - clip_off.y) * clip_scale.y);
+                            if (draw_min.x < damage_min.x) { draw_min.x = damage_min.x; }
+                            if (draw_min.y < damage_min.y) { draw_min.y = damage_min.y; }
+                            if (draw_max.x > damage_max.x) { draw_max.x = damage_max.x; }
+                            if (draw_max.y > damage_max.y) { draw_max.y = damage_max.y; }
+                            if (draw_max.x <= draw_min.x || draw_max.y <= draw_min.y)
+                                continue;
+                        }
+
+                        // Apply scissor/clipping rectangle
+                        VkRect2D scissor;
+                        scissor.offset.x = (int32_t)(draw_min.x);
+                        scissor.offset.y = (int32_t)(draw_min.y);
+                        scissor.extent.width = (uint32_t)(draw_max.x - draw_min.x);
+                        scissor.extent.height = (uint32_t)(draw_max.y - draw_min.y);
+                        vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+                        // Draw
+                        vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+                    }
                 }
                 // modify By Dicky
             }
         }
-        global_idx_offset += cmd_list->IdxBuffer.Size;
-        global_vtx_offset += cmd_list->VtxBuffer.Size;
+        if (!compact_layouts)
+        {
+            global_idx_offset += cmd_list->IdxBuffer.Size;
+            global_vtx_offset += cmd_list->VtxBuffer.Size;
+        }
     }
 
     // Note: at this point both vkCmdSetViewport() and vkCmdSetScissor() have been called.
@@ -617,6 +840,50 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 }
 
+void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline)
+{
+    ImGui_ImplVulkan_RenderDrawDataEx(draw_data, command_buffer, pipeline, NULL, 0);
+}
+
+void ImGui_ImplVulkan_RenderDrawDataDamage(ImDrawData* draw_data, VkCommandBuffer command_buffer, const ImVec4* damage_rects, int damage_rects_count, const VkClearValue* clear_value, VkPipeline pipeline)
+{
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0 || damage_rects_count <= 0)
+        return;
+
+    if (clear_value != NULL)
+    {
+        const ImVec2 clip_off = draw_data->DisplayPos;
+        const ImVec2 clip_scale = draw_data->FramebufferScale;
+        VkClearAttachment attachment = {};
+        attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        attachment.colorAttachment = 0;
+        attachment.clearValue = *clear_value;
+        for (int n = 0; n < damage_rects_count; n++)
+        {
+            // Clamp to the framebuffer as vkCmdClearAttachments() won't accept values that are off bounds
+            int x1 = (int)((damage_rects[n].x - clip_off.x) * clip_scale.x), y1 = (int)((damage_rects[n].y - clip_off.y) * clip_scale.y);
+            int x2 = (int)((damage_rects[n].z - clip_off.x) * clip_scale.x), y2 = (int)((damage_rects[n].w - clip_off.y) * clip_scale.y);
+            if (x1 < 0) { x1 = 0; }
+            if (y1 < 0) { y1 = 0; }
+            if (x2 > fb_width) { x2 = fb_width; }
+            if (y2 > fb_height) { y2 = fb_height; }
+            if (x2 <= x1 || y2 <= y1)
+                continue;
+            VkClearRect rect = {};
+            rect.rect.offset.x = x1;
+            rect.rect.offset.y = y1;
+            rect.rect.extent.width = (uint32_t)(x2 - x1);
+            rect.rect.extent.height = (uint32_t)(y2 - y1);
+            rect.baseArrayLayer = 0;
+            rect.layerCount = 1;
+            vkCmdClearAttachments(command_buffer, 1, &attachment, 1, &rect);
+        }
+    }
+    ImGui_ImplVulkan_RenderDrawDataEx(draw_data, command_buffer, pipeline, damage_rects, damage_rects_count);
+}
+
 bool ImGui_ImplVulkan_CreateFontsTexture(VkCommandBuffer command_buffer)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -860,7 +1127,7 @@ static void ImGui_ImplVulkan_CreatePipelineLayout(VkDevice device, const VkAlloc
     check_vk_result(err);
 }
 
-static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass)
+static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass, bool compact_vertices = false)
 {
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_CreateShaderModules(device, allocator);
@@ -892,6 +1159,15 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     attribute_desc[2].binding = binding_desc[0].binding;
     attribute_desc[2].format = VK_FORMAT_R8G8B8A8_UNORM;
     attribute_desc[2].offset = IM_OFFSETOF(ImDrawVert, col);
+    if (compact_vertices)
+    {
+        binding_desc[0].stride = sizeof(ImDrawVertCompact);
+        attribute_desc[0].format = VK_FORMAT_R16G16_SNORM;
+        attribute_desc[0].offset = IM_OFFSETOF(ImDrawVertCompact, pos);
+        attribute_desc[1].format = VK_FORMAT_R16G16_UNORM;
+        attribute_desc[1].offset = IM_OFFSETOF(ImDrawVertCompact, uv);
+        attribute_desc[2].offset = IM_OFFSETOF(ImDrawVertCompact, col);
+    }
 
     VkPipelineVertexInputStateCreateInfo vertex_info = {};
     vertex_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -1024,6 +1300,7 @@ bool ImGui_ImplVulkan_CreateDeviceObjects()
     }
 
     ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, bd->RenderPass, v->MSAASamples, &bd->Pipeline, bd->Subpass);
+    ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, bd->RenderPass, v->MSAASamples, &bd->PipelineCompact, bd->Subpass, true);
 
     return true;
 }
@@ -1060,6 +1337,7 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     if (bd->DescriptorSetLayout)  { vkDestroyDescriptorSetLayout(v->Device, bd->DescriptorSetLayout, v->Allocator); bd->DescriptorSetLayout = VK_NULL_HANDLE; }
     if (bd->PipelineLayout)       { vkDestroyPipelineLayout(v->Device, bd->PipelineLayout, v->Allocator); bd->PipelineLayout = VK_NULL_HANDLE; }
     if (bd->Pipeline)             { vkDestroyPipeline(v->Device, bd->Pipeline, v->Allocator); bd->Pipeline = VK_NULL_HANDLE; }
+    if (bd->PipelineCompact)      { vkDestroyPipeline(v->Device, bd->PipelineCompact, v->Allocator); bd->PipelineCompact = VK_NULL_HANDLE; }
 }
 
 bool    ImGui_ImplVulkan_LoadFunctions(PFN_vkVoidFunction(*loader_func)(const char* function_name, void* user_data), void* user_data)
@@ -1096,6 +1374,7 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info, VkRenderPass rend
     io.BackendRendererName = "imgui_impl_vulkan";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;  // We can create multi-viewports on the Renderer side (optional)
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasAnalyticShapes; // Our shaders evaluate the shape quads of io.ConfigAnalyticShapes.
 
     IM_ASSERT(info->Instance != VK_NULL_HANDLE);
     IM_ASSERT(info->PhysicalDevice != VK_NULL_HANDLE);
@@ -1440,11 +1719,11 @@ void ImGui_ImplVulkanH_CreateWindowSwapChain(VkPhysicalDevice physical_device, V
         VkAttachmentDescription attachment = {};
         attachment.format = wd->SurfaceFormat.format;
         attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-        attachment.loadOp = wd->ClearEnable ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.loadOp = wd->DamageEnable ? VK_ATTACHMENT_LOAD_OP_LOAD : wd->ClearEnable ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
         attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment.initialLayout = wd->DamageEnable ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VK_IMAGE_LAYOUT_UNDEFINED; // Images are moved to PRESENT_SRC by ImGui_ImplVulkanH_CreateOrResizeWindow() to be loaded
         attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
         VkAttachmentReference color_attachment = {};
         color_attachment.attachment = 0;
@@ -1459,7 +1738,7 @@ void ImGui_ImplVulkanH_CreateWindowSwapChain(VkPhysicalDevice physical_device, V
         dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         dependency.srcAccessMask = 0;
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | (wd->DamageEnable ? VK_ACCESS_COLOR_ATTACHMENT_READ_BIT : 0);
         VkRenderPassCreateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
         info.attachmentCount = 1;
@@ -1526,6 +1805,46 @@ void ImGui_ImplVulkanH_CreateOrResizeWindow(VkInstance instance, VkPhysicalDevic
     ImGui_ImplVulkanH_CreateWindowSwapChain(physical_device, device, wd, allocator, width, height, min_image_count);
     //ImGui_ImplVulkan_CreatePipeline(device, allocator, VK_NULL_HANDLE, wd->RenderPass, VK_SAMPLE_COUNT_1_BIT, &wd->Pipeline, g_VulkanInitInfo.Subpass);
     ImGui_ImplVulkanH_CreateWindowCommandBuffers(physical_device, device, wd, queue_family, allocator);
+
+    // The render pass loads the swapchain images when they are kept between frames, they need a defined layout before the first one
+    if (wd->DamageEnable)
+    {
+        VkResult err;
+        VkQueue queue;
+        vkGetDeviceQueue(device, queue_family, 0, &queue);
+        VkCommandBuffer command_buffer = wd->Frames[0].CommandBuffer;
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        err = vkBeginCommandBuffer(command_buffer, &begin_info);
+        check_vk_result(err);
+        for (uint32_t i = 0; i < wd->ImageCount; i++)
+        {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = wd->Frames[i].Backbuffer;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.layerCount = 1;
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
+        }
+        err = vkEndCommandBuffer(command_buffer);
+        check_vk_result(err);
+        VkSubmitInfo submit_info = {};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &command_buffer;
+        err = vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE);
+        check_vk_result(err);
+        err = vkQueueWaitIdle(queue);
+        check_vk_result(err);
+    }
 }
 
 void ImGui_ImplVulkanH_DestroyWindow(VkInstance instance, VkDevice device, ImGui_ImplVulkanH_Window* wd, const VkAllocationCallbacks* allocator)
@@ -1861,6 +2180,17 @@ static void createImage(ImGui_ImplVulkan_InitInfo* v, uint32_t width, uint32_t h
     vkBindImageMemory(v->Device, image, imageMemory, 0);
 }
 
+// storage lets compute shaders write the streaming images in place, see ImGui_ImplVulkan_AcquireTextureImage()
+static VkImageUsageFlags textureImageUsage(ImGui_ImplVulkan_InitInfo* v)
+{
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(v->PhysicalDevice, VK_FORMAT_R8G8B8A8_UNORM, &props);
+    if (props.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT)
+        usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    return usage;
+}
+
 static void createImageView(ImGui_ImplVulkan_InitInfo* v, VkImage image, VkImageView& imageView)
 {
     VkImageViewCreateInfo info = {};
@@ -2044,7 +2374,7 @@ ImTextureID ImGui_ImplVulkan_CreateTexture(const void * pixels, int width, int h
 
     createImage(v, width,height,VK_FORMAT_R8G8B8A8_UNORM,
                 VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                textureImageUsage(v),
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 texture->textureImage, texture->textureImageMemory);
 
@@ -2093,7 +2423,7 @@ ImTextureID ImGui_ImplVulkan_CreateTexture(VkBuffer buffer, size_t buffer_offset
 
     createImage(v, width,height,VK_FORMAT_R8G8B8A8_UNORM,
                 VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                textureImageUsage(v),
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 texture->textureImage, texture->textureImageMemory);
 
@@ -2122,6 +2452,129 @@ ImTextureID ImGui_ImplVulkan_CreateTexture(VkBuffer buffer, size_t buffer_offset
     return (ImTextureID)texture;
 }
 
+static void createStreamingResources(ImGui_ImplVulkan_InitInfo* v, ImTextureVk texture)
+{
+    createImage(v, texture->textureWidth, texture->textureHeight, VK_FORMAT_R8G8B8A8_UNORM,
+                VK_IMAGE_TILING_OPTIMAL,
+                textureImageUsage(v),
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                texture->backImage, texture->backImageMemory);
+    createImageView(v, texture->backImage, texture->backView);
+    texture->backDescriptor = ImGui_ImplVulkan_AddTexture(texture->textureSampler, texture->backView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = v->QueueFamily;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (vkCreateCommandPool(v->Device, &poolInfo, nullptr, &texture->commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create graphics command pool!");
+    }
+
+    VkCommandBuffer commandBuffers[2];
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = texture->commandPool;
+    allocInfo.commandBufferCount = 2;
+    if (vkAllocateCommandBuffers(v->Device, &allocInfo, commandBuffers) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate texture command buffers!");
+    }
+    texture->textureCommand = commandBuffers[0];
+    texture->backCommand = commandBuffers[1];
+
+    // created signaled, the first update of each image doesn't wait
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    if (vkCreateFence(v->Device, &fenceInfo, v->Allocator, &texture->textureFence) != VK_SUCCESS ||
+        vkCreateFence(v->Device, &fenceInfo, v->Allocator, &texture->backFence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture fence!");
+    }
+
+    // zero-copy updates: acquire -> compute store -> present, see AcquireTextureImage
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    if (vkCreateSemaphore(v->Device, &semaphoreInfo, v->Allocator, &texture->acquireSemaphore) != VK_SUCCESS ||
+        vkCreateSemaphore(v->Device, &semaphoreInfo, v->Allocator, &texture->writtenSemaphore) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture semaphore!");
+    }
+}
+
+static void destroyStreamingResources(ImGui_ImplVulkan_InitInfo* v, ImTextureVk texture)
+{
+    VkFence fences[2] = { texture->textureFence, texture->backFence };
+    if (texture->textureFence && texture->backFence) vkWaitForFences(v->Device, 2, fences, VK_TRUE, UINT64_MAX);
+    if (texture->textureFence) { vkDestroyFence(v->Device, texture->textureFence, v->Allocator); texture->textureFence = VK_NULL_HANDLE; }
+    if (texture->backFence) { vkDestroyFence(v->Device, texture->backFence, v->Allocator); texture->backFence = VK_NULL_HANDLE; }
+    if (texture->acquireSemaphore) { vkDestroySemaphore(v->Device, texture->acquireSemaphore, v->Allocator); texture->acquireSemaphore = VK_NULL_HANDLE; }
+    if (texture->writtenSemaphore) { vkDestroySemaphore(v->Device, texture->writtenSemaphore, v->Allocator); texture->writtenSemaphore = VK_NULL_HANDLE; }
+    if (texture->commandPool) { vkDestroyCommandPool(v->Device, texture->commandPool, nullptr); texture->commandPool = VK_NULL_HANDLE; }
+    texture->textureCommand = texture->backCommand = VK_NULL_HANDLE;
+    if (texture->backDescriptor) { vkFreeDescriptorSets(v->Device, v->DescriptorPool, 1, &texture->backDescriptor); texture->backDescriptor = VK_NULL_HANDLE; }
+    if (texture->backView) { vkDestroyImageView(v->Device, texture->backView, v->Allocator); texture->backView = VK_NULL_HANDLE; }
+    if (texture->backImage) { vkDestroyImage(v->Device, texture->backImage, v->Allocator); texture->backImage = VK_NULL_HANDLE; }
+    if (texture->backImageMemory) { vkFreeMemory(v->Device, texture->backImageMemory, v->Allocator); texture->backImageMemory = VK_NULL_HANDLE; }
+}
+
+// Records one layout transition of the back image into its command buffer, the caller submits it
+static VkCommandBuffer beginBackImageCommand(ImGui_ImplVulkan_InitInfo* v, ImTextureVk texture, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
+                                             uint32_t srcQueueFamily = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueueFamily = VK_QUEUE_FAMILY_IGNORED)
+{
+    // back image was filled two updates ago, its copy is normally long done
+    vkWaitForFences(v->Device, 1, &texture->backFence, VK_TRUE, UINT64_MAX);
+    vkResetFences(v->Device, 1, &texture->backFence);
+    VkCommandBuffer commandBuffer = texture->backCommand;
+    vkResetCommandBuffer(commandBuffer, 0);
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = srcQueueFamily;
+    barrier.dstQueueFamilyIndex = dstQueueFamily;
+    barrier.image = texture->backImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    return commandBuffer;
+}
+
+static void submitBackImageCommand(ImGui_ImplVulkan_InitInfo* v, ImTextureVk texture, VkCommandBuffer commandBuffer, VkSemaphore waitSemaphore = VK_NULL_HANDLE, VkPipelineStageFlags waitStage = 0)
+{
+    vkEndCommandBuffer(commandBuffer);
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = waitSemaphore ? 1 : 0;
+    submitInfo.pWaitSemaphores = &waitSemaphore;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    if (vkQueueSubmit(v->Queue, 1, &submitInfo, texture->backFence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit texture update!");
+    }
+}
+
+static void swapBackImage(ImTextureVk texture)
+{
+    std::swap(texture->textureImage, texture->backImage);
+    std::swap(texture->textureImageMemory, texture->backImageMemory);
+    std::swap(texture->textureView, texture->backView);
+    std::swap(texture->textureDescriptor, texture->backDescriptor);
+    std::swap(texture->textureCommand, texture->backCommand);
+    std::swap(texture->textureFence, texture->backFence);
+}
+
+// GPU buffer update never idles the queue: the copy goes to the back image of the texture and
+// is submitted on the render queue with its own fence, then back and front swap. Being on the
+// same queue the barriers order it after the frames still sampling that image and before the
+// next frame drawing it, so the caller only has to keep the buffer alive until the next update.
 void ImGui_ImplVulkan_UpdateTexture(ImTextureID textureid, VkBuffer stagingBuffer, size_t buffer_offset)
 {
     ImTextureVk texture = (ImTextureVk)textureid;
@@ -2130,30 +2583,116 @@ void ImGui_ImplVulkan_UpdateTexture(ImTextureID textureid, VkBuffer stagingBuffe
     if (!bd) return;
     ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo;
     if (!v || !v->PhysicalDevice) return;
-    VkDeviceSize imageSize = texture->textureWidth * texture->textureHeight * texture->textureChannels;
-    
-    // create staging buffer
-    VkCommandPool commandPool = VK_NULL_HANDLE;
 
-    VkCommandPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    poolInfo.queueFamilyIndex = v->QueueFamily;
-    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    if (!texture->backImage)
+        createStreamingResources(v, texture);
 
-    if (vkCreateCommandPool(v->Device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create graphics command pool!");
-    }
+    // whole image is rewritten, old content is discarded
+    VkCommandBuffer commandBuffer = beginBackImageCommand(v, texture, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                          0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-    //transitionImageLayout(v, commandPool, texture->textureImage, 
-    //                    VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, 
-    //                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    copyBufferToImage(v, commandPool, stagingBuffer, buffer_offset, texture->textureImage, 
-                    static_cast<uint32_t>(texture->textureWidth), static_cast<uint32_t>(texture->textureHeight));
-    //transitionImageLayout(v, commandPool, texture->textureImage, 
-    //                    VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 
-    //                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    VkBufferImageCopy region{};
+    region.bufferOffset = buffer_offset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { static_cast<uint32_t>(texture->textureWidth), static_cast<uint32_t>(texture->textureHeight), 1 };
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, texture->backImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-    vkDestroyCommandPool(v->Device, commandPool, nullptr);
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture->backImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    submitBackImageCommand(v, texture, commandBuffer);
+    swapBackImage(texture);
+}
+
+// Compute shaders may run on another queue, so unlike the buffer update acquire can't rely on
+// queue order and nothing waits on the host either. Acquire submits an empty batch on the render
+// queue that signals the acquire semaphore once every frame submitted before, which may still
+// sample the back image, is done. The writer waits it, stores into the image from UNDEFINED and
+// signals the written semaphore, present waits that before the back image turns shader readable
+// and swaps to front. The image is exclusive to the render queue family: a writer on another
+// family releases it with the GENERAL to SHADER_READ_ONLY_OPTIMAL transition and present records
+// the matching acquire, UNDEFINED contents need no transfer on the way out.
+bool ImGui_ImplVulkan_AcquireTextureImage(ImTextureID textureid, VkImage* image, VkImageView* view, VkSemaphore* acquired, VkSemaphore* written, uint32_t* queue_family)
+{
+    ImTextureVk texture = (ImTextureVk)textureid;
+    if (!texture || texture->extra_image) return false;
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (!bd) return false;
+    ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo;
+    if (!v || !v->PhysicalDevice) return false;
+    if (!(textureImageUsage(v) & VK_IMAGE_USAGE_STORAGE_BIT)) return false;
+
+    if (!texture->backImage)
+        createStreamingResources(v, texture);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &texture->acquireSemaphore;
+    if (vkQueueSubmit(v->Queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+        return false;
+    if (image) *image = texture->backImage;
+    if (view) *view = texture->backView;
+    if (acquired) *acquired = texture->acquireSemaphore;
+    if (written) *written = texture->writtenSemaphore;
+    if (queue_family) *queue_family = v->QueueFamily;
+    return true;
+}
+
+void ImGui_ImplVulkan_PresentTextureImage(ImTextureID textureid, uint32_t queue_family)
+{
+    ImTextureVk texture = (ImTextureVk)textureid;
+    if (!texture || !texture->backImage) return;
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (!bd) return;
+    ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo;
+    if (!v || !v->PhysicalDevice) return;
+
+    // the written semaphore makes the stores visible, the barrier only has to chain after its wait
+    const bool transfer = queue_family != VK_QUEUE_FAMILY_IGNORED && queue_family != v->QueueFamily;
+    VkCommandBuffer commandBuffer = beginBackImageCommand(v, texture, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                          0, VK_ACCESS_SHADER_READ_BIT,
+                                                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                                          transfer ? queue_family : VK_QUEUE_FAMILY_IGNORED,
+                                                          transfer ? v->QueueFamily : VK_QUEUE_FAMILY_IGNORED);
+    submitBackImageCommand(v, texture, commandBuffer, texture->writtenSemaphore, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    swapBackImage(texture);
+}
+
+void ImGui_ImplVulkan_CancelTextureImage(ImTextureID textureid)
+{
+    ImTextureVk texture = (ImTextureVk)textureid;
+    if (!texture || !texture->backImage) return;
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    if (!bd) return;
+    ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo;
+    if (!v || !v->PhysicalDevice) return;
+
+    // nothing was written: consume the acquire signal and keep the front image, the fence
+    // lets destroyStreamingResources know the wait is done
+    vkWaitForFences(v->Device, 1, &texture->backFence, VK_TRUE, UINT64_MAX);
+    vkResetFences(v->Device, 1, &texture->backFence);
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &texture->acquireSemaphore;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    if (vkQueueSubmit(v->Queue, 1, &submitInfo, texture->backFence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit texture update!");
+    }
 }
 
 void ImGui_ImplVulkan_UpdateTexture(ImTextureID textureid, const void * pixels)
@@ -2214,6 +2753,8 @@ void ImGui_ImplVulkan_SaveTexture(ImTextureVk texture, std::string path)
     ImGui_ImplVulkan_InitInfo* v = bd->VulkanInitInfo;
     if (!v || !v->PhysicalDevice) return;
 
+    if (texture->textureFence)
+        vkWaitForFences(v->Device, 1, &texture->textureFence, VK_TRUE, UINT64_MAX);
     VkDeviceSize imageSize = texture->textureWidth * texture->textureHeight * texture->textureChannels;
     VkBuffer stagingBuffer;
     VkDeviceMemory stagingBufferMemory;
@@ -2282,6 +2823,7 @@ void ImGui_ImplVulkan_DestroyTexture(ImTextureVk* texture)
         ImTextureVk textureVK = *texture;
         if (!textureVK->extra_image)
         {
+            destroyStreamingResources(v, textureVK);
             if (textureVK->textureDescriptor) { vkFreeDescriptorSets(v->Device, v->DescriptorPool, 1, &textureVK->textureDescriptor); textureVK->textureDescriptor = VK_NULL_HANDLE; }
             if (textureVK->textureSampler) { vkDestroySampler(v->Device, textureVK->textureSampler, v->Allocator); textureVK->textureSampler = VK_NULL_HANDLE; }
             if (textureVK->textureImageMemory) { vkFreeMemory(v->Device, textureVK->textureImageMemory, v->Allocator); textureVK->textureImageMemory = VK_NULL_HANDLE; }
@@ -74,6 +74,8 @@ IMGUI_IMPL_API bool         ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* inf
 IMGUI_IMPL_API void         ImGui_ImplVulkan_Shutdown();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_NewFrame();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline = VK_NULL_HANDLE);
+// Draw only inside damage_rects (non overlapping, same space as ImDrawCmd::ClipRect), clearing them first with clear_value when not NULL. The render pass must load the previous content.
+IMGUI_IMPL_API void         ImGui_ImplVulkan_RenderDrawDataDamage(ImDrawData* draw_data, VkCommandBuffer command_buffer, const ImVec4* damage_rects, int damage_rects_count, const VkClearValue* clear_value, VkPipeline pipeline = VK_NULL_HANDLE);
 IMGUI_IMPL_API bool         ImGui_ImplVulkan_CreateFontsTexture(VkCommandBuffer command_buffer);
 IMGUI_IMPL_API void         ImGui_ImplVulkan_DestroyFontUploadObjects();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count); // To override MinImageCount after initialization (e.g. if swap chain is recreated)
@@ -144,6 +146,7 @@ struct ImGui_ImplVulkanH_Window
     VkRenderPass        RenderPass;
     VkPipeline          Pipeline;               // The window pipeline may uses a different VkRenderPass than the one passed in ImGui_ImplVulkan_InitInfo
     bool                ClearEnable;
+    bool                DamageEnable;           // Keep the swapchain images content between frames (render pass loads them) so only damaged areas need redrawing. Set before creating the window.
     VkClearValue        ClearValue;
     uint32_t            FrameIndex;             // Current frame being rendered to (0 <= FrameIndex < FrameInFlightCount)
     uint32_t            ImageCount;             // Number of simultaneous in-flight frames (returned by vkGetSwapchainImagesKHR, usually derived from min_image_count)
@@ -172,6 +175,20 @@ typedef struct ImTextureVK
     int textureChannels = 0;
     bool extra_image = false;
     bool mark_to_release = false;
+    // double buffered streaming, created by the first update from a GPU buffer or the first acquire.
+    // the update fills the back image and swaps it to front, the fence guards reuse of its command buffer.
+    // with storage support the back image can also be written in place by compute shaders, see AcquireTextureImage.
+    VkImage backImage = VK_NULL_HANDLE;
+    VkDeviceMemory backImageMemory = VK_NULL_HANDLE;
+    VkImageView backView = VK_NULL_HANDLE;
+    VkDescriptorSet backDescriptor = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkCommandBuffer textureCommand = VK_NULL_HANDLE;
+    VkCommandBuffer backCommand = VK_NULL_HANDLE;
+    VkFence textureFence = VK_NULL_HANDLE;
+    VkFence backFence = VK_NULL_HANDLE;
+    VkSemaphore acquireSemaphore = VK_NULL_HANDLE;
+    VkSemaphore writtenSemaphore = VK_NULL_HANDLE;
     std::string name;
     ImTextureVK(std::string _name)
     {
@@ -193,6 +210,13 @@ IMGUI_IMPL_API ImTextureID  ImGui_ImplVulkan_CreateTexture(const void * pixels,
 IMGUI_IMPL_API ImTextureID  ImGui_ImplVulkan_CreateTexture(VkBuffer buffer, size_t buffer_offset, int width, int height);
 IMGUI_IMPL_API void         ImGui_ImplVulkan_UpdateTexture(ImTextureID textureid, const void * pixels);
 IMGUI_IMPL_API void         ImGui_ImplVulkan_UpdateTexture(ImTextureID textureid, VkBuffer stagingBuffer, size_t buffer_offset);
+// zero-copy update: acquire hands out the back image as a storage image in VK_IMAGE_LAYOUT_UNDEFINED (false when
+// the device can't store to R8G8B8A8 images) with the render queue family. the writer waits `acquired`, transitions to
+// VK_IMAGE_LAYOUT_GENERAL, writes in place and signals `written`, present waits it and swaps the image to front.
+// a writer on another queue family passes it to present after releasing the image, cancel when nothing was submitted.
+IMGUI_IMPL_API bool         ImGui_ImplVulkan_AcquireTextureImage(ImTextureID textureid, VkImage* image, VkImageView* view, VkSemaphore* acquired, VkSemaphore* written, uint32_t* queue_family);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_PresentTextureImage(ImTextureID textureid, uint32_t queue_family);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_CancelTextureImage(ImTextureID textureid);
 IMGUI_IMPL_API void         ImGui_ImplVulkan_SaveTexture(ImTextureVk texture, std::string path); // Add By Dicky
 IMGUI_IMPL_API void         ImGui_ImplVulkan_DestroyTexture(ImTextureVk * texture);
 IMGUI_IMPL_API ImGui_ImplVulkan_InitInfo* ImGui_ImplVulkan_GetInitInfo();
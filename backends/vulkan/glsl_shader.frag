@@ -8,7 +8,19 @@ layout(location = 0) in struct {
     vec2 UV;
 } In;
 
+layout(location = 2) in vec2 ShapePos;
+layout(location = 3) flat in vec4 Shape;
+layout(location = 4) flat in uint ShapeCorners;
+
 void main()
 {
-    fColor = In.Color * texture(sTexture, In.UV.st);
+    vec4 textured = In.Color * texture(sTexture, In.UV.st);
+    // Shape quads: coverage of the rounded box over one pixel, like the tessellated anti-aliased fringes
+    uint quadrant = (ShapePos.x > 0.0 ? 1u : 0u) + (ShapePos.y > 0.0 ? 2u : 0u);
+    float r = ((ShapeCorners >> quadrant) & 1u) != 0u ? Shape.z : 0.0;
+    vec2 q = abs(ShapePos) - Shape.xy + vec2(r);
+    float d = length(max(q, vec2(0.0))) + min(max(q.x, q.y), 0.0) - r;
+    d = Shape.w > 0.0 ? abs(d) - Shape.w * 0.5 : d;
+    vec4 shaped = vec4(In.Color.rgb, In.Color.a * clamp(0.5 - d, 0.0, 1.0));
+    fColor = Shape.x >= 0.0 ? shaped : textured;
 }
@@ -17,9 +17,23 @@ layout(location = 0) out struct {
     vec2 UV;
 } Out;
 
+// Analytic shapes (io.ConfigAnalyticShapes): shape vertices carry the half size, radius, thickness and corners in their uv
+// (see IM_DRAWVERT_SHAPE_MARKER in imgui.h), Shape.x < 0 for textured vertices.
+layout(location = 2) out vec2 ShapePos;
+layout(location = 3) flat out vec4 Shape;
+layout(location = 4) flat out uint ShapeCorners;
+
 void main()
 {
     Out.Color = aColor;
     Out.UV = aUV;
+    uint code_x = uint(clamp(-aUV.x - 8388608.0, 0.0, 16777215.0));
+    uint code_y = uint(clamp(aUV.y, 0.0, 16777215.0));
+    vec4 shape = vec4(float(code_x & 8191u), float(code_y & 8191u), float((code_y >> 13) & 511u), float((code_x >> 13) & 31u)) * 0.25;
+    vec2 extent = shape.xy + vec2(shape.w * 0.5 + 1.0);
+    uint corner = code_y >> 22;
+    ShapePos = vec2((corner & 1u) != 0u ? extent.x : -extent.x, (corner & 2u) != 0u ? extent.y : -extent.y);
+    Shape = aUV.x <= -8388608.0 ? shape : vec4(-1.0);
+    ShapeCorners = (code_x >> 18) & 15u;
     gl_Position = vec4(aPos * pc.uScale + pc.uTranslate, 0, 1);
 }
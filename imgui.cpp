@@ -1221,6 +1221,10 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDamageTracking = false;
+    ConfigDrawCallBatching = false;
+    ConfigCompactVertices = false;
+    ConfigAnalyticShapes = false;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -3397,6 +3401,8 @@ ImGuiWindow::~ImGuiWindow()
     IM_ASSERT(DrawList == &DrawListInst);
     IM_DELETE(Name);
     ColumnsStorage.clear_destruct();
+    if (ContentCache)
+        IM_DELETE(ContentCache);
     // add By Dicky for stack layout
     DC.Layouts.Data.clear_destruct();
     // add By Dicky for stack layout end
@@ -3472,6 +3478,11 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
+    if (window->ContentCache)
+    {
+        IM_DELETE(window->ContentCache);
+        window->ContentCache = NULL;
+    }
 }
 
 void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
@@ -3761,10 +3772,23 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 }
 
 // IM_ALLOC() == ImGui::MemAlloc()
+// Detached draw lists grow their buffers from worker threads, keep the allocation counter consistent
+#if defined(_MSC_VER)
+#include <intrin.h>     // _InterlockedExchangeAdd
+#endif
+static inline void MemAllocCounterAdd(int* counter, int value)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangeAdd((volatile long*)counter, value);
+#else
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
 void* ImGui::MemAlloc(size_t size)
 {
     if (ImGuiContext* ctx = GImGui)
-        ctx->IO.MetricsActiveAllocations++;
+        MemAllocCounterAdd(&ctx->IO.MetricsActiveAllocations, +1);
     return (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 }
 
@@ -3773,7 +3797,7 @@ void ImGui::MemFree(void* ptr)
 {
     if (ptr)
         if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
+            MemAllocCounterAdd(&ctx->IO.MetricsActiveAllocations, -1);
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
@@ -3959,6 +3983,35 @@ ImDrawListSharedData* ImGui::GetDrawListSharedData()
     return &GImGui->DrawListSharedData;
 }
 
+// A detached draw list owns its shared data, so worker threads never read the context copy which changes with every window and font
+ImDrawList* ImGui::CreateDetachedDrawList()
+{
+    ImDrawListSharedData* shared_data = IM_NEW(ImDrawListSharedData)();
+    ImDrawList* draw_list = IM_NEW(ImDrawList)(shared_data);
+    ResetDetachedDrawList(draw_list);
+    return draw_list;
+}
+
+void ImGui::ResetDetachedDrawList(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawListSharedData* shared_data = (ImDrawListSharedData*)draw_list->_Data;
+    IM_ASSERT(shared_data != &g.DrawListSharedData && "Not a detached draw list!");
+    *shared_data = g.DrawListSharedData;
+    shared_data->ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, +8192.0f, +8192.0f);
+    draw_list->_ResetForNewFrame();
+    draw_list->PushTextureID(g.IO.Fonts->TexID);
+    draw_list->PushClipRectFullScreen();
+}
+
+void ImGui::DestroyDetachedDrawList(ImDrawList* draw_list)
+{
+    ImDrawListSharedData* shared_data = (ImDrawListSharedData*)draw_list->_Data;
+    IM_ASSERT(shared_data != &GImGui->DrawListSharedData && "Not a detached draw list!");
+    IM_DELETE(draw_list);
+    IM_DELETE(shared_data);
+}
+
 void ImGui::StartMouseMovingWindow(ImGuiWindow* window)
 {
     // Set ActiveId even if the _NoMove flag is set. Without it, dragging away from a window with _NoMove would activate hover on other windows.
@@ -4529,6 +4582,7 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+    g.CachedContentReused = g.CachedContentSubmitted = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
     // Add By Dicky for Power Save
     g.MaxWaitBeforeNextFrame = INFINITY;
@@ -4564,6 +4618,8 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.ConfigAnalyticShapes && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasAnalyticShapes))
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AnalyticShapes;
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     for (int n = 0; n < g.Viewports.Size; n++)
@@ -4993,6 +5049,430 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
     }
 }
 
+// Content hash for damage tracking. ImHashData() goes one byte at a time, which is too slow for whole vertex buffers every frame.
+static ImU64 DamageHashData(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const ImU64 k = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU64 h[4] = { seed, seed ^ k, seed + k, ~seed };
+    for (; data_size >= 32; data += 32, data_size -= 32)
+        for (int n = 0; n < 4; n++)
+        {
+            ImU64 v;
+            memcpy(&v, data + n * 8, 8);
+            h[n] = (h[n] ^ v) * k;
+            h[n] ^= h[n] >> 29;
+        }
+    for (int n = 0; data_size > 0; n++)
+    {
+        ImU64 v = 0;
+        const size_t len = ImMin(data_size, (size_t)8);
+        memcpy(&v, data, len);
+        h[n] = (h[n] ^ v) * k;
+        h[n] ^= h[n] >> 29;
+        data += len;
+        data_size -= len;
+    }
+    ImU64 r = h[0] ^ (h[1] * 3) ^ (h[2] * 5) ^ (h[3] * 7);
+    r ^= r >> 31;
+    return r;
+}
+
+// Area a draw list may touch: its vertices bounding box, clipped by the union of its command clip rects.
+static ImRect CalcDrawListDamageBounds(const ImDrawList* draw_list)
+{
+    ImRect clip(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawCmd* cmd = draw_list->CmdBuffer.begin(); cmd != draw_list->CmdBuffer.end(); cmd++)
+        clip.Add(ImRect(cmd->ClipRect));
+    ImRect bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawVert* vtx = draw_list->VtxBuffer.begin(); vtx != draw_list->VtxBuffer.end(); vtx++)
+        bb.Add(vtx->pos);
+    bb.ClipWithFull(clip);
+    return bb;
+}
+
+static void AddViewportDamage(ImGuiViewportP* viewport, const ImRect& r)
+{
+    if (r.Min.x < r.Max.x && r.Min.y < r.Max.y)
+        viewport->DamageRects.push_back(ImVec4(r.Min.x, r.Min.y, r.Max.x, r.Max.y));
+}
+
+// Diff the draw lists of this Render() against the previous one to fill ImDrawData::DamageRects (io.ConfigDamageTracking).
+// - A draw list is identified by its pointer: a changed hash damages both its previous and its current bounds.
+// - A draw list moving below one it used to be drawn after damages the same way, as its overlaps are now composited in another order.
+// - Draw lists which are gone damage their previous bounds. Commands with user callbacks are always damaged.
+static void UpdateViewportDamage(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    draw_data->DamageValid = false;
+    draw_data->DamageRectsCount = 0;
+    draw_data->DamageRects = NULL;
+    viewport->DamageRects.resize(0);
+    if (!g.IO.ConfigDamageTracking || draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+    {
+        viewport->DamageDrawLists.resize(0);
+        viewport->DamageLastDisplayRect = ImVec4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX);
+        return;
+    }
+
+    ImVector<ImGuiDrawListDamage>& prev = viewport->DamageDrawLists;
+    ImVector<ImGuiDrawListDamage>& curr = viewport->DamageDrawListsNext;
+    curr.resize(draw_data->CmdListsCount);
+    int last_prev_n = -1;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        ImGuiDrawListDamage& entry = curr[n];
+        entry.DrawList = draw_list;
+        entry.Hash = DamageHashData(draw_list->CmdBuffer.Data, (size_t)draw_list->CmdBuffer.Size * sizeof(ImDrawCmd), 0);
+        entry.Hash = DamageHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx), entry.Hash);
+        entry.Hash = DamageHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert), entry.Hash);
+
+        // Draw lists generally keep their index, otherwise search them
+        int prev_n = (n < prev.Size && prev[n].DrawList == draw_list) ? n : -1;
+        for (int i = 0; prev_n == -1 && i < prev.Size; i++)
+            if (prev[i].DrawList == draw_list)
+                prev_n = i;
+        if (prev_n != -1 && prev_n > last_prev_n && prev[prev_n].Hash == entry.Hash)
+        {
+            entry.Bounds = prev[prev_n].Bounds;
+        }
+        else
+        {
+            entry.Bounds = CalcDrawListDamageBounds(draw_list);
+            AddViewportDamage(viewport, entry.Bounds);
+            if (prev_n != -1)
+                AddViewportDamage(viewport, prev[prev_n].Bounds);
+        }
+        if (prev_n != -1)
+        {
+            prev[prev_n].DrawList = NULL;
+            last_prev_n = ImMax(last_prev_n, prev_n);
+        }
+
+        // Content we can't see changing
+        for (const ImDrawCmd* cmd = draw_list->CmdBuffer.begin(); cmd != draw_list->CmdBuffer.end(); cmd++)
+        {
+            if (cmd->UserCallback != NULL && cmd->UserCallback != ImDrawCallback_ResetRenderState)
+                AddViewportDamage(viewport, ImRect(cmd->ClipRect));
+            else if (cmd->UserCallback == NULL && g.DamageTextures.Size > 0 && g.DamageTextures.contains(cmd->TextureId))
+            {
+                ImRect r(cmd->ClipRect);
+                r.ClipWithFull(entry.Bounds);
+                AddViewportDamage(viewport, r);
+            }
+        }
+    }
+    for (int i = 0; i < prev.Size; i++)
+        if (prev[i].DrawList != NULL)
+            AddViewportDamage(viewport, prev[i].Bounds);
+    prev.swap(curr);
+    for (int i = 0; i < g.DamageRects.Size; i++)
+        AddViewportDamage(viewport, g.DamageRects[i]);
+
+    // Any change of the target redraws everything
+    const ImVec4 display_rect(draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplaySize.x, draw_data->DisplaySize.y);
+    const bool target_changed = (viewport->DamageLastDisplayRect != display_rect || viewport->DamageLastFramebufferScale.x != draw_data->FramebufferScale.x || viewport->DamageLastFramebufferScale.y != draw_data->FramebufferScale.y);
+    viewport->DamageLastDisplayRect = display_rect;
+    viewport->DamageLastFramebufferScale = draw_data->FramebufferScale;
+    if (target_changed)
+        return;
+
+    // Snap to framebuffer pixels and clip to the viewport
+    ImVector<ImVec4>& rects = viewport->DamageRects;
+    const ImVec2 scale(ImMax(draw_data->FramebufferScale.x, 1.0f), ImMax(draw_data->FramebufferScale.y, 1.0f));
+    const ImRect viewport_rect(draw_data->DisplayPos, draw_data->DisplayPos + draw_data->DisplaySize);
+    ImRect bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i = 0; i < rects.Size; i++)
+    {
+        ImRect r(rects[i]);
+        r.Min = draw_data->DisplayPos + ImFloorSigned((r.Min - draw_data->DisplayPos) * scale) / scale;
+        r.Max = draw_data->DisplayPos + ImVec2(ImCeil((r.Max.x - draw_data->DisplayPos.x) * scale.x), ImCeil((r.Max.y - draw_data->DisplayPos.y) * scale.y)) / scale;
+        r.ClipWithFull(viewport_rect);
+        rects[i] = ImVec4(r.Min.x, r.Min.y, r.Max.x, r.Max.y);
+        bb.Add(r);
+    }
+
+    // Merge overlapping rectangles so renderers never draw a pixel twice. Each rectangle costs renderers a pass over the commands,
+    // so past a few of them we only keep their bounding box.
+    const int max_rects = 8;
+    if (rects.Size > max_rects * 4)
+    {
+        rects.resize(1);
+        rects[0] = ImVec4(bb.Min.x, bb.Min.y, bb.Max.x, bb.Max.y);
+    }
+    for (int i = 0; i < rects.Size; i++)
+    {
+        if (rects[i].x >= rects[i].z || rects[i].y >= rects[i].w)
+        {
+            rects.erase(rects.Data + i--);
+            continue;
+        }
+        for (int j = 0; j < i; j++)
+            if (rects[i].x < rects[j].z && rects[j].x < rects[i].z && rects[i].y < rects[j].w && rects[j].y < rects[i].w)
+            {
+                // Merged rectangle may now overlap others: re-examine it as the last one
+                ImVec4 r(ImMin(rects[i].x, rects[j].x), ImMin(rects[i].y, rects[j].y), ImMax(rects[i].z, rects[j].z), ImMax(rects[i].w, rects[j].w));
+                rects.erase(rects.Data + i);
+                rects.erase(rects.Data + j);
+                rects.push_back(r);
+                i = -1;
+                break;
+            }
+    }
+    if (rects.Size > max_rects)
+    {
+        rects.resize(1);
+        rects[0] = ImVec4(bb.Min.x, bb.Min.y, bb.Max.x, bb.Max.y);
+    }
+    draw_data->DamageValid = true;
+    draw_data->DamageRectsCount = rects.Size;
+    draw_data->DamageRects = rects.Data;
+}
+
+void ImGui::AddDamageRect(const ImVec2& p_min, const ImVec2& p_max)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.IO.ConfigDamageTracking)
+        g.DamageRects.push_back(ImRect(p_min, p_max));
+}
+
+void ImGui::AddDamageTexture(ImTextureID user_texture_id)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.IO.ConfigDamageTracking && !g.DamageTextures.contains(user_texture_id))
+        g.DamageTextures.push_back(user_texture_id);
+}
+
+// Scissor rectangle renderer backends derive from a clip rect, in framebuffer pixels
+static ImRect CalcBatchScissor(const ImVec4& clip_rect, const ImVec2& display_pos, const ImVec2& fb_scale)
+{
+    ImVec2 clip_min(ImMax((clip_rect.x - display_pos.x) * fb_scale.x, 0.0f), ImMax((clip_rect.y - display_pos.y) * fb_scale.y, 0.0f));
+    ImVec2 clip_max((clip_rect.z - display_pos.x) * fb_scale.x, (clip_rect.w - display_pos.y) * fb_scale.y);
+    if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+        return ImRect(0.0f, 0.0f, 0.0f, 0.0f);
+    ImVec2 scissor_min((float)(int)clip_min.x, (float)(int)clip_min.y);
+    return ImRect(scissor_min, scissor_min + ImVec2((float)(int)(clip_max.x - clip_min.x), (float)(int)(clip_max.y - clip_min.y)));
+}
+
+// Clip a command made of axis aligned quads as written by PrimRectUV() (rects, text) to 'scissor', interpolating their uv.
+// Quads falling outside are collapsed into an empty one. Returns false and leaves the vertices untouched for any other geometry.
+static bool ClipBatchQuads(ImDrawVert* vtx, const ImDrawIdx* idx, int idx_count, unsigned int vtx_min, const ImRect& scissor, const ImVec2& display_pos, const ImVec2& fb_scale)
+{
+    if (idx_count % 6 != 0)
+        return false;
+    for (int n = 0; n < idx_count; n += 6)
+    {
+        const unsigned int i0 = idx[n];
+        if (idx[n + 1] != i0 + 1 || idx[n + 2] != i0 + 2 || idx[n + 3] != i0 || idx[n + 4] != i0 + 2 || idx[n + 5] != i0 + 3)
+            return false;
+        const ImDrawVert* v = vtx + (i0 - vtx_min);
+        if (v[0].pos.y != v[1].pos.y || v[1].pos.x != v[2].pos.x || v[2].pos.y != v[3].pos.y || v[3].pos.x != v[0].pos.x || v[0].pos.x > v[1].pos.x || v[0].pos.y > v[3].pos.y)
+            return false;
+        if (v[0].uv.y != v[1].uv.y || v[1].uv.x != v[2].uv.x || v[2].uv.y != v[3].uv.y || v[3].uv.x != v[0].uv.x || v[0].uv.x <= -IM_DRAWVERT_SHAPE_MARKER)
+            return false;
+        if (v[0].col != v[1].col || v[0].col != v[2].col || v[0].col != v[3].col)
+            return false;
+    }
+
+    // Pulled in a fraction of pixel so the clipped geometry still tests inside the scissor after rounding, no pixel center is affected
+    const float inset = 1.0f / 256.0f;
+    const ImRect clip(display_pos + (scissor.Min + ImVec2(inset, inset)) / fb_scale, display_pos + (scissor.Max - ImVec2(inset, inset)) / fb_scale);
+    for (int n = 0; n < idx_count; n += 6)
+    {
+        ImDrawVert* v = vtx + (idx[n] - vtx_min);
+        const ImVec2 a = v[0].pos, b = v[2].pos, uv_a = v[0].uv, uv_b = v[2].uv;
+        ImVec2 p_min = ImMax(a, clip.Min), p_max = ImMin(b, clip.Max);
+        if (p_min.x >= p_max.x || p_min.y >= p_max.y)
+            p_max = p_min = clip.Min;
+        const ImVec2 t_min((b.x > a.x) ? (p_min.x - a.x) / (b.x - a.x) : 0.0f, (b.y > a.y) ? (p_min.y - a.y) / (b.y - a.y) : 0.0f);
+        const ImVec2 t_max((b.x > a.x) ? (p_max.x - a.x) / (b.x - a.x) : 0.0f, (b.y > a.y) ? (p_max.y - a.y) / (b.y - a.y) : 0.0f);
+        const ImVec2 uv_min(ImLerp(uv_a.x, uv_b.x, t_min.x), ImLerp(uv_a.y, uv_b.y, t_min.y));
+        const ImVec2 uv_max(ImLerp(uv_a.x, uv_b.x, t_max.x), ImLerp(uv_a.y, uv_b.y, t_max.y));
+        v[0].pos = p_min;                       v[0].uv = uv_min;
+        v[1].pos = ImVec2(p_max.x, p_min.y);    v[1].uv = ImVec2(uv_max.x, uv_min.y);
+        v[2].pos = p_max;                       v[2].uv = uv_max;
+        v[3].pos = ImVec2(p_min.x, p_max.y);    v[3].uv = ImVec2(uv_min.x, uv_max.y);
+    }
+    return true;
+}
+
+// Merge every draw list of the viewport into a single one with as few draw commands as possible (io.ConfigDrawCallBatching).
+// - Only consecutive commands are joined so the composition order is unchanged. They need the same texture and a clip rect they can share.
+// - Commands whose geometry already fits in their scissor don't need it: a run of those is drawn with the union of their scissors,
+//   and they can join a command of any other clip rect as long as they also fit in its scissor.
+// - Commands which need their clip rect can only be joined when small and made of axis aligned quads (rects, text), clipped on the CPU.
+// - With 16-bit indices a new command using ImDrawCmd::VtxOffset is started every 64K vertices.
+static void BatchViewportDrawData(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    if (!g.IO.ConfigDrawCallBatching || draw_data->CmdListsCount == 0 || draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+        return;
+    const bool has_vtx_offset = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) != 0;
+    if (sizeof(ImDrawIdx) == 2 && !has_vtx_offset && draw_data->TotalVtxCount > (1 << 16))
+        return;
+
+    if (viewport->BatchDrawList == NULL)
+    {
+        viewport->BatchDrawList = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+        viewport->BatchDrawList->_OwnerName = "##Batch";
+    }
+    ImDrawList* out = viewport->BatchDrawList;
+    out->CmdBuffer.resize(0);
+    out->IdxBuffer.resize(0);
+    out->VtxBuffer.resize(0);
+    out->IdxBuffer.reserve(draw_data->TotalIdxCount);
+    out->VtxBuffer.reserve(draw_data->TotalVtxCount);
+    out->Flags = draw_data->CmdLists[0]->Flags;
+
+    const int max_clipped_idx_count = 6 * 64;
+    const ImVec2 display_pos = draw_data->DisplayPos;
+    const ImVec2 fb_scale = draw_data->FramebufferScale;
+    int cmds_count = 0;
+    unsigned int vtx_offset = 0;
+    bool batch_open = false;
+    bool batch_clip_required = false;       // The batch uses the clip rect of its commands, otherwise the union of their scissors
+    ImRect batch_scissor, batch_bounds;     // In framebuffer pixels
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        for (const ImDrawCmd* cmd = draw_list->CmdBuffer.begin(); cmd != draw_list->CmdBuffer.end(); cmd++)
+        {
+            if (cmd->UserCallback != NULL)
+            {
+                ImDrawCmd callback_cmd = *cmd;
+                callback_cmd.VtxOffset = vtx_offset;
+                callback_cmd.IdxOffset = (unsigned int)out->IdxBuffer.Size;
+                out->CmdBuffer.push_back(callback_cmd);
+                batch_open = false;
+                cmds_count++;
+                continue;
+            }
+            if (cmd->ElemCount == 0)
+                continue;
+            cmds_count++;
+
+            // Nothing of it is visible
+            const ImRect scissor = CalcBatchScissor(cmd->ClipRect, display_pos, fb_scale);
+            if (scissor.Min.x >= scissor.Max.x)
+                continue;
+
+            // Copy the vertices it references. Commands of merged channels (columns, tables) interleave their vertices,
+            // in which case only the referenced ones are gathered.
+            const ImDrawIdx* src_idx = draw_list->IdxBuffer.Data + cmd->IdxOffset;
+            const ImDrawVert* src_vtx = draw_list->VtxBuffer.Data + cmd->VtxOffset;
+            unsigned int vtx_min = UINT_MAX, vtx_max = 0;
+            for (unsigned int n = 0; n < cmd->ElemCount; n++)
+            {
+                vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+                vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+            }
+            const int vtx_range = (int)(vtx_max - vtx_min + 1);
+            const bool gather = vtx_range > (int)cmd->ElemCount;
+            if (sizeof(ImDrawIdx) == 2 && out->VtxBuffer.Size + ImMin(vtx_range, (int)cmd->ElemCount) - (int)vtx_offset > (1 << 16))
+            {
+                vtx_offset = (unsigned int)out->VtxBuffer.Size;
+                batch_open = false;
+            }
+            const int out_vtx_start = out->VtxBuffer.Size;
+            const int out_idx_start = out->IdxBuffer.Size;
+            out->IdxBuffer.resize(out_idx_start + (int)cmd->ElemCount);
+            ImDrawIdx* dst_idx = out->IdxBuffer.Data + out_idx_start;
+            if (gather)
+            {
+                ImVector<int>& remap = viewport->BatchVtxRemap;
+                remap.resize(vtx_range);
+                memset(remap.Data, 0xFF, (size_t)vtx_range * sizeof(int));
+                for (unsigned int n = 0; n < cmd->ElemCount; n++)
+                {
+                    int& vtx_n = remap[src_idx[n] - vtx_min];
+                    if (vtx_n < 0)
+                    {
+                        vtx_n = out->VtxBuffer.Size - (int)vtx_offset;
+                        out->VtxBuffer.push_back(src_vtx[src_idx[n]]);
+                    }
+                    dst_idx[n] = (ImDrawIdx)vtx_n;
+                }
+            }
+            else
+            {
+                out->VtxBuffer.resize(out_vtx_start + vtx_range);
+                memcpy(out->VtxBuffer.Data + out_vtx_start, src_vtx + vtx_min, (size_t)vtx_range * sizeof(ImDrawVert));
+                const unsigned int idx_base = (unsigned int)out_vtx_start - vtx_offset - vtx_min;
+                for (unsigned int n = 0; n < cmd->ElemCount; n++)
+                    dst_idx[n] = (ImDrawIdx)(src_idx[n] + idx_base);
+            }
+            ImDrawVert* vtx = out->VtxBuffer.Data + out_vtx_start;
+            const int vtx_count = out->VtxBuffer.Size - out_vtx_start;
+
+            ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for (int n = 0; n < vtx_count; n++)
+                bounds.Add(vtx[n].pos);
+            bounds.Min = (bounds.Min - display_pos) * fb_scale;
+            bounds.Max = (bounds.Max - display_pos) * fb_scale;
+            bool fits = scissor.Contains(bounds);
+
+            bool merge = false;
+            if (batch_open && out->CmdBuffer.back().TextureId == cmd->TextureId)
+            {
+                if (batch_clip_required)
+                    merge = (memcmp(&out->CmdBuffer.back().ClipRect, &cmd->ClipRect, sizeof(ImVec4)) == 0) || (fits && batch_scissor.Contains(bounds));
+                else
+                    merge = fits || scissor.Contains(batch_bounds);
+                if (!merge && !fits && cmd->ElemCount <= (unsigned int)max_clipped_idx_count && ClipBatchQuads(vtx, dst_idx, (int)cmd->ElemCount, (unsigned int)out_vtx_start - vtx_offset, scissor, display_pos, fb_scale))
+                {
+                    bounds = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                    for (int n = 0; n < vtx_count; n++)
+                        bounds.Add((vtx[n].pos - display_pos) * fb_scale);
+                    fits = scissor.Contains(bounds);
+                    merge = fits && (!batch_clip_required || batch_scissor.Contains(bounds));
+                }
+            }
+
+            if (merge)
+            {
+                ImDrawCmd& batch_cmd = out->CmdBuffer.back();
+                if (!batch_clip_required && !fits)
+                {
+                    batch_clip_required = true;
+                    batch_scissor = scissor;
+                    batch_cmd.ClipRect = cmd->ClipRect;
+                }
+                else if (!batch_clip_required)
+                {
+                    // Pad the union by half a pixel so truncating it back to framebuffer pixels gives the same scissor
+                    batch_scissor.Add(scissor);
+                    batch_cmd.ClipRect = ImVec4(display_pos.x + (batch_scissor.Min.x + 0.5f) / fb_scale.x, display_pos.y + (batch_scissor.Min.y + 0.5f) / fb_scale.y,
+                        display_pos.x + (batch_scissor.Max.x + 0.5f) / fb_scale.x, display_pos.y + (batch_scissor.Max.y + 0.5f) / fb_scale.y);
+                }
+                batch_bounds.Add(bounds);
+                batch_cmd.ElemCount += cmd->ElemCount;
+            }
+            else
+            {
+                ImDrawCmd batch_cmd = *cmd;
+                batch_cmd.VtxOffset = vtx_offset;
+                batch_cmd.IdxOffset = (unsigned int)out_idx_start;
+                out->CmdBuffer.push_back(batch_cmd);
+                batch_open = true;
+                batch_clip_required = !fits;
+                batch_scissor = scissor;
+                batch_bounds = bounds;
+            }
+
+        }
+    }
+
+    g.DrawCallsBeforeBatching += cmds_count;
+    g.DrawCallsAfterBatching += out->CmdBuffer.Size;
+    draw_data->CmdLists = &viewport->BatchDrawList;
+    draw_data->CmdListsCount = 1;
+    draw_data->TotalVtxCount = out->VtxBuffer.Size;
+    draw_data->TotalIdxCount = out->IdxBuffer.Size;
+}
+
 // Push a clipping rectangle for both ImGui logic (hit-testing etc.) and low-level ImDrawList rendering.
 // - When using this function it is sane to ensure that float are perfectly rounded to integer values,
 //   so that e.g. (int)(max.x-min.x) in user's render produce correct result.
@@ -5239,6 +5719,8 @@ void ImGui::Render()
         EndFrame();
     const bool first_render_of_frame = (g.FrameCountRendered != g.FrameCount);
     g.FrameCountRendered = g.FrameCount;
+    if (first_render_of_frame)
+        g.RenderSerial++;
     g.IO.MetricsRenderWindows = 0;
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPre);
@@ -5277,6 +5759,7 @@ void ImGui::Render()
 
     // Setup ImDrawData structures for end-user
     g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.DrawCallsBeforeBatching = g.DrawCallsAfterBatching = 0;
     for (int n = 0; n < g.Viewports.Size; n++)
     {
         ImGuiViewportP* viewport = g.Viewports[n];
@@ -5287,10 +5770,14 @@ void ImGui::Render()
             AddDrawListToDrawData(&viewport->DrawDataBuilder.Layers[0], GetForegroundDrawList(viewport));
 
         SetupViewportDrawData(viewport, &viewport->DrawDataBuilder.Layers[0]);
+        UpdateViewportDamage(viewport);
+        BatchViewportDrawData(viewport);
         ImDrawData* draw_data = viewport->DrawData;
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
     }
+    g.DamageRects.resize(0);
+    g.DamageTextures.resize(0);
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
 }
@@ -8031,6 +8518,240 @@ ImGuiViewport* ImGui::GetWindowViewport()
     return g.CurrentViewport;
 }
 
+// Everything outside of the user version which changes how the widgets of a cached block are drawn
+static ImGuiID CalcCachedContentStateHash(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    struct
+    {
+        ImVec2          Pos, Size, Scroll, CursorPos;
+        ImVec1          Indent, ColumnsOffset;
+        ImRect          WorkRect;
+        ImVec4          ClipRect;
+        ImTextureID     TextureId;
+        ImFont*         Font;
+        float           FontSize, ItemWidth, TextWrapPos;
+        ImGuiItemFlags  ItemFlags;
+        ImGuiLayoutType LayoutType;
+        ImDrawListFlags DrawListFlags;
+        ImGuiID         NavId;
+        ImVec2          MousePos;
+        int             MouseDown;
+        int             Focus;
+    } state;
+    memset(&state, 0, sizeof(state));
+    state.Pos = window->Pos;
+    state.Size = window->Size;
+    state.Scroll = window->Scroll;
+    state.CursorPos = window->DC.CursorPos;
+    state.Indent = window->DC.Indent;
+    state.ColumnsOffset = window->DC.ColumnsOffset;
+    state.WorkRect = window->WorkRect;
+    state.ClipRect = window->DrawList->_CmdHeader.ClipRect;
+    state.TextureId = window->DrawList->_CmdHeader.TextureId;
+    state.Font = g.Font;
+    state.FontSize = g.FontSize;
+    state.ItemWidth = window->DC.ItemWidth;
+    state.TextWrapPos = window->DC.TextWrapPos;
+    state.ItemFlags = g.CurrentItemFlags;
+    state.LayoutType = window->DC.LayoutType;
+    state.DrawListFlags = window->DrawList->Flags;
+    if (g.NavWindow == window)
+        state.NavId = g.NavId;
+    if (g.HoveredWindow == window)
+    {
+        state.MousePos = g.IO.MousePos;
+        for (int n = 0; n < IM_ARRAYSIZE(g.IO.MouseDown); n++)
+            if (g.IO.MouseDown[n])
+                state.MouseDown |= 1 << n;
+    }
+    state.Focus = (g.NavWindow == window ? 1 : 0) | (g.NavWindow && g.NavWindow->RootWindow == window->RootWindow ? 2 : 0) | (g.NavDisableHighlight ? 4 : 0) | (g.NavDisableMouseHover ? 8 : 0);
+    return ImHashData(&g.Style, sizeof(g.Style), ImHashData(&state, sizeof(state)));
+}
+
+// Interactions which need the widgets to run even though nothing they draw may have changed yet
+static bool IsCachedContentReusable(ImGuiWindow* window, const ImGuiWindowContentCache* cache)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Appearing || (g.ActiveId != 0 && g.ActiveIdWindow == window))
+        return false;
+    if (g.HoveredWindow == window && (cache->HadHoveredItem || g.IO.MouseWheel != 0.0f || g.IO.MouseWheelH != 0.0f || g.DragDropActive))
+        return false;
+    if (g.NavWindow == window)
+    {
+        if (g.NavAnyRequest || g.NavActivateId != 0 || g.NavActivateDownId != 0)
+            return false;
+        for (int n = 0; n < g.InputEventsTrail.Size; n++)
+            if (g.InputEventsTrail[n].Type == ImGuiInputEventType_Key || g.InputEventsTrail[n].Type == ImGuiInputEventType_Text)
+                return false;
+    }
+    return true;
+}
+
+static void ReplayCachedContent(ImGuiWindow* window, const ImGuiWindowContentCache* cache)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList* draw_list = window->DrawList;
+    for (int cmd_n = 0; cmd_n < cache->Cmds.Size; cmd_n++)
+    {
+        const ImGuiWindowContentCacheCmd& cmd = cache->Cmds[cmd_n];
+        draw_list->_CmdHeader.ClipRect = cmd.ClipRect;
+        draw_list->_OnChangedClipRect();
+        draw_list->_CmdHeader.TextureId = cmd.TextureId;
+        draw_list->_OnChangedTextureID();
+        draw_list->PrimReserve(cmd.IdxCount, cmd.VtxCount);
+        memcpy(draw_list->_VtxWritePtr, cache->VtxBuffer.Data + cmd.VtxOffset, (size_t)cmd.VtxCount * sizeof(ImDrawVert));
+        const ImDrawIdx* src_idx = cache->IdxBuffer.Data + cmd.IdxOffset;
+        const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+        for (int n = 0; n < cmd.IdxCount; n++)
+            draw_list->_IdxWritePtr[n] = (ImDrawIdx)(vtx_base + src_idx[n]);
+        draw_list->_VtxWritePtr += cmd.VtxCount;
+        draw_list->_IdxWritePtr += cmd.IdxCount;
+        draw_list->_VtxCurrentIdx += cmd.VtxCount;
+    }
+    draw_list->_CmdHeader.ClipRect = draw_list->_ClipRectStack.back();
+    draw_list->_OnChangedClipRect();
+    draw_list->_CmdHeader.TextureId = draw_list->_TextureIdStack.back();
+    draw_list->_OnChangedTextureID();
+
+    ImGuiWindowTempData& dc = window->DC;
+    dc.CursorPos = cache->CursorPos;
+    dc.CursorPosPrevLine = cache->CursorPosPrevLine;
+    dc.CursorMaxPos = ImMax(dc.CursorMaxPos, cache->CursorMaxPos);
+    dc.IdealMaxPos = ImMax(dc.IdealMaxPos, cache->IdealMaxPos);
+    dc.CurrLineSize = cache->CurrLineSize;
+    dc.PrevLineSize = cache->PrevLineSize;
+    dc.CurrLineTextBaseOffset = cache->CurrLineTextBaseOffset;
+    dc.PrevLineTextBaseOffset = cache->PrevLineTextBaseOffset;
+    dc.IsSameLine = cache->IsSameLine;
+    dc.NavLayersActiveMaskNext |= cache->NavLayersActiveMaskNext;
+    if (cache->NavIdIsAlive)
+        g.NavIdIsAlive = true;
+    g.LastItemData = cache->LastItemData;
+}
+
+bool ImGui::BeginCachedContent(ImU64 version)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (window->SkipItems)
+        return false;
+
+    ImGuiWindowContentCache* cache = window->ContentCache;
+    if (cache == NULL)
+        cache = window->ContentCache = IM_NEW(ImGuiWindowContentCache)();
+    IM_ASSERT(!cache->Recording && "Mismatched BeginCachedContent()/EndCachedContent() calls!");
+    IM_ASSERT(cache->LastFrame != g.FrameCount && "BeginCachedContent() can only be called once per window per frame!");
+    cache->LastFrame = g.FrameCount;
+
+    // Columns, tables and stack layouts measure their items every frame, splitting channels would break the recorded command ranges
+    ImDrawList* draw_list = window->DrawList;
+    const bool can_cache = window->DC.CurrentColumns == NULL && window->DC.CurrentTableIdx == -1 && window->DC.CurrentLayout == NULL && draw_list->_Splitter._Count <= 1;
+    const ImGuiID state_hash = can_cache ? CalcCachedContentStateHash(window) : 0;
+    if (can_cache && cache->Valid && cache->Version == version && cache->StateHash == state_hash && IsCachedContentReusable(window, cache))
+    {
+        ReplayCachedContent(window, cache);
+        cache->ReuseCount++;
+        g.CachedContentReused++;
+        g.CachedContentReusedTotal++;
+        return false;
+    }
+
+    cache->Valid = false;
+    cache->Recording = true;
+    cache->Version = version;
+    cache->StateHash = state_hash;
+    cache->RecordIdxStart = can_cache ? draw_list->IdxBuffer.Size : -1;
+    cache->RecordCmdCount = draw_list->CmdBuffer.Size;
+    cache->RecordChildWindows = window->DC.ChildWindows.Size;
+    cache->RecordWindowsActive = g.WindowsActiveCount;
+    cache->RecordSplitterCount = draw_list->_Splitter._Count;
+    cache->RecordHoveredId = g.HoveredId;
+    cache->RecordNavIdIsAlive = g.NavIdIsAlive;
+    cache->RecordCursorMaxPos = window->DC.CursorMaxPos;
+    cache->RecordIdealMaxPos = window->DC.IdealMaxPos;
+    window->DC.CursorMaxPos = window->DC.IdealMaxPos = window->DC.CursorPos;
+    cache->SubmitCount++;
+    g.CachedContentSubmitted++;
+    g.CachedContentSubmittedTotal++;
+    return true;
+}
+
+void ImGui::EndCachedContent()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiWindowContentCache* cache = window->ContentCache;
+    IM_ASSERT(cache != NULL && cache->Recording && "Mismatched BeginCachedContent()/EndCachedContent() calls!");
+    cache->Recording = false;
+
+    ImGuiWindowTempData& dc = window->DC;
+    const ImVec2 block_max_pos = dc.CursorMaxPos;
+    const ImVec2 block_ideal_max_pos = dc.IdealMaxPos;
+    dc.CursorMaxPos = ImMax(cache->RecordCursorMaxPos, block_max_pos);
+    dc.IdealMaxPos = ImMax(cache->RecordIdealMaxPos, block_ideal_max_pos);
+
+    // Nested windows and channels can't be replayed from our draw list alone
+    ImDrawList* draw_list = window->DrawList;
+    if (cache->RecordIdxStart < 0 || dc.ChildWindows.Size != cache->RecordChildWindows || g.WindowsActiveCount != cache->RecordWindowsActive || draw_list->_Splitter._Count != cache->RecordSplitterCount)
+        return;
+
+    // Copy the commands appended since BeginCachedContent(), each with the vertex range its indices reference
+    cache->VtxBuffer.resize(0);
+    cache->IdxBuffer.resize(0);
+    cache->Cmds.resize(0);
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd& src_cmd = draw_list->CmdBuffer[cmd_n];
+        if (src_cmd.UserCallback != NULL)
+        {
+            if (cmd_n >= cache->RecordCmdCount - 1)
+                return;
+            continue;
+        }
+        const int idx_start = ImMax((int)src_cmd.IdxOffset, cache->RecordIdxStart);
+        const int idx_end = (int)(src_cmd.IdxOffset + src_cmd.ElemCount);
+        if (idx_end <= idx_start)
+            continue;
+        const ImDrawIdx* src_idx = draw_list->IdxBuffer.Data + idx_start;
+        unsigned int vtx_min = UINT_MAX, vtx_max = 0;
+        for (int n = 0; n < idx_end - idx_start; n++)
+        {
+            vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+            vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+        }
+
+        ImGuiWindowContentCacheCmd cmd;
+        cmd.ClipRect = src_cmd.ClipRect;
+        cmd.TextureId = src_cmd.TextureId;
+        cmd.VtxOffset = cache->VtxBuffer.Size;
+        cmd.VtxCount = (int)(vtx_max - vtx_min + 1);
+        cmd.IdxOffset = cache->IdxBuffer.Size;
+        cmd.IdxCount = idx_end - idx_start;
+        cache->VtxBuffer.resize(cmd.VtxOffset + cmd.VtxCount);
+        memcpy(cache->VtxBuffer.Data + cmd.VtxOffset, draw_list->VtxBuffer.Data + src_cmd.VtxOffset + vtx_min, (size_t)cmd.VtxCount * sizeof(ImDrawVert));
+        cache->IdxBuffer.resize(cmd.IdxOffset + cmd.IdxCount);
+        for (int n = 0; n < cmd.IdxCount; n++)
+            cache->IdxBuffer.Data[cmd.IdxOffset + n] = (ImDrawIdx)(src_idx[n] - vtx_min);
+        cache->Cmds.push_back(cmd);
+    }
+
+    cache->CursorPos = dc.CursorPos;
+    cache->CursorPosPrevLine = dc.CursorPosPrevLine;
+    cache->CursorMaxPos = block_max_pos;
+    cache->IdealMaxPos = block_ideal_max_pos;
+    cache->CurrLineSize = dc.CurrLineSize;
+    cache->PrevLineSize = dc.PrevLineSize;
+    cache->CurrLineTextBaseOffset = dc.CurrLineTextBaseOffset;
+    cache->PrevLineTextBaseOffset = dc.PrevLineTextBaseOffset;
+    cache->IsSameLine = dc.IsSameLine;
+    cache->NavLayersActiveMaskNext = dc.NavLayersActiveMaskNext;
+    cache->NavIdIsAlive = !cache->RecordNavIdIsAlive && g.NavIdIsAlive;
+    cache->HadHoveredItem = (g.HoveredId != cache->RecordHoveredId && g.HoveredId != 0);
+    cache->LastItemData = g.LastItemData;
+    cache->Valid = true;
+}
+
 ImFont* ImGui::GetFont()
 {
     return GImGui->Font;
@@ -18616,6 +19337,12 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
     Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
+    if (g.CachedContentReusedTotal + g.CachedContentSubmittedTotal > 0)
+        Text("%d/%d cached window contents reused (%.1f%% since start)", g.CachedContentReused, g.CachedContentReused + g.CachedContentSubmitted,
+            100.0 * (double)g.CachedContentReusedTotal / (double)(g.CachedContentReusedTotal + g.CachedContentSubmittedTotal));
+    if (io.ConfigDrawCallBatching)
+        Text("Draw call batching: %d -> %d draw calls (%.1f%% fewer)", g.DrawCallsBeforeBatching, g.DrawCallsAfterBatching,
+            100.0f * (float)(g.DrawCallsBeforeBatching - g.DrawCallsAfterBatching) / (float)ImMax(g.DrawCallsBeforeBatching, 1));
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -19510,6 +20237,17 @@ void ImGui::DebugNodeViewport(ImGuiViewportP* viewport)
             (flags & ImGuiViewportFlags_Minimized) ? " Minimized" : "",
             (flags & ImGuiViewportFlags_NoAutoMerge) ? " NoAutoMerge" : "",
             (flags & ImGuiViewportFlags_CanHostOtherWindows) ? " CanHostOtherWindows" : "");
+        if (GImGui->IO.ConfigDamageTracking)
+        {
+            const ImDrawData* draw_data = &viewport->DrawDataP;
+            float damage_area = 0.0f;
+            for (int n = 0; n < draw_data->DamageRectsCount; n++)
+                damage_area += (draw_data->DamageRects[n].z - draw_data->DamageRects[n].x) * (draw_data->DamageRects[n].w - draw_data->DamageRects[n].y);
+            if (!draw_data->DamageValid)
+                BulletText("Damage: whole viewport");
+            else
+                BulletText("Damage: %d rects, %.1f%% of the viewport", draw_data->DamageRectsCount, 100.0f * damage_area / ImMax(1.0f, viewport->Size.x * viewport->Size.y));
+        }
         for (int layer_i = 0; layer_i < IM_ARRAYSIZE(viewport->DrawDataBuilder.Layers); layer_i++)
             for (int draw_list_i = 0; draw_list_i < viewport->DrawDataBuilder.Layers[layer_i].Size; draw_list_i++)
                 DebugNodeDrawList(NULL, viewport, viewport->DrawDataBuilder.Layers[layer_i][draw_list_i], "DrawList");
@@ -19563,6 +20301,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
             GetForegroundDrawList(window)->AddRect(r.Min + window->Pos, r.Max + window->Pos, IM_COL32(255, 255, 0, 255));
     }
     BulletText("NavLayersActiveMask: %X, NavLastChildNavWindow: %s", window->DC.NavLayersActiveMask, window->NavLastChildNavWindow ? window->NavLastChildNavWindow->Name : "NULL");
+    if (ImGuiWindowContentCache* cache = window->ContentCache)
+        BulletText("ContentCache: %s, %d vtx, %d idx, %d cmds, reused %d/%d", cache->Valid ? "valid" : "invalid", cache->VtxBuffer.Size, cache->IdxBuffer.Size, cache->Cmds.Size, cache->ReuseCount, cache->ReuseCount + cache->SubmitCount);
 
     BulletText("Viewport: %d%s, ViewportId: 0x%08X, ViewportPos: (%.1f,%.1f)", window->Viewport ? window->Viewport->Idx : -1, window->ViewportOwned ? " (Owned)" : "", window->ViewportId, window->ViewportPos.x, window->ViewportPos.y);
     BulletText("ViewportMonitor: %d", window->Viewport ? window->Viewport->PlatformMonitor : -1);
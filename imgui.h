@@ -136,6 +136,7 @@ Index of this file:
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
+struct ImDrawDataSnapshot;          // Copy of an ImDrawData with pooled buffers, to render on another thread.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
@@ -304,6 +305,8 @@ namespace ImGui
     IMGUI_API void          EndFrame();                                 // ends the Dear ImGui frame. automatically called by Render(). If you don't need to render data (skipping rendering) you may call EndFrame() without Render()... but you'll have wasted CPU already! If you don't need to render, better to not create any windows and not call NewFrame() at all!
     IMGUI_API void          Render();                                   // ends the Dear ImGui frame, finalize the draw data. You can then get call GetDrawData().
     IMGUI_API ImDrawData*   GetDrawData();                              // valid after Render() and until the next call to NewFrame(). this is what you have to render.
+    IMGUI_API void          AddDamageRect(const ImVec2& p_min, const ImVec2& p_max);  // with io.ConfigDamageTracking: redraw this area at the next Render() even if no draw list changed (e.g. something drawn by a callback).
+    IMGUI_API void          AddDamageTexture(ImTextureID user_texture_id);            // with io.ConfigDamageTracking: redraw everything using this texture at the next Render(). Call after updating its pixels in place.
 
     // Demo, Debug, Information
     IMGUI_API void          ShowDemoWindow(bool* p_open = NULL);        // create Demo window. demonstrate most ImGui features. call this to learn about the library! try to make it always available in your application!
@@ -363,6 +366,14 @@ namespace ImGui
     IMGUI_API float         GetWindowHeight();                          // get current window height (shortcut for GetWindowSize().y)
     IMGUI_API ImGuiViewport*GetWindowViewport();                        // get viewport currently associated to the current window.
 
+    // Retained Window Content
+    // - Wrap the widgets of a window whose output rarely changes: when BeginCachedContent() returns false, the draw output and layout recorded on a previous frame are appended again and you can skip the widgets.
+    // - Bump 'version' whenever anything drawn inside the block changes. Window position/size/scroll, style, font and hover/active/nav state are tracked for you.
+    // - The block must be balanced and only draw: child windows, popups, tooltips, columns and draw callbacks inside it disable the reuse.
+    // - Call once per window per frame. Only call EndCachedContent() if BeginCachedContent() returns true!
+    IMGUI_API bool          BeginCachedContent(ImU64 version);          // true: submit the block then call EndCachedContent(). false: the block was replayed from its cache.
+    IMGUI_API void          EndCachedContent();
+
     // Window manipulation
     // - Prefer using SetNextXXX functions (before Begin) rather that SetXXX functions (after Begin).
     IMGUI_API void          SetNextWindowPos(const ImVec2& pos, ImGuiCond cond = 0, const ImVec2& pivot = ImVec2(0, 0)); // set next window position. call before Begin(). use pivot=(0.5f,0.5f) to center on given point, etc.
@@ -901,6 +912,14 @@ namespace ImGui
     IMGUI_API ImDrawList*   GetBackgroundDrawList(ImGuiViewport* viewport);                     // get background draw list for the given viewport. this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList(ImGuiViewport* viewport);                     // get foreground draw list for the given viewport. this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
 
+    // Detached Draw Lists
+    // - Create, reset and destroy them on the thread owning the context. In between, any thread may fill one: it draws with its own copy of the shared data (font, font size, tessellation tables) taken by the last reset.
+    // - Draw in local coordinates, then splice the output into a window draw list or channel with ImDrawList::AddDrawList() from the context thread.
+    // - AddText() still reads the glyph shadow/outline values of the current style, don't push those while workers are drawing.
+    IMGUI_API ImDrawList*   CreateDetachedDrawList();                                           // reset and ready to be filled, with the current font and a clip rect of +/-8192 around the local origin.
+    IMGUI_API void          ResetDetachedDrawList(ImDrawList* draw_list);                       // clear before filling it again, refreshes its copy of the shared data.
+    IMGUI_API void          DestroyDetachedDrawList(ImDrawList* draw_list);
+
     // Miscellaneous Utilities
     IMGUI_API bool          IsRectVisible(const ImVec2& size);                                  // test if rectangle (of given size, starting from cursor position) is visible / not clipped.
     IMGUI_API bool          IsRectVisible(const ImVec2& rect_min, const ImVec2& rect_max);      // test if rectangle (in screen space) is visible / not clipped. to perform coarse clipping on user's side.
@@ -1596,6 +1615,7 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasAnalyticShapes = 1 << 4, // Backend Renderer evaluates the shape quads emitted with io.ConfigAnalyticShapes (see IM_DRAWVERT_SHAPE_MARKER).
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2043,6 +2063,10 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDamageTracking;           // = false          // Fill ImDrawData::DamageRects with the areas that changed since the previous Render(), by diffing the draw lists. Renderers keeping their target between frames can redraw only those, and skip presenting when there are none.
+    bool        ConfigDrawCallBatching;         // = false          // Merge the draw commands of each viewport into a single draw list at Render(), joining consecutive commands across windows when they share a texture and their clip rects can be shared (the geometry already fits in the scissor, or small quads are clipped on the CPU). Reduces draw calls, output is unchanged.
+    bool        ConfigCompactVertices;          // = false          // Renderer backends supporting it (OpenGL3, Vulkan) upload draw lists as ImDrawVertCompact vertices (12 bytes instead of 20) and 16-bit indices when they fit, to reduce the bandwidth of large meshes.
+    bool        ConfigAnalyticShapes;           // = false          // Draw anti-aliased rounded rectangles, circles and lines as a single quad each, the renderer evaluating the shape per pixel, instead of tessellating them. Requires a backend setting ImGuiBackendFlags_RendererHasAnalyticShapes (OpenGL3 with GLSL 1.30+, Vulkan, soft), ignored otherwise.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -2559,6 +2583,30 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Compact vertex layout renderer backends may upload instead of ImDrawVert when io.ConfigCompactVertices is set: 12 bytes instead of 20.
+// Positions are fixed point with 1/IM_DRAWVERT_COMPACT_POS_SCALE pixel steps, relative to an origin per draw list. UV are normalized to 0..65535.
+// See ImDrawList::CalcCompactVtxOrigin()/PackCompactVtx(). Draw lists which don't fit (too large, uv outside 0..1) are uploaded as ImDrawVert.
+#define IM_DRAWVERT_COMPACT_POS_SCALE   8.0f
+struct ImDrawVertCompact
+{
+    ImS16   pos[2];
+    ImU16   uv[2];
+    ImU32   col;
+};
+
+// Analytic shapes emitted with ImDrawListFlags_AnalyticShapes: AddRect(), AddRectFilled() with rounding, AddCircle() and AddCircleFilled()
+// with an automatic segment count, and AddLine() or any 2 point open polyline, write one quad per shape and the renderer computes the
+// distance to the rounded box for every pixel, with the coverage clamp(0.5 - distance, 0, 1) of the tessellated anti-aliased fringes.
+// The 4 vertices carry the shape in their uv as exact integers, uv.x <= -IM_DRAWVERT_SHAPE_MARKER tells them apart from textured vertices.
+// Sizes are in 1/IM_DRAWVERT_SHAPE_UNIT pixels:
+//   -uv.x - IM_DRAWVERT_SHAPE_MARKER: bits 0-12 half width, bits 13-17 stroke thickness (0 when filled), bits 18-21 rounded corners (top-left, top-right, bottom-left, bottom-right)
+//   uv.y:                             bits 0-12 half height, bits 13-21 corner radius, bits 22-23 corner of this vertex (same order: bit 0 right, bit 1 bottom)
+// The quad extends half the thickness + 1 pixel beyond the shape. A line is a box along the segment, its quad is rotated so the width
+// follows the direction from vertex 0 to vertex 1. Longer polylines are tessellated, like shapes which don't fit (half size above
+// 2047 pixels, radius above 127, thickness above 7).
+#define IM_DRAWVERT_SHAPE_MARKER        8388608.0f
+#define IM_DRAWVERT_SHAPE_UNIT          4.0f
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
@@ -2621,6 +2669,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AnalyticShapes          = 1 << 4,  // Emit anti-aliased rounded rectangles, circles and lines as shape quads (see IM_DRAWVERT_SHAPE_MARKER). Set when 'io.ConfigAnalyticShapes' is enabled and supported by the backend.
 };
 
 // Draw command list
@@ -2716,6 +2765,7 @@ struct ImDrawList
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API void  AddDrawList(const ImDrawList* src, const ImVec2& offset = ImVec2(0, 0)); // Append the output of another draw list (e.g. a detached one filled by a worker thread) translated by offset. Its clip rects are translated too and intersected with the current one.
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -2739,6 +2789,12 @@ struct ImDrawList
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
+    // Advanced: Compact layouts for renderer backends (io.ConfigCompactVertices)
+    IMGUI_API bool  CalcCompactVtxOrigin(ImVec2* out_origin) const;             // Origin to pass to PackCompactVtx(). Returns false when the vertices can't be represented as ImDrawVertCompact.
+    IMGUI_API void  PackCompactVtx(ImDrawVertCompact* dst, const ImVec2& origin) const; // Write VtxBuffer.Size vertices to dst.
+    inline    bool  CanPackIdx16() const                                        { return sizeof(ImDrawIdx) == 2 || VtxBuffer.Size <= (1 << 16); }
+    IMGUI_API void  PackIdx16(ImU16* dst) const;                                // Write IdxBuffer.Size indices to dst. Requires CanPackIdx16().
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     inline    void  AddBezierCurve(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0) { AddBezierCubic(p1, p2, p3, p4, col, thickness, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
     inline    void  PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments = 0) { PathBezierCubicCurveTo(p2, p3, p4, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
@@ -2755,6 +2811,7 @@ struct ImDrawList
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
+    IMGUI_API bool  _AddAnalyticShape(const ImVec2& center, const ImVec2& half_size, float rounding, ImDrawFlags flags, float thickness, ImU32 col, const ImVec2& axis = ImVec2(1.0f, 0.0f));
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2771,6 +2828,9 @@ struct ImDrawData
     ImVec2          DisplaySize;            // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2          FramebufferScale;       // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*  OwnerViewport;          // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    bool            DamageValid;            // Set with io.ConfigDamageTracking when DamageRects covers every change since the previous Render() of this viewport. When false, redraw everything.
+    int             DamageRectsCount;       // Number of damaged rectangles, 0 with DamageValid means the frame is identical to the previous one.
+    ImVec4*         DamageRects;            // Damaged rectangles (x1, y1, x2, y2) in the same space as ClipRect, not overlapping. Owned by the viewport.
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -2779,6 +2839,28 @@ struct ImDrawData
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
+// Copy of an ImDrawData owned by the caller, so a render thread can submit frame N while the main thread builds frame N+1.
+// - Capture() after Render() on the main thread, then hand the snapshot to the render thread. Use two snapshots (or more) and don't capture into one the render thread is still drawing.
+// - The draw lists and their buffers are pooled: once they have grown to the size of a frame, Capture() doesn't allocate anymore.
+// - With 'move' the buffers are swapped with the context draw lists instead of copied. These are left empty: the draw data of that viewport can't be rendered anymore until the next frame.
+// - Serial is the one of the Render() the draw data comes from, bumped once per frame and shared by the snapshots of every viewport of that frame.
+//   The texture helpers use it to keep textures alive until the render thread is done with them (see ImDestroyTexture()).
+// - OwnerViewport is copied as is, it must not be dereferenced from the render thread.
+struct ImDrawDataSnapshot
+{
+    ImDrawData              DrawData;           // Captured draw data, its CmdLists and DamageRects point into the storage below
+    ImU64                   Serial;             // Render serial of the captured frame, 0 when empty
+    ImVector<ImDrawList*>   Lists;              // [Internal] Pool of draw lists, the first DrawData.CmdListsCount ones are in use
+    ImVector<ImDrawList*>   CmdLists;           // [Internal] Storage for DrawData.CmdLists
+    ImVector<ImVec4>        DamageRects;        // [Internal] Storage for DrawData.DamageRects
+
+    ImDrawDataSnapshot()    { Serial = 0; }
+    ~ImDrawDataSnapshot()   { Clear(); }
+    IMGUI_API void          Capture(ImDrawData* src, bool move = false);
+    IMGUI_API void          Clear();            // Free the pool
+    IMGUI_API static ImU64  GetRenderSerial();  // Serial of the last Render() of the current context, 0 without one
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontAtlasFlags, ImFontAtlas, ImFontGlyphRangesBuilder, ImFont)
 //-----------------------------------------------------------------------------
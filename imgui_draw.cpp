@@ -485,6 +485,68 @@ ImDrawList* ImDrawList::CloneOutput() const
     return dst;
 }
 
+// Each command copies the vertex range its indices reference, so the source may come from any draw list and land in the current channel
+void ImDrawList::AddDrawList(const ImDrawList* src, const ImVec2& offset)
+{
+    IM_ASSERT(src != this && src->_Splitter._Count <= 1);
+    const ImVec4 clip_rect = _CmdHeader.ClipRect;
+    const ImTextureID texture_id = _CmdHeader.TextureId;
+    for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &src->CmdBuffer.Data[cmd_n];
+        if (src_cmd->UserCallback != NULL)
+        {
+            AddCallback(src_cmd->UserCallback, src_cmd->UserCallbackData);
+            continue;
+        }
+        if (src_cmd->ElemCount == 0)
+            continue;
+        ImVec4 cmd_clip_rect(ImMax(src_cmd->ClipRect.x + offset.x, clip_rect.x), ImMax(src_cmd->ClipRect.y + offset.y, clip_rect.y), ImMin(src_cmd->ClipRect.z + offset.x, clip_rect.z), ImMin(src_cmd->ClipRect.w + offset.y, clip_rect.w));
+        if (cmd_clip_rect.x >= cmd_clip_rect.z || cmd_clip_rect.y >= cmd_clip_rect.w)
+            continue;
+
+        const ImDrawIdx* src_idx = src->IdxBuffer.Data + src_cmd->IdxOffset;
+        const int idx_count = (int)src_cmd->ElemCount;
+        unsigned int vtx_min = UINT_MAX, vtx_max = 0;
+        for (int n = 0; n < idx_count; n++)
+        {
+            vtx_min = ImMin(vtx_min, (unsigned int)src_idx[n]);
+            vtx_max = ImMax(vtx_max, (unsigned int)src_idx[n]);
+        }
+        const int vtx_count = (int)(vtx_max - vtx_min + 1);
+        const ImDrawVert* src_vtx = src->VtxBuffer.Data + src_cmd->VtxOffset + vtx_min;
+
+        _CmdHeader.ClipRect = cmd_clip_rect;
+        _OnChangedClipRect();
+        _CmdHeader.TextureId = src_cmd->TextureId;
+        _OnChangedTextureID();
+        PrimReserve(idx_count, vtx_count);
+        if (offset.x == 0.0f && offset.y == 0.0f)
+        {
+            memcpy(_VtxWritePtr, src_vtx, (size_t)vtx_count * sizeof(ImDrawVert));
+        }
+        else
+        {
+            for (int n = 0; n < vtx_count; n++)
+            {
+                _VtxWritePtr[n] = src_vtx[n];
+                _VtxWritePtr[n].pos.x += offset.x;
+                _VtxWritePtr[n].pos.y += offset.y;
+            }
+        }
+        const unsigned int vtx_base = _VtxCurrentIdx - vtx_min;
+        for (int n = 0; n < idx_count; n++)
+            _IdxWritePtr[n] = (ImDrawIdx)(vtx_base + src_idx[n]);
+        _VtxWritePtr += vtx_count;
+        _IdxWritePtr += idx_count;
+        _VtxCurrentIdx += vtx_count;
+    }
+    _CmdHeader.ClipRect = clip_rect;
+    _OnChangedClipRect();
+    _CmdHeader.TextureId = texture_id;
+    _OnChangedTextureID();
+}
+
 void ImDrawList::AddDrawCmd()
 {
     ImDrawCmd draw_cmd;
@@ -747,6 +809,76 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     _IdxWritePtr += 6;
 }
 
+// One quad carrying the shape in its uv for the renderer to evaluate (ImDrawListFlags_AnalyticShapes, see IM_DRAWVERT_SHAPE_MARKER).
+// Sizes are rounded to 1/IM_DRAWVERT_SHAPE_UNIT pixel. Returns false when they don't fit the encoding, the caller then tessellates the shape.
+// 'axis' is the unit direction of the shape width, the quad is rotated along with it (lines).
+bool ImDrawList::_AddAnalyticShape(const ImVec2& center, const ImVec2& half_size, float rounding, ImDrawFlags flags, float thickness, ImU32 col, const ImVec2& axis)
+{
+    const int half_w = (int)(half_size.x * IM_DRAWVERT_SHAPE_UNIT + 0.5f);
+    const int half_h = (int)(half_size.y * IM_DRAWVERT_SHAPE_UNIT + 0.5f);
+    const int radius = (rounding >= 0.5f) ? (int)(rounding * IM_DRAWVERT_SHAPE_UNIT + 0.5f) : 0;
+    const int stroke = (int)(thickness * IM_DRAWVERT_SHAPE_UNIT + 0.5f);
+    if (half_w < 2 || half_h < 2 || half_w > 0x1FFF || half_h > 0x1FFF || radius > 0x1FF || stroke > 0x1F)
+        return false;
+    const int corners = radius ? (flags & ImDrawFlags_RoundCornersMask_) >> 4 : 0;
+    const float code_x = IM_DRAWVERT_SHAPE_MARKER + (float)(half_w | (stroke << 13) | (corners << 18));
+    const float code_y = (float)(half_h | (radius << 13));
+    const float corner_bit = (float)(1 << 22);
+    const float margin = stroke / (IM_DRAWVERT_SHAPE_UNIT * 2.0f) + 1.0f;
+    const ImVec2 extent_x = axis * (half_w / IM_DRAWVERT_SHAPE_UNIT + margin);
+    const ImVec2 extent_y = ImVec2(-axis.y, axis.x) * (half_h / IM_DRAWVERT_SHAPE_UNIT + margin);
+    PrimReserve(6, 4);
+    PrimQuadUV(center - extent_x - extent_y, center + extent_x - extent_y, center + extent_x + extent_y, center - extent_x + extent_y,
+        ImVec2(-code_x, code_y), ImVec2(-code_x, code_y + corner_bit), ImVec2(-code_x, code_y + corner_bit * 3), ImVec2(-code_x, code_y + corner_bit * 2), col);
+    return true;
+}
+
+// The origin is the center of the vertices bounds so positions get the whole signed range on both sides
+bool ImDrawList::CalcCompactVtxOrigin(ImVec2* out_origin) const
+{
+    *out_origin = ImVec2(0.0f, 0.0f);
+    if (VtxBuffer.Size == 0)
+        return true;
+    float min_x = FLT_MAX, min_y = FLT_MAX, max_x = -FLT_MAX, max_y = -FLT_MAX;
+    float uv_min = 0.0f, uv_max = 1.0f;
+    for (const ImDrawVert* vtx = VtxBuffer.Data, *vtx_end = VtxBuffer.Data + VtxBuffer.Size; vtx < vtx_end; vtx++)
+    {
+        min_x = ImMin(min_x, vtx->pos.x); max_x = ImMax(max_x, vtx->pos.x);
+        min_y = ImMin(min_y, vtx->pos.y); max_y = ImMax(max_y, vtx->pos.y);
+        uv_min = ImMin(uv_min, ImMin(vtx->uv.x, vtx->uv.y));
+        uv_max = ImMax(uv_max, ImMax(vtx->uv.x, vtx->uv.y));
+    }
+    const ImVec2 origin(ImFloor((min_x + max_x) * 0.5f), ImFloor((min_y + max_y) * 0.5f));
+    const float pos_range = 32767.0f / IM_DRAWVERT_COMPACT_POS_SCALE;
+    *out_origin = origin;
+    // Written so NaN fails too
+    return uv_min >= 0.0f && uv_max <= 1.0f && origin.x - min_x <= pos_range && max_x - origin.x <= pos_range && origin.y - min_y <= pos_range && max_y - origin.y <= pos_range;
+}
+
+void ImDrawList::PackCompactVtx(ImDrawVertCompact* dst, const ImVec2& origin) const
+{
+    for (const ImDrawVert* vtx = VtxBuffer.Data, *vtx_end = VtxBuffer.Data + VtxBuffer.Size; vtx < vtx_end; vtx++, dst++)
+    {
+        dst->pos[0] = (ImS16)ImFloorSigned((vtx->pos.x - origin.x) * IM_DRAWVERT_COMPACT_POS_SCALE + 0.5f);
+        dst->pos[1] = (ImS16)ImFloorSigned((vtx->pos.y - origin.y) * IM_DRAWVERT_COMPACT_POS_SCALE + 0.5f);
+        dst->uv[0] = (ImU16)(vtx->uv.x * 65535.0f + 0.5f);
+        dst->uv[1] = (ImU16)(vtx->uv.y * 65535.0f + 0.5f);
+        dst->col = vtx->col;
+    }
+}
+
+void ImDrawList::PackIdx16(ImU16* dst) const
+{
+    IM_ASSERT(CanPackIdx16());
+    if (sizeof(ImDrawIdx) == 2)
+    {
+        memcpy(dst, IdxBuffer.Data, (size_t)IdxBuffer.Size * sizeof(ImU16));
+        return;
+    }
+    for (const ImDrawIdx* idx = IdxBuffer.Data, *idx_end = IdxBuffer.Data + IdxBuffer.Size; idx < idx_end; idx++, dst++)
+        *dst = (ImU16)*idx;
+}
+
 // On AddPolyline() and AddConvexPolyFilled() we intentionally avoid using ImVec2 and superfluous function calls to optimize debug/non-inlined builds.
 // - Those macros expects l-values and need to be used as their own statement.
 // - Those macros are intentionally not surrounded by the 'do {} while (0)' idiom because even that translates to runtime with debug compilers.
@@ -754,6 +886,83 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Normals of the line segments [i, i+1] into normals[i], the last segment of a closed line ends on points[0].
+// An open line copies the normal of its last segment on its last point so there is one normal per point.
+// - The SSE path does two segments per iteration with the same operations as the scalar one (ImRsqrt() is _mm_rsqrt_ss() there) so the output is identical.
+static void PolylineSegmentNormals(const ImVec2* points, const int points_count, bool closed, ImVec2* normals)
+{
+    const int count = closed ? points_count : points_count - 1;
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 negate_y = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    for (; i1 + 2 < points_count && i1 + 2 <= count; i1 += 2)
+    {
+        // Lanes are (x, y) of two segments
+        __m128 d = _mm_sub_ps(_mm_loadu_ps(&points[i1 + 1].x), _mm_loadu_ps(&points[i1].x));
+        __m128 d2 = _mm_mul_ps(d, d);
+        d2 = _mm_add_ps(d2, _mm_shuffle_ps(d2, d2, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128 over_zero = _mm_cmpgt_ps(d2, zero);
+        d = _mm_or_ps(_mm_and_ps(over_zero, _mm_mul_ps(d, _mm_rsqrt_ps(d2))), _mm_andnot_ps(over_zero, d));
+        _mm_storeu_ps(&normals[i1].x, _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)), negate_y)); // (dy, -dx)
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        normals[i1].x = dy;
+        normals[i1].y = -dx;
+    }
+    if (!closed)
+        normals[points_count - 1] = normals[points_count - 2];
+}
+
+// Offset direction at each point: the average of the normals of its two segments, scaled with IM_FIXNORMAL2F() so the line keeps its width on joints.
+// The first point of an open line has a single segment and uses its normal as is.
+static void PolylinePointNormals(const ImVec2* normals, const int points_count, bool closed, ImVec2* point_normals)
+{
+    if (closed)
+    {
+        float dm_x = (normals[points_count - 1].x + normals[0].x) * 0.5f;
+        float dm_y = (normals[points_count - 1].y + normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        point_normals[0].x = dm_x;
+        point_normals[0].y = dm_y;
+    }
+    else
+    {
+        point_normals[0] = normals[0];
+    }
+    int i = 1;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 min_d2 = _mm_set1_ps(0.000001f);
+    const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+    for (; i + 2 <= points_count; i += 2)
+    {
+        __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i - 1].x), _mm_loadu_ps(&normals[i].x)), half);
+        __m128 d2 = _mm_mul_ps(dm, dm);
+        d2 = _mm_add_ps(d2, _mm_shuffle_ps(d2, d2, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128 over_min = _mm_cmpgt_ps(d2, min_d2);
+        __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+        dm = _mm_or_ps(_mm_and_ps(over_min, _mm_mul_ps(dm, inv_len2)), _mm_andnot_ps(over_min, dm));
+        _mm_storeu_ps(&point_normals[i].x, dm);
+    }
+#endif
+    for (; i < points_count; i++)
+    {
+        float dm_x = (normals[i - 1].x + normals[i].x) * 0.5f;
+        float dm_y = (normals[i - 1].y + normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        point_normals[i].x = dm_x;
+        point_normals[i].y = dm_y;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -762,6 +971,16 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         return;
 
     const bool closed = (flags & ImDrawFlags_Closed) != 0;
+    if (points_count == 2 && !closed && (Flags & ImDrawListFlags_AnalyticShapes) && (Flags & ImDrawListFlags_AntiAliasedLines) && thickness >= 1.0f)
+    {
+        // Single segment (AddLine): a box as long as the segment and as wide as the line, rotated along it
+        const float dx = points[1].x - points[0].x;
+        const float dy = points[1].y - points[0].y;
+        const float length = ImSqrt(dx * dx + dy * dy);
+        if (length > 0.0f && _AddAnalyticShape(ImVec2((points[0].x + points[1].x) * 0.5f, (points[0].y + points[1].y) * 0.5f), ImVec2(length * 0.5f, thickness * 0.5f), 0.0f, ImDrawFlags_RoundCornersNone, 0.0f, col, ImVec2(dx / length, dy / length)))
+            return;
+    }
+
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
     const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
     const bool thick_line = (thickness > _FringeScale);
@@ -790,22 +1009,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 3 : 5) * sizeof(ImVec2)); //-V630
-        ImVec2* temp_points = temp_normals + points_count;
-
-        // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
-        if (!closed)
-            temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        // The first <points_count> items are normals of the line segments, then the averaged normals at each line point
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * 2 * sizeof(ImVec2)); //-V630
+        ImVec2* temp_point_normals = temp_normals + points_count;
+        PolylineSegmentNormals(points, points_count, closed, temp_normals);
+        PolylinePointNormals(temp_normals, points_count, closed, temp_point_normals);
 
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
         if (use_texture || !thick_line)
@@ -820,38 +1028,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Generate the indices to form a number of triangles for each line segment, the first point in a closed line is the end of the final one (as n+1 wraps)
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -868,11 +1049,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
                     _IdxWritePtr += 12;
                 }
-
                 idx1 = idx2;
             }
 
-            // Add vertexes for each point on the line
+            // Add vertexes for each point on the line, written straight from the point normals (dm_x, dm_y are offset to the outer edge of the AA area)
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
@@ -889,8 +1069,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
+                    const float dm_x = temp_point_normals[i].x * half_draw_size;
+                    const float dm_y = temp_point_normals[i].y * half_draw_size;
+                    _VtxWritePtr[0].pos.x = points[i].x + dm_x; _VtxWritePtr[0].pos.y = points[i].y + dm_y; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
+                    _VtxWritePtr[1].pos.x = points[i].x - dm_x; _VtxWritePtr[1].pos.y = points[i].y - dm_y; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
                     _VtxWritePtr += 2;
                 }
             }
@@ -899,9 +1081,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 // If we're not using a texture, we need the center vertex as well
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
+                    const float dm_x = temp_point_normals[i].x * half_draw_size;
+                    const float dm_y = temp_point_normals[i].y * half_draw_size;
+                    _VtxWritePtr[0].pos = points[i];                                                    _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
+                    _VtxWritePtr[1].pos.x = points[i].x + dm_x; _VtxWritePtr[1].pos.y = points[i].y + dm_y; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
+                    _VtxWritePtr[2].pos.x = points[i].x - dm_x; _VtxWritePtr[2].pos.y = points[i].y - dm_y; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
                     _VtxWritePtr += 3;
                 }
             }
@@ -911,50 +1095,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Generate the indices to form a number of triangles for each line segment, the first point in a closed line is the end of the final one (as n+1 wraps)
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
@@ -962,17 +1107,20 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
                 _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
                 _IdxWritePtr += 18;
-
                 idx1 = idx2;
             }
 
             // Add vertices
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
+                const float dm_out_x = temp_point_normals[i].x * (half_inner_thickness + AA_SIZE);
+                const float dm_out_y = temp_point_normals[i].y * (half_inner_thickness + AA_SIZE);
+                const float dm_in_x = temp_point_normals[i].x * half_inner_thickness;
+                const float dm_in_y = temp_point_normals[i].y * half_inner_thickness;
+                _VtxWritePtr[0].pos.x = points[i].x + dm_out_x; _VtxWritePtr[0].pos.y = points[i].y + dm_out_y; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
+                _VtxWritePtr[1].pos.x = points[i].x + dm_in_x;  _VtxWritePtr[1].pos.y = points[i].y + dm_in_y;  _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+                _VtxWritePtr[2].pos.x = points[i].x - dm_in_x;  _VtxWritePtr[2].pos.y = points[i].y - dm_in_y;  _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+                _VtxWritePtr[3].pos.x = points[i].x - dm_out_x; _VtxWritePtr[3].pos.y = points[i].y - dm_out_y; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
                 _VtxWritePtr += 4;
             }
         }
@@ -1038,29 +1186,16 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        // Compute normals, then the averaged normals at each vertex
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * 2 * sizeof(ImVec2)); //-V630
+        ImVec2* temp_point_normals = temp_normals + points_count;
+        PolylineSegmentNormals(points, points_count, true, temp_normals);
+        PolylinePointNormals(temp_normals, points_count, true, temp_point_normals);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            const float dm_x = temp_point_normals[i1].x * (AA_SIZE * 0.5f);
+            const float dm_y = temp_point_normals[i1].y * (AA_SIZE * 0.5f);
 
             // Add vertices
             _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
@@ -1392,11 +1527,18 @@ static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
     return flags;
 }
 
-void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+// Clamp rounding so opposite rounded corners don't overlap. 'flags' must have gone through FixRectCornerFlags().
+static inline float FixRectRounding(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
 {
-    flags = FixRectCornerFlags(flags);
     rounding = ImMin(rounding, ImFabs(b.x - a.x) * ( ((flags & ImDrawFlags_RoundCornersTop)  == ImDrawFlags_RoundCornersTop)  || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f ) - 1.0f);
     rounding = ImMin(rounding, ImFabs(b.y - a.y) * ( ((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight)  == ImDrawFlags_RoundCornersRight)  ? 0.5f : 1.0f ) - 1.0f);
+    return rounding;
+}
+
+void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+{
+    flags = FixRectCornerFlags(flags);
+    rounding = FixRectRounding(a, b, rounding, flags);
 
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
@@ -1433,6 +1575,13 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_AnalyticShapes) && (Flags & ImDrawListFlags_AntiAliasedLines) && thickness >= 1.0f)
+    {
+        const ImVec2 a = p_min + ImVec2(0.50f, 0.50f), b = p_max - ImVec2(0.50f, 0.50f);
+        flags = FixRectCornerFlags(flags);
+        if (_AddAnalyticShape((a + b) * 0.5f, ImVec2(ImFabs(b.x - a.x), ImFabs(b.y - a.y)) * 0.5f, FixRectRounding(a, b, rounding, flags), flags, thickness, col))
+            return;
+    }
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1451,6 +1600,12 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
     }
     else
     {
+        if ((Flags & ImDrawListFlags_AnalyticShapes) && (Flags & ImDrawListFlags_AntiAliasedFill))
+        {
+            ImDrawFlags fixed_flags = FixRectCornerFlags(flags);
+            if (_AddAnalyticShape((p_min + p_max) * 0.5f, ImVec2(ImFabs(p_max.x - p_min.x), ImFabs(p_max.y - p_min.y)) * 0.5f, FixRectRounding(p_min, p_max, rounding, fixed_flags), fixed_flags, 0.0f, col))
+                return;
+        }
         PathRect(p_min, p_max, rounding, flags);
         PathFillConvex(col);
     }
@@ -1523,6 +1678,10 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && (Flags & ImDrawListFlags_AnalyticShapes) && (Flags & ImDrawListFlags_AntiAliasedLines) && thickness >= 1.0f)
+        if (_AddAnalyticShape(center, ImVec2(radius - 0.5f, radius - 0.5f), radius - 0.5f, ImDrawFlags_RoundCornersAll, thickness, col))
+            return;
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1547,6 +1706,10 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments <= 0 && (Flags & ImDrawListFlags_AnalyticShapes) && (Flags & ImDrawListFlags_AntiAliasedFill))
+        if (_AddAnalyticShape(center, ImVec2(radius, radius), radius, ImDrawFlags_RoundCornersAll, 0.0f, col))
+            return;
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1889,6 +2052,74 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
     }
 }
 
+void ImDrawDataSnapshot::Capture(ImDrawData* src, bool move)
+{
+    IM_ASSERT(src != NULL && src != &DrawData);
+    while (Lists.Size < src->CmdListsCount)
+        Lists.push_back(IM_NEW(ImDrawList)(NULL));
+    CmdLists.resize(src->CmdListsCount);
+    for (int n = 0; n < src->CmdListsCount; n++)
+    {
+        ImDrawList* src_list = src->CmdLists[n];
+        ImDrawList* dst_list = Lists[n];
+        if (move)
+        {
+            dst_list->CmdBuffer.swap(src_list->CmdBuffer);
+            dst_list->IdxBuffer.swap(src_list->IdxBuffer);
+            dst_list->VtxBuffer.swap(src_list->VtxBuffer);
+            src_list->CmdBuffer.resize(0);
+            src_list->IdxBuffer.resize(0);
+            src_list->VtxBuffer.resize(0);
+            // Write pointers were into the buffers we took, leave an empty but valid list behind
+            src_list->CmdBuffer.push_back(ImDrawCmd());
+            src_list->_VtxCurrentIdx = 0;
+            src_list->_VtxWritePtr = NULL;
+            src_list->_IdxWritePtr = NULL;
+        }
+        else
+        {
+            // resize() + memcpy() rather than operator=, which would free the buffers we want to reuse
+            dst_list->CmdBuffer.resize(src_list->CmdBuffer.Size);
+            dst_list->IdxBuffer.resize(src_list->IdxBuffer.Size);
+            dst_list->VtxBuffer.resize(src_list->VtxBuffer.Size);
+            if (src_list->CmdBuffer.Size > 0)
+                memcpy(dst_list->CmdBuffer.Data, src_list->CmdBuffer.Data, (size_t)src_list->CmdBuffer.size_in_bytes());
+            if (src_list->IdxBuffer.Size > 0)
+                memcpy(dst_list->IdxBuffer.Data, src_list->IdxBuffer.Data, (size_t)src_list->IdxBuffer.size_in_bytes());
+            if (src_list->VtxBuffer.Size > 0)
+                memcpy(dst_list->VtxBuffer.Data, src_list->VtxBuffer.Data, (size_t)src_list->VtxBuffer.size_in_bytes());
+        }
+        dst_list->Flags = src_list->Flags;
+        dst_list->_OwnerName = src_list->_OwnerName;
+        CmdLists[n] = dst_list;
+    }
+    DamageRects.resize(src->DamageRectsCount);
+    if (src->DamageRectsCount > 0)
+        memcpy(DamageRects.Data, src->DamageRects, (size_t)DamageRects.size_in_bytes());
+
+    DrawData = *src;
+    DrawData.CmdLists = CmdLists.Data;
+    DrawData.DamageRects = DamageRects.Data;
+    // Only the main thread captures, the render thread reads Serial from the snapshot it was given
+    Serial = GetRenderSerial();
+}
+
+void ImDrawDataSnapshot::Clear()
+{
+    for (int n = 0; n < Lists.Size; n++)
+        IM_DELETE(Lists[n]);
+    Lists.clear();
+    CmdLists.clear();
+    DamageRects.clear();
+    DrawData.Clear();
+    Serial = 0;
+}
+
+ImU64 ImDrawDataSnapshot::GetRenderSerial()
+{
+    return GImGui ? GImGui->RenderSerial : 0;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
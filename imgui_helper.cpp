@@ -150,6 +150,7 @@ struct ImTexture
     int     Width     = 0;
     int     Height    = 0;
     double  TimeStamp = NAN;
+    ImGui::ImMat Source[2];     // gpu mats of the last two updates, alive until their copy fence is waited
 };
 #elif IMGUI_RENDERING_DX11
 #include <imgui_impl_dx11.h>
@@ -177,6 +178,16 @@ struct ImTexture
     int    Height    = 0;
     double  TimeStamp = NAN;
 };
+#elif IMGUI_SOFT_RENDERER
+// no GPU backend, textures are the ImMat of imgui_impl_soft
+#include <imgui_impl_soft.h>
+struct ImTexture
+{
+    ImTextureID TextureID = nullptr;
+    int    Width     = 0;
+    int    Height    = 0;
+    double  TimeStamp = NAN;
+};
 #else
 struct ImTexture
 {
@@ -289,6 +300,9 @@ void ImGenerateOrUpdateTexture(ImTextureID& imtexid,int width,int height,int cha
 {
     IM_ASSERT(pixels);
     IM_ASSERT(channels>0 && channels<=4);
+    // Draw lists using the texture don't change when only its pixels do
+    if (imtexid && ImGui::GetCurrentContext())
+        ImGui::AddDamageTexture(imtexid);
 #if IMGUI_RENDERING_VULKAN
     if (imtexid == 0)
     {
@@ -566,6 +580,16 @@ ImTextureID ImCreateTexture(const void* data, int width, int height, double time
     texture.TimeStamp = time_stamp;
     g_tex_mutex.unlock();
     return reinterpret_cast<ImTextureID>(static_cast<intptr_t>(texture.TextureID));
+#elif IMGUI_SOFT_RENDERER
+    g_tex_mutex.lock();
+    g_Textures.resize(g_Textures.size() + 1);
+    ImTexture& texture = g_Textures.back();
+    texture.TextureID = ImGui_ImplSoft_CreateTexture(data, width, height);
+    texture.Width  = width;
+    texture.Height = height;
+    texture.TimeStamp = time_stamp;
+    g_tex_mutex.unlock();
+    return texture.TextureID;
 #else
     return nullptr;
 #endif
@@ -581,6 +605,8 @@ static std::vector<ImTexture>::iterator ImFindTexture(ImTextureID texture)
     auto textureID = reinterpret_cast<LPDIRECT3DTEXTURE9>(texture);
 #elif IMGUI_OPENGL
     auto textureID = static_cast<GLuint>(reinterpret_cast<intptr_t>(texture));
+#elif IMGUI_SOFT_RENDERER
+    auto textureID = texture;
 #else
     int textureID = -1;
 #endif
@@ -590,44 +616,86 @@ static std::vector<ImTexture>::iterator ImFindTexture(ImTextureID texture)
     });
 }
 
-void ImDestroyTexture(ImTextureID texture)
+static void ImReleaseTexture(ImTexture& texture)
 {
-    g_tex_mutex.lock();
-    auto textureIt = ImFindTexture(texture);
-    if (textureIt == g_Textures.end())
-    {
-        g_tex_mutex.unlock();
-        return;
-    }
 #if IMGUI_RENDERING_VULKAN
-    if (textureIt->TextureID)
+    if (texture.TextureID)
     {
-        ImGui_ImplVulkan_DestroyTexture(&textureIt->TextureID);
-        textureIt->TextureID = nullptr;
+        ImGui_ImplVulkan_DestroyTexture(&texture.TextureID);
+        texture.TextureID = nullptr;
     }
 #elif IMGUI_RENDERING_DX11
-    if (textureIt->TextureID)
+    if (texture.TextureID)
     {
-        textureIt->TextureID->Release();
-        textureIt->TextureID = nullptr;
+        texture.TextureID->Release();
+        texture.TextureID = nullptr;
     }
 #elif IMGUI_RENDERING_DX9
-    if (textureIt->TextureID)
+    if (texture.TextureID)
     {
-        textureIt->TextureID->Release();
-        textureIt->TextureID = nullptr;
+        texture.TextureID->Release();
+        texture.TextureID = nullptr;
     }
 #elif IMGUI_OPENGL
-    if (textureIt->TextureID)
+    if (texture.TextureID)
+    {
+        glDeleteTextures(1, &texture.TextureID);
+        texture.TextureID = 0;
+    }
+#elif IMGUI_SOFT_RENDERER
+    if (texture.TextureID)
     {
-        glDeleteTextures(1, &textureIt->TextureID);
-        textureIt->TextureID = 0;
+        ImGui_ImplSoft_DestroyTexture(texture.TextureID);
+        texture.TextureID = nullptr;
     }
 #endif
+}
+
+// Retired textures with the render serial after which no draw data can reference them
+static bool g_TextureRetiring = false;
+static std::vector<std::pair<ImU64, ImTexture>> g_RetiredTextures;
+
+void ImDestroyTexture(ImTextureID texture)
+{
+    g_tex_mutex.lock();
+    auto textureIt = ImFindTexture(texture);
+    if (textureIt == g_Textures.end())
+    {
+        g_tex_mutex.unlock();
+        return;
+    }
+    // The frame being built may already use it, the snapshots of all its viewports carry the next render serial
+    if (g_TextureRetiring)
+        g_RetiredTextures.push_back(std::make_pair(ImDrawDataSnapshot::GetRenderSerial() + 1, std::move(*textureIt)));
+    else
+        ImReleaseTexture(*textureIt);
     g_Textures.erase(textureIt);
     g_tex_mutex.unlock();
 }
 
+void ImSetTextureRetiring(bool enable)
+{
+    g_tex_mutex.lock();
+    g_TextureRetiring = enable;
+    g_tex_mutex.unlock();
+    if (!enable)
+        ImReleaseRetiredTextures(UINT64_MAX);
+}
+
+void ImReleaseRetiredTextures(ImU64 completed_serial)
+{
+    g_tex_mutex.lock();
+    auto it = std::remove_if(g_RetiredTextures.begin(), g_RetiredTextures.end(), [completed_serial](std::pair<ImU64, ImTexture>& retired)
+    {
+        if (retired.first > completed_serial)
+            return false;
+        ImReleaseTexture(retired.second);
+        return true;
+    });
+    g_RetiredTextures.erase(it, g_RetiredTextures.end());
+    g_tex_mutex.unlock();
+}
+
 int ImGetTextureWidth(ImTextureID texture)
 {
     auto textureIt = ImFindTexture(texture);
@@ -680,6 +748,53 @@ bool ImTextureToFile(ImTextureID texture, std::string path)
     return false;
 }
 
+#if IMGUI_VULKAN_SHADER && IMGUI_RENDERING_VULKAN
+// Zero-copy update: the back image of the texture is wrapped as a 2D RGBA8 VkImageMat and the store pass
+// writes the mat straight into it, no buffer to image copy. Acquire, store and present are chained by
+// semaphores, none of them waits on the host. False when the texture can't take it in place.
+static bool ImStoreTexture(const ImGui::VkMat& vkmat, ImTextureID texture)
+{
+    g_tex_mutex.lock();
+    auto textureIt = ImFindTexture(texture);
+    bool same_size = textureIt != g_Textures.end() && textureIt->Width == vkmat.w && textureIt->Height == vkmat.h;
+    g_tex_mutex.unlock();
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkSemaphore acquired = VK_NULL_HANDLE;
+    VkSemaphore written = VK_NULL_HANDLE;
+    uint32_t queue_family = VK_QUEUE_FAMILY_IGNORED;
+    if (!same_size || !ImGui_ImplVulkan_AcquireTextureImage(texture, &image, &view, &acquired, &written, &queue_family))
+        return false;
+    // owned by the backend, the refcount keeps the command from destroying it. contents are discarded,
+    // the first barrier of the store chains with the acquire wait at the compute stage
+    ImGui::VkImageMemory memory = {};
+    memory.image = image;
+    memory.imageview = view;
+    memory.width = vkmat.w;
+    memory.height = vkmat.h;
+    memory.depth = 1;
+    memory.format = VK_FORMAT_R8G8B8A8_UNORM;
+    memory.access_flags = 0;
+    memory.image_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    memory.stage_flags = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    memory.refcount = 1;
+    ImGui::VkImageMat image_mat(vkmat.w, vkmat.h, &memory, 4u, 4, nullptr);
+    image_mat.elempack = 4;
+    image_mat.type = IM_DT_INT8;
+    image_mat.color_format = IM_CF_ABGR;
+    if (!ImGui::ImVulkanVkMatToTexture(vkmat, image_mat, acquired, written, queue_family))
+    {
+        ImGui_ImplVulkan_CancelTextureImage(texture);
+        return false;
+    }
+    const ImGui::VulkanDevice* vkdev = ((const ImGui::VkAllocator*)vkmat.allocator)->vkdev;
+    ImGui_ImplVulkan_PresentTextureImage(texture, vkdev->info.compute_queue_family_index());
+    if (ImGui::GetCurrentContext())
+        ImGui::AddDamageTexture(texture);
+    return true;
+}
+#endif
+
 void ImMatToTexture(ImGui::ImMat mat, ImTextureID& texture)
 {
     if (mat.empty())
@@ -693,7 +808,18 @@ void ImMatToTexture(ImGui::ImMat mat, ImTextureID& texture)
     {
         ImGui::VkMat vkmat = mat;
 #if IMGUI_RENDERING_VULKAN
+        if (texture && ImStoreTexture(vkmat, texture))
+            return;
+        // update doesn't wait the copy, keep the buffer until the same back image is filled again
         ImGui::ImGenerateOrUpdateTexture(texture, vkmat.w, vkmat.h, vkmat.c, vkmat.buffer_offset(), (const unsigned char *)vkmat.buffer());
+        g_tex_mutex.lock();
+        auto textureIt = ImFindTexture(texture);
+        if (textureIt != g_Textures.end())
+        {
+            textureIt->Source[1] = textureIt->Source[0];
+            textureIt->Source[0] = mat;
+        }
+        g_tex_mutex.unlock();
 #else
         ImGui::ImMat cpu_mat;
         ImGui::ImVulkanVkMatToImMat(vkmat, cpu_mat);
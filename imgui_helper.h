@@ -25,6 +25,10 @@ IMGUI_API inline void ImGenerateOrUpdateTexture(ImTextureID& imtexid,int width,i
 IMGUI_API ImTextureID ImCreateTexture(const void* data, int width, int height, double time_stamp = NAN);
 IMGUI_API ImTextureID ImLoadTexture(const char* path);
 IMGUI_API void ImDestroyTexture(ImTextureID texture);
+// Render thread drawing ImDrawDataSnapshot: while retiring is on, ImDestroyTexture() keeps the texture alive until the render
+// thread is done with every snapshot of the frame after the last Render(). Off releases every retired texture, turn it off once the render thread is stopped.
+IMGUI_API void ImSetTextureRetiring(bool enable);
+IMGUI_API void ImReleaseRetiredTextures(ImU64 completed_serial); // call from the thread owning the rendering API with the Serial of the last frame it finished, i.e. once the snapshots of all viewports sharing that Serial are drawn
 IMGUI_API int ImGetTextureWidth(ImTextureID texture);
 IMGUI_API int ImGetTextureHeight(ImTextureID texture);
 IMGUI_API double ImGetTextureTimeStamp(ImTextureID texture);
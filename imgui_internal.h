@@ -1681,6 +1681,14 @@ struct ImGuiDockContext
 // [SECTION] Viewport support
 //-----------------------------------------------------------------------------
 
+// Draw list as rendered by the previous Render(), kept by each viewport when io.ConfigDamageTracking is set
+struct ImGuiDrawListDamage
+{
+    const ImDrawList*   DrawList;
+    ImU64               Hash;                   // Hash of the commands, indices and vertices
+    ImRect              Bounds;                 // Bounding box of the vertices, clipped by the command clip rects
+};
+
 // ImGuiViewport Private/Internals fields (cardinal sin: we are using inheritance!)
 // Every instance of ImGuiViewport is in fact a ImGuiViewportP.
 struct ImGuiViewportP : public ImGuiViewport
@@ -1706,9 +1714,16 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              WorkOffsetMax;          // Work Area: Offset from Pos+Size to bottom-right corner of Work Area. Generally (0,0) or (0,-status_bar_height).
     ImVec2              BuildWorkOffsetMin;     // Work Area: Offset being built during current frame. Generally >= 0.0f.
     ImVec2              BuildWorkOffsetMax;     // Work Area: Offset being built during current frame. Generally <= 0.0f.
-
-    ImGuiViewportP()                    { Idx = -1; LastFrameActive = DrawListsLastFrame[0] = DrawListsLastFrame[1] = LastFrontMostStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; PlatformMonitor = -1; PlatformWindowCreated = false; Window = NULL; DrawLists[0] = DrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); }
-    ~ImGuiViewportP()                   { if (DrawLists[0]) IM_DELETE(DrawLists[0]); if (DrawLists[1]) IM_DELETE(DrawLists[1]); }
+    ImVector<ImGuiDrawListDamage> DamageDrawLists;     // Damage tracking: draw lists of the previous Render(), diffed against the current ones
+    ImVector<ImGuiDrawListDamage> DamageDrawListsNext; // Damage tracking: draw lists of the current Render(), swapped with DamageDrawLists once diffed
+    ImVector<ImVec4>    DamageRects;            // Damage tracking: storage for DrawDataP.DamageRects
+    ImVec4              DamageLastDisplayRect;  // Damage tracking: DisplayPos/DisplaySize of the previous Render(), any change damages the whole viewport
+    ImVec2              DamageLastFramebufferScale;
+    ImDrawList*         BatchDrawList;          // Draw call batching: every draw list of DrawDataP merged into one (io.ConfigDrawCallBatching)
+    ImVector<int>       BatchVtxRemap;          // Draw call batching: scratch buffer to gather the vertices of a command
+
+    ImGuiViewportP()                    { Idx = -1; LastFrameActive = DrawListsLastFrame[0] = DrawListsLastFrame[1] = LastFrontMostStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; PlatformMonitor = -1; PlatformWindowCreated = false; Window = NULL; DrawLists[0] = DrawLists[1] = BatchDrawList = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); DamageLastDisplayRect = ImVec4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX); DamageLastFramebufferScale = ImVec2(0.0f, 0.0f); }
+    ~ImGuiViewportP()                   { if (DrawLists[0]) IM_DELETE(DrawLists[0]); if (DrawLists[1]) IM_DELETE(DrawLists[1]); if (BatchDrawList) IM_DELETE(BatchDrawList); }
     void    ClearRequestFlags()         { PlatformRequestClose = PlatformRequestMove = PlatformRequestResize = false; }
 
     // Calculate work rect pos/size given a set of offset (we have 1 pair of offset for rect locked from last frame data, and 1 pair for currently building rect)
@@ -1869,6 +1884,7 @@ struct ImGuiContext
     int                     FrameCountEnded;
     int                     FrameCountPlatformEnded;
     int                     FrameCountRendered;
+    ImU64                   RenderSerial;                       // Bumped by the first Render() of each frame, see ImDrawDataSnapshot::Serial
     bool                    WithinFrameScope;                   // Set by NewFrame(), cleared by EndFrame()
     bool                    WithinFrameScopeWithImplicitWindow; // Set by NewFrame(), cleared by EndFrame() when the implicit debug window has been pushed
     bool                    WithinEndChild;                     // Set within EndChild()
@@ -2022,6 +2038,14 @@ struct ImGuiContext
     // Render
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImGuiMouseCursor        MouseCursor;
+    ImVector<ImRect>        DamageRects;                        // Submitted with AddDamageRect(), merged into the viewports damage at the next Render()
+    ImVector<ImTextureID>   DamageTextures;                     // Submitted with AddDamageTexture(), every command using them is damaged at the next Render()
+    int                     CachedContentReused;                // Number of BeginCachedContent() blocks replayed from their cache this frame
+    int                     CachedContentSubmitted;             // Number of BeginCachedContent() blocks submitted this frame
+    ImU64                   CachedContentReusedTotal;
+    ImU64                   CachedContentSubmittedTotal;
+    int                     DrawCallsBeforeBatching;            // Draw commands of every viewport before/after the io.ConfigDrawCallBatching pass of the last Render()
+    int                     DrawCallsAfterBatching;
 
     // Drag and Drop
     bool                    DragDropActive;
@@ -2148,6 +2172,7 @@ struct ImGuiContext
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountPlatformEnded = FrameCountRendered = -1;
+        RenderSerial = 0;
         WithinFrameScope = WithinFrameScopeWithImplicitWindow = WithinEndChild = false;
         GcCompactAll = false;
         TestEngineHookItems = false;
@@ -2236,6 +2261,9 @@ struct ImGuiContext
 
         DimBgRatio = 0.0f;
         MouseCursor = ImGuiMouseCursor_Arrow;
+        CachedContentReused = CachedContentSubmitted = 0;
+        CachedContentReusedTotal = CachedContentSubmittedTotal = 0;
+        DrawCallsBeforeBatching = DrawCallsAfterBatching = 0;
 
         DragDropActive = DragDropWithinSource = DragDropWithinTarget = false;
         DragDropSourceFlags = ImGuiDragDropFlags_None;
@@ -2362,6 +2390,57 @@ struct IMGUI_API ImGuiWindowTempData
     ImVector<float>         TextWrapPosStack;       // Store text wrap pos to restore (attention: .back() is not == TextWrapPos)
 };
 
+// Draw commands of a BeginCachedContent()/EndCachedContent() block, with indices relative to the command's own vertices
+struct ImGuiWindowContentCacheCmd
+{
+    ImVec4                  ClipRect;
+    ImTextureID             TextureId;
+    int                     VtxOffset, VtxCount;                // Into ImGuiWindowContentCache::VtxBuffer
+    int                     IdxOffset, IdxCount;                // Into ImGuiWindowContentCache::IdxBuffer
+};
+
+// Retained output of a BeginCachedContent()/EndCachedContent() block, replayed as long as Version and StateHash don't change
+struct IMGUI_API ImGuiWindowContentCache
+{
+    bool                    Valid;                              // Buffers and layout below hold the output of a complete block
+    bool                    Recording;                          // Between BeginCachedContent() returning true and EndCachedContent()
+    bool                    HadHoveredItem;                     // An item of the block was hovered: it may run hover timers (tooltips), don't reuse while the window is hovered
+    int                     LastFrame;
+    ImU64                   Version;                            // User version passed to BeginCachedContent()
+    ImGuiID                 StateHash;                          // Hash of the window/style/input state the block was drawn with
+
+    // Recording markers
+    int                     RecordIdxStart;
+    int                     RecordCmdCount;
+    int                     RecordChildWindows;
+    int                     RecordWindowsActive;
+    int                     RecordSplitterCount;
+    ImGuiID                 RecordHoveredId;
+    bool                    RecordNavIdIsAlive;
+    ImVec2                  RecordCursorMaxPos;                 // Backup of DC.CursorMaxPos/IdealMaxPos, reset while recording so the block measures its own extent
+    ImVec2                  RecordIdealMaxPos;
+
+    // Draw output
+    ImVector<ImDrawVert>    VtxBuffer;
+    ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImGuiWindowContentCacheCmd> Cmds;
+
+    // Layout and item state at the end of the block
+    ImVec2                  CursorPos, CursorPosPrevLine, CursorMaxPos, IdealMaxPos;
+    ImVec2                  CurrLineSize, PrevLineSize;
+    float                   CurrLineTextBaseOffset, PrevLineTextBaseOffset;
+    bool                    IsSameLine;
+    short                   NavLayersActiveMaskNext;
+    bool                    NavIdIsAlive;                       // The block made g.NavIdIsAlive true
+    ImGuiLastItemData       LastItemData;
+
+    // Statistics
+    int                     ReuseCount;
+    int                     SubmitCount;
+
+    ImGuiWindowContentCache() { Valid = Recording = HadHoveredItem = false; LastFrame = -1; Version = 0; StateHash = 0; ReuseCount = SubmitCount = 0; }
+};
+
 // Storage for one window
 struct IMGUI_API ImGuiWindow
 {
@@ -2468,6 +2547,7 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
+    ImGuiWindowContentCache* ContentCache;                      // Allocated by the first BeginCachedContent() in this window
 
     // Docking
     bool                    DockIsActive        :1;             // When docking artifacts are actually visible. When this is set, DockNode is guaranteed to be != NULL. ~~ (DockNode != NULL) && (DockNode->Windows.Size > 1).
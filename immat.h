@@ -301,6 +301,8 @@ enum ImInterpolateMode {
     IM_INTERPOLATE_AREA,
     IM_INTERPOLATE_TRILINEAR,
     IM_INTERPOLATE_TETRAHEDRAL,
+    IM_INTERPOLATE_LANCZOS,         // separable lanczos3, two 1D passes
+    IM_INTERPOLATE_PYRAMID,         // multi-step 2x area downscale, then area to target size
     IM_NB_INTERP_MODE
 };
 
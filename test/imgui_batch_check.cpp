@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <imgui_impl_soft.h>
+#include <immat.h>
+
+using namespace std;
+
+// Headless check of io.ConfigDrawCallBatching: the demo window with its sections open and a stack of small
+// overlapping windows are rendered with batching off and on through imgui_impl_soft, with the same scripted
+// mouse. Batching only changes how the draw commands are grouped, so the two images must be the same; the
+// process exits with 1 when any pixel differs, and reports the draw call counts of both.
+// usage: imgui_batch_check [frames] [width height]
+
+struct RunStat
+{
+    int draw_cmds       {0};
+    int draw_lists      {0};
+    vector<ImU32> pixels;
+};
+
+// same as imgui_frame_bench: write the open state of the demo headers before the first ShowDemoWindow
+static void open_headers(const char* window, ImGuiWindowFlags flags, const vector<const char*>& labels)
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin(window, nullptr, flags);
+    for (auto label : labels)
+        ImGui::GetStateStorage()->SetInt(ImGui::GetID(label), 1);
+    ImGui::End();
+}
+
+static void draw_ui(int index)
+{
+    static const vector<const char*> headers = { "Help", "Configuration", "Window options", "Widgets", "Layout & Scrolling",
+                                                 "Popups & Modal windows", "Tables & Columns" };
+    if (index == 0)
+        open_headers("Dear ImGui Demo", ImGuiWindowFlags_MenuBar, headers);
+    ImGui::ShowDemoWindow();
+
+    // overlapping windows with text and rects, most of their commands can be joined across windows
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    for (int i = 0; i < 24; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "Window %d", i);
+        ImGui::SetNextWindowPos(ImVec2(display.x * 0.55f + (i % 6) * 60.f, 40.f + (i / 6) * 110.f + (i % 6) * 12.f), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(180, 120), ImGuiCond_Always);
+        ImGui::Begin(name);
+        ImGui::Text("window %d", i);
+        ImGui::Button("Button");
+        ImGui::ProgressBar((i % 10) / 10.f);
+        ImGui::End();
+    }
+}
+
+static RunStat run(bool batching, int frames, int width, int height)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = 1.f / 60.f;
+    io.ConfigDrawCallBatching = batching;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    ImGui_ImplSoft_Init();
+
+    RunStat stat;
+    ImGui::ImMat frame_mat;
+    for (int i = 0; i < frames; i++)
+    {
+        float t = i / 60.f;
+        io.AddMousePosEvent(width * (0.5f + 0.45f * sinf(t * 1.3f)), height * (0.5f + 0.45f * sinf(t * 0.7f)));
+        ImGui_ImplSoft_NewFrame();
+        ImGui::NewFrame();
+        draw_ui(i);
+        ImGui::Render();
+        ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), frame_mat, true, IM_COL32(114, 140, 153, 255));
+    }
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    stat.draw_lists = draw_data->CmdListsCount;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        stat.draw_cmds += draw_data->CmdLists[n]->CmdBuffer.Size;
+    const ImU32* pixels = (const ImU32*)frame_mat.data;
+    stat.pixels.assign(pixels, pixels + (size_t)frame_mat.w * frame_mat.h);
+    ImGui_ImplSoft_Shutdown();
+    ImGui::DestroyContext();
+    return stat;
+}
+
+int main(int argc, char* argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 30;
+    int width = argc > 3 ? atoi(argv[2]) : 1280;
+    int height = argc > 3 ? atoi(argv[3]) : 720;
+    if (frames <= 0 || width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [frames] [width height]" << endl;
+        return -1;
+    }
+
+    RunStat unbatched = run(false, frames, width, height);
+    RunStat batched = run(true, frames, width, height);
+
+    int max_diff = 0;
+    size_t differing = 0;
+    const bool same_size = unbatched.pixels.size() == batched.pixels.size();
+    for (size_t i = 0; same_size && i < unbatched.pixels.size(); i++)
+    {
+        int diff = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            diff = std::max(diff, abs((int)((unbatched.pixels[i] >> shift) & 0xFF) - (int)((batched.pixels[i] >> shift) & 0xFF)));
+        max_diff = std::max(max_diff, diff);
+        differing += diff > 0;
+    }
+    const bool matching = same_size && !unbatched.pixels.empty() && differing == 0;
+
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+    json += "  \"frames\": " + to_string(frames) + ",\n";
+    json += "  \"width\": " + to_string(width) + ",\n";
+    json += "  \"height\": " + to_string(height) + ",\n";
+    json += "  \"unbatched\": { \"draw_lists\": " + to_string(unbatched.draw_lists) + ", \"draw_cmds\": " + to_string(unbatched.draw_cmds) + " },\n";
+    json += "  \"batched\": { \"draw_lists\": " + to_string(batched.draw_lists) + ", \"draw_cmds\": " + to_string(batched.draw_cmds) + " },\n";
+    json += "  \"differing_pixels\": " + to_string(differing) + ",\n";
+    json += "  \"max_pixel_diff\": " + to_string(max_diff) + ",\n";
+    json += "  \"matching\": " + string(matching ? "true" : "false") + "\n";
+    json += "}\n";
+    cout << json;
+    return matching ? 0 : 1;
+}
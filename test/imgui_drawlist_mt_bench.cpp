@@ -0,0 +1,196 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <thread>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_helper.h>
+
+using namespace std;
+
+// Headless benchmark of detached draw lists: a window shows strips of waveform, each strip is a polyline
+// through every sample with a marker every 256 samples and a label. The strips are split in contiguous
+// chunks, every worker thread fills one detached draw list with its chunk in local coordinates and the UI
+// thread splices them back in order with ImDrawList::AddDrawList(), so the window output must be the
+// same whatever the thread count. Workers are started for every frame, their startup is part of fill_ms.
+// The process exits with 1 when the output differs between thread counts.
+// usage: imgui_drawlist_mt_bench [samples] [strips] [frames] [max_threads]
+
+static const float strip_height = 48.f;
+static const float strip_width = 1800.f;
+
+static float sample_value(int strip, int index)
+{
+    float t = index * 0.0007f;
+    return sinf(t * (3.f + strip * 0.37f)) * 0.6f + sinf(t * 41.f + strip) * 0.25f + sinf(t * 313.f) * 0.1f;
+}
+
+static void draw_strips(ImDrawList* draw_list, int strip_begin, int strip_end, int samples)
+{
+    char label[32];
+    for (int strip = strip_begin; strip < strip_end; strip++)
+    {
+        ImVec2 origin(0, strip * strip_height);
+        ImU32 color = ImColor::HSV((strip % 16) / 16.f, 0.6f, 1.f);
+        draw_list->AddRectFilled(origin, ImVec2(origin.x + strip_width, origin.y + strip_height - 2), IM_COL32(32, 32, 40, 255));
+        // stroked in pieces so a single primitive stays below 64K vertices with 16-bit indices
+        for (int begin = 0; begin < samples - 1; begin += 4096)
+        {
+            int end = std::min(begin + 4096, samples - 1);
+            draw_list->PathClear();
+            for (int i = begin; i <= end; i++)
+                draw_list->PathLineTo(ImVec2(origin.x + strip_width * i / samples, origin.y + strip_height * (0.5f - 0.45f * sample_value(strip, i))));
+            draw_list->PathStroke(color, 0, 1.5f);
+        }
+        for (int i = 0; i < samples; i += 256)
+            draw_list->AddCircleFilled(ImVec2(origin.x + strip_width * i / samples, origin.y + strip_height * (0.5f - 0.45f * sample_value(strip, i))), 2.5f, color, 8);
+        snprintf(label, sizeof(label), "strip %d", strip);
+        draw_list->AddText(ImVec2(origin.x + 4, origin.y + 2), IM_COL32_WHITE, label);
+    }
+}
+
+struct RunStat
+{
+    int threads         {0};
+    double fill_ms      {0};
+    double splice_ms    {0};
+    double frame_ms     {0};
+    int vertices        {0};
+    int indices         {0};
+    ImU32 checksum      {0};
+};
+
+static string json_number(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", value);
+    return buf;
+}
+
+static RunStat run(int threads, int samples, int strips, int frames)
+{
+    const int warmup = std::min(frames, 3);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+
+    RunStat stat;
+    stat.threads = threads;
+    vector<ImDrawList*> lists;
+    for (int i = 0; i < warmup + frames; i++)
+    {
+        double frame_start = ImGui::get_current_time();
+        ImGui::NewFrame();
+        if (lists.empty())
+            for (int t = 0; t < threads; t++)
+                lists.push_back(ImGui::CreateDetachedDrawList());
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Waveforms", nullptr, ImGuiWindowFlags_NoDecoration);
+        ImDrawList* window_list = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+
+        // shared data copies are refreshed on the UI thread, the workers only touch their own list
+        for (auto list : lists)
+            ImGui::ResetDetachedDrawList(list);
+        double fill_start = ImGui::get_current_time();
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++)
+        {
+            int strip_begin = strips * t / threads;
+            int strip_end = strips * (t + 1) / threads;
+            workers.emplace_back(draw_strips, lists[t], strip_begin, strip_end, samples);
+        }
+        for (auto& worker : workers)
+            worker.join();
+        double fill_time = ImGui::get_current_time() - fill_start;
+
+        double splice_start = ImGui::get_current_time();
+        int vtx_start = window_list->VtxBuffer.Size;
+        int idx_start = window_list->IdxBuffer.Size;
+        for (auto list : lists)
+            window_list->AddDrawList(list, origin);
+        double splice_time = ImGui::get_current_time() - splice_start;
+
+        ImU32 checksum = ImHashData(window_list->VtxBuffer.Data + vtx_start, (window_list->VtxBuffer.Size - vtx_start) * sizeof(ImDrawVert));
+        ImGui::Dummy(ImVec2(strip_width, strip_height * strips));
+        ImGui::End();
+        ImGui::Render();
+        double frame_time = ImGui::get_current_time() - frame_start;
+        if (i < warmup)
+            continue;
+        stat.fill_ms += fill_time * 1000.0 / frames;
+        stat.splice_ms += splice_time * 1000.0 / frames;
+        stat.frame_ms += frame_time * 1000.0 / frames;
+        stat.vertices = window_list->VtxBuffer.Size - vtx_start;
+        stat.indices = window_list->IdxBuffer.Size - idx_start;
+        stat.checksum = checksum;
+    }
+    for (auto list : lists)
+        ImGui::DestroyDetachedDrawList(list);
+    ImGui::DestroyContext();
+    return stat;
+}
+
+int main(int argc, char* argv[])
+{
+    int samples = argc > 1 ? atoi(argv[1]) : 100000;
+    int strips = argc > 2 ? atoi(argv[2]) : 20;
+    int frames = argc > 3 ? atoi(argv[3]) : 20;
+    int max_threads = argc > 4 ? atoi(argv[4]) : (int)std::max(std::thread::hardware_concurrency(), 1u);
+    if (samples <= 0 || strips <= 0 || frames <= 0 || max_threads <= 0)
+    {
+        cout << "usage: " << argv[0] << " [samples] [strips] [frames] [max_threads]" << endl;
+        return -1;
+    }
+
+    vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2)
+        thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    vector<RunStat> stats;
+    for (int threads : thread_counts)
+        stats.push_back(run(std::min(threads, strips), samples, strips, frames));
+
+    bool identical = true;
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+    json += "  \"samples\": " + to_string(samples) + ",\n";
+    json += "  \"strips\": " + to_string(strips) + ",\n";
+    json += "  \"frames\": " + to_string(frames) + ",\n";
+    json += "  \"runs\": [\n";
+    for (size_t i = 0; i < stats.size(); i++)
+    {
+        const RunStat& stat = stats[i];
+        char checksum[16];
+        snprintf(checksum, sizeof(checksum), "%08x", stat.checksum);
+        identical &= stat.checksum == stats[0].checksum && stat.vertices == stats[0].vertices;
+        json += "    { \"threads\": " + to_string(stat.threads) +
+                ", \"fill_ms\": " + json_number(stat.fill_ms) +
+                ", \"splice_ms\": " + json_number(stat.splice_ms) +
+                ", \"frame_ms\": " + json_number(stat.frame_ms) +
+                ", \"fill_speedup\": " + json_number(stats[0].fill_ms / std::max(stat.fill_ms, 1e-9)) +
+                ", \"vertices\": " + to_string(stat.vertices) +
+                ", \"indices\": " + to_string(stat.indices) +
+                ", \"checksum\": \"" + checksum + "\" }" + (i + 1 < stats.size() ? ",\n" : "\n");
+    }
+    json += "  ],\n";
+    json += "  \"identical_output\": " + string(identical ? "true" : "false") + "\n";
+    json += "}\n";
+    cout << json;
+    return identical ? 0 : 1;
+}
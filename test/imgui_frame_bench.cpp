@@ -0,0 +1,421 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <implot.h>
+#include <imgui_node_editor.h>
+#include <imgui_impl_soft.h>
+#include <immat.h>
+
+using namespace std;
+namespace ed = ax::NodeEditor;
+
+// Headless frame benchmark, no platform or renderer backend: the font atlas is built on the CPU and the
+// draw data of every frame is dropped after Render. Each workload gets a fresh context and a scripted
+// mouse so hover, scroll and clipping paths run the same way on every run.
+// With soft every frame is also rasterized by imgui_impl_soft and its time reported as raster_ms, png_dir
+// keeps the last frame of each workload as <name>.png for screenshot diffs.
+// usage: imgui_frame_bench [all|demo|table|windows|implot|node] [frames] [width height] [soft [png_dir]]
+
+// counts every MemAlloc made while a context is current, allocations per frame show up as churn
+static size_t g_alloc_count = 0;
+static void* bench_alloc(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    g_alloc_count++;
+    return malloc(size);
+}
+
+static void bench_free(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    free(ptr);
+}
+
+struct FrameStat
+{
+    double ms           {0};
+    double raster_ms    {0};
+    int vertices        {0};
+    int indices         {0};
+    int draw_cmds       {0};
+    int draw_lists      {0};
+    int active_allocs   {0};
+    size_t allocs       {0};
+};
+
+struct Workload
+{
+    const char* name;
+    void (*init)();
+    void (*frame)(int index);
+    void (*term)();
+};
+
+// every section starts collapsed, which would leave the demo and ImPlot workloads at a few hundred vertices.
+// On the first frame the window is created at display size and the header ids under scope get their open
+// state written to the window storage, the same key TreeNode reads back
+static void open_headers(const char* window, ImGuiWindowFlags flags, const vector<const char*>& scope, const vector<const char*>& labels)
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin(window, nullptr, flags);
+    for (auto id : scope)
+        ImGui::PushID(id);
+    for (auto label : labels)
+        ImGui::GetStateStorage()->SetInt(ImGui::GetID(label), 1);
+    for (size_t i = 0; i < scope.size(); i++)
+        ImGui::PopID();
+    ImGui::End();
+}
+
+static void demo_frame(int index)
+{
+    static const vector<const char*> headers = { "Help", "Configuration", "Window options", "Widgets", "Layout & Scrolling",
+                                                 "Popups & Modal windows", "Tables & Columns", "Filtering", "Inputs, Navigation & Focus" };
+    if (index == 0)
+        open_headers("Dear ImGui Demo", ImGuiWindowFlags_MenuBar, {}, headers);
+    ImGui::ShowDemoWindow();
+}
+
+// 10k rows through the clipper, scrolled by the wheel events queued in run_workload
+static void table_frame(int index)
+{
+    IM_UNUSED(index);
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Table", nullptr, ImGuiWindowFlags_NoDecoration);
+    const int rows = 10000;
+    const int columns = 8;
+    ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV |
+                            ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable;
+    if (ImGui::BeginTable("rows", columns, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (int c = 0; c < columns; c++)
+        {
+            char label[16];
+            snprintf(label, sizeof(label), "Column %d", c);
+            ImGui::TableSetupColumn(label);
+        }
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(rows);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                ImGui::TableNextRow();
+                ImGui::PushID(row);
+                ImGui::TableNextColumn();
+                ImGui::Selectable("##row", false, ImGuiSelectableFlags_SpanAllColumns);
+                ImGui::SameLine();
+                ImGui::Text("%05d", row);
+                for (int c = 1; c < columns; c++)
+                {
+                    ImGui::TableNextColumn();
+                    if (c == 1)
+                        ImGui::ProgressBar((row % 100) / 100.f, ImVec2(-FLT_MIN, 0), "");
+                    else
+                        ImGui::Text("%.3f", sinf(row * 0.1f + c));
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+// 1000 small windows tiled over the display, most of them overlap so hovering and sorting cost shows
+static void windows_frame(int index)
+{
+    IM_UNUSED(index);
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    const ImVec2 size(160, 90);
+    const int per_row = std::max((int)(display.x / (size.x * 0.5f)), 1);
+    for (int i = 0; i < 1000; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "Window %d", i);
+        int tile = i % (per_row * 16);
+        ImVec2 pos((tile % per_row) * size.x * 0.5f, (tile / per_row) * size.y * 0.5f);
+        ImGui::SetNextWindowPos(pos, ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(size, ImGuiCond_FirstUseEver);
+        ImGui::Begin(name);
+        ImGui::Text("window %d", i);
+        ImGui::Button("Button");
+        ImGui::End();
+    }
+}
+
+static void implot_init()
+{
+    ImPlot::CreateContext();
+}
+
+// the Plots tab is the one selected by default, its tree ids hang off the tab id inside the tab bar
+static void implot_frame(int index)
+{
+    static const vector<const char*> headers = { "Line Plots", "Filled Line Plots", "Shaded Plots##", "Scatter Plots", "Realtime Plots",
+                                                 "Stairstep Plots", "Bar Plots", "Bar Groups", "Bar Stacks", "Error Bars", "Stem Plots##",
+                                                 "Infinite Lines", "Pie Charts", "Heatmaps", "Histogram", "Histogram 2D", "Digital Plots",
+                                                 "Images", "Markers and Text", "NaN Values" };
+    if (index == 0)
+        open_headers("ImPlot Demo", ImGuiWindowFlags_MenuBar, { "ImPlotDemoTabs", "Plots" }, headers);
+    ImPlot::ShowDemoWindow();
+}
+
+static void implot_term()
+{
+    ImPlot::DestroyContext();
+}
+
+// there is no node editor demo in the tree, a 20x10 grid of nodes each linked to its right neighbour stands in
+static ed::EditorContext* g_editor = nullptr;
+static void node_init()
+{
+    ed::Config config;
+    config.SettingsFile = nullptr;
+    g_editor = ed::CreateEditor(&config);
+}
+
+static void node_frame(int index)
+{
+    IM_UNUSED(index);
+    const int cols = 20;
+    const int rows = 10;
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Node Editor", nullptr, ImGuiWindowFlags_NoDecoration);
+    ed::SetCurrentEditor(g_editor);
+    ed::Begin("graph");
+    for (int n = 0; n < cols * rows; n++)
+    {
+        ed::NodeId node_id(n + 1);
+        if (ImGui::GetFrameCount() == 1)
+            ed::SetNodePosition(node_id, ImVec2((n % cols) * 180.f, (n / cols) * 120.f));
+        ed::BeginNode(node_id);
+        ImGui::Text("Node %d", n);
+        ed::BeginPin(ed::PinId(100000 + n * 2), ed::PinKind::Input);
+        ImGui::Text("-> In");
+        ed::EndPin();
+        ImGui::SameLine();
+        ed::BeginPin(ed::PinId(100000 + n * 2 + 1), ed::PinKind::Output);
+        ImGui::Text("Out ->");
+        ed::EndPin();
+        ed::EndNode();
+    }
+    for (int n = 0; n < cols * rows; n++)
+    {
+        if (n % cols == cols - 1)
+            continue;
+        ed::Link(ed::LinkId(200000 + n), ed::PinId(100000 + n * 2 + 1), ed::PinId(100000 + (n + 1) * 2));
+    }
+    ed::End();
+    ed::SetCurrentEditor(nullptr);
+    ImGui::End();
+}
+
+static void node_term()
+{
+    ed::DestroyEditor(g_editor);
+    g_editor = nullptr;
+}
+
+static double percentile(vector<double> values, double p)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t)(p * values.size()));
+    return values[index];
+}
+
+static string json_number(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", value);
+    return buf;
+}
+
+// warmup frames settle window sizes and caches, only the frames after them are reported
+static string run_workload(const Workload& workload, int frames, int width, int height, bool soft, const string& png_dir)
+{
+    const int warmup = std::min(frames, 10);
+    ImGui::SetAllocatorFunctions(bench_alloc, bench_free);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = 1.f / 60.f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    ImGui::ImMat frame_mat;
+    if (soft)
+        ImGui_ImplSoft_Init();
+    if (workload.init)
+        workload.init();
+
+    vector<FrameStat> stats;
+    for (int i = 0; i < warmup + frames; i++)
+    {
+        // mouse sweeps a lissajous over the display, the wheel scrolls down then back up
+        float t = i / 60.f;
+        io.AddMousePosEvent(width * (0.5f + 0.45f * sinf(t * 1.3f)), height * (0.5f + 0.45f * sinf(t * 0.7f)));
+        io.AddMouseWheelEvent(0.f, (i / 120) % 2 ? 2.f : -2.f);
+
+        if (soft)
+            ImGui_ImplSoft_NewFrame();
+        size_t allocs = g_alloc_count;
+        double start = ImGui::get_current_time();
+        ImGui::NewFrame();
+        workload.frame(i);
+        ImGui::Render();
+        double time = ImGui::get_current_time() - start;
+        double raster_time = 0;
+        if (soft)
+        {
+            double raster_start = ImGui::get_current_time();
+            ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), frame_mat, true, IM_COL32(114, 140, 153, 255));
+            raster_time = ImGui::get_current_time() - raster_start;
+        }
+        if (i < warmup)
+            continue;
+
+        FrameStat stat;
+        stat.ms = time * 1000.0;
+        stat.raster_ms = raster_time * 1000.0;
+        stat.allocs = g_alloc_count - allocs;
+        stat.active_allocs = io.MetricsActiveAllocations;
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        if (draw_data)
+        {
+            stat.vertices = draw_data->TotalVtxCount;
+            stat.indices = draw_data->TotalIdxCount;
+            stat.draw_lists = draw_data->CmdListsCount;
+            for (int n = 0; n < draw_data->CmdListsCount; n++)
+                stat.draw_cmds += draw_data->CmdLists[n]->CmdBuffer.Size;
+        }
+        stats.push_back(stat);
+    }
+
+    if (workload.term)
+        workload.term();
+    if (soft)
+    {
+        if (!png_dir.empty() && !frame_mat.empty())
+        {
+            string path = png_dir + "/" + workload.name + ".png";
+            if (!stbi_write_png(path.c_str(), frame_mat.w, frame_mat.h, 4, frame_mat.data, frame_mat.w * 4))
+                cerr << "can't write " << path << endl;
+        }
+        ImGui_ImplSoft_Shutdown();
+    }
+    ImGui::DestroyContext();
+
+    vector<double> ms, raster_ms;
+    double total = 0, raster_total = 0;
+    FrameStat peak;
+    double sum_vertices = 0, sum_indices = 0, sum_cmds = 0, sum_allocs = 0;
+    for (auto& stat : stats)
+    {
+        ms.push_back(stat.ms);
+        total += stat.ms;
+        raster_ms.push_back(stat.raster_ms);
+        raster_total += stat.raster_ms;
+        sum_vertices += stat.vertices;
+        sum_indices += stat.indices;
+        sum_cmds += stat.draw_cmds;
+        sum_allocs += stat.allocs;
+        peak.vertices = std::max(peak.vertices, stat.vertices);
+        peak.indices = std::max(peak.indices, stat.indices);
+        peak.draw_cmds = std::max(peak.draw_cmds, stat.draw_cmds);
+        peak.draw_lists = std::max(peak.draw_lists, stat.draw_lists);
+        peak.active_allocs = std::max(peak.active_allocs, stat.active_allocs);
+    }
+    double count = std::max((double)stats.size(), 1.0);
+
+    string json = "    {\n";
+    json += "      \"name\": \"" + string(workload.name) + "\",\n";
+    json += "      \"frames\": " + to_string(stats.size()) + ",\n";
+    json += "      \"ms\": { \"mean\": " + json_number(total / count) +
+            ", \"p50\": " + json_number(percentile(ms, 0.5)) +
+            ", \"p90\": " + json_number(percentile(ms, 0.9)) +
+            ", \"p99\": " + json_number(percentile(ms, 0.99)) +
+            ", \"max\": " + json_number(percentile(ms, 1.0)) + " },\n";
+    if (soft)
+    {
+        json += "      \"raster_ms\": { \"mean\": " + json_number(raster_total / count) +
+                ", \"p50\": " + json_number(percentile(raster_ms, 0.5)) +
+                ", \"p90\": " + json_number(percentile(raster_ms, 0.9)) +
+                ", \"p99\": " + json_number(percentile(raster_ms, 0.99)) +
+                ", \"max\": " + json_number(percentile(raster_ms, 1.0)) + " },\n";
+        // frames per second of the whole CPU frame, ImGui plus rasterizer
+        json += "      \"fps\": " + json_number(1000.0 * count / std::max(total + raster_total, 1e-9)) + ",\n";
+    }
+    json += "      \"vertices\": { \"mean\": " + json_number(sum_vertices / count) + ", \"max\": " + to_string(peak.vertices) + " },\n";
+    json += "      \"indices\": { \"mean\": " + json_number(sum_indices / count) + ", \"max\": " + to_string(peak.indices) + " },\n";
+    json += "      \"draw_cmds\": { \"mean\": " + json_number(sum_cmds / count) + ", \"max\": " + to_string(peak.draw_cmds) + " },\n";
+    json += "      \"draw_lists_max\": " + to_string(peak.draw_lists) + ",\n";
+    json += "      \"allocs_per_frame\": " + json_number(sum_allocs / count) + ",\n";
+    json += "      \"active_allocations\": { \"last\": " + to_string(stats.empty() ? 0 : stats.back().active_allocs) + ", \"max\": " + to_string(peak.active_allocs) + " },\n";
+    json += "      \"active_allocations_per_frame\": [";
+    for (size_t i = 0; i < stats.size(); i++)
+        json += string(i ? ", " : "") + to_string(stats[i].active_allocs);
+    json += "]\n";
+    json += "    }";
+    return json;
+}
+
+int main(int argc, char* argv[])
+{
+    string bench = argc > 1 ? argv[1] : "all";
+    int frames = argc > 2 ? atoi(argv[2]) : 300;
+    int width = argc > 4 ? atoi(argv[3]) : 1920;
+    int height = argc > 4 ? atoi(argv[4]) : 1080;
+    bool soft = argc > 5 && string(argv[5]) == "soft";
+    string png_dir = argc > 6 ? argv[6] : "";
+    const Workload workloads[] =
+    {
+        { "demo",       nullptr,        demo_frame,     nullptr     },
+        { "table",      nullptr,        table_frame,    nullptr     },
+        { "windows",    nullptr,        windows_frame,  nullptr     },
+        { "implot",     implot_init,    implot_frame,   implot_term },
+        { "node",       node_init,      node_frame,     node_term   },
+    };
+    bool known = bench == "all";
+    for (auto& workload : workloads)
+        known |= bench == workload.name;
+    if (!known || frames <= 0 || width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [all|demo|table|windows|implot|node] [frames] [width height] [soft [png_dir]]" << endl;
+        return -1;
+    }
+
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+    json += "  \"display\": [" + to_string(width) + ", " + to_string(height) + "],\n";
+    json += "  \"workloads\": [\n";
+    bool first = true;
+    for (auto& workload : workloads)
+    {
+        if (bench != "all" && bench != workload.name)
+            continue;
+        json += string(first ? "" : ",\n") + run_workload(workload, frames, width, height, soft, png_dir);
+        first = false;
+    }
+    json += "\n  ]\n}\n";
+    cout << json;
+    return 0;
+}
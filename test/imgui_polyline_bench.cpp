@@ -0,0 +1,258 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_helper.h>
+
+using namespace std;
+
+// Headless micro-benchmark of the polyline and convex fill tessellation: a detached draw list strokes a wavy
+// polyline (thin, textured and thick, open and closed) and fills a convex polygon over and over, the throughput
+// is reported in points per second. Every vertex position is checked against a scalar reference of the
+// tessellation using an exact square root, the process exits with 1 when a position is off by more than the
+// reciprocal square root approximation allows. The checksums of the vertices and indices are printed to compare
+// builds, e.g. with and without IMGUI_DISABLE_SSE.
+// usage: imgui_polyline_bench [points] [strokes] [iterations]
+
+struct Case
+{
+    const char* name;
+    ImDrawListFlags flags;
+    float thickness;
+    bool closed;
+    bool fill;
+};
+
+struct CaseStat
+{
+    double ms               {0};
+    double points_per_sec   {0};
+    int vertices            {0};
+    int indices             {0};
+    float max_error         {0};
+    ImU32 checksum          {0};
+};
+
+static string json_number(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", value);
+    return buf;
+}
+
+static void make_points(vector<ImVec2>& points, int count, int stroke, bool convex)
+{
+    points.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        float t = (float)i / count;
+        if (convex)
+        {
+            // clockwise on screen, with uneven spacing
+            float a = 6.2831853f * (t + 0.02f * sinf(t * 40.f));
+            points[i] = ImVec2(400.f + 300.f * cosf(a), 300.f + 200.f * sinf(a));
+        }
+        else
+        {
+            float x = 10.f + 1800.f * t;
+            float y = 200.f + 120.f * sinf(t * (7.f + stroke)) + 30.f * sinf(t * 131.f) + 4.f * sinf(t * 977.f);
+            // a few duplicated points and spikes for degenerate segments
+            if (i % 97 == 5)
+                points[i] = points[i - 1];
+            else
+                points[i] = ImVec2(x, (i % 211 == 7) ? y - 60.f : y);
+        }
+    }
+}
+
+// Reference normal at every point: same formulas as the tessellation, with 1/sqrt instead of the approximation
+static void reference_normals(const vector<ImVec2>& points, bool closed, vector<ImVec2>& normals)
+{
+    const int points_count = (int)points.size();
+    const int count = closed ? points_count : points_count - 1;
+    vector<ImVec2> segment(points_count);
+    for (int i1 = 0; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        float d2 = dx * dx + dy * dy;
+        if (d2 > 0.f)
+        {
+            float inv_len = 1.f / sqrtf(d2);
+            dx *= inv_len;
+            dy *= inv_len;
+        }
+        segment[i1] = ImVec2(dy, -dx);
+    }
+    if (!closed)
+        segment[points_count - 1] = segment[points_count - 2];
+    normals.resize(points_count);
+    for (int i = 0; i < points_count; i++)
+    {
+        if (i == 0 && !closed)
+        {
+            normals[i] = segment[0];
+            continue;
+        }
+        const ImVec2& n0 = segment[i == 0 ? points_count - 1 : i - 1];
+        const ImVec2& n1 = segment[i];
+        float dm_x = (n0.x + n1.x) * 0.5f;
+        float dm_y = (n0.y + n1.y) * 0.5f;
+        float d2 = dm_x * dm_x + dm_y * dm_y;
+        if (d2 > 0.000001f)
+        {
+            float inv_len2 = std::min(1.f / d2, 100.f);
+            dm_x *= inv_len2;
+            dm_y *= inv_len2;
+        }
+        normals[i] = ImVec2(dm_x, dm_y);
+    }
+}
+
+// Largest distance between the vertices of one primitive and the reference, offsets are along the point normal
+static float measure_error(const Case& c, const vector<ImVec2>& points, const ImDrawVert* vtx, float fringe)
+{
+    vector<ImVec2> normals;
+    reference_normals(points, c.closed || c.fill, normals);
+    vector<float> offsets;
+    if (c.fill)
+        offsets = { -fringe * 0.5f, fringe * 0.5f };
+    else if (c.flags & ImDrawListFlags_AntiAliasedLinesUseTex)
+        offsets = { c.thickness * 0.5f + 1.f, -(c.thickness * 0.5f + 1.f) };
+    else if (c.thickness <= fringe)
+        offsets = { 0.f, fringe, -fringe };
+    else
+    {
+        float half_inner = (c.thickness - fringe) * 0.5f;
+        offsets = { half_inner + fringe, half_inner, -half_inner, -(half_inner + fringe) };
+    }
+    float max_error = 0.f;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        for (float offset : offsets)
+        {
+            max_error = std::max(max_error, fabsf(points[i].x + normals[i].x * offset - vtx->pos.x));
+            max_error = std::max(max_error, fabsf(points[i].y + normals[i].y * offset - vtx->pos.y));
+            vtx++;
+        }
+    }
+    return max_error;
+}
+
+static CaseStat run(const Case& c, int points_count, int strokes, int iterations)
+{
+    vector<vector<ImVec2>> shapes(strokes);
+    for (int s = 0; s < strokes; s++)
+        make_points(shapes[s], points_count, s, c.fill);
+
+    CaseStat stat;
+    ImDrawList* draw_list = ImGui::CreateDetachedDrawList();
+    const int warmup = std::min(iterations, 3);
+    for (int i = 0; i < warmup + iterations; i++)
+    {
+        ImGui::ResetDetachedDrawList(draw_list);
+        draw_list->Flags = c.flags;
+        double start = ImGui::get_current_time();
+        for (int s = 0; s < strokes; s++)
+        {
+            if (c.fill)
+                draw_list->AddConvexPolyFilled(shapes[s].data(), points_count, IM_COL32(255, 200, 64, 255));
+            else
+                draw_list->AddPolyline(shapes[s].data(), points_count, IM_COL32(64, 200, 255, 255), c.closed ? ImDrawFlags_Closed : 0, c.thickness);
+        }
+        double time = ImGui::get_current_time() - start;
+        if (i >= warmup)
+            stat.ms += time * 1000.0 / iterations;
+    }
+    stat.vertices = draw_list->VtxBuffer.Size;
+    stat.indices = draw_list->IdxBuffer.Size;
+    stat.points_per_sec = (double)points_count * strokes / std::max(stat.ms / 1000.0, 1e-9);
+    stat.checksum = ImHashData(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert), ImHashData(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx)));
+    const int vtx_per_stroke = stat.vertices / strokes;
+    for (int s = 0; s < strokes; s++)
+        stat.max_error = std::max(stat.max_error, measure_error(c, shapes[s], draw_list->VtxBuffer.Data + s * vtx_per_stroke, draw_list->_FringeScale));
+    ImGui::DestroyDetachedDrawList(draw_list);
+    return stat;
+}
+
+int main(int argc, char* argv[])
+{
+    int points = argc > 1 ? atoi(argv[1]) : 4096;
+    int strokes = argc > 2 ? atoi(argv[2]) : 64;
+    int iterations = argc > 3 ? atoi(argv[3]) : 20;
+    // thick lines use 4 vertices per point and one primitive must stay below 64K vertices with 16-bit indices
+    if (points < 3 || points > 16000 || strokes <= 0 || iterations <= 0)
+    {
+        cout << "usage: " << argv[0] << " [points (3..16000)] [strokes] [iterations]" << endl;
+        return -1;
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    ImGui::NewFrame();
+
+    const ImDrawListFlags aa_lines = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AllowVtxOffset;
+    const Case cases[] =
+    {
+        { "thin_open",          aa_lines,                                           1.0f, false, false },
+        { "thin_closed",        aa_lines,                                           1.0f, true,  false },
+        { "textured_open",      aa_lines | ImDrawListFlags_AntiAliasedLinesUseTex,  3.0f, false, false },
+        { "textured_closed",    aa_lines | ImDrawListFlags_AntiAliasedLinesUseTex,  3.0f, true,  false },
+        { "thick_open",         aa_lines,                                           3.5f, false, false },
+        { "thick_closed",       aa_lines,                                           3.5f, true,  false },
+        { "convex_fill",        ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset, 1.0f, true, true },
+    };
+
+    // the approximated reciprocal square root is within 1.5 * 2^-12, sharp joints scale the offsets up to 10x
+    const float tolerance = 0.1f;
+    bool accurate = true;
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+#ifdef IMGUI_ENABLE_SSE
+    json += "  \"simd\": \"sse\",\n";
+#else
+    json += "  \"simd\": \"none\",\n";
+#endif
+    json += "  \"points\": " + to_string(points) + ",\n";
+    json += "  \"strokes\": " + to_string(strokes) + ",\n";
+    json += "  \"iterations\": " + to_string(iterations) + ",\n";
+    json += "  \"cases\": [\n";
+    const int cases_count = (int)(sizeof(cases) / sizeof(cases[0]));
+    for (int i = 0; i < cases_count; i++)
+    {
+        CaseStat stat = run(cases[i], points, strokes, iterations);
+        accurate &= stat.max_error <= tolerance;
+        char checksum[16];
+        snprintf(checksum, sizeof(checksum), "%08x", stat.checksum);
+        json += "    { \"name\": \"" + string(cases[i].name) + "\"" +
+                ", \"ms\": " + json_number(stat.ms) +
+                ", \"mpoints_per_sec\": " + json_number(stat.points_per_sec / 1e6) +
+                ", \"vertices\": " + to_string(stat.vertices) +
+                ", \"indices\": " + to_string(stat.indices) +
+                ", \"max_error_px\": " + json_number(stat.max_error) +
+                ", \"checksum\": \"" + checksum + "\" }" + (i + 1 < cases_count ? ",\n" : "\n");
+    }
+    json += "  ],\n";
+    json += "  \"accurate\": " + string(accurate ? "true" : "false") + "\n";
+    json += "}\n";
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    cout << json;
+    return accurate ? 0 : 1;
+}
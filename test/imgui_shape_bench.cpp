@@ -0,0 +1,191 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <imgui_impl_soft.h>
+#include <immat.h>
+
+using namespace std;
+
+// Headless benchmark of io.ConfigAnalyticShapes: a rounded UI (framed widgets, radio buttons, sliders, child
+// windows) and a panel of rounded rects, circles and slanted lines drawn with the draw list are rendered once with tessellated
+// shapes and once with analytic shape quads, both rasterized by imgui_impl_soft. Reports the vertex and index
+// counts of both and how far the two images are apart, the process exits with 1 when they differ by more than
+// anti-aliasing noise (the tessellated circles are polygons, the analytic ones are exact).
+// usage: imgui_shape_bench [frames] [width height]
+
+struct RunStat
+{
+    double frame_ms     {0};
+    double raster_ms    {0};
+    int vertices        {0};
+    int indices         {0};
+    vector<ImU32> pixels;
+};
+
+static string json_number(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", value);
+    return buf;
+}
+
+static void draw_ui(float width, float height)
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(width * 0.5f, height));
+    ImGui::Begin("Widgets", nullptr, ImGuiWindowFlags_NoDecoration);
+    static float values[4] = { 0.25f, 0.5f, 0.75f, 1.f };
+    static bool checks[4] = { true, false, true, false };
+    static int radio = 1;
+    for (int row = 0; row < 12; row++)
+    {
+        ImGui::PushID(row);
+        ImGui::Button("Button");
+        ImGui::SameLine();
+        ImGui::Checkbox("Check", &checks[row % 4]);
+        ImGui::SameLine();
+        ImGui::RadioButton("A", &radio, 0);
+        ImGui::SameLine();
+        ImGui::RadioButton("B", &radio, 1);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120);
+        ImGui::SliderFloat("##value", &values[row % 4], 0.f, 1.f);
+        ImGui::ProgressBar(values[(row + 1) % 4], ImVec2(-1, 0));
+        ImGui::PopID();
+    }
+    ImGui::BeginChild("child", ImVec2(0, 0), true);
+    ImGui::TextUnformatted("Child window");
+    ImGui::EndChild();
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(width * 0.5f, 0));
+    ImGui::SetNextWindowSize(ImVec2(width * 0.5f, height));
+    ImGui::Begin("Shapes", nullptr, ImGuiWindowFlags_NoDecoration);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float cell = 48.f;
+    const int columns = (int)((width * 0.5f - 16) / cell);
+    const int rows = (int)((height - 16) / cell);
+    for (int y = 0; y < rows; y++)
+    {
+        for (int x = 0; x < columns; x++)
+        {
+            ImVec2 p_min(origin.x + x * cell + 4, origin.y + y * cell + 4);
+            ImVec2 p_max(p_min.x + cell - 8 - (x % 3) * 4.5f, p_min.y + cell - 8 - (y % 3) * 3.25f);
+            ImVec2 center((p_min.x + p_max.x) * 0.5f, (p_min.y + p_max.y) * 0.5f);
+            ImU32 color = ImColor::HSV(((x + y * columns) % 24) / 24.f, 0.6f, 0.9f, 0.5f + 0.5f * ((x + y) % 2));
+            switch ((x + y) % 5)
+            {
+                case 0: draw_list->AddRectFilled(p_min, p_max, color, 2.f + (x % 5) * 3.f); break;
+                case 1: draw_list->AddRect(p_min, p_max, color, 2.f + (y % 5) * 3.f, ImDrawFlags_RoundCornersTop, 1.f + (x % 3)); break;
+                case 2: draw_list->AddCircleFilled(center, 4.f + (x % 6) * 3.7f, color); break;
+                case 3: draw_list->AddCircle(center, 4.f + (y % 6) * 3.7f, color, 0, 1.f + (y % 2) * 1.5f); break;
+                case 4: draw_list->AddLine(ImVec2(p_min.x, p_max.y - (x % 4) * 9.f), ImVec2(p_max.x, p_min.y + (y % 4) * 9.f), color, 1.f + (x % 4) * 1.25f); break;
+            }
+        }
+    }
+    ImGui::Dummy(ImVec2(columns * cell, rows * cell));
+    ImGui::End();
+}
+
+static RunStat run(bool analytic, int frames, int width, int height)
+{
+    const int warmup = std::min(frames, 3);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = 1.f / 60.f;
+    io.ConfigAnalyticShapes = analytic;
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.WindowRounding = style.ChildRounding = 8.f;
+    style.FrameRounding = style.GrabRounding = 6.f;
+    style.FrameBorderSize = 1.f;
+    ImGui_ImplSoft_Init();
+
+    RunStat stat;
+    ImGui::ImMat frame_mat;
+    for (int i = 0; i < warmup + frames; i++)
+    {
+        ImGui_ImplSoft_NewFrame();
+        double start = ImGui::get_current_time();
+        ImGui::NewFrame();
+        draw_ui((float)width, (float)height);
+        ImGui::Render();
+        double frame_time = ImGui::get_current_time() - start;
+        double raster_start = ImGui::get_current_time();
+        ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), frame_mat, true, IM_COL32(30, 30, 36, 255));
+        double raster_time = ImGui::get_current_time() - raster_start;
+        if (i < warmup)
+            continue;
+        stat.frame_ms += frame_time * 1000.0 / frames;
+        stat.raster_ms += raster_time * 1000.0 / frames;
+        stat.vertices = ImGui::GetDrawData()->TotalVtxCount;
+        stat.indices = ImGui::GetDrawData()->TotalIdxCount;
+    }
+    const ImU32* pixels = (const ImU32*)frame_mat.data;
+    stat.pixels.assign(pixels, pixels + (size_t)frame_mat.w * frame_mat.h);
+    ImGui_ImplSoft_Shutdown();
+    ImGui::DestroyContext();
+    return stat;
+}
+
+int main(int argc, char* argv[])
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 20;
+    int width = argc > 3 ? atoi(argv[2]) : 1280;
+    int height = argc > 3 ? atoi(argv[3]) : 720;
+    if (frames <= 0 || width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [frames] [width height]" << endl;
+        return -1;
+    }
+
+    RunStat tessellated = run(false, frames, width, height);
+    RunStat analytic = run(true, frames, width, height);
+
+    // per channel difference, edge pixels of circles and arcs legitimately differ a little
+    const int tolerance = 64;
+    double sum_diff = 0;
+    int max_diff = 0;
+    size_t over_tolerance = 0;
+    for (size_t i = 0; i < tessellated.pixels.size(); i++)
+    {
+        int diff = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            diff = std::max(diff, abs((int)((tessellated.pixels[i] >> shift) & 0xFF) - (int)((analytic.pixels[i] >> shift) & 0xFF)));
+        sum_diff += diff;
+        max_diff = std::max(max_diff, diff);
+        over_tolerance += diff > tolerance;
+    }
+    const double pixel_count = (double)std::max(tessellated.pixels.size(), (size_t)1);
+    const double mean_diff = sum_diff / pixel_count;
+    const double over_ratio = over_tolerance / pixel_count;
+    const bool matching = tessellated.pixels.size() == analytic.pixels.size() && mean_diff < 1.0 && over_ratio < 0.002;
+
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+    json += "  \"frames\": " + to_string(frames) + ",\n";
+    json += "  \"width\": " + to_string(width) + ",\n";
+    json += "  \"height\": " + to_string(height) + ",\n";
+    json += "  \"tessellated\": { \"vertices\": " + to_string(tessellated.vertices) + ", \"indices\": " + to_string(tessellated.indices) +
+            ", \"frame_ms\": " + json_number(tessellated.frame_ms) + ", \"raster_ms\": " + json_number(tessellated.raster_ms) + " },\n";
+    json += "  \"analytic\": { \"vertices\": " + to_string(analytic.vertices) + ", \"indices\": " + to_string(analytic.indices) +
+            ", \"frame_ms\": " + json_number(analytic.frame_ms) + ", \"raster_ms\": " + json_number(analytic.raster_ms) + " },\n";
+    json += "  \"vertex_ratio\": " + json_number((double)tessellated.vertices / std::max(analytic.vertices, 1)) + ",\n";
+    json += "  \"mean_pixel_diff\": " + json_number(mean_diff) + ",\n";
+    json += "  \"max_pixel_diff\": " + to_string(max_diff) + ",\n";
+    json += "  \"pixels_over_tolerance\": " + json_number(over_ratio) + ",\n";
+    json += "  \"matching\": " + string(matching ? "true" : "false") + "\n";
+    json += "}\n";
+    cout << json;
+    return matching ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <imgui_impl_soft.h>
+#include <immat.h>
+
+using namespace std;
+
+// Headless check of ImDrawDataSnapshot and of the texture retiring it drives, rendered with imgui_impl_soft:
+// - a frame with the demo window and an image is captured by copy and by move, both snapshots must render the
+//   same pixels as the draw data they were taken from, and a second copy into the pool must not allocate.
+// - the image texture is destroyed while retiring is on: it must stay alive, and still render, until
+//   ImReleaseRetiredTextures() gets the serial of the frame after the last Render, and be freed then.
+// Texture helpers use imgui_impl_soft when no GPU backend is built. The process exits with 1 on any failure.
+// usage: imgui_snapshot_check [width height]
+
+// the soft textures are IM_NEW'd ImMat, the free of the watched one tells when the texture is released
+static size_t g_alloc_count = 0;
+static void* g_watched = nullptr;
+static bool g_watched_freed = false;
+static void* check_alloc(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    g_alloc_count++;
+    return malloc(size);
+}
+
+static void check_free(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    if (ptr && ptr == g_watched)
+        g_watched_freed = true;
+    free(ptr);
+}
+
+static int g_failures = 0;
+static void check(bool condition, const char* what)
+{
+    cout << (condition ? "  ok      " : "  FAILED  ") << what << endl;
+    g_failures += !condition;
+}
+
+static vector<ImU32> render(ImDrawData* draw_data)
+{
+    ImGui::ImMat frame_mat;
+    ImGui_ImplSoft_RenderDrawData(draw_data, frame_mat, true, IM_COL32(114, 140, 153, 255));
+    const ImU32* pixels = (const ImU32*)frame_mat.data;
+    return vector<ImU32>(pixels, pixels + (size_t)frame_mat.w * frame_mat.h);
+}
+
+static void frame(ImTextureID image)
+{
+    ImGui_ImplSoft_NewFrame();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::ShowDemoWindow();
+    if (image)
+    {
+        ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.6f, 20), ImGuiCond_Always);
+        ImGui::Begin("Image", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Image(image, ImVec2(192, 192));
+        ImGui::End();
+    }
+    ImGui::Render();
+}
+
+int main(int argc, char* argv[])
+{
+    int width = argc > 2 ? atoi(argv[1]) : 1280;
+    int height = argc > 2 ? atoi(argv[2]) : 720;
+    if (width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [width height]" << endl;
+        return -1;
+    }
+
+    ImGui::SetAllocatorFunctions(check_alloc, check_free);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+    io.DeltaTime = 1.f / 60.f;
+    ImGui_ImplSoft_Init();
+
+    // 64x64 checker, a texture freed too early would render garbage or crash
+    vector<ImU32> checker(64 * 64);
+    for (int y = 0; y < 64; y++)
+        for (int x = 0; x < 64; x++)
+            checker[y * 64 + x] = ((x / 8 + y / 8) % 2) ? IM_COL32(230, 60, 40, 255) : IM_COL32(40, 80, 230, 255);
+    ImTextureID image = ImGui::ImCreateTexture(checker.data(), 64, 64);
+    check(image != nullptr, "texture helpers create a texture without a GPU backend");
+    if (!image)
+    {
+        ImGui_ImplSoft_Shutdown();
+        ImGui::DestroyContext();
+        return 1;
+    }
+    g_watched = image;
+
+    for (int i = 0; i < 3; i++)
+        frame(image);
+    {
+        ImDrawDataSnapshot copied, moved;
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        const vector<ImU32> reference = render(draw_data);
+        copied.Capture(draw_data);
+        moved.Capture(draw_data, true);
+        bool emptied = true;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            emptied &= draw_data->CmdLists[n]->VtxBuffer.Size == 0 && draw_data->CmdLists[n]->IdxBuffer.Size == 0;
+        check(!reference.empty() && render(&copied.DrawData) == reference, "copied snapshot renders the same pixels");
+        check(render(&moved.DrawData) == reference, "moved snapshot renders the same pixels");
+        check(emptied, "move leaves the context draw lists empty");
+        check(copied.Serial != 0 && copied.Serial == moved.Serial && copied.Serial == ImDrawDataSnapshot::GetRenderSerial(), "snapshots carry the serial of the last Render");
+
+        // retired while the snapshot of the last frame may still be drawn, and the frame being built may use it too
+        const ImU64 serial = copied.Serial;
+        ImGui::ImSetTextureRetiring(true);
+        ImGui::ImDestroyTexture(image);
+        check(!g_watched_freed, "destroyed texture is retired, not freed");
+        ImGui::ImReleaseRetiredTextures(serial);
+        check(!g_watched_freed, "texture survives the release of its own frame");
+        check(render(&copied.DrawData) == reference, "retired texture still renders");
+
+        // the next frame doesn't use it anymore, once its snapshot is drawn the texture goes
+        frame(nullptr);
+        size_t allocs = g_alloc_count;
+        copied.Capture(ImGui::GetDrawData());
+        check(g_alloc_count == allocs, "capture into a grown pool doesn't allocate");
+        check(copied.Serial == serial + 1, "next frame has the next serial");
+        render(&copied.DrawData);
+        ImGui::ImReleaseRetiredTextures(copied.Serial);
+        check(g_watched_freed, "texture is freed with the serial of the frame after its destruction");
+        ImGui::ImSetTextureRetiring(false);
+    }
+
+    ImGui_ImplSoft_Shutdown();
+    ImGui::DestroyContext();
+    cout << (g_failures ? "FAILED" : "passed") << endl;
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,213 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_helper.h>
+
+using namespace std;
+
+// Headless benchmark of the vertex/index bandwidth of a plot frame: a window draws a polyline through every
+// sample of a few series plus a marker every 64 samples. The draw data is packed the way the OpenGL3 and Vulkan
+// backends do it, once as ImDrawVert and ImDrawIdx and once with io.ConfigCompactVertices (ImDrawVertCompact
+// where a draw list fits, 16-bit indices where it has few enough vertices), into a staging buffer standing for
+// the mapped GPU buffer. The compact vertices are decoded back and compared with the originals, the process exits
+// with 1 when a position is off by more than half a fixed point step or an uv by more than half a 16-bit step.
+// usage: imgui_vertex_bench [samples] [series] [frames]
+
+static float sample_value(int series, int index)
+{
+    float t = index * 0.0009f;
+    return sinf(t * (2.f + series * 0.53f)) * 0.5f + sinf(t * 37.f + series) * 0.3f + sinf(t * 271.f) * 0.1f;
+}
+
+struct PackStat
+{
+    size_t vtx_bytes        {0};
+    size_t idx_bytes        {0};
+    double pack_ms          {0};
+    int compact_lists       {0};
+    int idx16_lists         {0};
+};
+
+static string json_number(double value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.4f", value);
+    return buf;
+}
+
+// Same layout as the backends: every draw list after the previous one, index buffers aligned on 4 bytes
+static PackStat pack(const ImDrawData* draw_data, bool compact, vector<char>& vtx_staging, vector<char>& idx_staging)
+{
+    PackStat stat;
+    double start = ImGui::get_current_time();
+    vector<ImVec2> origins(draw_data->CmdListsCount);
+    vector<char> compact_vtx(draw_data->CmdListsCount), idx16(draw_data->CmdListsCount);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        compact_vtx[n] = compact && cmd_list->CalcCompactVtxOrigin(&origins[n]);
+        idx16[n] = compact && cmd_list->CanPackIdx16();
+        stat.vtx_bytes += cmd_list->VtxBuffer.Size * (compact_vtx[n] ? sizeof(ImDrawVertCompact) : sizeof(ImDrawVert));
+        stat.idx_bytes += cmd_list->IdxBuffer.Size * (idx16[n] ? sizeof(ImU16) : sizeof(ImDrawIdx));
+        stat.idx_bytes = (stat.idx_bytes + 3) & ~(size_t)3;
+        stat.compact_lists += compact_vtx[n];
+        stat.idx16_lists += idx16[n];
+    }
+    vtx_staging.resize(stat.vtx_bytes);
+    idx_staging.resize(stat.idx_bytes);
+    char* vtx_dst = vtx_staging.data();
+    char* idx_dst = idx_staging.data();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        if (compact_vtx[n])
+        {
+            cmd_list->PackCompactVtx((ImDrawVertCompact*)vtx_dst, origins[n]);
+            vtx_dst += cmd_list->VtxBuffer.Size * sizeof(ImDrawVertCompact);
+        }
+        else
+        {
+            memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            vtx_dst += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        }
+        size_t idx_bytes = cmd_list->IdxBuffer.Size * (idx16[n] ? sizeof(ImU16) : sizeof(ImDrawIdx));
+        if (idx16[n])
+            cmd_list->PackIdx16((ImU16*)idx_dst);
+        else
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, idx_bytes);
+        idx_dst += (idx_bytes + 3) & ~(size_t)3;
+    }
+    stat.pack_ms = (ImGui::get_current_time() - start) * 1000.0;
+    return stat;
+}
+
+// Largest difference between the draw lists and their compact copy, in pixels and in uv
+static void measure_error(const ImDrawData* draw_data, const vector<char>& vtx_staging, float& max_pos_error, float& max_uv_error)
+{
+    max_pos_error = max_uv_error = 0.f;
+    const char* vtx_src = vtx_staging.data();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        ImVec2 origin;
+        if (!cmd_list->CalcCompactVtxOrigin(&origin))
+        {
+            vtx_src += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+            continue;
+        }
+        const ImDrawVertCompact* compact = (const ImDrawVertCompact*)vtx_src;
+        for (int i = 0; i < cmd_list->VtxBuffer.Size; i++)
+        {
+            const ImDrawVert& v = cmd_list->VtxBuffer[i];
+            max_pos_error = std::max(max_pos_error, fabsf(origin.x + compact[i].pos[0] / IM_DRAWVERT_COMPACT_POS_SCALE - v.pos.x));
+            max_pos_error = std::max(max_pos_error, fabsf(origin.y + compact[i].pos[1] / IM_DRAWVERT_COMPACT_POS_SCALE - v.pos.y));
+            max_uv_error = std::max(max_uv_error, fabsf(compact[i].uv[0] / 65535.f - v.uv.x));
+            max_uv_error = std::max(max_uv_error, fabsf(compact[i].uv[1] / 65535.f - v.uv.y));
+        }
+        vtx_src += cmd_list->VtxBuffer.Size * sizeof(ImDrawVertCompact);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int samples = argc > 1 ? atoi(argv[1]) : 250000;
+    int series = argc > 2 ? atoi(argv[2]) : 4;
+    int frames = argc > 3 ? atoi(argv[3]) : 10;
+    if (samples <= 1 || series <= 0 || frames <= 0)
+    {
+        cout << "usage: " << argv[0] << " [samples] [series] [frames]" << endl;
+        return -1;
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    unsigned char* pixels = nullptr;
+    int tex_w = 0, tex_h = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &tex_w, &tex_h);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+
+    vector<char> vtx_staging, idx_staging;
+    PackStat full, compact;
+    float max_pos_error = 0.f, max_uv_error = 0.f;
+    int vertices = 0, indices = 0, draw_lists = 0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Plot", nullptr, ImGuiWindowFlags_NoDecoration);
+        ImGui::Text("%d samples x %d series", samples, series);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size(io.DisplaySize.x - origin.x * 2, io.DisplaySize.y - origin.y - 8);
+        for (int s = 0; s < series; s++)
+        {
+            ImU32 color = ImColor::HSV(s / (float)series, 0.7f, 1.f);
+            // stroked in pieces so a single primitive stays below 64K vertices with 16-bit indices
+            for (int begin = 0; begin < samples - 1; begin += 4096)
+            {
+                int end = std::min(begin + 4096, samples - 1);
+                draw_list->PathClear();
+                for (int i = begin; i <= end; i++)
+                    draw_list->PathLineTo(ImVec2(origin.x + size.x * i / (samples - 1), origin.y + size.y * (0.5f - 0.45f * sample_value(s, i))));
+                draw_list->PathStroke(color, 0, 1.f);
+            }
+            for (int i = 0; i < samples; i += 64)
+                draw_list->AddCircleFilled(ImVec2(origin.x + size.x * i / (samples - 1), origin.y + size.y * (0.5f - 0.45f * sample_value(s, i))), 2.f, color, 6);
+        }
+        ImGui::Dummy(size);
+        ImGui::End();
+        ImGui::Render();
+
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        PackStat full_frame = pack(draw_data, false, vtx_staging, idx_staging);
+        PackStat compact_frame = pack(draw_data, true, vtx_staging, idx_staging);
+        full.pack_ms += full_frame.pack_ms / frames;
+        compact.pack_ms += compact_frame.pack_ms / frames;
+        full.vtx_bytes = full_frame.vtx_bytes; full.idx_bytes = full_frame.idx_bytes;
+        compact.vtx_bytes = compact_frame.vtx_bytes; compact.idx_bytes = compact_frame.idx_bytes;
+        compact.compact_lists = compact_frame.compact_lists; compact.idx16_lists = compact_frame.idx16_lists;
+        measure_error(draw_data, vtx_staging, max_pos_error, max_uv_error);
+        vertices = draw_data->TotalVtxCount;
+        indices = draw_data->TotalIdxCount;
+        draw_lists = draw_data->CmdListsCount;
+    }
+    ImGui::DestroyContext();
+
+    const size_t full_bytes = full.vtx_bytes + full.idx_bytes;
+    const size_t compact_bytes = compact.vtx_bytes + compact.idx_bytes;
+    const bool accurate = max_pos_error <= 0.5f / IM_DRAWVERT_COMPACT_POS_SCALE + 1e-3f && max_uv_error <= 0.5f / 65535.f + 1e-6f;
+    string json = "{\n";
+    json += "  \"imgui\": \"" + string(IMGUI_VERSION) + "\",\n";
+    json += "  \"samples\": " + to_string(samples) + ",\n";
+    json += "  \"series\": " + to_string(series) + ",\n";
+    json += "  \"frames\": " + to_string(frames) + ",\n";
+    json += "  \"vertices\": " + to_string(vertices) + ",\n";
+    json += "  \"indices\": " + to_string(indices) + ",\n";
+    json += "  \"draw_lists\": " + to_string(draw_lists) + ",\n";
+    json += "  \"full\": { \"vtx_bytes\": " + to_string(full.vtx_bytes) + ", \"idx_bytes\": " + to_string(full.idx_bytes) +
+            ", \"frame_bytes\": " + to_string(full_bytes) + ", \"pack_ms\": " + json_number(full.pack_ms) + " },\n";
+    json += "  \"compact\": { \"vtx_bytes\": " + to_string(compact.vtx_bytes) + ", \"idx_bytes\": " + to_string(compact.idx_bytes) +
+            ", \"frame_bytes\": " + to_string(compact_bytes) + ", \"pack_ms\": " + json_number(compact.pack_ms) +
+            ", \"compact_vtx_lists\": " + to_string(compact.compact_lists) + ", \"idx16_lists\": " + to_string(compact.idx16_lists) + " },\n";
+    json += "  \"bytes_saved\": " + json_number(1.0 - (double)compact_bytes / (double)std::max(full_bytes, (size_t)1)) + ",\n";
+    json += "  \"max_pos_error_px\": " + json_number(max_pos_error) + ",\n";
+    json += "  \"max_uv_error_steps\": " + json_number(max_uv_error * 65535.0) + ",\n";
+    json += "  \"accurate\": " + string(accurate ? "true" : "false") + "\n";
+    json += "}\n";
+    cout << json;
+    return accurate ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <iostream>
+#include <ImVulkanShader.h>
+
+using namespace std;
+
+// writes ImVulkanCharacterize of every device, to stdout or to <dir>/vulkan_device_<index>.json
+int main(int argc, char* argv[])
+{
+    string dir = argc > 1 ? argv[1] : "";
+    int loop = argc > 2 ? atoi(argv[2]) : 10;
+    if (loop <= 0)
+    {
+        cout << "usage: " << argv[0] << " [output dir] [loop]" << endl;
+        return -1;
+    }
+
+    ImGui::ImVulkanShaderInit();
+    for (int i = 0; i < ImGui::get_gpu_count(); i++)
+    {
+        string json = ImGui::ImVulkanCharacterize(ImGui::get_gpu_device(i), loop);
+        if (dir.empty())
+        {
+            cout << json;
+            continue;
+        }
+        string path = dir + "/vulkan_device_" + to_string(i) + ".json";
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (!fp)
+        {
+            cerr << "can't write " << path << endl;
+            continue;
+        }
+        fwrite(json.data(), 1, json.size(), fp);
+        fclose(fp);
+        cout << "device " << i << " report " << path << endl;
+    }
+    ImGui::ImVulkanShaderClear();
+    return 0;
+}
@@ -0,0 +1,705 @@
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <immat.h>
+#include <ImVulkanShader.h>
+#include <Crop_vulkan.h>
+#include <Flip_vulkan.h>
+#include <Canny_vulkan.h>
+#include <Harris_vulkan.h>
+#include <Exposure_vulkan.h>
+#include <WhiteBalance_vulkan.h>
+#include <ColorBalance_vulkan.h>
+#include <Brightness_vulkan.h>
+#include <Contrast_vulkan.h>
+#include <Gamma_vulkan.h>
+#include <Saturation_vulkan.h>
+#include <Vibrance_vulkan.h>
+#include <Hue_vulkan.h>
+#include <ColorGrade_vulkan.h>
+#include <AlphaBlending_vulkan.h>
+#include <Histogram_vulkan.h>
+#include <Waveform_vulkan.h>
+#include <Vector_vulkan.h>
+#include <CIE_vulkan.h>
+#include <Reduce_vulkan.h>
+#include <Reference_cpu.h>
+#include <imvk_preprocess.h>
+#include <imvk_scheduler.h>
+#include <imvk_pipelinecache.h>
+#include "vulkan_test_util.h"
+
+using namespace std;
+
+// exact area average in double, reference for every downscale mode
+static void cpu_resize_area(const ImGui::ImMat& src, ImGui::ImMat& dst, int dst_w, int dst_h)
+{
+    dst.create_type(dst_w, dst_h, 4, IM_DT_INT8);
+    dst.color_format = IM_CF_ABGR;
+    const uint8_t* s = (const uint8_t*)src.data;
+    uint8_t* d = (uint8_t*)dst.data;
+    double scale_x = (double)src.w / dst_w;
+    double scale_y = (double)src.h / dst_h;
+    for (int y = 0; y < dst_h; y++)
+    {
+        double fy1 = y * scale_y, fy2 = fy1 + scale_y;
+        int sy1 = (int)floor(fy1), sy2 = std::min((int)ceil(fy2), src.h);
+        for (int x = 0; x < dst_w; x++)
+        {
+            double fx1 = x * scale_x, fx2 = fx1 + scale_x;
+            int sx1 = (int)floor(fx1), sx2 = std::min((int)ceil(fx2), src.w);
+            double sum[4] = {0, 0, 0, 0};
+            double area = 0;
+            for (int j = sy1; j < sy2; j++)
+            {
+                double wy = std::min(j + 1.0, fy2) - std::max((double)j, fy1);
+                for (int i = sx1; i < sx2; i++)
+                {
+                    double wx = std::min(i + 1.0, fx2) - std::max((double)i, fx1);
+                    const uint8_t* pixel = s + ((size_t)j * src.w + i) * 4;
+                    for (int c = 0; c < 4; c++) sum[c] += pixel[c] * wx * wy;
+                    area += wx * wy;
+                }
+            }
+            uint8_t* out = d + ((size_t)y * dst_w + x) * 4;
+            for (int c = 0; c < 4; c++) out[c] = (uint8_t)std::min(255.0, floor(sum[c] / area + 0.5));
+        }
+    }
+}
+
+static int bench_resize(int width, int height, int loop)
+{
+    const struct { ImInterpolateMode mode; const char* name; } modes[] = {
+        { IM_INTERPOLATE_NEAREST,   "nearest" },
+        { IM_INTERPOLATE_BILINEAR,  "bilinear" },
+        { IM_INTERPOLATE_BICUBIC,   "bicubic" },
+        { IM_INTERPOLATE_AREA,      "area" },
+        { IM_INTERPOLATE_PYRAMID,   "pyramid" },
+        { IM_INTERPOLATE_LANCZOS,   "lanczos3" },
+    };
+    const int factors[] = { 2, 4, 8 };
+
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+
+    ImGui::Resize_vulkan resize(gpu);
+    cout << "resize " << width << "x" << height << " rgba8, " << loop << " loops, gpu resident, psnr against cpu area average" << endl;
+    for (int factor : factors)
+    {
+        float scale = 1.f / factor;
+        for (auto& m : modes)
+        {
+            ImGui::VkMat dst_gpu;
+            dst_gpu.type = IM_DT_INT8;
+            dst_gpu.color_format = IM_CF_ABGR;
+            resize.Resize(src_gpu, dst_gpu, scale, scale, m.mode); // warm up
+            double t0 = get_current_time();
+            for (int i = 0; i < loop; i++)
+                resize.Resize(src_gpu, dst_gpu, scale, scale, m.mode);
+            double ms = (get_current_time() - t0) * 1000.0 / loop;
+
+            ImGui::ImMat dst, ref;
+            ImGui::ImVulkanVkMatToImMat(dst_gpu, dst);
+            cpu_resize_area(src, ref, dst.w, dst.h);
+            fprintf(stdout, "  %dx %-10s %5dx%-5d %8.3f ms  psnr %6.2f dB\n", factor, m.name, dst.w, dst.h, ms, psnr_rgb(dst, ref));
+        }
+    }
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// crop + flip + resize as three filters against one fused geometry dispatch
+static int bench_geometry(int width, int height, int loop)
+{
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+
+    ImGui::Crop_vulkan crop(gpu);
+    ImGui::Flip_vulkan flip(gpu);
+    ImGui::Resize_vulkan resize(gpu);
+    ImGui::Geometry_vulkan geometry(gpu);
+    int crop_w = width / 2, crop_h = height / 2;
+    ImGui::VkMat crop_gpu, flip_gpu, chain_gpu, fused_gpu;
+    crop_gpu.type = flip_gpu.type = chain_gpu.type = fused_gpu.type = IM_DT_INT8;
+
+    double t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+    {
+        crop.crop(src_gpu, crop_gpu, width / 4, height / 4, crop_w, crop_h);
+        flip.flip(crop_gpu, flip_gpu, true, false);
+        resize.Resize(flip_gpu, chain_gpu, 0.5f, 0.5f, IM_INTERPOLATE_BILINEAR);
+    }
+    double chain_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        geometry.transform(src_gpu, fused_gpu, width / 4, height / 4, crop_w, crop_h, true, false, false, chain_gpu.w, chain_gpu.h, IM_INTERPOLATE_BILINEAR);
+    double fused_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+    ImGui::ImMat chain, fused;
+    ImGui::ImVulkanVkMatToImMat(chain_gpu, chain);
+    ImGui::ImVulkanVkMatToImMat(fused_gpu, fused);
+    cout << "geometry " << width << "x" << height << " crop " << crop_w << "x" << crop_h << " + flip + resize to " << fused.w << "x" << fused.h << endl;
+    fprintf(stdout, "  chained %8.3f ms  fused %8.3f ms  psnr %6.2f dB\n", chain_ms, fused_ms, psnr_rgb(chain, fused));
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// N frames one submit each against N frames recorded into one submit
+static int bench_edge(int width, int height, int loop)
+{
+    const int batch = 8;
+    std::vector<ImGui::ImMat> frames(batch);
+    for (auto& frame : frames)
+        make_zone_plate(frame, width, height);
+
+    ImGui::Canny_vulkan canny(ImGui::get_default_gpu_index());
+    ImGui::Harris_vulkan harris(ImGui::get_default_gpu_index());
+    canny.SetParam(3, 0.1f, 0.45f);
+    harris.SetParam(3, 1.0f, 0.1f, 0.04f, 5.0f);
+    std::vector<ImGui::ImMat> outs(batch);
+    for (auto& out : outs)
+        out.type = IM_DT_INT8;
+    cout << "edge " << width << "x" << height << " rgba8, " << batch << " frames per batch, " << loop << " loops" << endl;
+
+    canny.filter(frames, outs); // warm up
+    double t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        for (int j = 0; j < batch; j++)
+            canny.filter(frames[j], outs[j]);
+    double single_ms = (get_current_time() - t0) * 1000.0 / (loop * batch);
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        canny.filter(frames, outs);
+    double batch_ms = (get_current_time() - t0) * 1000.0 / (loop * batch);
+    fprintf(stdout, "  canny  single %8.3f ms/frame  batched %8.3f ms/frame\n", single_ms, batch_ms);
+
+    harris.filter(frames, outs); // warm up
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        for (int j = 0; j < batch; j++)
+            harris.filter(frames[j], outs[j]);
+    single_ms = (get_current_time() - t0) * 1000.0 / (loop * batch);
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        harris.filter(frames, outs);
+    batch_ms = (get_current_time() - t0) * 1000.0 / (loop * batch);
+    fprintf(stdout, "  harris single %8.3f ms/frame  batched %8.3f ms/frame\n", single_ms, batch_ms);
+    return 0;
+}
+
+// grading panel as nine chained adjustment filters against one fused color grade dispatch
+static int bench_grade(int width, int height, int loop)
+{
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+
+    ImGui::ColorGradeParam param;
+    param.exposure = 0.2f;
+    param.temperature = 0.1f;
+    param.shadows = ImVec4(0.05f, 0.f, -0.05f, 0.f);
+    param.midtones = ImVec4(0.f, 0.02f, 0.f, 0.f);
+    param.highlights = ImVec4(-0.03f, 0.f, 0.03f, 0.f);
+    param.brightness = 0.02f;
+    param.contrast = 1.1f;
+    param.gamma = 0.9f;
+    param.saturation = 1.2f;
+    param.vibrance = 0.2f;
+    param.hue = 0.1f;
+
+    ImGui::Exposure_vulkan exposure(gpu);
+    ImGui::WhiteBalance_vulkan whitebalance(gpu);
+    ImGui::ColorBalance_vulkan colorbalance(gpu);
+    ImGui::Brightness_vulkan brightness(gpu);
+    ImGui::Contrast_vulkan contrast(gpu);
+    ImGui::Gamma_vulkan gamma(gpu);
+    ImGui::Saturation_vulkan saturation(gpu);
+    ImGui::Vibrance_vulkan vibrance(gpu);
+    ImGui::Hue_vulkan hue(gpu);
+    ImGui::ColorGrade_vulkan grade(gpu);
+    ImGui::VkMat ping, pong, fused_gpu;
+    ping.type = pong.type = fused_gpu.type = IM_DT_INT8;
+
+    double t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+    {
+        exposure.filter(src_gpu, ping, param.exposure);
+        whitebalance.filter(ping, pong, param.temperature);
+        colorbalance.filter(pong, ping, param.shadows, param.midtones, param.highlights, param.preserve_lightness);
+        brightness.filter(ping, pong, param.brightness);
+        contrast.filter(pong, ping, param.contrast);
+        gamma.filter(ping, pong, param.gamma);
+        saturation.filter(pong, ping, param.saturation);
+        vibrance.filter(ping, pong, param.vibrance);
+        hue.filter(pong, ping, param.hue);
+    }
+    double chain_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+    grade.filter(src_gpu, fused_gpu, param); // warm up
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        grade.filter(src_gpu, fused_gpu, param);
+    double fused_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+    ImGui::ImMat chain, fused;
+    ImGui::ImVulkanVkMatToImMat(ping, chain);
+    ImGui::ImVulkanVkMatToImMat(fused_gpu, fused);
+    cout << "grade " << width << "x" << height << " rgba8, 9 stages, " << loop << " loops" << endl;
+    fprintf(stdout, "  chained %8.3f ms  fused %8.3f ms  psnr %6.2f dB\n", chain_ms, fused_ms, psnr_rgb(chain, fused));
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// timeline frame of N layers, one blend call per layer against one composite submit
+static int bench_composite(int loop)
+{
+    const int layer_count = 10;
+    const struct { int w, h; } sizes[] = { { 1920, 1080 }, { 3840, 2160 } };
+    const int modes[] = { IM_BLEND_NORMAL, IM_BLEND_SCREEN, IM_BLEND_MULTIPLY, IM_BLEND_OVERLAY, IM_BLEND_ADD };
+
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::AlphaBlending_vulkan blending(gpu);
+    cout << "composite " << layer_count << " layers rgba8, " << loop << " loops, gpu resident" << endl;
+    for (auto& size : sizes)
+    {
+        std::vector<ImGui::ImBlendLayer> layers(layer_count);
+        for (int i = 0; i < layer_count; i++)
+        {
+            ImGui::ImMat mat;
+            int w = i == 0 ? size.w : size.w / 2, h = i == 0 ? size.h : size.h / 2;
+            make_zone_plate(mat, w, h);
+            ImGui::VkCompute cmd(vkdev);
+            ImGui::VkMat mat_gpu;
+            cmd.record_clone(mat, mat_gpu, opt);
+            cmd.submit_and_wait();
+            layers[i].mat = mat_gpu;
+            layers[i].x = i == 0 ? 0 : (i * size.w / 12);
+            layers[i].y = i == 0 ? 0 : (i * size.h / 16);
+            layers[i].opacity = i == 0 ? 1.f : 0.8f;
+        }
+
+        // two mats per call, normal mode only
+        ImGui::VkMat ping, pong;
+        ping.type = pong.type = IM_DT_INT8;
+        double t0 = get_current_time();
+        for (int n = 0; n < loop; n++)
+        {
+            ping = layers[0].mat;
+            for (int i = 1; i < layer_count; i++)
+            {
+                blending.blend(layers[i].mat, ping, pong, layers[i].x, layers[i].y);
+                std::swap(ping, pong);
+            }
+        }
+        double chain_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+        ImGui::VkMat fused;
+        fused.type = IM_DT_INT8;
+        fused.w = size.w;
+        fused.h = size.h;
+        blending.composite(layers, fused); // warm up
+        t0 = get_current_time();
+        for (int n = 0; n < loop; n++)
+            blending.composite(layers, fused);
+        double fused_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+        ImGui::ImMat chain, composited;
+        ImGui::ImVulkanVkMatToImMat(ping, chain);
+        ImGui::ImVulkanVkMatToImMat(fused, composited);
+        fprintf(stdout, "  %dx%d  per blend %8.3f ms %8.1f layers/s  composite %8.3f ms %8.1f layers/s  psnr %6.2f dB\n",
+                size.w, size.h, chain_ms, layer_count * 1000.0 / chain_ms, fused_ms, layer_count * 1000.0 / fused_ms, psnr_rgb(chain, composited));
+
+        // mixed modes and scaled layers, the case blend() can not express
+        for (int i = 1; i < layer_count; i++)
+        {
+            layers[i].mode = modes[i % (sizeof(modes) / sizeof(modes[0]))];
+            layers[i].scale_x = layers[i].scale_y = 0.5f + 0.1f * i;
+        }
+        t0 = get_current_time();
+        for (int n = 0; n < loop; n++)
+            blending.composite(layers, fused);
+        fused_ms = (get_current_time() - t0) * 1000.0 / loop;
+        fprintf(stdout, "  %dx%d  mixed modes and scale composite %8.3f ms %8.1f layers/s\n", size.w, size.h, fused_ms, layer_count * 1000.0 / fused_ms);
+    }
+
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// decoded nv12 frame in host memory to a letterboxed network tensor in host memory
+static int bench_preprocess(int width, int height, int loop)
+{
+    const int net_w = 640, net_h = 640;
+    const float pad = 114.f / 255.f;
+    std::vector<float> mean_vals = { 0.485f, 0.456f, 0.406f };
+    std::vector<float> norm_vals = { 1.f / 0.229f, 1.f / 0.224f, 1.f / 0.225f };
+
+    int gpu = ImGui::get_default_gpu_index();
+    ImGui::ImMat rgba, nv12;
+    make_zone_plate(rgba, width, height);
+    ImGui::ColorConvert_vulkan convert(gpu);
+    nv12.type = IM_DT_INT8;
+    nv12.color_format = IM_CF_NV12;
+    nv12.color_range = IM_CR_NARROW_RANGE;
+    rgba.color_space = IM_CS_BT709;
+    convert.ConvertColorFormat(rgba, nv12);
+
+    ImGui::Copy_Make_Border_vulkan border(gpu);
+    ImGui::Substract_Mean_Normalize_vulkan normalize(gpu);
+    ImGui::Preprocess_vulkan preprocess(gpu);
+    ImGui::ImMat probe;
+    preprocess.forward(nv12, probe, net_w, net_h, mean_vals, norm_vals); // letterbox rect
+    int left = preprocess.roi_x, top = preprocess.roi_y;
+    int right = net_w - preprocess.roi_w - left, bottom = net_h - preprocess.roi_h - top;
+    cout << "preprocess " << width << "x" << height << " nv12 to " << net_w << "x" << net_h << " letterbox, host in/out, " << loop << " loops" << endl;
+
+    // yuv to rgb with resize, border, normalize, each its own upload and download
+    ImGui::ImMat resized, padded, chain;
+    double t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+    {
+        resized.release();
+        resized.type = IM_DT_INT8;
+        resized.color_format = IM_CF_ABGR;
+        resized.w = preprocess.roi_w;
+        resized.h = preprocess.roi_h;
+        convert.ConvertColorFormat(nv12, resized, IM_INTERPOLATE_BILINEAR);
+        padded.color_format = IM_CF_ABGR;
+        border.forward(resized, padded, top, bottom, left, right, pad);
+        chain.type = IM_DT_FLOAT32;
+        chain.color_format = IM_CF_BGR;
+        normalize.forward(padded, chain, mean_vals, norm_vals);
+    }
+    double chain_ms = (get_current_time() - t0) * 1000.0 / loop;
+    fprintf(stdout, "  chained fp32 planar      %8.3f ms\n", chain_ms);
+
+    const struct { ImDataType type; int elempack; const char* name; } outputs[] = {
+        { IM_DT_FLOAT32, 1, "fused fp32 planar       " },
+        { IM_DT_FLOAT16, 1, "fused fp16 planar       " },
+        { IM_DT_FLOAT32, 4, "fused fp32 elempack 4   " },
+        { IM_DT_FLOAT16, 4, "fused fp16 elempack 4   " },
+        { IM_DT_FLOAT16, 8, "fused fp16 elempack 8   " },
+    };
+    for (auto& o : outputs)
+    {
+        ImGui::ImMat tensor;
+        tensor.type = o.type;
+        preprocess.forward(nv12, tensor, net_w, net_h, mean_vals, norm_vals, o.elempack, true, pad); // warm up
+        t0 = get_current_time();
+        for (int i = 0; i < loop; i++)
+            preprocess.forward(nv12, tensor, net_w, net_h, mean_vals, norm_vals, o.elempack, true, pad);
+        double ms = (get_current_time() - t0) * 1000.0 / loop;
+        if (o.type == IM_DT_FLOAT32 && o.elempack == 1)
+        {
+            // same math, the chained resize samples on a corner aligned grid so small differences remain
+            double diff = 0;
+            size_t count = (size_t)net_w * net_h;
+            for (int c = 0; c < 3; c++)
+            {
+                const float* a = (const float*)tensor.data + c * tensor.cstep;
+                const float* b = (const float*)chain.data + c * chain.cstep;
+                for (size_t j = 0; j < count; j++)
+                    diff += fabs(a[j] - b[j]);
+            }
+            fprintf(stdout, "  %s %8.3f ms  mean abs diff to chained %.4f\n", o.name, ms, diff / (count * 3));
+        }
+        else
+            fprintf(stdout, "  %s %8.3f ms\n", o.name, ms);
+    }
+    return 0;
+}
+
+// independent frames over every device, host in/out so each job carries its own transfers
+static int bench_scheduler(int width, int height, int loop)
+{
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+    ImGui::ColorGradeParam param;
+    param.exposure = 0.2f;
+    param.contrast = 1.1f;
+    param.saturation = 1.2f;
+    param.hue = 0.1f;
+
+    int gpu_count = ImGui::get_gpu_count();
+    int frames = loop * std::max(gpu_count, 1);
+    std::vector<ImGui::ColorGrade_vulkan*> grades(gpu_count + 1, nullptr);
+    std::vector<ImGui::ImMat> outputs(frames);
+    cout << "scheduler " << width << "x" << height << " rgba8 grade, " << gpu_count << " devices, " << frames << " frames" << endl;
+
+    int gpu = ImGui::get_default_gpu_index();
+    grades[gpu] = new ImGui::ColorGrade_vulkan(gpu);
+    grades[gpu]->filter(src, outputs[0], param); // warm up
+    double t0 = get_current_time();
+    for (int i = 0; i < frames; i++)
+        grades[gpu]->filter(src, outputs[i], param);
+    double single_fps = frames / (get_current_time() - t0);
+    fprintf(stdout, "  single device  %8.2f fps\n", single_fps);
+
+    {
+        ImGui::GpuScheduler scheduler;
+        // one job per lane first so pipelines are built outside the measure
+        for (int i = 0; i < scheduler.lane_count(); i++)
+            scheduler.submit([&](int g) { if (!grades[g]) grades[g] = new ImGui::ColorGrade_vulkan(g); });
+        scheduler.wait();
+        scheduler.reset_stats();
+        for (int i = 0; i < frames; i++)
+            scheduler.submit([&, i](int g) { grades[g]->filter(src, outputs[i], param); }, src.total() * src.elemsize * 2);
+        scheduler.wait();
+        double fps = scheduler.throughput();
+        fprintf(stdout, "  scheduler      %8.2f fps  x%.2f\n", fps, fps / single_fps);
+        for (auto& stat : scheduler.stats())
+            fprintf(stdout, "    gpu %d  %6llu frames  busy %8.3f s  %8.2f fps  heap %u/%u MB\n", stat.gpu,
+                    (unsigned long long)stat.completed, stat.busy_time, stat.throughput, stat.heap_usage, stat.heap_budget);
+    }
+    for (auto grade : grades)
+        delete grade;
+    return 0;
+}
+
+// default local size against the tuned one, the first tuned call pays the benchmark
+static int bench_tuning(int width, int height, int loop)
+{
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+    ImGui::ColorGradeParam param;
+    param.exposure = 0.2f;
+    param.contrast = 1.1f;
+    param.saturation = 1.2f;
+    cout << "tuning " << width << "x" << height << " rgba8, " << loop << " loops" << endl;
+
+    for (int tuned = 0; tuned < 2; tuned++)
+    {
+        ImGui::set_local_size_tuning(tuned != 0);
+        ImGui::ColorGrade_vulkan grade(gpu);
+        ImGui::Resize_vulkan resize(gpu);
+        ImGui::VkMat graded, half;
+        graded.type = half.type = IM_DT_INT8;
+        double t0 = get_current_time();
+        grade.filter(src_gpu, graded, param);
+        resize.Resize(src_gpu, half, 0.5f, 0.5f, IM_INTERPOLATE_BICUBIC);
+        double first_ms = (get_current_time() - t0) * 1000.0;
+        t0 = get_current_time();
+        for (int i = 0; i < loop; i++)
+            grade.filter(src_gpu, graded, param);
+        double grade_ms = (get_current_time() - t0) * 1000.0 / loop;
+        t0 = get_current_time();
+        for (int i = 0; i < loop; i++)
+            resize.Resize(src_gpu, half, 0.5f, 0.5f, IM_INTERPOLATE_BICUBIC);
+        double resize_ms = (get_current_time() - t0) * 1000.0 / loop;
+        fprintf(stdout, "  %s  first call %8.3f ms  grade %8.3f ms  resize bicubic 1/2 %8.3f ms\n",
+                tuned ? "tuned  " : "default", first_ms, grade_ms, resize_ms);
+    }
+    ImGui::set_local_size_tuning(false);
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// all four scopes on one 4K frame at full, quarter and 1/16 sample density, with the histogram error against stride 1
+static int bench_scopes(int loop)
+{
+    const int width = 3840, height = 2160;
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+    ImGui::Histogram_vulkan histogram(gpu);
+    ImGui::Waveform_vulkan waveform(gpu);
+    ImGui::Vector_vulkan vector(gpu);
+    ImGui::CIE_vulkan cie(gpu);
+    cout << "scopes " << width << "x" << height << " rgba8, histogram + waveform + vector + cie, " << loop << " loops" << endl;
+
+    ImGui::ImMat reference;
+    histogram.scope(src_gpu, reference, 256, 1.0f, false, 1);
+    const int strides[] = {1, 2, 4};
+    for (int stride : strides)
+    {
+        ImGui::VkMat hist_gpu, wave_gpu, vector_gpu, cie_gpu;
+        double t0 = get_current_time();
+        for (int i = 0; i < loop; i++)
+        {
+            histogram.scope(src_gpu, hist_gpu, 256, 1.0f, false, stride);
+            waveform.scope(src_gpu, wave_gpu, 256, 0.1f, false, stride);
+            vector.scope(src_gpu, vector_gpu, 0.01f, stride);
+            cie.scope(src_gpu, cie_gpu, 0.01f, true, stride);
+        }
+        double scopes_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+        ImGui::ImMat hist;
+        histogram.scope(src_gpu, hist, 256, 1.0f, false, stride);
+        double max_error = 0;
+        for (int c = 0; c < 3; c++)
+            for (int x = 0; x < 256; x++)
+                max_error = std::max(max_error, (double)fabs(hist.at<float>(x, 0, c) - reference.at<float>(x, 0, c)));
+        double samples = (double)((width + stride - 1) / stride) * ((height + stride - 1) / stride);
+        fprintf(stdout, "  stride %d  %8.3f ms for 4 scopes  histogram max bin error %.5f%% of pixels (bound 3 x %.5f%%)\n",
+                stride, scopes_ms, max_error * 100.0 / ((double)width * height), 50.0 / sqrt(samples));
+    }
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+// frame statistics on the device against downloading the frame for the cpu
+static int bench_reduce(int width, int height, int loop)
+{
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+    int gpu = ImGui::get_default_gpu_index();
+    const ImGui::VulkanDevice* vkdev = ImGui::get_gpu_device(gpu);
+    ImGui::Option opt;
+    opt.blob_vkallocator = vkdev->acquire_blob_allocator();
+    opt.staging_vkallocator = vkdev->acquire_staging_allocator();
+    ImGui::VkMat src_gpu;
+    {
+        ImGui::VkCompute cmd(vkdev);
+        cmd.record_clone(src, src_gpu, opt);
+        cmd.submit_and_wait();
+    }
+    ImGui::Reduce_vulkan reduce(gpu);
+    cout << "reduce " << width << "x" << height << " rgba8, " << loop << " loops" << endl;
+
+    ImGui::ImMat stats;
+    reduce.reduce(src_gpu, stats); // warm up
+    double t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        reduce.reduce(src_gpu, stats);
+    double gpu_ms = (get_current_time() - t0) * 1000.0 / loop;
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+        reduce.reduce_arg(src_gpu, stats);
+    double arg_ms = (get_current_time() - t0) * 1000.0 / loop;
+
+    ImGui::VkCompute cmd(vkdev);
+    t0 = get_current_time();
+    for (int i = 0; i < loop; i++)
+    {
+        ImGui::ImMat frame;
+        cmd.record_clone(src_gpu, frame, opt);
+        cmd.submit_and_wait();
+        cmd.reset();
+        ImGui::CPU::Reduce(frame, stats, false);
+    }
+    double cpu_ms = (get_current_time() - t0) * 1000.0 / loop;
+    fprintf(stdout, "  gpu %8.3f ms  gpu arg %8.3f ms  download + cpu %8.3f ms\n", gpu_ms, arg_ms, cpu_ms);
+
+    src_gpu.release();
+    vkdev->reclaim_blob_allocator(opt.blob_vkallocator);
+    vkdev->reclaim_staging_allocator(opt.staging_vkallocator);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    string bench = argc > 1 ? argv[1] : "all";
+    int width = argc > 3 ? atoi(argv[2]) : 7680;
+    int height = argc > 3 ? atoi(argv[3]) : 4320;
+    int loop = argc > 4 ? atoi(argv[4]) : 20;
+    if (width <= 0 || height <= 0 || loop <= 0)
+    {
+        cout << "usage: " << argv[0] << " [all|resize|geometry|edge|grade|composite|preprocess|scheduler|tuning|scopes|reduce] [width height] [loop]" << endl;
+        return -1;
+    }
+
+    ImGui::ImVulkanShaderInit();
+    if (bench == "all" || bench == "resize")
+        bench_resize(width, height, loop);
+    if (bench == "all" || bench == "geometry")
+        bench_geometry(width, height, loop);
+    if (bench == "all" || bench == "edge")
+        bench_edge(width, height, loop);
+    if (bench == "all" || bench == "grade")
+        bench_grade(width, height, loop);
+    if (bench == "all" || bench == "composite")
+        bench_composite(loop);
+    if (bench == "all" || bench == "preprocess")
+        bench_preprocess(width, height, loop);
+    if (bench == "all" || bench == "scheduler")
+        bench_scheduler(width, height, loop);
+    if (bench == "all" || bench == "tuning")
+        bench_tuning(width, height, loop);
+    if (bench == "all" || bench == "scopes")
+        bench_scopes(loop);
+    if (bench == "all" || bench == "reduce")
+        bench_reduce(width, height, loop);
+    ImGui::ImVulkanShaderClear();
+    return 0;
+}
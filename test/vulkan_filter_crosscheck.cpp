@@ -0,0 +1,318 @@
+// Cross check of the vulkan filters against their cpu reference path.
+// Every filter is built twice, once on the vulkan device and once on a gpu index without device,
+// which selects the cpu path, and both outputs are compared by psnr. All checks run a second time
+// with set_local_size_tuning on, so every tuned local size is cross checked as well.
+// Runs without a physical gpu on Mesa lavapipe:
+//   VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json vulkan_filter_crosscheck
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <immat.h>
+#include <ImVulkanShader.h>
+#include <Geometry_vulkan.h>
+#include <GaussianBlur.h>
+#include <Box.h>
+#include <USM_vulkan.h>
+#include <Brightness_vulkan.h>
+#include <Contrast_vulkan.h>
+#include <Gamma_vulkan.h>
+#include <Saturation_vulkan.h>
+#include <Hue_vulkan.h>
+#include <AlphaBlending_vulkan.h>
+#include <Lut3D.h>
+#include <Reduce_vulkan.h>
+#include "vulkan_test_util.h"
+
+using namespace std;
+
+static int g_gpu = 0;
+static int g_cpu = 0;
+
+static double value_at(const ImGui::ImMat& m, size_t i)
+{
+    switch (m.type)
+    {
+        case IM_DT_INT8:    return ((const uint8_t*)m.data)[i] / 255.0;
+        case IM_DT_INT16:   return ((const uint16_t*)m.data)[i] / 65535.0;
+        case IM_DT_FLOAT16: return im_float16_to_float32(((const unsigned short*)m.data)[i]);
+        case IM_DT_FLOAT32: return ((const float*)m.data)[i];
+        default:            return 0;
+    }
+}
+
+static int check(const char* name, const ImGui::ImMat& out_gpu, const ImGui::ImMat& out_cpu, double min_psnr)
+{
+    bool pass = !out_gpu.empty() && !out_cpu.empty() && out_gpu.w == out_cpu.w && out_gpu.h == out_cpu.h &&
+                out_gpu.c == out_cpu.c && out_gpu.type == out_cpu.type;
+    double psnr = 0, max_diff = 1;
+    if (pass)
+    {
+        double mse = 0;
+        max_diff = 0;
+        size_t count = out_gpu.total();
+        for (size_t i = 0; i < count; i++)
+        {
+            double diff = value_at(out_gpu, i) - value_at(out_cpu, i);
+            mse += diff * diff;
+            max_diff = std::max(max_diff, fabs(diff));
+        }
+        mse /= count;
+        psnr = mse <= 1e-12 ? 99.0 : 10.0 * log10(1.0 / mse);
+        pass = psnr >= min_psnr;
+    }
+    fprintf(stdout, "  %-28s %5dx%-5d psnr %6.2f dB  max diff %.4f  %s\n", name, out_gpu.w, out_gpu.h, psnr, max_diff, pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
+
+// make(gpu) builds the filter, run(filter, out) runs it, out type is preset to int8
+template <typename Make, typename Run>
+static int cross_check(const char* name, double min_psnr, Make make, Run run)
+{
+    auto gpu_filter = make(g_gpu);
+    auto cpu_filter = make(g_cpu);
+    ImGui::ImMat out_gpu, out_cpu;
+    out_gpu.type = out_cpu.type = IM_DT_INT8;
+    run(*gpu_filter, out_gpu);
+    run(*cpu_filter, out_cpu);
+    return check(name, out_gpu, out_cpu, min_psnr);
+}
+
+static int check_color_convert(const ImGui::ImMat& src)
+{
+    int failed = 0;
+    auto make = [](int gpu) { return std::make_unique<ImGui::ColorConvert_vulkan>(gpu); };
+    failed += cross_check("conv abgr->argb", 45, make, [&](ImGui::ColorConvert_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_ARGB;
+        f.ConvertColorFormat(src, out);
+    });
+
+    ImGui::ImMat rgb709 = src;
+    rgb709.color_space = IM_CS_BT709;
+    ImGui::ImMat yuv;
+    failed += cross_check("rgb->yuv420 bt709 narrow", 40, make, [&](ImGui::ColorConvert_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_YUV420;
+        out.color_range = IM_CR_NARROW_RANGE;
+        f.ConvertColorFormat(rgb709, out);
+        yuv = out;
+    });
+
+    const struct { ImInterpolateMode mode; const char* name; } modes[] = {
+        { IM_INTERPOLATE_NEAREST,  "yuv420->rgb nearest 1/2" },
+        { IM_INTERPOLATE_BILINEAR, "yuv420->rgb bilinear 1/2" },
+        { IM_INTERPOLATE_BICUBIC,  "yuv420->rgb bicubic 1/2" },
+        { IM_INTERPOLATE_AREA,     "yuv420->rgb area 1/2" },
+    };
+    failed += cross_check("yuv420->rgb", 40, make, [&](ImGui::ColorConvert_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_ABGR;
+        f.ConvertColorFormat(yuv, out);
+    });
+    for (auto& m : modes)
+    {
+        failed += cross_check(m.name, 40, make, [&](ImGui::ColorConvert_vulkan& f, ImGui::ImMat& out)
+        {
+            out.color_format = IM_CF_ABGR;
+            out.w = yuv.w / 2;
+            out.h = yuv.h / 2;
+            f.ConvertColorFormat(yuv, out, m.mode);
+        });
+    }
+
+    ImGui::ImMat gray;
+    gray.create_type(src.w, src.h, 1, IM_DT_INT8);
+    gray.color_format = IM_CF_GRAY;
+    for (size_t i = 0; i < (size_t)src.w * src.h; i++)
+        ((uint8_t*)gray.data)[i] = ((const uint8_t*)src.data)[i * 4];
+    failed += cross_check("gray->rgb", 45, make, [&](ImGui::ColorConvert_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_ABGR;
+        f.ConvertColorFormat(gray, out);
+    });
+    return failed;
+}
+
+static int check_geometry(const ImGui::ImMat& src)
+{
+    int failed = 0;
+    auto make_resize = [](int gpu) { return std::make_unique<ImGui::Resize_vulkan>(gpu); };
+    const struct { ImInterpolateMode mode; const char* name; double min_psnr; } modes[] = {
+        { IM_INTERPOLATE_NEAREST,  "resize nearest 1/2",  35 },
+        { IM_INTERPOLATE_BILINEAR, "resize bilinear 1/2", 40 },
+        { IM_INTERPOLATE_BICUBIC,  "resize bicubic 1/2",  40 },
+        { IM_INTERPOLATE_AREA,     "resize area 1/3",     40 },
+        { IM_INTERPOLATE_LANCZOS,  "resize lanczos3 1/3", 40 },
+        // the shader path halves through fp16 levels, the cpu path does one exact area average
+        { IM_INTERPOLATE_PYRAMID,  "resize pyramid 1/3",  30 },
+    };
+    for (auto& m : modes)
+    {
+        float scale = m.mode == IM_INTERPOLATE_AREA || m.mode == IM_INTERPOLATE_LANCZOS || m.mode == IM_INTERPOLATE_PYRAMID ? 1.f / 3.f : 0.5f;
+        failed += cross_check(m.name, m.min_psnr, make_resize, [&](ImGui::Resize_vulkan& f, ImGui::ImMat& out)
+        {
+            out.color_format = IM_CF_ABGR;
+            f.Resize(src, out, scale, scale, m.mode);
+        });
+    }
+
+    auto make_geometry = [](int gpu) { return std::make_unique<ImGui::Geometry_vulkan>(gpu); };
+    failed += cross_check("crop+flip+transpose bicubic", 40, make_geometry, [&](ImGui::Geometry_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_ABGR;
+        f.transform(src, out, src.w / 8, src.h / 8, src.w / 2, src.h / 2, true, false, true, src.h / 3, src.w / 3, IM_INTERPOLATE_BICUBIC);
+    });
+    failed += cross_check("crop+flip rgb out", 45, make_geometry, [&](ImGui::Geometry_vulkan& f, ImGui::ImMat& out)
+    {
+        out.color_format = IM_CF_BGR;
+        f.transform(src, out, src.w / 4, 0, src.w / 2, src.h, false, true, false, 0, 0, IM_INTERPOLATE_NEAREST);
+    });
+    return failed;
+}
+
+static int check_blur(const ImGui::ImMat& src)
+{
+    int failed = 0;
+    failed += cross_check("gaussian r3", 40, [](int gpu) { return std::make_unique<ImGui::GaussianBlur_vulkan>(gpu); },
+        [&](ImGui::GaussianBlur_vulkan& f, ImGui::ImMat& out) { f.SetParam(3, 0.f); f.filter(src, out); });
+    failed += cross_check("box 5x5", 40, [](int gpu) { return std::make_unique<ImGui::BoxBlur_vulkan>(gpu); },
+        [&](ImGui::BoxBlur_vulkan& f, ImGui::ImMat& out) { f.SetParam(5, 5); f.filter(src, out); });
+    failed += cross_check("usm", 35, [](int gpu) { return std::make_unique<ImGui::USM_vulkan>(gpu); },
+        [&](ImGui::USM_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 1.5f, 2.f, 0.05f); });
+    return failed;
+}
+
+static int check_color(const ImGui::ImMat& src)
+{
+    int failed = 0;
+    failed += cross_check("brightness", 45, [](int gpu) { return std::make_unique<ImGui::Brightness_vulkan>(gpu); },
+        [&](ImGui::Brightness_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 0.1f); });
+    failed += cross_check("contrast", 45, [](int gpu) { return std::make_unique<ImGui::Contrast_vulkan>(gpu); },
+        [&](ImGui::Contrast_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 1.5f); });
+    failed += cross_check("gamma", 40, [](int gpu) { return std::make_unique<ImGui::Gamma_vulkan>(gpu); },
+        [&](ImGui::Gamma_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 2.2f); });
+    failed += cross_check("saturation", 40, [](int gpu) { return std::make_unique<ImGui::Saturation_vulkan>(gpu); },
+        [&](ImGui::Saturation_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 1.5f); });
+    failed += cross_check("hue", 35, [](int gpu) { return std::make_unique<ImGui::Hue_vulkan>(gpu); },
+        [&](ImGui::Hue_vulkan& f, ImGui::ImMat& out) { f.filter(src, out, 0.5f); });
+
+    ImGui::ImMat overlay;
+    make_zone_plate(overlay, src.w / 2, src.h / 2, true);
+    auto make_blend = [](int gpu) { return std::make_unique<ImGui::AlphaBlending_vulkan>(gpu); };
+    failed += cross_check("alpha blend", 45, make_blend,
+        [&](ImGui::AlphaBlending_vulkan& f, ImGui::ImMat& out) { f.blend(overlay, src, out, src.w / 3, -src.h / 8); });
+    failed += cross_check("alpha blend 0.6", 45, make_blend,
+        [&](ImGui::AlphaBlending_vulkan& f, ImGui::ImMat& out) { f.blend(overlay, src, out, 0.6f, src.w / 3, -src.h / 8); });
+
+    std::vector<ImGui::ImBlendLayer> layers(4);
+    const int modes[] = { IM_BLEND_NORMAL, IM_BLEND_SCREEN, IM_BLEND_OVERLAY, IM_BLEND_DIFFERENCE };
+    for (int i = 0; i < 4; i++)
+    {
+        layers[i].mat = i == 0 ? src : overlay;
+        layers[i].x = i * src.w / 5;
+        layers[i].y = i * src.h / 7 - src.h / 10;
+        layers[i].scale_x = i == 0 ? 1.f : 0.5f + 0.3f * i;
+        layers[i].scale_y = i == 0 ? 1.f : 1.3f - 0.2f * i;
+        layers[i].opacity = i == 0 ? 1.f : 0.7f;
+        layers[i].mode = modes[i];
+    }
+    failed += cross_check("composite 4 layers", 40, make_blend,
+        [&](ImGui::AlphaBlending_vulkan& f, ImGui::ImMat& out) { out.w = src.w; out.h = src.h; f.composite(layers, out); });
+
+    const struct { int mode; const char* name; } luts[] = {
+        { IM_INTERPOLATE_NEAREST,     "lut3d nearest" },
+        { IM_INTERPOLATE_TRILINEAR,   "lut3d trilinear" },
+        { IM_INTERPOLATE_TETRAHEDRAL, "lut3d tetrahedral" },
+    };
+    for (auto& l : luts)
+    {
+        // fp16 table on the shader side
+        failed += cross_check(l.name, 35, [&](int gpu) { return std::make_unique<ImGui::LUT3D_vulkan>(SDR709_HDRHLG, l.mode, gpu); },
+            [&](ImGui::LUT3D_vulkan& f, ImGui::ImMat& out) { f.filter(src, out); });
+    }
+    return failed;
+}
+
+// statistics against the cpu sums in double: values within 1e-4 of max(1, |cpu|), positions exact
+static int check_reduce(const ImGui::ImMat& src)
+{
+    int failed = 0;
+    ImGui::Reduce_vulkan gpu_reduce(g_gpu);
+    ImGui::Reduce_vulkan cpu_reduce(g_cpu);
+    for (int arg = 0; arg < 2; arg++)
+    {
+        ImGui::ImMat out_gpu, out_cpu;
+        if (arg)
+        {
+            gpu_reduce.reduce_arg(src, out_gpu);
+            cpu_reduce.reduce_arg(src, out_cpu);
+        }
+        else
+        {
+            gpu_reduce.reduce(src, out_gpu);
+            cpu_reduce.reduce(src, out_cpu);
+        }
+        bool pass = !out_gpu.empty() && !out_cpu.empty() && out_gpu.w == out_cpu.w && out_gpu.h == out_cpu.h;
+        double max_diff = 1;
+        if (pass)
+        {
+            max_diff = 0;
+            for (int y = 0; y < out_cpu.h; y++)
+                for (int x = 0; x < out_cpu.w; x++)
+                {
+                    double a = out_gpu.at<float>(x, y), b = out_cpu.at<float>(x, y);
+                    double diff = fabs(a - b) / std::max(1.0, fabs(b));
+                    max_diff = std::max(max_diff, diff);
+                }
+            pass = max_diff <= (arg ? 0 : 1e-4);
+        }
+        fprintf(stdout, "  %-28s %5dx%-5d max diff %.6f  %s\n", arg ? "reduce arg" : "reduce", src.w, src.h, max_diff, pass ? "PASS" : "FAIL");
+        failed += pass ? 0 : 1;
+    }
+    return failed;
+}
+
+int main(int argc, char* argv[])
+{
+    int width = argc > 2 ? atoi(argv[1]) : 640;
+    int height = argc > 2 ? atoi(argv[2]) : 360;
+    if (width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [width height]" << endl;
+        return -1;
+    }
+
+    ImGui::ImVulkanShaderInit();
+    g_gpu = ImGui::get_default_gpu_index();
+    g_cpu = ImGui::get_gpu_count();
+    if (!ImGui::get_gpu_device(g_gpu))
+    {
+        cout << "no vulkan device, nothing to cross check against" << endl;
+        ImGui::ImVulkanShaderClear();
+        return -1;
+    }
+
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height, true);
+    cout << "cross check vulkan against cpu on " << ImGui::get_gpu_info(g_gpu).device_name() << ", " << width << "x" << height << " rgba8" << endl;
+    int failed = 0;
+    // second run with every tunable pipeline on its tuned local size
+    for (int tuned = 0; tuned < 2; tuned++)
+    {
+        ImGui::set_local_size_tuning(tuned != 0);
+        cout << (tuned ? "tuned local sizes" : "default local sizes") << endl;
+        failed += check_color_convert(src);
+        failed += check_geometry(src);
+        failed += check_blur(src);
+        failed += check_color(src);
+        failed += check_reduce(src);
+    }
+    ImGui::set_local_size_tuning(false);
+    cout << (failed ? "FAILED " : "all passed") << (failed ? to_string(failed) : "") << endl;
+
+    ImGui::ImVulkanShaderClear();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+// Regression check of the chain-wide fp16 intermediate policy against an fp32 chain.
+// The same resize + color + sharpen + grade chain runs with set_intermediate_type(IM_DT_FLOAT32) as the
+// reference and with the fp16 default, every intermediate stays on the device in intermediate_type(),
+// the int8 outputs are compared by psnr. An int8 intermediate chain is printed for comparison only.
+// Runs without a physical gpu on Mesa lavapipe:
+//   VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json vulkan_precision_check
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <immat.h>
+#include <ImVulkanShader.h>
+#include <Brightness_vulkan.h>
+#include <Contrast_vulkan.h>
+#include <Saturation_vulkan.h>
+#include <Gamma_vulkan.h>
+#include <USM_vulkan.h>
+#include <ColorGrade_vulkan.h>
+#include "vulkan_test_util.h"
+
+using namespace std;
+
+// filters are built after the policy is set, intermediates take type
+static void run_chain(int gpu, const ImGui::ImMat& src, ImGui::ImMat& out, ImDataType type, size_t& intermediate_bytes)
+{
+    ImGui::Resize_vulkan resize(gpu);
+    ImGui::Brightness_vulkan brightness(gpu);
+    ImGui::Contrast_vulkan contrast(gpu);
+    ImGui::Saturation_vulkan saturation(gpu);
+    ImGui::Gamma_vulkan gamma(gpu);
+    ImGui::USM_vulkan usm(gpu);
+    ImGui::ColorGrade_vulkan grade(gpu);
+    ImGui::ColorGradeParam param;
+    param.exposure = 0.15f;
+    param.temperature = 0.1f;
+    param.vibrance = 0.2f;
+
+    ImGui::VkMat a, b;
+    a.type = b.type = type;
+    intermediate_bytes = 0;
+    resize.Resize(src, a, 0.5f, 0.5f, IM_INTERPOLATE_BICUBIC);
+    intermediate_bytes += a.total() * a.elemsize;
+    brightness.filter(a, b, 0.05f);
+    intermediate_bytes += b.total() * b.elemsize;
+    contrast.filter(b, a, 1.2f);
+    intermediate_bytes += a.total() * a.elemsize;
+    saturation.filter(a, b, 1.3f);
+    intermediate_bytes += b.total() * b.elemsize;
+    gamma.filter(b, a, 1.1f);
+    intermediate_bytes += a.total() * a.elemsize;
+    usm.filter(a, b, 1.5f, 1.0f, 0.02f);
+    intermediate_bytes += b.total() * b.elemsize;
+    out.type = IM_DT_INT8;
+    grade.filter(b, out, param);
+}
+
+int main(int argc, char* argv[])
+{
+    int width = argc > 2 ? atoi(argv[1]) : 1920;
+    int height = argc > 2 ? atoi(argv[2]) : 1080;
+    double min_psnr = argc > 3 ? atof(argv[3]) : 40.0;
+    if (width <= 0 || height <= 0)
+    {
+        cout << "usage: " << argv[0] << " [width height] [min psnr]" << endl;
+        return -1;
+    }
+
+    ImGui::ImVulkanShaderInit();
+    int gpu = ImGui::get_default_gpu_index();
+    if (!ImGui::get_gpu_device(gpu))
+    {
+        cout << "no vulkan device" << endl;
+        ImGui::ImVulkanShaderClear();
+        return -1;
+    }
+
+    ImGui::ImMat src;
+    make_zone_plate(src, width, height);
+    cout << "fp16 chain against fp32 chain on " << ImGui::get_gpu_info(gpu).device_name() << ", " << width << "x" << height << " rgba8" << endl;
+
+    ImGui::ImMat out_fp32, out_fp16, out_int8;
+    size_t bytes_fp32 = 0, bytes_fp16 = 0, bytes_int8 = 0;
+    ImGui::set_intermediate_type(IM_DT_FLOAT32);
+    run_chain(gpu, src, out_fp32, ImGui::intermediate_type(), bytes_fp32);
+    ImGui::set_intermediate_type(IM_DT_FLOAT16);
+    run_chain(gpu, src, out_fp16, ImGui::intermediate_type(), bytes_fp16);
+    run_chain(gpu, src, out_int8, IM_DT_INT8, bytes_int8);
+
+    double psnr_fp16 = psnr_rgb(out_fp16, out_fp32);
+    double psnr_int8 = psnr_rgb(out_int8, out_fp32);
+    bool pass = psnr_fp16 >= min_psnr;
+    fprintf(stdout, "  fp32 intermediates %8.2f MB  reference\n", bytes_fp32 / 1024.0 / 1024.0);
+    fprintf(stdout, "  fp16 intermediates %8.2f MB  psnr %6.2f dB  %s\n", bytes_fp16 / 1024.0 / 1024.0, psnr_fp16, pass ? "PASS" : "FAIL");
+    fprintf(stdout, "  int8 intermediates %8.2f MB  psnr %6.2f dB  (not checked)\n", bytes_int8 / 1024.0 / 1024.0, psnr_int8);
+
+    ImGui::ImVulkanShaderClear();
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+// Helpers shared by the vulkan filter benches and checks
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <immat.h>
+
+// synthetic 8-bit RGBA source, zone plate on rgb so aliasing shows up in PSNR.
+// alpha is opaque, or ramps along x with alpha_ramp so blending sees every coverage
+static inline void make_zone_plate(ImGui::ImMat& mat, int width, int height, bool alpha_ramp = false)
+{
+    mat.create_type(width, height, 4, IM_DT_INT8);
+    mat.color_format = IM_CF_ABGR;
+    uint8_t* data = (uint8_t*)mat.data;
+    const double k = M_PI / (double)std::max(width, height);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            double dx = x - width / 2, dy = y - height / 2;
+            double r2 = dx * dx + dy * dy;
+            uint8_t* pixel = data + ((size_t)y * width + x) * 4;
+            pixel[0] = (uint8_t)(127.5 + 127.5 * cos(k * r2 * 0.5));
+            pixel[1] = (uint8_t)(127.5 + 127.5 * cos(k * dx * dx * 0.25));
+            pixel[2] = (uint8_t)(255.0 * x / width);
+            pixel[3] = alpha_ramp ? (uint8_t)(255.0 * x / width) : 255;
+        }
+    }
+}
+
+// PSNR of the rgb channels of two int8 mats, 0 when they can't be compared and 99 when identical
+static inline double psnr_rgb(const ImGui::ImMat& a, const ImGui::ImMat& b)
+{
+    if (a.w != b.w || a.h != b.h || a.c != b.c || a.c < 3 || a.type != IM_DT_INT8 || b.type != IM_DT_INT8)
+        return 0;
+    const uint8_t* pa = (const uint8_t*)a.data;
+    const uint8_t* pb = (const uint8_t*)b.data;
+    double mse = 0;
+    size_t count = (size_t)a.w * a.h;
+    for (size_t i = 0; i < count; i++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            double diff = (double)pa[i * a.c + c] - (double)pb[i * b.c + c];
+            mse += diff * diff;
+        }
+    }
+    mse /= count * 3;
+    return mse <= 1e-12 ? 99.0 : 10.0 * log10(255.0 * 255.0 / mse);
+}